@@ -0,0 +1,46 @@
+# PlatformIO pre-build script: gzip portal/index.html into
+# src/portal_html.h so the captive portal serves it straight from flash.
+#
+# Also runs standalone: python scripts/embed_portal.py
+
+import gzip
+import os
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO)
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "portal", "index.html")
+HEADER = os.path.join(PROJECT_DIR, "src", "portal_html.h")
+
+
+def embed():
+    if os.path.exists(HEADER) and os.path.getmtime(HEADER) >= os.path.getmtime(SOURCE):
+        return
+
+    with open(SOURCE, "rb") as f:
+        html = f.read()
+
+    # mtime=0 keeps the output (and the build) reproducible
+    packed = gzip.compress(html, compresslevel=9, mtime=0)
+
+    lines = []
+    for i in range(0, len(packed), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+
+    with open(HEADER, "w") as f:
+        f.write("// Generated by scripts/embed_portal.py from portal/index.html - do not edit\n")
+        f.write("#ifndef PORTAL_HTML_H\n#define PORTAL_HTML_H\n\n")
+        f.write("#include <Arduino.h>\n\n")
+        f.write("// %d bytes of HTML, gzip -9\n" % len(html))
+        f.write("#define PORTAL_HTML_GZ_LEN %d\n\n" % len(packed))
+        f.write("static const uint8_t PORTAL_HTML_GZ[PORTAL_HTML_GZ_LEN] PROGMEM = {\n")
+        f.write("\n".join(lines))
+        f.write("\n};\n\n#endif // PORTAL_HTML_H\n")
+
+    print("Embedded portal/index.html: %d -> %d bytes" % (len(html), len(packed)))
+
+
+embed()
@@ -0,0 +1,78 @@
+#include "ack_batcher.h"
+#include "debug_log.h"
+
+// Frame keys, indexed by AckKind
+static const char* ACK_KEYS[ACK_KIND_COUNT] = { "acks", "displayed", "dismissed" };
+
+void AckBatcher::add(AckKind kind, const char* id) {
+    if (id == nullptr || id[0] == '\0') return;
+
+    portENTER_CRITICAL(&_mux);
+    bool stored = _count < ACK_BATCH_CAPACITY;
+    if (stored) {
+        if (_count == 0) {
+            _oldestAt = millis();
+        }
+        PendingAck& entry = _pending[_count++];
+        entry.kind = kind;
+        strncpy(entry.id, id, sizeof(entry.id) - 1);
+        entry.id[sizeof(entry.id) - 1] = '\0';
+    } else {
+        _dropped++;
+    }
+    portEXIT_CRITICAL(&_mux);
+
+    if (!stored) {
+        LOG_W(ACK, "Batch full, dropped %s for %s", ACK_KEYS[kind], id);
+    }
+}
+
+bool AckBatcher::isDue() {
+    portENTER_CRITICAL(&_mux);
+    bool due = _count >= ACK_BATCH_MAX ||
+               (_count > 0 && millis() - _oldestAt >= ACK_BATCH_INTERVAL);
+    portEXIT_CRITICAL(&_mux);
+    return due;
+}
+
+uint8_t AckBatcher::pending() {
+    return _count;
+}
+
+uint8_t AckBatcher::copyInto(JsonObject frame, uint8_t max) {
+    // Copy out under the lock, build JSON outside it. add() only appends,
+    // so these are still the oldest entries when consume() runs
+    PendingAck taken[ACK_BATCH_CAPACITY];
+
+    portENTER_CRITICAL(&_mux);
+    uint8_t n = min(_count, max);
+    memcpy(taken, _pending, n * sizeof(PendingAck));
+    portEXIT_CRITICAL(&_mux);
+
+    if (n == 0) return 0;
+
+    JsonArray lists[ACK_KIND_COUNT];
+    for (uint8_t i = 0; i < n; i++) {
+        AckKind kind = taken[i].kind;
+        if (lists[kind].isNull()) {
+            lists[kind] = frame[ACK_KEYS[kind]].to<JsonArray>();
+        }
+        lists[kind].add(taken[i].id);   // char[], so the document copies it
+    }
+    return n;
+}
+
+void AckBatcher::consume(uint8_t count) {
+    portENTER_CRITICAL(&_mux);
+    uint8_t n = min(_count, count);
+    memmove(_pending, _pending + n, (_count - n) * sizeof(PendingAck));
+    _count -= n;
+    if (_count > 0 && n > 0) {
+        _oldestAt = millis();   // Remainder goes out with the next flush
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+unsigned long AckBatcher::getDropped() {
+    return _dropped;
+}
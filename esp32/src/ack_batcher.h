@@ -0,0 +1,62 @@
+#ifndef ACK_BATCHER_H
+#define ACK_BATCHER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include "notification_queue.h"
+
+// ============================================
+// Ack Batcher
+// Coalesces delivery acks and the user's "displayed" / "dismissed"
+// events into one frame per ACK_BATCH_INTERVAL ms or ACK_BATCH_MAX
+// items, so a burst of alerts isn't answered by a burst of ack frames
+// competing with it for airtime. One per transport; any task may add,
+// the transport's own task drains: it copies a batch into a frame and
+// consumes it only once the frame went out, so a failed send keeps it.
+// ============================================
+
+#define ACK_BATCH_MAX        8      // Flush once this many are pending
+#define ACK_BATCH_INTERVAL   250    // ...or this long after the oldest one (ms)
+#define ACK_BATCH_CAPACITY   16     // Held while the link is down; newest dropped beyond
+#define ACK_PIGGYBACK_MAX    4      // Ride along on a heartbeat (keeps it under WS_TX_BUFFER_SIZE)
+
+enum AckKind : uint8_t {
+    ACK_RECEIVED,     // Reached the watch's inbox
+    ACK_DISPLAYED,    // Shown on screen
+    ACK_DISMISSED,    // Dismissed with the USER button
+    ACK_KIND_COUNT
+};
+
+class AckBatcher {
+public:
+    // Any task; empty ids are ignored
+    void add(AckKind kind, const char* id);
+
+    // Transport task
+    bool isDue();
+    uint8_t pending();
+
+    // Copy up to `max` of the oldest entries into
+    // frame["acks"/"displayed"/"dismissed"]; they stay pending
+    uint8_t copyInto(JsonObject frame, uint8_t max = ACK_BATCH_CAPACITY);
+
+    // Remove the `count` oldest entries, once the frame they went into was sent
+    void consume(uint8_t count);
+
+    unsigned long getDropped();
+
+private:
+    struct PendingAck {
+        AckKind kind;
+        char id[sizeof(NotificationData::id)];
+    };
+
+    PendingAck _pending[ACK_BATCH_CAPACITY];
+    uint8_t _count = 0;
+    unsigned long _oldestAt = 0;
+    unsigned long _dropped = 0;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif // ACK_BATCHER_H
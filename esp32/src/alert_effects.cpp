@@ -0,0 +1,199 @@
+#include "alert_effects.h"
+#include "debug_log.h"
+#include "display.h"
+#include "power_manager.h"
+#include "notification_queue.h"
+#include <driver/ledc.h>
+#include <soc/soc_caps.h>
+
+AlertEffects Effects;
+
+// Indexed by AlertPattern
+static const PatternTiming TIMINGS[] = {
+    //  on    off   breath  low%
+    { 0,    0,    0,      100 },   // PATTERN_NONE
+    { 500,  500,  1500,   30  },   // PATTERN_PULSE
+    { 100,  150,  500,    10  },   // PATTERN_STROBE
+};
+
+void AlertEffects::begin() {
+    _ledReady = rmtInit(RGB_LED_PIN, RMT_TX_MODE, RMT_MEM_NUM_BLOCKS_2, LED_RMT_FREQ);
+    if (_ledReady) {
+        stopLed();  // Some LEDs power up lit
+    } else {
+        LOG_W(FX, "RMT unavailable on GPIO %d, no LED effects", RGB_LED_PIN);
+    }
+
+#if SOC_LEDC_GAMMA_CURVE_FADE_SUPPORTED
+    // Already installed is fine (the core's ledcFade may have done it)
+    esp_err_t err = ledc_fade_func_install(0);
+    _fadeReady = err == ESP_OK || err == ESP_ERR_INVALID_STATE;
+#endif
+
+    LOG_I(FX, "Alert effects ready (LED %s, backlight fade %s)",
+          _ledReady ? "on" : "off", _fadeReady ? "on" : "off");
+}
+
+void AlertEffects::start(AlertPattern pattern, uint16_t color) {
+    if (pattern == _pattern && color == _color) return;
+    if (pattern == PATTERN_NONE) {
+        stop();
+        return;
+    }
+
+    const PatternTiming& timing = TIMINGS[pattern];
+    _pattern = pattern;
+    _color = color;
+
+    startLed(timing, color);
+    startBacklight(timing);
+
+    LOG_D(FX, "Pattern %d, colour 0x%04X", pattern, color);
+}
+
+void AlertEffects::stop() {
+    if (_pattern == PATTERN_NONE) return;
+
+    _pattern = PATTERN_NONE;
+    _color = 0;
+    stopLed();
+    stopBacklight();
+}
+
+void AlertEffects::loop() {
+    if (_pattern == PATTERN_NONE || _fadeDuration == 0) return;
+
+    if (millis() - _fadeArmedAt >= _fadeDuration) {
+        startBacklight(TIMINGS[_pattern]);
+    }
+}
+
+unsigned long AlertEffects::msUntilRefresh() {
+    if (_pattern == PATTERN_NONE || _fadeDuration == 0) return ULONG_MAX;
+
+    unsigned long elapsed = millis() - _fadeArmedAt;
+    return elapsed < _fadeDuration ? _fadeDuration - elapsed : 0;
+}
+
+AlertPattern AlertEffects::getPattern() {
+    return _pattern;
+}
+
+AlertPattern AlertEffects::patternForRank(uint8_t rank) {
+    if (rank >= PRIORITY_URGENT) return PATTERN_STROBE;
+    if (rank >= PRIORITY_HIGH) return PATTERN_PULSE;
+    return PATTERN_NONE;
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void AlertEffects::startLed(const PatternTiming& timing, uint16_t color) {
+    if (!_ledReady) return;
+
+    // Ends any running loop; the RMT may still be reading _symbols
+    stopLed();
+
+    // RGB565 -> 8 bits per channel, scaled down: full power is blinding
+    uint8_t r = ((color >> 11) & 0x1F) * 255 / 31 * LED_BRIGHTNESS / 255;
+    uint8_t g = ((color >> 5) & 0x3F) * 255 / 63 * LED_BRIGHTNESS / 255;
+    uint8_t b = (color & 0x1F) * 255 / 31 * LED_BRIGHTNESS / 255;
+
+    rmt_data_t* p = _symbols;
+    rmt_data_t* end = _symbols + LED_MAX_SYMBOLS;
+    p += encodeColor(p, r, g, b);
+    p += encodeHold(p, timing.ledOnMs, end - p);
+    p += encodeColor(p, 0, 0, 0);
+    p += encodeHold(p, timing.ledOffMs, end - p);
+
+    // Replayed by the peripheral until stopLed()
+    rmtWriteLooping(RGB_LED_PIN, _symbols, p - _symbols);
+}
+
+void AlertEffects::stopLed() {
+    if (!_ledReady) return;
+
+    // A one-shot write ends the loop; black, then the latch gap
+    rmt_data_t off[25];
+    size_t count = encodeColor(off, 0, 0, 0);
+    count += encodeHold(off + count, LED_RESET_MS, 1);
+    rmtWrite(RGB_LED_PIN, off, count, 10);
+}
+
+void AlertEffects::startBacklight(const PatternTiming& timing) {
+    _fadeDuration = 0;
+#if SOC_LEDC_GAMMA_CURVE_FADE_SUPPORTED
+    if (!_fadeReady) return;
+
+    uint32_t high = Power.getBrightness();
+    uint32_t low = high * timing.lowPercent / 100;
+    uint32_t steps = constrain(high - low, 1, 1023);
+
+    // Half a breath, in PWM periods, spread over the duty steps
+    uint32_t periods = (uint32_t)BL_PWM_FREQ * (timing.breathMs / 2) / 1000;
+    uint32_t cyclesPerStep = constrain(periods / steps, 1, 1023);
+
+    ledc_fade_param_config_t ranges[BL_FADE_RANGES];
+    for (uint8_t i = 0; i < BL_FADE_RANGES; i++) {
+        ranges[i].dir = i & 1;          // Down from full, back up, ...
+        ranges[i].cycle_num = cyclesPerStep;
+        ranges[i].scale = 1;
+        ranges[i].step_num = steps;
+    }
+
+    ledc_mode_t mode = LEDC_LOW_SPEED_MODE;
+    ledc_channel_t channel = (ledc_channel_t)BL_LEDC_CHANNEL;
+    if (ledc_set_multi_fade(mode, channel, high, ranges, BL_FADE_RANGES) != ESP_OK ||
+        ledc_fade_start(mode, channel, LEDC_FADE_NO_WAIT) != ESP_OK) {
+        LOG_W(FX, "Backlight fade rejected");
+        return;
+    }
+
+    _fadeArmedAt = millis();
+    _fadeDuration = (unsigned long)timing.breathMs * BL_FADE_RANGES / 2;
+#endif
+}
+
+void AlertEffects::stopBacklight() {
+#if SOC_LEDC_GAMMA_CURVE_FADE_SUPPORTED
+    if (_fadeDuration > 0) {
+        ledc_fade_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)BL_LEDC_CHANNEL);
+    }
+#endif
+    _fadeDuration = 0;
+    Display.setBrightness(Power.getBrightness());
+}
+
+size_t AlertEffects::encodeColor(rmt_data_t* out, uint8_t r, uint8_t g, uint8_t b) {
+    // WS2812 order is GRB, most significant bit first
+    uint32_t grb = ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+    for (uint8_t i = 0; i < 24; i++) {
+        bool one = grb & (1UL << (23 - i));
+        out[i].level0 = 1;
+        out[i].duration0 = one ? 2 : 1;   // 0.8 / 0.4 us high
+        out[i].level1 = 0;
+        out[i].duration1 = one ? 1 : 2;   // 0.4 / 0.8 us low
+    }
+    return 24;
+}
+
+size_t AlertEffects::encodeHold(rmt_data_t* out, uint32_t ms, size_t room) {
+    // Line low for `ms`; each symbol holds up to 2 x 32767 ticks (26 ms).
+    // A zero duration would end the transmission, so both halves are >= 1
+    uint32_t ticks = max(ms, (uint32_t)LED_RESET_MS) * (LED_RMT_FREQ / 1000);
+    size_t count = 0;
+    while (ticks > 0 && count < room) {
+        uint32_t first = min(ticks, (uint32_t)32767);
+        ticks -= first;
+        uint32_t second = constrain(ticks, 1, 32767);
+        ticks -= min(ticks, second);
+
+        out[count].level0 = 0;
+        out[count].duration0 = first;
+        out[count].level1 = 0;
+        out[count].duration1 = second;
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,75 @@
+#ifndef ALERT_EFFECTS_H
+#define ALERT_EFFECTS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ============================================
+// Alert Effects
+// Attention patterns for high / urgent alerts, run by peripherals
+// instead of the UI loop: the status LED (WS2812 on RGB_LED_PIN) is an
+// RMT loop of colour frame, hold, black frame, hold, and the backlight
+// breathes through a LEDC hardware multi-fade. Once started neither
+// needs the CPU; the fade only has to be re-armed every few seconds.
+// ============================================
+
+#define LED_RMT_FREQ        2500000   // 0.4 us ticks: WS2812 bits are 2+1 / 1+2 ticks
+#define LED_BRIGHTNESS      64        // Alert colour scaled to this (of 255)
+#define LED_MAX_SYMBOLS     96        // Two RMT blocks; a looping pattern must fit
+#define LED_RESET_MS        1         // Low time that latches a frame (>= 50 us)
+
+#define BL_LEDC_CHANNEL     0         // The panel backlight's channel (display.h)
+#define BL_PWM_FREQ         44100     // Its PWM frequency (display.h)
+#define BL_FADE_RANGES      16        // Hardware fade ranges per arm (8 breaths)
+
+enum AlertPattern : uint8_t {
+    PATTERN_NONE,
+    PATTERN_PULSE,      // High: slow LED blink, slow backlight breathing
+    PATTERN_STROBE      // Urgent: fast LED strobe, fast backlight breathing
+};
+
+struct PatternTiming {
+    uint16_t ledOnMs;
+    uint16_t ledOffMs;
+    uint16_t breathMs;      // One backlight cycle: full -> low -> full
+    uint8_t lowPercent;     // Backlight low point, % of the profile brightness
+};
+
+class AlertEffects {
+public:
+    void begin();
+
+    // UI task. `color` is RGB565 (the alert type's colour); restarting
+    // the running pattern with the same colour is a no-op
+    void start(AlertPattern pattern, uint16_t color);
+    void stop();
+
+    // UI task: re-arms the backlight fade once its ranges have run out
+    void loop();
+    unsigned long msUntilRefresh();
+
+    AlertPattern getPattern();
+
+    // High -> pulse, urgent -> strobe, anything lower -> none
+    static AlertPattern patternForRank(uint8_t rank);
+
+private:
+    bool _ledReady = false;
+    bool _fadeReady = false;
+    AlertPattern _pattern = PATTERN_NONE;
+    uint16_t _color = 0;
+    unsigned long _fadeArmedAt = 0;
+    unsigned long _fadeDuration = 0;
+    rmt_data_t _symbols[LED_MAX_SYMBOLS];
+
+    void startLed(const PatternTiming& timing, uint16_t color);
+    void stopLed();
+    void startBacklight(const PatternTiming& timing);
+    void stopBacklight();
+    size_t encodeColor(rmt_data_t* out, uint8_t r, uint8_t g, uint8_t b);
+    size_t encodeHold(rmt_data_t* out, uint32_t ms, size_t room);
+};
+
+extern AlertEffects Effects;
+
+#endif // ALERT_EFFECTS_H
@@ -0,0 +1,90 @@
+#include "app_events.h"
+#include "debug_log.h"
+
+AppEventBus Events;
+
+static const char* SOURCE_NAMES[] = { "WS", "BLE", "RT" };
+
+const char* getSourceName(NotificationSource source) {
+    return SOURCE_NAMES[source];
+}
+
+void AppEventBus::begin() {
+    _events = xEventGroupCreate();
+    _free = xQueueCreate(EVENT_INBOX_DEPTH, sizeof(uint8_t));
+    _inbox = xQueueCreate(EVENT_INBOX_DEPTH, sizeof(uint8_t));
+
+    if (!_events || !_free || !_inbox) {
+        LOG_E(EVT, "Failed to create event group / inbox");
+        return;
+    }
+
+    for (uint8_t i = 0; i < EVENT_INBOX_DEPTH; i++) {
+        xQueueSend(_free, &i, 0);
+    }
+
+    LOG_I(EVT, "Event bus ready (inbox %d x %u bytes)",
+          EVENT_INBOX_DEPTH, (unsigned)sizeof(InboxItem));
+}
+
+// ============================================
+// Producers
+// ============================================
+
+InboxItem* AppEventBus::reserveNotification(NotificationSource source) {
+    // Never block a transport task: if the UI is that far behind, the
+    // notification queue behind it would be evicting anyway
+    uint8_t index;
+    if (xQueueReceive(_free, &index, 0) != pdTRUE) {
+        _inboxDropped++;
+        LOG_W(EVT, "Inbox full, dropped a %s notification (%lu dropped)",
+              getSourceName(source), _inboxDropped);
+        return nullptr;
+    }
+
+    InboxItem* item = &_slots[index];
+    memset(&item->data, 0, sizeof(item->data));
+    item->seq = 0;
+    item->prevSeq = 0;
+    item->source = source;
+    return item;
+}
+
+void AppEventBus::commitNotification(InboxItem* item) {
+    uint8_t index = item - _slots;
+    item->queuedUs = micros();
+
+    // Every slot has room in the inbox; this never fails
+    xQueueSend(_inbox, &index, 0);
+    xEventGroupSetBits(_events, EVT_NOTIFICATION);
+}
+
+void AppEventBus::signal(EventBits_t bits) {
+    xEventGroupSetBits(_events, bits);
+}
+
+// ============================================
+// Consumer
+// ============================================
+
+EventBits_t AppEventBus::wait(EventBits_t bits, TickType_t timeout) {
+    // Any bit wakes us; all returned bits are cleared
+    return xEventGroupWaitBits(_events, bits, pdTRUE, pdFALSE, timeout) & bits;
+}
+
+InboxItem* AppEventBus::takeNotification() {
+    uint8_t index;
+    if (xQueueReceive(_inbox, &index, 0) != pdTRUE) {
+        return nullptr;
+    }
+    return &_slots[index];
+}
+
+void AppEventBus::releaseNotification(InboxItem* item) {
+    uint8_t index = item - _slots;
+    xQueueSend(_free, &index, 0);
+}
+
+unsigned long AppEventBus::getInboxDropped() {
+    return _inboxDropped;
+}
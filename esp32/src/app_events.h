@@ -0,0 +1,78 @@
+#ifndef APP_EVENTS_H
+#define APP_EVENTS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/queue.h>
+#include "notification_queue.h"
+
+// ============================================
+// Application Event Bus
+// The network, BLE and input tasks never touch the screen or the
+// notification queue directly; they post here and the UI task wakes up.
+// Notifications live in a fixed pool of inbox slots: a transport
+// decodes straight into a reserved slot and only its index moves
+// through the FreeRTOS queues.
+// ============================================
+
+// Event bits consumed by the UI task
+#define EVT_NOTIFICATION    (1 << 0)   // Inbox holds one or more notifications
+#define EVT_LINK_CHANGED    (1 << 1)   // WiFi or BLE link came up / dropped
+#define EVT_BTN_USER        (1 << 2)   // USER short press (dismiss)
+#define EVT_BTN_BOOT        (1 << 3)   // BOOT short press (connection info)
+#define EVT_FACTORY_RESET   (1 << 4)   // BOOT held past LONG_PRESS_TIME
+#define EVT_WIFI_UP         (1 << 5)   // WiFi associated and got an IP
+#define EVT_WIFI_FAILED     (1 << 6)   // WiFi gave up (connect timeout / retries)
+#define EVT_ALL_UI          (EVT_NOTIFICATION | EVT_LINK_CHANGED | EVT_BTN_USER | \
+                             EVT_BTN_BOOT | EVT_FACTORY_RESET | EVT_WIFI_UP | \
+                             EVT_WIFI_FAILED)
+
+#define EVENT_INBOX_DEPTH   8          // Inbox slots (decoding + waiting for the UI task)
+
+enum NotificationSource : uint8_t {
+    SOURCE_WEBSOCKET,
+    SOURCE_BLE,
+    SOURCE_REALTIME      // Supabase Realtime, direct mode
+};
+
+// Log label: "WS", "BLE", "RT"
+const char* getSourceName(NotificationSource source);
+
+struct InboxItem {
+    NotificationData data;
+    uint32_t queuedUs;         // micros() when the transport handed it over
+    uint32_t seq;              // Box sequence number, 0 = not numbered
+    uint32_t prevSeq;          // The box's previous one for us (filtered in between)
+    NotificationSource source;
+};
+
+class AppEventBus {
+public:
+    void begin();
+
+    // Producers (any task): reserve a slot, decode into it, then commit
+    // it to the UI task or release it if decoding failed
+    InboxItem* reserveNotification(NotificationSource source);
+    void commitNotification(InboxItem* item);
+    void signal(EventBits_t bits);
+
+    // Consumer (UI task): release each slot once handled
+    EventBits_t wait(EventBits_t bits, TickType_t timeout);
+    InboxItem* takeNotification();
+
+    void releaseNotification(InboxItem* item);
+    unsigned long getInboxDropped();
+
+private:
+    EventGroupHandle_t _events = nullptr;
+    InboxItem _slots[EVENT_INBOX_DEPTH];
+    QueueHandle_t _free = nullptr;     // Slot indices producers may reserve
+    QueueHandle_t _inbox = nullptr;    // Slot indices waiting for the UI task
+
+    unsigned long _inboxDropped = 0;
+};
+
+extern AppEventBus Events;
+
+#endif // APP_EVENTS_H
@@ -0,0 +1,183 @@
+#include "benchmark.h"
+
+#if BENCHMARK_BUILD
+
+#include "websocket_client.h"
+#include "ble_client.h"
+#include "wire_protocol.h"
+#include "notification_queue.h"
+#include "recent_ids.h"
+#include "display.h"
+#include "app_events.h"
+
+FirmwareBench Bench;
+
+// A typical alert: UUID id, accented message long enough to wrap
+static const char BENCH_JSON[] =
+    "{\"type\":\"notification\",\"id\":\"0d6c9a8e-5a43-4a8e-9f51-3b0b2f6f1c11\","
+    "\"table\":\"12\",\"alert\":\"waiter_called\","
+    "\"message\":\"La mesa 12 solicita atenci\xC3\xB3n del mesero, por favor ac\xC3\xA9rquese\","
+    "\"priority\":\"high\",\"timestamp\":1718000000000}";
+
+// Private state of the benchmark operations
+static NotificationQueue benchQueue;
+static RecentIdCache benchIds;
+static NotificationData benchNotif;
+static TextLayout benchLayout;
+
+void FirmwareBench::run() {
+    Serial.println();
+    Serial.println("[BENCH] ========================================");
+    Serial.printf("[BENCH] Firmware v" FIRMWARE_VERSION ", %lu MHz, %d iterations\n",
+                  (unsigned long)ESP.getCpuFreqMHz(), BENCH_ITERATIONS);
+    Serial.println("[BENCH] name                  cycles/op   us/op  heap B/op");
+
+    buildSamples();
+
+    // Sets up the WS parse filter; the socket itself is never polled
+    WsClient.begin("127.0.0.1", 3334);
+
+    measure("ws.json", wsJson, drainTransports);
+    measure("ws.bpw1", wsBinary, drainTransports);
+    measure("ble.json", bleJson, drainTransports);
+    measure("ble.bpw1", bleBinary, drainTransports);
+    measure("queue.push+pop", queuePushPop);
+    measure("recentIds.check", recentIds);
+    measure("display.layout", layoutFresh);
+    measure("display.cached", layoutCached);
+
+    Serial.printf("[BENCH] Done. Free heap %lu, min %lu, largest block %lu\n",
+                  (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap(),
+                  (unsigned long)ESP.getMaxAllocHeap());
+    Serial.println("[BENCH] ========================================");
+}
+
+void FirmwareBench::measure(const char* name, BenchOp op, BenchOp cleanup) {
+    for (uint8_t i = 0; i < BENCH_WARMUP; i++) {
+        op(*this);
+        if (cleanup) cleanup(*this);
+    }
+
+    uint64_t cycles = 0;
+    uint32_t heapBefore = ESP.getFreeHeap();
+
+    for (uint16_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t start = ESP.getCycleCount();
+        op(*this);
+        cycles += (uint32_t)(ESP.getCycleCount() - start);
+        if (cleanup) cleanup(*this);
+    }
+
+    // Positive = heap kept per operation (a leak, or a cache growing)
+    int32_t heapDelta = (int32_t)(heapBefore - ESP.getFreeHeap());
+    uint32_t perOp = cycles / BENCH_ITERATIONS;
+
+    Serial.printf("[BENCH] %-20s %10lu %7lu %10ld\n", name, (unsigned long)perOp,
+                  (unsigned long)(perOp / ESP.getCpuFreqMHz()),
+                  (long)(heapDelta / BENCH_ITERATIONS));
+}
+
+// ============================================
+// Operations
+// ============================================
+
+void FirmwareBench::wsJson(FirmwareBench& bench) {
+    // Fresh copy each time: the parser may write into its input
+    memcpy(bench._frame, BENCH_JSON, bench._jsonLength);
+    WsClient.decodeForBench(bench._frame, bench._jsonLength);
+}
+
+void FirmwareBench::wsBinary(FirmwareBench& bench) {
+    WsClient.decodeForBench(bench._binary, bench._binaryLength);
+}
+
+void FirmwareBench::bleJson(FirmwareBench& bench) {
+    memcpy(bench._frame, BENCH_JSON, bench._jsonLength);
+    BleClient.decodeForBench(bench._frame, bench._jsonLength);
+}
+
+void FirmwareBench::bleBinary(FirmwareBench& bench) {
+    BleClient.decodeForBench(bench._binary, bench._binaryLength);
+}
+
+void FirmwareBench::queuePushPop(FirmwareBench& bench) {
+    // Distinct tables so every push adds rather than merges
+    snprintf(benchNotif.table, sizeof(benchNotif.table), "%lu",
+             (unsigned long)(bench._counter++ % MAX_NOTIFICATIONS));
+    benchQueue.push(benchNotif);
+    if (benchQueue.count() >= MAX_NOTIFICATIONS) {
+        benchQueue.pop();
+    }
+}
+
+void FirmwareBench::recentIds(FirmwareBench& bench) {
+    // New id each time: the full scan plus an insert, the common case
+    snprintf(benchNotif.id, sizeof(benchNotif.id), "bench-%lu", (unsigned long)bench._counter++);
+    benchIds.checkAndRemember(benchNotif);
+}
+
+void FirmwareBench::layoutFresh(FirmwareBench& bench) {
+    // Measure + wrap + scene build; the panel push only happens once
+    // since the scene doesn't change between runs
+    benchLayout.valid = false;
+    Display.showNotification(benchNotif, benchLayout, 1, 1);
+}
+
+void FirmwareBench::layoutCached(FirmwareBench& bench) {
+    Display.showNotification(benchNotif, benchLayout, 1, 1);
+}
+
+void FirmwareBench::drainTransports(FirmwareBench& bench) {
+    // What the UI task and the ack flush would do, kept out of the timing
+    InboxItem* item;
+    while ((item = Events.takeNotification()) != nullptr) {
+        Events.releaseNotification(item);
+    }
+    WsClient.discardAcksForBench();
+    BleClient.discardAcksForBench();
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void FirmwareBench::buildSamples() {
+    _jsonLength = strlen(BENCH_JSON);
+
+    // Same alert as bpw1: [tag][len][value] after the header
+    uint8_t* p = _binary;
+    *p++ = WIRE_MAGIC;
+    *p++ = WIRE_VERSION;
+    *p++ = WIRE_MSG_NOTIFICATION;
+
+    auto putString = [&p](uint8_t tag, const char* value) {
+        size_t len = strlen(value);
+        *p++ = tag;
+        *p++ = (uint8_t)len;
+        memcpy(p, value, len);
+        p += len;
+    };
+
+    putString(WIRE_TAG_ID, "0d6c9a8e-5a43-4a8e-9f51-3b0b2f6f1c11");
+    putString(WIRE_TAG_TABLE, "12");
+    *p++ = WIRE_TAG_ALERT_CODE;
+    *p++ = 1;
+    *p++ = WIRE_ALERT_WAITER_CALLED;
+    *p++ = WIRE_TAG_PRIORITY;
+    *p++ = 1;
+    *p++ = PRIORITY_HIGH;
+    putString(WIRE_TAG_MESSAGE,
+              "La mesa 12 solicita atenci\xC3\xB3n del mesero, por favor ac\xC3\xA9rquese");
+
+    uint64_t timestamp = 1718000000000ULL;
+    *p++ = WIRE_TAG_TIMESTAMP;
+    *p++ = 8;
+    for (uint8_t i = 0; i < 8; i++) {
+        *p++ = (uint8_t)(timestamp >> (8 * i));
+    }
+    _binaryLength = p - _binary;
+
+    wireDecodeNotification(_binary, _binaryLength, benchNotif);
+}
+
+#endif // BENCHMARK_BUILD
@@ -0,0 +1,55 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#if BENCHMARK_BUILD
+
+// ============================================
+// On-target Benchmarks (env:esp32-c6-bench)
+// Boots into a run of the notification hot paths on the real chip -
+// JSON and bpw1 decode over WS and BLE, the queue, the duplicate
+// cache and the display layout - and prints CPU cycles, time and heap
+// per operation over Serial. Only setup-time state is initialised, so
+// no radio or task competes with the measurement.
+// ============================================
+
+#define BENCH_ITERATIONS    200    // Timed runs per benchmark
+#define BENCH_WARMUP        5      // Untimed runs first (caches, lazy init)
+
+class FirmwareBench {
+public:
+    void run();
+
+private:
+    typedef void (*BenchOp)(FirmwareBench& bench);
+
+    // Time `op` per iteration; `cleanup` runs untimed after each one
+    void measure(const char* name, BenchOp op, BenchOp cleanup = nullptr);
+
+    // Per-benchmark operations (static so they fit BenchOp)
+    static void wsJson(FirmwareBench& bench);
+    static void wsBinary(FirmwareBench& bench);
+    static void bleJson(FirmwareBench& bench);
+    static void bleBinary(FirmwareBench& bench);
+    static void queuePushPop(FirmwareBench& bench);
+    static void recentIds(FirmwareBench& bench);
+    static void layoutFresh(FirmwareBench& bench);
+    static void layoutCached(FirmwareBench& bench);
+    static void drainTransports(FirmwareBench& bench);
+
+    uint8_t _frame[512];
+    size_t _jsonLength = 0;
+    size_t _binaryLength = 0;
+    uint8_t _binary[256];
+    uint32_t _counter = 0;
+
+    void buildSamples();
+};
+
+extern FirmwareBench Bench;
+
+#endif // BENCHMARK_BUILD
+
+#endif // BENCHMARK_H
@@ -1,5 +1,11 @@
 #include "ble_client.h"
+#include "debug_log.h"
 #include "display.h"
+#include "wire_protocol.h"
+#include "latency_monitor.h"
+#include "metrics.h"
+#include "sequence_tracker.h"
+#include "subscription_filter.h"
 #include <ArduinoJson.h>
 
 BitsperBoxBLEClient BleClient;
@@ -23,61 +29,79 @@ class MyAdvertisedDeviceCallbacks;
 
 class MyClientCallback : public BLEClientCallbacks {
     void onConnect(BLEClient* pclient) override {
-        Serial.println("[BLE] onConnect callback");
+        LOG_D(BLE, "onConnect callback");
         BleClient.handleConnect();
     }
 
     void onDisconnect(BLEClient* pclient) override {
-        Serial.println("[BLE] onDisconnect callback");
+        LOG_D(BLE, "onDisconnect callback");
         BleClient.handleDisconnect();
     }
 };
 
+// One instance each for the lifetime of the firmware; the stack keeps
+// raw pointers to them
+static MyClientCallback clientCallbacks;
+
+// Looks for our name in the raw advertising data (advert plus scan
+// response), walking the [length][type][data] structures in place:
+// getName() would build a String for every named advertiser
+static bool advertisesServerName(const uint8_t* payload, size_t length) {
+    static const size_t nameLen = sizeof(BLE_SERVER_NAME) - 1;
+
+    size_t pos = 0;
+    while (pos < length) {
+        uint8_t fieldLen = payload[pos];
+        if (fieldLen == 0 || pos + 1 + fieldLen > length) break;   // Padding or truncated
+
+        uint8_t type = payload[pos + 1];
+        if ((type == ESP_BLE_AD_TYPE_NAME_CMPL || type == ESP_BLE_AD_TYPE_NAME_SHORT) &&
+            fieldLen - 1 == nameLen &&
+            memcmp(payload + pos + 2, BLE_SERVER_NAME, nameLen) == 0) {
+            return true;
+        }
+        pos += 1 + fieldLen;
+    }
+    return false;
+}
+
 class MyAdvertisedDeviceCallbacks : public BLEAdvertisedDeviceCallbacks {
     void onResult(BLEAdvertisedDevice advertisedDevice) override {
-        // Log all found devices for debugging
-        String name = advertisedDevice.haveName() ? advertisedDevice.getName().c_str() : "(sin nombre)";
-        String addr = advertisedDevice.getAddress().toString().c_str();
-        Serial.printf("[BLE] Encontrado: %s - %s\n", name.c_str(), addr.c_str());
-
-        // First priority: Check if this matches the configured MAC address
-        const char* targetAddr = BleClient.getTargetAddress();
-        if (targetAddr != nullptr && strlen(targetAddr) > 0) {
-            // Compare addresses (case insensitive)
-            String targetLower = String(targetAddr);
-            targetLower.toLowerCase();
-            String foundLower = addr;
-            foundLower.toLowerCase();
-
-            if (targetLower == foundLower) {
-                Serial.printf("[BLE] *** BitsperBox encontrado por direccion MAC configurada! ***\n");
-                BleClient.handleDeviceFound(&advertisedDevice);
-                return;
-            }
+        // Runs for every advertiser in range (hundreds per scan in a busy
+        // place): no String work or logging until something matches
+
+        // First priority: the configured / last known box, 6-byte compare
+        if (BleClient.isKnownAddress(*advertisedDevice.getAddress().getNative())) {
+            LOG_I(BLE, "*** BitsperBox encontrado por direccion MAC conocida! ***");
+            BleClient.handleDeviceFound(&advertisedDevice);
+            return;
         }
 
         // Second priority: Check by service UUID
         if (advertisedDevice.haveServiceUUID() &&
             advertisedDevice.isAdvertisingService(serviceUUID)) {
-            Serial.printf("[BLE] *** BitsperBox encontrado por UUID! ***\n");
+            LOG_I(BLE, "*** BitsperBox encontrado por UUID! ***");
             BleClient.handleDeviceFound(&advertisedDevice);
             return;
         }
 
-        // Third priority: Check by name
-        if (advertisedDevice.haveName() &&
-            advertisedDevice.getName() == BLE_SERVER_NAME) {
-            Serial.printf("[BLE] *** BitsperBox encontrado por nombre! ***\n");
+        // Third priority: Check by name, on the raw bytes
+        if (!advertisedDevice.haveName()) return;
+        const uint8_t* payload = advertisedDevice.getPayload();
+        if (advertisesServerName(payload, advertisedDevice.getPayloadLength())) {
+            LOG_I(BLE, "*** BitsperBox encontrado por nombre! ***");
             BleClient.handleDeviceFound(&advertisedDevice);
             return;
         }
     }
 };
 
+static MyAdvertisedDeviceCallbacks advertisedDeviceCallbacks;
+
 // Notification callback (static for BLE library)
 static void notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
                            uint8_t* pData, size_t length, bool isNotify) {
-    Serial.printf("[BLE] Notification received, length: %d\n", length);
+    LOG_D(BLE, "Notification received, length: %d", length);
     BleClient.handleNotifyData(pData, length);
 }
 
@@ -87,13 +111,13 @@ static void notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
 
 // Scan complete callback
 static void scanCompleteCallback(BLEScanResults results) {
-    Serial.printf("[BLE] Escaneo completo. %d dispositivos encontrados.\n", results.getCount());
+    LOG_I(BLE, "Escaneo completo. %d dispositivos encontrados.", results.getCount());
 
     // If we're still in scanning state (didn't find BitsperBox), show status
     if (BleClient.getState() == BLE_STATE_SCANNING) {
         Display.showBLEStatus("NO ENCONTRADO", "Reintentando...");
-        Serial.println("[BLE] BitsperBox no encontrado, reintentara...");
-        BleClient.markScanComplete();  // Reset state to allow next scan
+        LOG_I(BLE, "BitsperBox no encontrado, reintentara...");
+        BleClient.markScanComplete();  // Reset state and back off the next scan
     }
 }
 
@@ -101,57 +125,102 @@ static void scanCompleteCallback(BLEScanResults results) {
 void BitsperBoxBLEClient::markScanComplete() {
     if (_state == BLE_STATE_SCANNING) {
         _state = BLE_STATE_DISCONNECTED;
+
+        // The box stays absent: scan less and less often
+        scheduleNextSearch(_scanBackoff);
+        _scanBackoff = min(_scanBackoff * 2, (unsigned long)BLE_SCAN_MAX_INTERVAL);
     }
 }
 
 void BitsperBoxBLEClient::begin() {
-    Serial.println("[BLE] Initializing BLE client...");
+    LOG_I(BLE, "Initializing BLE client...");
 
     BLEDevice::init("BitsperWatch");
 
     _pBLEScan = BLEDevice::getScan();
-    _pBLEScan->setAdvertisedDeviceCallbacks(new MyAdvertisedDeviceCallbacks());
-    _pBLEScan->setInterval(1349);
-    _pBLEScan->setWindow(449);
-    _pBLEScan->setActiveScan(true);
+    _pBLEScan->setAdvertisedDeviceCallbacks(&advertisedDeviceCallbacks);
+    _pBLEScan->setInterval(BLE_SCAN_PERIOD_MS);
+    _pBLEScan->setWindow(BLE_SCAN_WINDOW_MS);
+
+    // Only the keys we use are kept when parsing; everything else is skipped
+    if (_filter.isNull()) {
+        _filter["type"] = true;
+        _filter["device_id"] = true;
+        _filter["id"] = true;
+        _filter["table"] = true;
+        _filter["alert"] = true;
+        _filter["message"] = true;
+        _filter["priority"] = true;
+        _filter["timestamp"] = true;
+        _filter["client_time"] = true;
+        _filter["server_time"] = true;
+        _filter["seq"] = true;
+        _filter["prev_seq"] = true;
+        _filter["seq_epoch"] = true;
+        _filter["to"] = true;
+
+        // A filter that didn't fit keeps nothing at all: every message
+        // would parse to null
+        _filterOk = !_filter.overflowed() && _filterArena.getFailures() == 0;
+        if (!_filterOk) {
+            LOG_E(BLE, "Parse filter doesn't fit its arena (%u/%u bytes), parsing unfiltered",
+                  (unsigned)_filterArena.getUsed(), (unsigned)_filterArena.getCapacity());
+        }
+    }
+
+    // Single client reused for every reconnect (it keeps the discovered
+    // services, so reconnecting to the same box skips GATT discovery)
+    createClient();
 
     _state = BLE_STATE_IDLE;
 
-    Serial.println("[BLE] BLE client initialized");
-    Serial.println("[BLE] Buscara dispositivo: " BLE_SERVER_NAME);
+    LOG_I(BLE, "BLE client initialized");
+    LOG_I(BLE, "Buscara dispositivo: " BLE_SERVER_NAME);
 }
 
 void BitsperBoxBLEClient::loop() {
+    // Enter / leave standby on this task, where connects happen
+    if (_standby != _standbyApplied) {
+        applyStandby();
+    }
+
+    // Coalesced acks / user actions, written without response
+    if (_connected && _acks.isDue()) {
+        sendAcks();
+    }
+
+    // A hole in the box's numbering: ask for just that run
+    uint32_t from, to;
+    if (_connected && Sequences.takeGap(from, to)) {
+        sendResync(from, to);
+    }
+
     // Handle connection request
     if (_doConnect) {
         _doConnect = false;
         Display.showBLEConnecting("BitsperBox");
         if (connectToServer()) {
-            Serial.println("[BLE] Connected to BitsperBox!");
+            LOG_I(BLE, "Connected to BitsperBox!");
             // Note: Display will be updated by onConnectionChange callback
+            _directConnect = false;
+        } else if (_directConnect) {
+            // Box off or out of range; after a couple of tries fall back to scanning
+            _directConnect = false;
+            _directFailures++;
+            LOG_W(BLE, "Directed connect failed (%d/%d)", _directFailures, BLE_DIRECT_ATTEMPTS);
+            scheduleNextSearch(BLE_RECONNECT_DELAY);
         } else {
-            Serial.println("[BLE] Failed to connect, will retry...");
+            LOG_W(BLE, "Failed to connect, will retry...");
+            // The error stays on screen until the backoff triggers the next scan
             Display.showBLEStatus("ERROR", "Conexion fallida");
-            delay(1000);
             scheduleReconnect();
         }
     }
 
-    // Handle scan request
-    if (_doScan && !_connected) {
+    // Handle search request (directed connect or scan)
+    if (_doScan && !_connected && !_standby) {
         _doScan = false;
-        _state = BLE_STATE_SCANNING;
-        Serial.println("[BLE] Starting BLE scan...");
-        Serial.println("[BLE] Buscando dispositivo llamado: " BLE_SERVER_NAME);
-
-        // Show scanning on display
-        Display.showBLEScanning();
-
-        // Clear previous results
-        _pBLEScan->clearResults();
-
-        // Start scan with completion callback (5 seconds, non-blocking)
-        _pBLEScan->start(5, scanCompleteCallback, false);
+        beginSearch();
     }
 
     // Update display while scanning
@@ -163,21 +232,10 @@ void BitsperBoxBLEClient::loop() {
         }
     }
 
-    // Auto-scan if disconnected
-    if (!_connected && _state != BLE_STATE_SCANNING &&
-        _state != BLE_STATE_CONNECTING) {
-        unsigned long now = millis();
-
-        // Check if we should scan
-        if (now - _lastScanTime > BLE_SCAN_INTERVAL) {
-            _lastScanTime = now;
-            _doScan = true;
-        }
-    }
-
-    // Handle reconnection with backoff
-    if (!_connected && _lastReconnect > 0 && millis() >= _lastReconnect) {
-        _lastReconnect = 0;
+    // Next scheduled search while disconnected
+    if (!_connected && !_doConnect && !_standby && _nextSearch > 0 && millis() >= _nextSearch &&
+        _state != BLE_STATE_SCANNING && _state != BLE_STATE_CONNECTING) {
+        _nextSearch = 0;
         _doScan = true;
     }
 
@@ -189,10 +247,11 @@ void BitsperBoxBLEClient::loop() {
 
             // Verify connection is still valid
             if (!_pClient->isConnected()) {
-                Serial.println("[BLE] Connection lost (detected in heartbeat)");
+                LOG_W(BLE, "Connection lost (detected in heartbeat)");
                 handleDisconnect();
             } else {
-                Serial.println("[BLE] Heartbeat - connection OK");
+                _rssi = _pClient->getRssi();
+                LOG_D(BLE, "Heartbeat - connection OK (RSSI %d dBm)", _rssi);
             }
         }
     }
@@ -221,7 +280,10 @@ void BitsperBoxBLEClient::disconnect() {
 
 void BitsperBoxBLEClient::forceReconnect() {
     disconnect();
+    _gattStale = true;        // Manual reconnect also rediscovers the GATT table
     _reconnectAttempts = 0;
+    _directFailures = 0;
+    _scanBackoff = BLE_SCAN_INTERVAL;
     _doScan = true;
 }
 
@@ -237,10 +299,47 @@ BLEState BitsperBoxBLEClient::getState() {
     return _state;
 }
 
+uint16_t BitsperBoxBLEClient::getMTU() {
+    return _mtu;
+}
+
+int8_t BitsperBoxBLEClient::getRssi() {
+    return _rssi;
+}
+
+unsigned long BitsperBoxBLEClient::getFramesDropped() {
+    return _reassembler.getDroppedCount();
+}
+
+void BitsperBoxBLEClient::setStandby(bool standby) {
+    _standby = standby;
+}
+
+bool BitsperBoxBLEClient::isStandby() {
+    return _standbyApplied;
+}
+
+bool BitsperBoxBLEClient::hasKnownAddress() {
+    return _haveServerMac;
+}
+
 void BitsperBoxBLEClient::setTargetAddress(const char* address) {
     if (address != nullptr) {
         strncpy(_targetAddress, address, sizeof(_targetAddress) - 1);
-        Serial.printf("[BLE] Target address set to: %s\n", _targetAddress);
+        LOG_I(BLE, "Target address set to: %s", _targetAddress);
+
+        // Parsed once; scan results are matched on the raw 6 bytes
+        uint8_t* m = _targetMac;
+        _haveTargetMac = sscanf(_targetAddress, "%2hhx:%2hhx:%2hhx:%2hhx:%2hhx:%2hhx",
+                                &m[0], &m[1], &m[2], &m[3], &m[4], &m[5]) == 6;
+        if (_haveTargetMac) {
+            // Also the first directed-connect target (assume a public address)
+            memcpy(_serverMac, _targetMac, sizeof(_serverMac));
+            _serverAddrType = BLE_ADDR_TYPE_PUBLIC;
+            _haveServerMac = true;
+        } else {
+            LOG_W(BLE, "Target address not parseable, scanning only");
+        }
     }
 }
 
@@ -248,27 +347,45 @@ const char* BitsperBoxBLEClient::getTargetAddress() {
     return _targetAddress;
 }
 
+bool BitsperBoxBLEClient::isKnownAddress(const uint8_t* mac) {
+    // First byte rejects almost every advertiser
+    if (_haveTargetMac && mac[0] == _targetMac[0] && memcmp(mac, _targetMac, 6) == 0) {
+        return true;
+    }
+    return _haveServerMac && mac[0] == _serverMac[0] && memcmp(mac, _serverMac, 6) == 0;
+}
+
 void BitsperBoxBLEClient::registerDevice(const char* deviceId, const char* deviceName) {
     strncpy(_deviceId, deviceId, sizeof(_deviceId) - 1);
     strncpy(_deviceName, deviceName, sizeof(_deviceName) - 1);
 
     // If already connected, send registration
     if (_connected && _pRegisterChar) {
-        StaticJsonDocument<128> doc;
-        doc["type"] = "register";
-        doc["device_id"] = _deviceId;
+        JsonDocument& doc = beginWrite("register");
         doc["name"] = _deviceName;
+        doc["wire"] = WIRE_PROTOCOL_NAME;  // We also accept bpw1 binary notifications
+        doc["mtu"] = _mtu;                 // Lets the box size its frames
+        doc["frag"] = 1;                   // We reassemble fragmented messages
+        doc["client_time"] = (uint32_t)millis();  // Echoed back for clock sync
+
+        // Where the box should resume (nothing the first time since boot)
+        if (Sequences.getEpoch() != 0) {
+            doc["seq_epoch"] = Sequences.getEpoch();
+            doc["last_seq"] = Sequences.getLastContiguous();
+        }
 
-        char buffer[128];
-        serializeJson(doc, buffer);
+        // Only what this watch is for (the box sends everything otherwise)
+        if (!Subscription.isEmpty()) {
+            Subscription.writeJson(doc["filter"].to<JsonObject>());
+        }
 
-        _pRegisterChar->writeValue((uint8_t*)buffer, strlen(buffer));
-        Serial.printf("[BLE] Registration sent: %s\n", buffer);
-    }
-}
+        // Written with response: may span several ATT packets (<= 512)
+        size_t len = serializeWrite();
+        if (len == 0) return;
 
-void BitsperBoxBLEClient::onNotification(std::function<void(BLENotificationData&)> callback) {
-    _onNotification = callback;
+        _pRegisterChar->writeValue((uint8_t*)_txBuffer, len, true);
+        LOG_D(BLE, "Registration sent: %.*s", (int)len, _txBuffer);
+    }
 }
 
 void BitsperBoxBLEClient::onConnectionChange(std::function<void(bool)> callback) {
@@ -282,7 +399,7 @@ void BitsperBoxBLEClient::onConnectionChange(std::function<void(bool)> callback)
 void BitsperBoxBLEClient::handleDeviceFound(BLEAdvertisedDevice* device) {
     // Ignore if already connected, connecting, or connection pending
     if (_connected || _state == BLE_STATE_CONNECTING || _doConnect) {
-        Serial.println("[BLE] Ignoring device found - already connected/connecting");
+        LOG_D(BLE, "Ignoring device found - already connected/connecting");
         return;
     }
 
@@ -290,13 +407,18 @@ void BitsperBoxBLEClient::handleDeviceFound(BLEAdvertisedDevice* device) {
     _pBLEScan->stop();
     _state = BLE_STATE_IDLE;
 
-    // Show found device on display
+    // Show found device on display. This runs in the BLE stack's scan
+    // callback, so don't hold it up - the BLE task picks up the connect
     String deviceName = device->haveName() ? device->getName().c_str() : "BitsperBox";
     Display.showBLEFound(deviceName.c_str());
-    delay(1500);  // Show found message briefly
 
-    // Store device and request connection
-    _pServerDevice = new BLEAdvertisedDevice(*device);
+    // Remember the box (later reconnects go straight to it) and request
+    // the connection
+    memcpy(_serverMac, *device->getAddress().getNative(), sizeof(_serverMac));
+    _serverAddrType = device->getAddressType();
+    _haveServerMac = true;
+    _directFailures = 0;
+    _directConnect = false;
     _doConnect = true;
 }
 
@@ -304,16 +426,15 @@ void BitsperBoxBLEClient::handleConnect() {
     _connected = true;
     _state = BLE_STATE_CONNECTED;
     _reconnectAttempts = 0;
+    _directFailures = 0;
+    _scanBackoff = BLE_SCAN_INTERVAL;
+    _nextSearch = 0;
     _lastHeartbeat = millis();  // Reset heartbeat timer
 
-    Serial.println("[BLE] handleConnect() called - connection established");
+    LOG_D(BLE, "handleConnect() called - connection established");
 
-    // Send registration if we have device info
-    if (strlen(_deviceId) > 0) {
-        // Delay slightly to let connection stabilize
-        delay(500);
-        registerDevice(_deviceId, _deviceName);
-    }
+    // Registration is sent by connectToServer() once the register
+    // characteristic has been discovered (it isn't known yet here)
 
     if (_onConnectionChange) {
         _onConnectionChange(true);
@@ -321,27 +442,51 @@ void BitsperBoxBLEClient::handleConnect() {
 }
 
 void BitsperBoxBLEClient::handleDisconnect() {
-    Serial.println("[BLE] handleDisconnect() called!");
-    Serial.printf("[BLE] Previous state: connected=%d, state=%d\n", _connected, _state);
+    LOG_D(BLE, "handleDisconnect() called!");
+    LOG_D(BLE, "Previous state: connected=%d, state=%d", _connected, _state);
+    if (_connected) Metrics.count(METRIC_BLE_RECONNECTS);
 
     _connected = false;
     _state = BLE_STATE_DISCONNECTED;
-    _pNotifyChar = nullptr;
-    _pRegisterChar = nullptr;
+    _reassemblyStale = true;   // Partial message from this link: reset by the next notify
+    // _pNotifyChar / _pRegisterChar stay cached for the next connect
 
-    Serial.println("[BLE] Disconnected from BitsperBox - will attempt reconnect");
+    LOG_W(BLE, "Disconnected from BitsperBox - will attempt reconnect");
 
     if (_onConnectionChange) {
         _onConnectionChange(false);
     }
 
-    // Schedule reconnection immediately (not with backoff for first attempt)
-    _reconnectAttempts = 0;  // Reset attempts to reconnect quickly
-    scheduleReconnect();
+    // The box was just here: go straight back to it, no scan
+    _reconnectAttempts = 0;
+    _directFailures = 0;
+    _scanBackoff = BLE_SCAN_INTERVAL;
+    scheduleNextSearch(0);
 }
 
 void BitsperBoxBLEClient::handleNotifyData(uint8_t* data, size_t length) {
-    parseNotification(data, length);
+    _rxUs = micros();  // The last fragment completes the message
+
+    // feed() expires a stale partial message itself, on this same task
+    if (_reassemblyStale) {
+        _reassemblyStale = false;
+        _reassembler.reset();
+    }
+
+    switch (_reassembler.feed(data, length)) {
+        case BLE_FRAME_UNFRAMED:
+            parseNotification(data, length);
+            break;
+
+        case BLE_FRAME_COMPLETE:
+            LOG_D(BLE, "Reassembled message (%d bytes)", _reassembler.length());
+            parseNotification(_reassembler.data(), _reassembler.length());
+            break;
+
+        default:
+            // Waiting for more fragments, or the partial message was dropped
+            break;
+    }
 }
 
 // ============================================
@@ -349,90 +494,147 @@ void BitsperBoxBLEClient::handleNotifyData(uint8_t* data, size_t length) {
 // ============================================
 
 bool BitsperBoxBLEClient::connectToServer() {
-    if (!_pServerDevice) {
-        Serial.println("[BLE] No server device to connect to");
+    if (!_haveServerMac) {
+        LOG_I(BLE, "No server device to connect to");
         return false;
     }
 
     _state = BLE_STATE_CONNECTING;
-    Serial.printf("[BLE] Connecting to %s...\n",
-                  _pServerDevice->getAddress().toString().c_str());
+    unsigned long started = millis();
+    BLEAddress address(_serverMac);
+    LOG_I(BLE, "Connecting to %s%s...",
+          address.toString().c_str(), _directConnect ? " (directed, no scan)" : "");
 
-    // Create client
-    _pClient = BLEDevice::createClient();
-    _pClient->setClientCallbacks(new MyClientCallback());
+    // The cached services belong to one box; a different box (or a failed
+    // setup) needs a fresh client. Safe here: we're fully disconnected
+    if (_gattStale || (_gattCached && memcmp(_gattMac, _serverMac, sizeof(_gattMac)) != 0)) {
+        createClient();
+    }
 
     // Connect to server
-    if (!_pClient->connect(_pServerDevice)) {
-        Serial.println("[BLE] Failed to connect");
+    if (!_pClient->connect(address, _serverAddrType, BLE_DIRECT_TIMEOUT)) {
+        LOG_E(BLE, "Failed to connect");
         _state = BLE_STATE_DISCONNECTED;
         return false;
     }
 
-    Serial.println("[BLE] Connected, negotiating MTU...");
+    LOG_I(BLE, "Connected, negotiating MTU...");
 
     // Request larger MTU for longer messages (notifications can be ~200 bytes)
     uint16_t mtu = _pClient->getMTU();
-    Serial.printf("[BLE] Current MTU: %d\n", mtu);
+    LOG_I(BLE, "Current MTU: %d", mtu);
 
     // Try to set a larger MTU (512 is max for BLE 4.2+)
     if (mtu < 256) {
         _pClient->setMTU(256);
         delay(100);  // Give time for MTU negotiation
         mtu = _pClient->getMTU();
-        Serial.printf("[BLE] Negotiated MTU: %d\n", mtu);
+        LOG_I(BLE, "Negotiated MTU: %d", mtu);
     }
+    _mtu = mtu;
 
-    Serial.println("[BLE] Discovering services...");
+    bool cached = _gattCached;
+    if (!cached && !discoverGatt()) {
+        _gattStale = true;
+        _pClient->disconnect();
+        _state = BLE_STATE_DISCONNECTED;
+        return false;
+    }
+
+    // Subscribe to notifications (the CCCD is per connection, handles aren't)
+    if (_pNotifyChar->canNotify()) {
+        _pNotifyChar->registerForNotify(notifyCallback);
+        LOG_I(BLE, "Subscribed to notifications");
+    }
+
+    if (_pRegisterChar == nullptr) {
+        LOG_W(BLE, "Warning: register characteristic not found");
+    } else if (strlen(_deviceId) > 0) {
+        // Register now that the characteristic (and the final MTU) is known
+        registerDevice(_deviceId, _deviceName);
+    }
+
+    LOG_I(BLE, "Link ready in %lu ms (%s)", millis() - started,
+          cached ? "cached GATT handles" : "full discovery");
+
+    // Connection successful - callback will be called by onConnect
+    return true;
+}
+
+void BitsperBoxBLEClient::createClient() {
+    // Deleting the old client frees its service/characteristic tree
+    if (_pClient != nullptr) {
+        delete _pClient;
+    }
+    _pClient = BLEDevice::createClient();
+    _pClient->setClientCallbacks(&clientCallbacks);
+
+    _pNotifyChar = nullptr;
+    _pRegisterChar = nullptr;
+    _gattCached = false;
+    _gattStale = false;
+}
+
+bool BitsperBoxBLEClient::discoverGatt() {
+    LOG_I(BLE, "Discovering services...");
 
     // Get service
     BLERemoteService* pRemoteService = _pClient->getService(serviceUUID);
     if (pRemoteService == nullptr) {
-        Serial.println("[BLE] Failed to find BitsperBox service");
-        _pClient->disconnect();
-        _state = BLE_STATE_DISCONNECTED;
+        LOG_E(BLE, "Failed to find BitsperBox service");
         return false;
     }
 
     // Get notification characteristic
     _pNotifyChar = pRemoteService->getCharacteristic(notifyCharUUID);
     if (_pNotifyChar == nullptr) {
-        Serial.println("[BLE] Failed to find notify characteristic");
-        _pClient->disconnect();
-        _state = BLE_STATE_DISCONNECTED;
+        LOG_E(BLE, "Failed to find notify characteristic");
         return false;
     }
 
-    // Subscribe to notifications
-    if (_pNotifyChar->canNotify()) {
-        _pNotifyChar->registerForNotify(notifyCallback);
-        Serial.println("[BLE] Subscribed to notifications");
-    }
-
-    // Get register characteristic
+    // Optional: older boxes don't have it
     _pRegisterChar = pRemoteService->getCharacteristic(registerCharUUID);
-    if (_pRegisterChar == nullptr) {
-        Serial.println("[BLE] Warning: register characteristic not found");
-    }
 
-    // Connection successful - callback will be called by onConnect
+    // The box builds its GATT table in a fixed order, so these handles
+    // stay valid across its restarts too
+    memcpy(_gattMac, _serverMac, sizeof(_gattMac));
+    _gattCached = true;
     return true;
 }
 
-void BitsperBoxBLEClient::parseNotification(uint8_t* data, size_t length) {
-    // Null terminate the data
-    char json[512];
-    size_t copyLen = (length < sizeof(json) - 1) ? length : sizeof(json) - 1;
-    memcpy(json, data, copyLen);
-    json[copyLen] = '\0';
+#if BENCHMARK_BUILD
+void BitsperBoxBLEClient::decodeForBench(const uint8_t* data, size_t length) {
+    parseNotification(data, length);
+}
+#endif
+
+void BitsperBoxBLEClient::parseNotification(const uint8_t* data, size_t length) {
+    // Compact binary notification (fits a default-MTU packet)
+    if (wireIsBinary(data, length)) {
+        InboxItem* item = decodeBinary(data, length, _rxUs);
+        if (item) {
+            queueAck(ACK_RECEIVED, item->data.id);
+            publishNotification(item);
+        }
+        return;
+    }
 
-    Serial.printf("[BLE] Parsing: %s\n", json);
+    // Parse straight from the (possibly reassembled) buffer - no fixed copy,
+    // so nothing is silently truncated
+    LOG_D(BLE, "Parsing (%d bytes): %.*s",
+          length, (int)min(length, (size_t)128), (const char*)data);
 
-    StaticJsonDocument<512> doc;
-    DeserializationError error = deserializeJson(doc, json);
+    _rxDoc.clear();
+    _rxArena.reset();
+    JsonDocument& doc = _rxDoc;
+    DeserializationError error = _filterOk
+        ? deserializeJson(doc, (const char*)data, length, DeserializationOption::Filter(_filter))
+        : deserializeJson(doc, (const char*)data, length);
 
     if (error) {
-        Serial.printf("[BLE] JSON parse error: %s\n", error.c_str());
+        LOG_E(BLE, "JSON parse error: %s (arena %u/%u bytes)", error.c_str(),
+              (unsigned)_rxArena.getUsed(), (unsigned)_rxArena.getCapacity());
+        Metrics.count(METRIC_JSON_ERRORS);
         return;
     }
 
@@ -440,31 +642,167 @@ void BitsperBoxBLEClient::parseNotification(uint8_t* data, size_t length) {
     const char* type = doc["type"] | "";
 
     if (strcmp(type, "notification") == 0) {
-        BLENotificationData notif;
-        memset(&notif, 0, sizeof(notif));
-
-        strncpy(notif.table, doc["table"] | "", sizeof(notif.table) - 1);
-        strncpy(notif.type, doc["alert"] | "", sizeof(notif.type) - 1);
-        strncpy(notif.message, doc["message"] | "", sizeof(notif.message) - 1);
-        strncpy(notif.priority, doc["priority"] | "medium", sizeof(notif.priority) - 1);
-        notif.timestamp = doc["timestamp"] | millis();
-
-        Serial.printf("[BLE] Notification: Table %s, Type %s, Priority %s\n",
-                      notif.table, notif.type, notif.priority);
-
-        if (_onNotification) {
-            _onNotification(notif);
+        InboxItem* item = decodeJson(doc, _rxUs);
+        if (item) {
+            queueAck(ACK_RECEIVED, item->data.id);
+            publishNotification(item);
         }
     }
     else if (strcmp(type, "pong") == 0) {
         // Heartbeat response
-        Serial.println("[BLE] Heartbeat pong received");
+        LOG_D(BLE, "Heartbeat pong received");
     }
     else if (strcmp(type, "registered") == 0) {
-        Serial.println("[BLE] Device registered with BitsperBox");
+        // Sent to every subscriber: only ours when it names us
+        if (!isForUs(doc["device_id"] | "")) return;
+
+        LOG_I(BLE, "Device registered with BitsperBox");
+
+        // Replays of what we missed follow this message
+        if (doc["seq_epoch"].is<uint32_t>()) {
+            Sequences.onRegistered(doc["seq_epoch"].as<uint32_t>(), doc["seq"] | (uint32_t)0);
+        }
+
+        // Box clock, from the echo of our register send time
+        if (doc["server_time"].is<uint64_t>() && doc["client_time"].is<uint32_t>()) {
+            Latency.onSyncReply(doc["server_time"].as<uint64_t>(),
+                                doc["client_time"].as<uint32_t>());
+        }
+    }
+    else if (strcmp(type, "resynced") == 0) {
+        // The resent notifications came first; the rest of the range is gone
+        if (!isForUs(doc["device_id"] | "")) return;
+        Sequences.onResynced(doc["to"] | (uint32_t)0);
     }
     else {
-        Serial.printf("[BLE] Unknown message type: %s\n", type);
+        LOG_W(BLE, "Unknown message type: %s", type);
+    }
+}
+
+bool BitsperBoxBLEClient::isForUs(const char* deviceId) {
+    // Replies go to every subscriber; one without an id could be anyone's
+    return deviceId[0] != '\0' && strcmp(deviceId, _deviceId) == 0;
+}
+
+void BitsperBoxBLEClient::beginSearch() {
+    // Known box and it answered recently: connect without scanning
+    if (_haveServerMac && _directFailures < BLE_DIRECT_ATTEMPTS) {
+        _directConnect = true;
+        _doConnect = true;
+        return;
+    }
+
+    startFallbackScan();
+}
+
+void BitsperBoxBLEClient::startFallbackScan() {
+    _state = BLE_STATE_SCANNING;
+
+    // Passive scans see the service UUID in the advertisement; the name
+    // only comes in the scan response, so every Nth scan is active
+    bool active = (++_scanCount % BLE_SCAN_ACTIVE_EVERY) == 0;
+    _pBLEScan->setActiveScan(active);
+
+    LOG_I(BLE, "Starting %s BLE scan (%d ms / %d ms)...",
+          active ? "active" : "passive", BLE_SCAN_WINDOW_MS, BLE_SCAN_PERIOD_MS);
+    LOG_I(BLE, "Buscando dispositivo llamado: " BLE_SERVER_NAME);
+
+    // Show scanning on display
+    Display.showBLEScanning();
+
+    // Clear previous results
+    _pBLEScan->clearResults();
+
+    // Start scan with completion callback (non-blocking)
+    _pBLEScan->start(BLE_SCAN_DURATION, scanCompleteCallback, false);
+}
+
+void BitsperBoxBLEClient::applyStandby() {
+    _standbyApplied = _standby;
+
+    if (_standbyApplied) {
+        LOG_I(BLE, "Standby - WiFi is primary, releasing the radio");
+        if (_state == BLE_STATE_SCANNING) {
+            stopScan();
+        }
+        _doScan = false;
+        _nextSearch = 0;
+        disconnect();
+        _rssi = 0;
+        return;
+    }
+
+    // Failover: straight to the known box, no scan and no backoff
+    LOG_I(BLE, "Leaving standby - reconnecting to BitsperBox");
+    _reconnectAttempts = 0;
+    _directFailures = 0;
+    _scanBackoff = BLE_SCAN_INTERVAL;
+    _doScan = true;
+}
+
+void BitsperBoxBLEClient::sendAcks() {
+    if (_pRegisterChar == nullptr) return;
+
+    // One ATT write without response when the MTU allows it (a UUID id
+    // costs ~40 bytes of JSON). Below that the batch goes as a write with
+    // response, which the stack splits into a long write. The batch stays
+    // pending until the write went out
+    size_t limit = _mtu - 3;
+    uint8_t fit = limit > 88 ? min((limit - 48) / 40, (size_t)ACK_BATCH_MAX) : ACK_BATCH_MAX;
+
+    JsonDocument& doc = beginWrite("acks");
+    uint8_t count = _acks.copyInto(doc.as<JsonObject>(), fit);
+
+    size_t len = serializeWrite();
+    if (len == 0) return;   // Left pending
+    bool withResponse = len > limit;
+
+    // writeValue() reports nothing back, so only a live link consumes
+    if (_pClient == nullptr || !_pClient->isConnected()) {
+        LOG_W(BLE, "Link down, %d acks left pending", count);
+        return;
+    }
+    _pRegisterChar->writeValue((uint8_t*)_txBuffer, len, withResponse);
+    _acks.consume(count);
+    LOG_D(BLE, "Sent %d acks in one write%s", count, withResponse ? " (with response)" : "");
+}
+
+void BitsperBoxBLEClient::sendResync(uint32_t from, uint32_t to) {
+    if (_pRegisterChar == nullptr) return;
+
+    JsonDocument& doc = beginWrite("resync");
+    doc["seq_epoch"] = Sequences.getEpoch();
+    doc["from"] = from;
+    doc["to"] = to;
+
+    // With response, like the register: longer than a default-MTU packet
+    size_t len = serializeWrite();
+    if (len == 0) return;
+    _pRegisterChar->writeValue((uint8_t*)_txBuffer, len, true);
+}
+
+JsonDocument& BitsperBoxBLEClient::beginWrite(const char* type) {
+    _txDoc.clear();
+    _txArena.reset();
+    _txDoc["type"] = type;
+    _txDoc["device_id"] = _deviceId;
+    return _txDoc;
+}
+
+size_t BitsperBoxBLEClient::serializeWrite() {
+    if (_txDoc.overflowed() || measureJson(_txDoc) >= sizeof(_txBuffer)) {
+        LOG_E(BLE, "Outgoing write too large, dropped (%s)",
+              (const char*)(_txDoc["type"] | "?"));
+        return 0;
+    }
+    return serializeJson(_txDoc, _txBuffer, sizeof(_txBuffer));
+}
+
+void BitsperBoxBLEClient::scheduleNextSearch(unsigned long delay) {
+    // 0 is "nothing scheduled"
+    _nextSearch = max(millis() + delay, 1UL);
+    if (delay > 0) {
+        LOG_D(BLE, "Next search in %lu ms", delay);
     }
 }
 
@@ -475,8 +813,8 @@ void BitsperBoxBLEClient::scheduleReconnect() {
     unsigned long delay = BLE_RECONNECT_DELAY * (1 << (_reconnectAttempts - 1));
     if (delay > 30000UL) delay = 30000UL;
 
-    _lastReconnect = millis() + delay;
+    scheduleNextSearch(delay);
 
-    Serial.printf("[BLE] Reconnect scheduled in %lu ms (attempt %d)\n",
-                  delay, _reconnectAttempts);
+    LOG_I(BLE, "Reconnect scheduled in %lu ms (attempt %d)",
+          delay, _reconnectAttempts);
 }
@@ -10,12 +10,23 @@
 #include <functional>
 #include "config.h"
 #include "storage.h"
+#include "notification_queue.h"
+#include "ble_framing.h"
+#include "json_arena.h"
+#include "transport.h"
 
 // ============================================
 // BLE Client for BitsperWatch
 // Connects to BitsperBox via Bluetooth Low Energy
 // ============================================
 
+// Fixed JSON memory (no per-message heap allocation). RX belongs to the
+// notify callback, TX to the BLE task
+#define BLE_RX_ARENA_SIZE     2048   // Filtered incoming message
+#define BLE_TX_ARENA_SIZE     2048   // Register with its filter, acks, resync
+#define BLE_TX_BUFFER_SIZE    512    // Serialized write: a long write tops out at 512
+#define BLE_FILTER_ARENA_SIZE 2048   // One slot pool plus the ~15 filter keys
+
 enum BLEState {
     BLE_STATE_IDLE,
     BLE_STATE_SCANNING,
@@ -25,17 +36,10 @@ enum BLEState {
     BLE_STATE_ERROR
 };
 
-// Same notification structure as WebSocket
-struct BLENotificationData {
-    char table[16];
-    char type[32];
-    char message[256];
-    char priority[16];
-    unsigned long timestamp;
-};
-
-class BitsperBoxBLEClient {
+class BitsperBoxBLEClient : public Transport {
 public:
+    BitsperBoxBLEClient() : Transport(SOURCE_BLE) {}
+
     void begin();
     void loop();
     void startScan();
@@ -43,9 +47,18 @@ public:
     void disconnect();
     void forceReconnect();
 
-    bool isConnected();
+    bool isConnected() override;
     bool isScanning();
     BLEState getState();
+    uint16_t getMTU();
+    int8_t getRssi();             // Sampled on the heartbeat, 0 = unknown
+    unsigned long getFramesDropped();   // Fragmented messages lost in reassembly
+
+    // Standby ("both" mode, WiFi primary): link down, no scanning, box
+    // address kept for an immediate directed reconnect. Any task
+    void setStandby(bool standby);
+    bool isStandby();
+    bool hasKnownAddress();
 
     // Register device with BitsperBox
     void registerDevice(const char* deviceId, const char* deviceName);
@@ -53,12 +66,17 @@ public:
     // Set target server address (from config)
     void setTargetAddress(const char* address);
     const char* getTargetAddress();
+    bool isKnownAddress(const uint8_t* mac);   // Scan callback fast path
 
     // Callbacks
-    void onNotification(std::function<void(BLENotificationData&)> callback);
     void onConnectionChange(std::function<void(bool)> callback);
 
-    // Called by BLE callbacks (public for friend access)
+#if BENCHMARK_BUILD
+    // On-target benchmarks: one whole notification, past reassembly
+    void decodeForBench(const uint8_t* data, size_t length);
+#endif
+
+    // Called by BLE callbacks
     void handleDeviceFound(BLEAdvertisedDevice* device);
     void handleConnect();
     void handleDisconnect();
@@ -71,16 +89,52 @@ private:
     BLEClient* _pClient = nullptr;
     BLERemoteCharacteristic* _pNotifyChar = nullptr;
     BLERemoteCharacteristic* _pRegisterChar = nullptr;
-    BLEAdvertisedDevice* _pServerDevice = nullptr;
 
     // Connection state
     bool _connected = false;
     bool _doConnect = false;
-    bool _doScan = false;
-    unsigned long _lastScanTime = 0;
-    unsigned long _lastReconnect = 0;
+    bool _doScan = false;         // Search now (directed connect or scan)
     unsigned long _lastHeartbeat = 0;
     int _reconnectAttempts = 0;
+    volatile bool _standby = false;   // Requested (transport manager)
+    bool _standbyApplied = false;     // BLE task's view
+    volatile int8_t _rssi = 0;
+
+    // Search scheduling: directed connect to the known box first, then
+    // low-duty scans whose spacing doubles while the box stays absent
+    unsigned long _nextSearch = 0;
+    unsigned long _scanBackoff = BLE_SCAN_INTERVAL;
+    uint8_t _directFailures = 0;
+    uint8_t _scanCount = 0;
+    bool _directConnect = false;  // Pending connect skips the scan
+
+    // Box to connect to (configured, learned from a scan, or last link)
+    uint8_t _serverMac[6] = {0};
+    uint8_t _serverAddrType = 0;  // esp_ble_addr_type_t
+    bool _haveServerMac = false;
+
+    // GATT handles of _gattMac, kept in _pClient across reconnects
+    uint8_t _gattMac[6] = {0};
+    bool _gattCached = false;
+    bool _gattStale = false;      // Recreate the client before the next connect
+    uint16_t _mtu = 23;           // Effective ATT MTU, reported on register
+    uint32_t _rxUs = 0;           // micros() when the current message arrived
+
+    // Preallocated decode/encode state
+    StaticJsonArena<BLE_RX_ARENA_SIZE> _rxArena;
+    StaticJsonArena<BLE_TX_ARENA_SIZE> _txArena;
+    StaticJsonArena<BLE_FILTER_ARENA_SIZE> _filterArena;
+    JsonDocument _rxDoc{&_rxArena};
+    JsonDocument _txDoc{&_txArena};
+    char _txBuffer[BLE_TX_BUFFER_SIZE];
+    JsonDocument _filter{&_filterArena};
+    bool _filterOk = false;      // Parse filter built; parse unfiltered otherwise
+
+    // Reassembly of notifications split across several packets. Only the
+    // notify callback (Bluedroid task) touches it; a disconnect seen on
+    // another task asks for the reset through the flag
+    BleReassembler _reassembler;
+    volatile bool _reassemblyStale = false;
 
     // Device info for registration
     char _deviceId[32] = {0};
@@ -88,15 +142,28 @@ private:
 
     // Target server address (from config)
     char _targetAddress[20] = {0};
+    uint8_t _targetMac[6] = {0};
+    bool _haveTargetMac = false;
 
     // Callbacks
-    std::function<void(BLENotificationData&)> _onNotification = nullptr;
     std::function<void(bool)> _onConnectionChange = nullptr;
 
     // Helper methods
     bool connectToServer();
-    void parseNotification(uint8_t* data, size_t length);
+    void createClient();
+    bool discoverGatt();
+    void parseNotification(const uint8_t* data, size_t length);
+    bool isForUs(const char* deviceId);
+    void beginSearch();
+    void startFallbackScan();
+    void scheduleNextSearch(unsigned long delay);
     void scheduleReconnect();
+    void applyStandby();
+    void sendAcks();
+    void sendResync(uint32_t from, uint32_t to);
+
+    JsonDocument& beginWrite(const char* type);
+    size_t serializeWrite();   // Into _txBuffer; 0 when dropped as too large
 };
 
 extern BitsperBoxBLEClient BleClient;
@@ -0,0 +1,90 @@
+#include "ble_framing.h"
+#include "debug_log.h"
+
+BleFrameResult BleReassembler::feed(const uint8_t* data, size_t length) {
+    if (length < BLE_FRAG_HEADER_SIZE || data[0] != BLE_FRAG_MARKER) {
+        return BLE_FRAME_UNFRAMED;
+    }
+
+    checkTimeout();
+
+    uint8_t seq = data[1];
+    uint8_t index = data[2];
+    uint8_t count = data[3];
+    const uint8_t* chunk = data + BLE_FRAG_HEADER_SIZE;
+    size_t chunkLen = length - BLE_FRAG_HEADER_SIZE;
+
+    if (count == 0 || index >= count) {
+        drop("bad fragment header");
+        return BLE_FRAME_DROPPED;
+    }
+
+    // First fragment starts a new message (and abandons any partial one)
+    if (index == 0) {
+        if (_active) drop("superseded by new message");
+        _active = true;
+        _seq = seq;
+        _count = count;
+        _nextIndex = 0;
+        _length = 0;
+        _startedAt = millis();
+    }
+
+    // Notifications on one link arrive in order, so anything else is loss
+    if (!_active || seq != _seq || index != _nextIndex || count != _count) {
+        if (_active) drop("fragment out of sequence");
+        return BLE_FRAME_DROPPED;
+    }
+
+    if (_length + chunkLen > sizeof(_buffer)) {
+        drop("message exceeds reassembly buffer");
+        return BLE_FRAME_DROPPED;
+    }
+
+    memcpy(_buffer + _length, chunk, chunkLen);
+    _length += chunkLen;
+    _nextIndex++;
+
+    if (_nextIndex < _count) {
+        return BLE_FRAME_PENDING;
+    }
+
+    _active = false;
+    _completed++;
+    return BLE_FRAME_COMPLETE;
+}
+
+void BleReassembler::checkTimeout() {
+    if (_active && millis() - _startedAt > BLE_REASSEMBLY_TIMEOUT) {
+        drop("timeout");
+    }
+}
+
+void BleReassembler::reset() {
+    _active = false;
+    _length = 0;
+}
+
+const uint8_t* BleReassembler::data() {
+    return _buffer;
+}
+
+size_t BleReassembler::length() {
+    return _length;
+}
+
+unsigned long BleReassembler::getCompletedCount() {
+    return _completed;
+}
+
+unsigned long BleReassembler::getDroppedCount() {
+    return _dropped;
+}
+
+void BleReassembler::drop(const char* reason) {
+    LOG_W(BLE, "Dropping partial message seq %d (%d/%d fragments): %s",
+          _seq, _nextIndex, _count, reason);
+    _active = false;
+    _length = 0;
+    _dropped++;
+}
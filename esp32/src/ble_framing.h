@@ -0,0 +1,57 @@
+#ifndef BLE_FRAMING_H
+#define BLE_FRAMING_H
+
+#include <Arduino.h>
+
+// ============================================
+// BLE Notification Framing
+// Messages larger than the negotiated MTU arrive as fragments:
+//
+//   [marker 0xF5][message seq][fragment index][fragment count][payload]
+//
+// Unframed payloads (legacy JSON or a single bpw1 packet) pass through.
+// ============================================
+
+#define BLE_FRAG_MARKER          0xF5
+#define BLE_FRAG_HEADER_SIZE     4
+#define BLE_REASSEMBLY_SIZE      1024   // Largest reassembled message
+#define BLE_REASSEMBLY_TIMEOUT   2000   // Drop a partial message after 2s
+
+enum BleFrameResult {
+    BLE_FRAME_UNFRAMED,   // Not a fragment - use the raw payload
+    BLE_FRAME_PENDING,    // Fragment stored, waiting for the rest
+    BLE_FRAME_COMPLETE,   // Message reassembled - see data()/length()
+    BLE_FRAME_DROPPED     // Out of order, oversized or stale - discarded
+};
+
+class BleReassembler {
+public:
+    BleFrameResult feed(const uint8_t* data, size_t length);
+
+    // Drop a partial message that has waited too long. feed() already
+    // calls it: only from the task that feeds
+    void checkTimeout();
+    void reset();
+
+    const uint8_t* data();
+    size_t length();
+
+    unsigned long getCompletedCount();
+    unsigned long getDroppedCount();
+
+private:
+    uint8_t _buffer[BLE_REASSEMBLY_SIZE];
+    size_t _length = 0;
+    bool _active = false;
+    uint8_t _seq = 0;
+    uint8_t _count = 0;
+    uint8_t _nextIndex = 0;
+    unsigned long _startedAt = 0;
+
+    unsigned long _completed = 0;
+    unsigned long _dropped = 0;
+
+    void drop(const char* reason);
+};
+
+#endif // BLE_FRAMING_H
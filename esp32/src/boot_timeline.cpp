@@ -0,0 +1,29 @@
+#include "boot_timeline.h"
+#include "debug_log.h"
+
+BootTimeline Boot;
+
+static const char* const BOOT_STAGE_NAMES[BOOT_STAGE_COUNT] = {
+    "display", "config", "tasks", "wifi", "ws", "ble", "first_notif"
+};
+
+void BootTimeline::mark(BootStage stage) {
+    if (_stages[stage] != 0) return;
+
+    // millis() can still be 0 this early; 0 means "not reached"
+    _stages[stage] = max(millis(), 1UL);
+    LOG_I(BOOT, "%s at %lu ms", BOOT_STAGE_NAMES[stage], (unsigned long)_stages[stage]);
+}
+
+uint32_t BootTimeline::get(BootStage stage) {
+    return _stages[stage];
+}
+
+void BootTimeline::writeJson(JsonObject out) {
+    for (uint8_t i = 0; i < BOOT_STAGE_COUNT; i++) {
+        if (_stages[i] != 0) {
+            out[BOOT_STAGE_NAMES[i]] = _stages[i];
+        }
+    }
+    out["reset_reason"] = (int)esp_reset_reason();
+}
@@ -0,0 +1,38 @@
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// ============================================
+// Boot Timeline
+// millis() at each boot milestone, so time-to-first-notification after
+// a brownout can be tracked from the box. Each stage records once.
+// ============================================
+
+enum BootStage : uint8_t {
+    BOOT_DISPLAY,        // Splash on screen
+    BOOT_CONFIG,         // Config loaded from NVS
+    BOOT_TASKS,          // Runtime tasks started (setup done)
+    BOOT_WIFI,           // WiFi got an IP
+    BOOT_WS,             // Registered with the box over WebSocket (direct: Realtime joined)
+    BOOT_BLE,            // Connected to the box over BLE
+    BOOT_FIRST_NOTIF,    // First notification on screen
+    BOOT_STAGE_COUNT
+};
+
+class BootTimeline {
+public:
+    // Any task; later calls for the same stage are ignored
+    void mark(BootStage stage);
+    uint32_t get(BootStage stage);   // 0 = not reached
+
+    void writeJson(JsonObject out);
+
+private:
+    volatile uint32_t _stages[BOOT_STAGE_COUNT] = {};
+};
+
+extern BootTimeline Boot;
+
+#endif // BOOT_TIMELINE_H
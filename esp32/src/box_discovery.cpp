@@ -0,0 +1,97 @@
+#include "box_discovery.h"
+#include "debug_log.h"
+#include "storage.h"
+
+BoxDiscovery Discovery;
+
+bool BoxDiscovery::start() {
+    if (_search) return false;
+    if (!init()) return false;
+
+    _search = mdns_query_async_new(nullptr, DISCOVERY_SERVICE, DISCOVERY_PROTO, MDNS_TYPE_PTR,
+                                   DISCOVERY_TIMEOUT, DISCOVERY_MAX_RESULTS, nullptr);
+    if (!_search) {
+        LOG_W(MDNS, "Query could not be started");
+        return false;
+    }
+
+    LOG_I(MDNS, "Looking for " DISCOVERY_SERVICE "." DISCOVERY_PROTO " on the LAN...");
+    return true;
+}
+
+bool BoxDiscovery::poll(char* host, size_t hostSize, uint16_t& port) {
+    if (!_search) return false;
+
+    // Zero timeout: only reports whether the query window has closed
+    mdns_result_t* results = nullptr;
+    uint8_t count = 0;
+    if (!mdns_query_async_get_results(_search, 0, &results, &count)) {
+        return false;
+    }
+
+    bool found = false;
+    for (mdns_result_t* r = results; r != nullptr && !found; r = r->next) {
+        for (mdns_ip_addr_t* a = r->addr; a != nullptr; a = a->next) {
+            if (a->addr.type != ESP_IPADDR_TYPE_V4) continue;
+
+            // lwIP keeps the address in network byte order
+            uint32_t ip = a->addr.u_addr.ip4.addr;
+            snprintf(host, hostSize, "%u.%u.%u.%u", (unsigned)(ip & 0xFF), (unsigned)((ip >> 8) & 0xFF),
+                     (unsigned)((ip >> 16) & 0xFF), (unsigned)(ip >> 24));
+            port = r->port;
+            found = true;
+
+            LOG_I(MDNS, "Found %s (%s) at %s:%u", r->instance_name ? r->instance_name : "?",
+                  r->hostname ? r->hostname : "?", host, port);
+            break;
+        }
+    }
+
+    if (!found) {
+        LOG_W(MDNS, "No BitsperBox answered (%d results)", count);
+    }
+
+    mdns_query_results_free(results);
+    mdns_query_async_delete(_search);
+    _search = nullptr;
+    return found;
+}
+
+bool BoxDiscovery::isRunning() {
+    return _search != nullptr;
+}
+
+void BoxDiscovery::cancel() {
+    if (!_search) return;
+
+    // Results are freed with the search when the query hasn't finished
+    mdns_result_t* results = nullptr;
+    uint8_t count = 0;
+    if (mdns_query_async_get_results(_search, 0, &results, &count)) {
+        mdns_query_results_free(results);
+    }
+    mdns_query_async_delete(_search);
+    _search = nullptr;
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+bool BoxDiscovery::init() {
+    if (_mdnsReady) return true;
+
+    esp_err_t err = mdns_init();
+    if (err != ESP_OK) {
+        LOG_E(MDNS, "Init failed: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    // The watch answers as bitsperwatch-<id>.local too
+    char hostname[32];
+    snprintf(hostname, sizeof(hostname), "bitsperwatch-%s", Storage.getDeviceId().c_str());
+    mdns_hostname_set(hostname);
+
+    _mdnsReady = true;
+    return true;
+}
@@ -0,0 +1,42 @@
+#ifndef BOX_DISCOVERY_H
+#define BOX_DISCOVERY_H
+
+#include <Arduino.h>
+#include <mdns.h>
+
+// ============================================
+// BitsperBox Discovery (mDNS / DNS-SD)
+// Looks up the box's _bitsperbox._tcp service on the LAN without
+// blocking the network task: start() sends the query and poll() picks
+// up the answer once the query window has closed. Used when the
+// cached / configured endpoint stops answering (the Pi got a new DHCP
+// lease) or when no IP was configured at all.
+// ============================================
+
+#define DISCOVERY_SERVICE      "_bitsperbox"
+#define DISCOVERY_PROTO        "_tcp"
+#define DISCOVERY_TIMEOUT      3000    // ms a query collects answers
+#define DISCOVERY_MAX_RESULTS  4
+
+class BoxDiscovery {
+public:
+    // Network task, WiFi up. False if mDNS is unavailable or a query
+    // is already running
+    bool start();
+
+    // True once per query, with the first box that has an IPv4 address
+    bool poll(char* host, size_t hostSize, uint16_t& port);
+
+    bool isRunning();
+    void cancel();
+
+private:
+    bool _mdnsReady = false;
+    mdns_search_once_t* _search = nullptr;
+
+    bool init();
+};
+
+extern BoxDiscovery Discovery;
+
+#endif // BOX_DISCOVERY_H
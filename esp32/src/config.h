@@ -47,19 +47,67 @@
 #define BLE_NOTIFY_CHAR_UUID    "beb5483e-36e1-4688-b7f5-ea07361b26a8"
 #define BLE_REGISTER_CHAR_UUID  "beb5483e-36e1-4688-b7f5-ea07361b26a9"
 #define BLE_SERVER_NAME         "BitsperBox"
-#define BLE_SCAN_INTERVAL       5000   // Scan every 5 seconds when disconnected
+#define BLE_SCAN_INTERVAL       5000   // Wait after the first scan that finds nothing
+#define BLE_SCAN_MAX_INTERVAL   60000  // Backoff cap while the box stays absent
+#define BLE_SCAN_DURATION       5      // Seconds per scan
+#define BLE_SCAN_PERIOD_MS      1000   // Low duty: listen BLE_SCAN_WINDOW_MS
+#define BLE_SCAN_WINDOW_MS      60     //   out of every BLE_SCAN_PERIOD_MS
+#define BLE_SCAN_ACTIVE_EVERY   4      // Every Nth scan is active (name is in the scan response)
+#define BLE_DIRECT_ATTEMPTS     2      // Directed connects to the known box before scanning
+#define BLE_DIRECT_TIMEOUT      4000   // ms per directed connect
 #define BLE_RECONNECT_DELAY     3000   // Wait 3 seconds before reconnecting
 
 // ----- Connection Mode -----
 // "wifi" = WiFi WebSocket only
 // "ble" = BLE only
-// "both" = WiFi primary, BLE fallback
+// "both" = WiFi primary, BLE fallback (standby while WiFi is healthy,
+//          see transport_manager.h)
+// Direct mode (Supabase Realtime, no box) always runs over WiFi
 #define DEFAULT_CONNECTION_MODE "both"
 
 // ----- Notification Settings -----
 #define NOTIFICATION_TIMEOUT  60000  // Auto-dismiss after 60s
 #define MAX_NOTIFICATIONS     10     // Max queue size
-#define ALERT_BLINK_INTERVAL  500    // Blink every 500ms for urgent
+
+// ----- Runtime Tasks (FreeRTOS) -----
+// Priorities: input > UI > network/BLE, so a press or a new alert
+// preempts socket polling and BLE connection setup
+#define TASK_INPUT_PRIORITY   4
+#define TASK_UI_PRIORITY      3
+#define TASK_NET_PRIORITY     2
+#define TASK_BLE_PRIORITY     2
+#define TASK_INPUT_STACK      2048
+#define TASK_UI_STACK         6144
+#define TASK_NET_STACK        6144
+#define TASK_NET_STACK_TLS    10240  // Direct mode: mbedTLS handshake runs on this stack
+#define TASK_BLE_STACK        6144
+#define TASK_LOG_PRIORITY     1      // Just above idle: logs drain when nothing else runs
+#define TASK_LOG_STACK        3072
+#define BLE_POLL_INTERVAL     20     // ms between BLE state machine steps
+#define INFO_SCREEN_TIME      3000   // BOOT short press info screen
+#define CONNECTED_SCREEN_TIME 2000   // WiFi "connected" screen at boot
+#define LATENCY_SCREEN_TIME   10000  // Latency debug screen (second BOOT press)
+
+// ----- Boot -----
+// 1 = no splash / serial-attach delays; set 0 to catch the early boot
+// log on the USB CDC monitor
+#ifndef FAST_BOOT
+#define FAST_BOOT             1
+#endif
+
+// 1 = boot into the on-target benchmarks (benchmark.h) instead of the
+// normal firmware; set by env:esp32-c6-bench
+#ifndef BENCHMARK_BUILD
+#define BENCHMARK_BUILD       0
+#endif
+
+// ----- Logging -----
+// Compile-time level for every module (debug_log.h); a single module
+// can be raised with -DLOG_LEVEL_<MODULE>=LOG_DEBUG. Lines above the
+// level compile to nothing, arguments included
+#ifndef LOG_LEVEL
+#define LOG_LEVEL             LOG_WARN
+#endif
 
 // ----- Device Info -----
 #define DEVICE_TYPE         "BitsperWatch"
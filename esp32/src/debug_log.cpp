@@ -0,0 +1,133 @@
+#include "debug_log.h"
+#include <stdarg.h>
+
+DeferredLog Log;
+
+DeferredLog::DeferredLog() {
+    // Before any task can log (global constructors run first)
+    for (uint32_t i = 0; i < LOG_RING_SLOTS; i++) {
+        _slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+void DeferredLog::begin() {
+    if (_task) return;
+    xTaskCreate(taskEntry, "log", TASK_LOG_STACK, this, TASK_LOG_PRIORITY, &_task);
+}
+
+void DeferredLog::write(uint8_t level, const char* format, ...) {
+    // Claim a slot: bounded MPMC ring, one compare-and-swap per line
+    uint32_t pos = _head.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &_slots[pos & (LOG_RING_SLOTS - 1)];
+        int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // The flusher is a whole ring behind: drop rather than wait
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = _head.load(std::memory_order_relaxed);
+        }
+    }
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(slot->text, sizeof(slot->text), format, args);
+    va_end(args);
+
+    slot->level = level;
+    slot->length = (uint8_t)constrain(length, 0, (int)sizeof(slot->text) - 1);
+    slot->seq.store(pos + 1, std::memory_order_release);
+}
+
+void DeferredLog::flush() {
+    drain(true);
+    Serial.flush();
+}
+
+void DeferredLog::setTailLevel(uint8_t level) {
+    portENTER_CRITICAL(&_tailMux);
+    _tailLevel = level;
+    _tailLength = 0;
+    portEXIT_CRITICAL(&_tailMux);
+}
+
+uint8_t DeferredLog::getTailLevel() {
+    return _tailLevel;
+}
+
+size_t DeferredLog::takeTail(char* out, size_t size) {
+    portENTER_CRITICAL(&_tailMux);
+    size_t length = min(_tailLength, size - 1);
+    memcpy(out, _tailText, length);
+    _tailLength = 0;
+    portEXIT_CRITICAL(&_tailMux);
+
+    out[length] = '\0';
+    return length;
+}
+
+unsigned long DeferredLog::getDropped() {
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void DeferredLog::taskEntry(void* param) {
+    DeferredLog* log = static_cast<DeferredLog*>(param);
+    for (;;) {
+        log->drain(false);
+        vTaskDelay(pdMS_TO_TICKS(LOG_FLUSH_INTERVAL));
+    }
+}
+
+void DeferredLog::drain(bool wait) {
+    // One consumer at a time (the task, or flush() before a restart)
+    if (_draining.exchange(true, std::memory_order_acquire)) return;
+
+    // No host on the USB CDC port: the lines only go to the tail
+    bool toSerial = (bool)Serial;
+
+    for (;;) {
+        Slot& slot = _slots[_tail & (LOG_RING_SLOTS - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != _tail + 1) break;
+
+        if (toSerial) {
+            // Host attached but slow: leave the line for the next pass
+            if (!wait && Serial.availableForWrite() < slot.length + 1) break;
+            Serial.write((const uint8_t*)slot.text, slot.length);
+            Serial.write('\n');
+        }
+
+        if (slot.level <= _tailLevel) {
+            appendTail(slot.text, slot.length);
+        }
+
+        slot.seq.store(_tail + LOG_RING_SLOTS, std::memory_order_release);
+        _tail++;
+    }
+
+    uint32_t dropped = _dropped.load(std::memory_order_relaxed);
+    if (toSerial && dropped != _droppedReported) {
+        Serial.printf("[DLOG] %lu lines dropped (ring full)\n", (unsigned long)(dropped - _droppedReported));
+        _droppedReported = dropped;
+    }
+
+    _draining.store(false, std::memory_order_release);
+}
+
+void DeferredLog::appendTail(const char* text, size_t length) {
+    portENTER_CRITICAL(&_tailMux);
+    // Overflow between two "log" frames drops the newest lines
+    if (_tailLength + length + 1 <= sizeof(_tailText)) {
+        memcpy(_tailText + _tailLength, text, length);
+        _tailLength += length;
+        _tailText[_tailLength++] = '\n';
+    }
+    portEXIT_CRITICAL(&_tailMux);
+}
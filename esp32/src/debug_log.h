@@ -0,0 +1,175 @@
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+
+// ============================================
+// Deferred Logging
+// LOG_E / LOG_W / LOG_I / LOG_D(MODULE, fmt, ...) format the line
+// into a slot of a lock-free ring and return: a full ring drops the
+// line instead of waiting. A task just above idle writes the slots to
+// Serial, so a USB host that isn't reading can never stall a
+// transport. Each module has its own compile-time level; calls above
+// it compile to nothing, arguments included. While the box asks for
+// it, lines are also tailed to it over the WebSocket.
+// ============================================
+
+#define LOG_NONE    0
+#define LOG_ERROR   1
+#define LOG_WARN    2
+#define LOG_INFO    3
+#define LOG_DEBUG   4
+
+#define LOG_RING_SLOTS      32     // Power of two
+#define LOG_LINE_MAX        124    // Longer lines are truncated
+#define LOG_FLUSH_INTERVAL  20     // ms between drains of the ring
+#define LOG_TAIL_BUFFER     768    // Tailed text waiting for the next "log" frame
+#define LOG_TAIL_INTERVAL   500    // ms between "log" frames while tailing
+
+// ----- Per-module levels (default LOG_LEVEL, config.h) -----
+#ifndef LOG_LEVEL_ACK
+#define LOG_LEVEL_ACK       LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_BLE
+#define LOG_LEVEL_BLE       LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_BOOT
+#define LOG_LEVEL_BOOT      LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_BTN
+#define LOG_LEVEL_BTN       LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_DISPLAY
+#define LOG_LEVEL_DISPLAY   LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_EVT
+#define LOG_LEVEL_EVT       LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_FX
+#define LOG_LEVEL_FX        LOG_LEVEL      // Alert LED / backlight effects
+#endif
+#ifndef LOG_LEVEL_INFO
+#define LOG_LEVEL_INFO      LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_INIT
+#define LOG_LEVEL_INIT      LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_LAT
+#define LOG_LEVEL_LAT       LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_LOG
+#define LOG_LEVEL_LOG       LOG_LEVEL      // Persistent notification log
+#endif
+#ifndef LOG_LEVEL_MDNS
+#define LOG_LEVEL_MDNS      LOG_LEVEL      // BitsperBox discovery
+#endif
+#ifndef LOG_LEVEL_METRICS
+#define LOG_LEVEL_METRICS   LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_NOTIF
+#define LOG_LEVEL_NOTIF     LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_OTA
+#define LOG_LEVEL_OTA       LOG_LEVEL      // Firmware updates
+#endif
+#ifndef LOG_LEVEL_PORTAL
+#define LOG_LEVEL_PORTAL    LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_POWER
+#define LOG_LEVEL_POWER     LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_QUEUE
+#define LOG_LEVEL_QUEUE     LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_RT
+#define LOG_LEVEL_RT        LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SEQ
+#define LOG_LEVEL_SEQ       LOG_LEVEL      // Notification sequence / resync
+#endif
+#ifndef LOG_LEVEL_STATE
+#define LOG_LEVEL_STATE     LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_STORAGE
+#define LOG_LEVEL_STORAGE   LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SYSTEM
+#define LOG_LEVEL_SYSTEM    LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_WIFI
+#define LOG_LEVEL_WIFI      LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_WIRE
+#define LOG_LEVEL_WIRE      LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_WS
+#define LOG_LEVEL_WS        LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_XPORT
+#define LOG_LEVEL_XPORT     LOG_LEVEL
+#endif
+
+// The module name is the line's tag: LOG_I(WS, "Connected") -> "[WS] Connected".
+// A constant-false condition is removed by the compiler with its arguments
+#define LOG_E(mod, fmt, ...) \
+    do { if (LOG_LEVEL_##mod >= LOG_ERROR) Log.write(LOG_ERROR, "[" #mod "] " fmt, ##__VA_ARGS__); } while (0)
+#define LOG_W(mod, fmt, ...) \
+    do { if (LOG_LEVEL_##mod >= LOG_WARN) Log.write(LOG_WARN, "[" #mod "] " fmt, ##__VA_ARGS__); } while (0)
+#define LOG_I(mod, fmt, ...) \
+    do { if (LOG_LEVEL_##mod >= LOG_INFO) Log.write(LOG_INFO, "[" #mod "] " fmt, ##__VA_ARGS__); } while (0)
+#define LOG_D(mod, fmt, ...) \
+    do { if (LOG_LEVEL_##mod >= LOG_DEBUG) Log.write(LOG_DEBUG, "[" #mod "] " fmt, ##__VA_ARGS__); } while (0)
+
+class DeferredLog {
+public:
+    DeferredLog();
+
+    void begin();                 // Starts the flush task
+
+    // Any task (not ISRs); never blocks. Use the LOG_x macros
+    void write(uint8_t level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+    // Write out everything pending, waiting on Serial (before a restart)
+    void flush();
+
+    // Remote tail: lines at `level` or more severe are also kept for the
+    // WebSocket; LOG_NONE stops it. Only compiled-in lines can be tailed
+    void setTailLevel(uint8_t level);
+    uint8_t getTailLevel();
+    size_t takeTail(char* out, size_t size);   // Net task; 0 when nothing new
+
+    unsigned long getDropped();
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;    // == position + 1 once written
+        uint8_t level;
+        uint8_t length;
+        char text[LOG_LINE_MAX];
+    };
+
+    Slot _slots[LOG_RING_SLOTS];
+    std::atomic<uint32_t> _head{0};   // Next position to claim (producers)
+    uint32_t _tail = 0;               // Next position to write out (flusher)
+    std::atomic<bool> _draining{false};
+    std::atomic<uint32_t> _dropped{0};
+    uint32_t _droppedReported = 0;
+    TaskHandle_t _task = nullptr;
+
+    volatile uint8_t _tailLevel = LOG_NONE;
+    char _tailText[LOG_TAIL_BUFFER];
+    size_t _tailLength = 0;
+    portMUX_TYPE _tailMux = portMUX_INITIALIZER_UNLOCKED;
+
+    static void taskEntry(void* param);
+    void drain(bool wait);
+    void appendTail(const char* text, size_t length);
+};
+
+extern DeferredLog Log;
+
+#endif // DEBUG_LOG_H
@@ -1,69 +1,142 @@
 #include "display.h"
+#include "debug_log.h"
 
 DisplayManager Display;
 
+// Overlay tags (widgets drawn on top of the current screen)
+#define TAG_QUEUE_BADGE   1
+#define TAG_WEAK_SIGNAL   2
+
+// Notification screen message area
+#define MSG_TOP           155
+#define MSG_BOTTOM        (LCD_HEIGHT - 45)   // Clear of the urgent banner
+#define MSG_MARGIN        10
+#define MSG_LINE_GAP      4
+#define MSG_LARGE_LINES   3                   // Size 2 only if it fits in this many
+
+// Screens are drawn from the UI task, BLE status from the BLE task and
+// the weak-signal banner from the network task; one builder at a time
+class DisplayLock {
+public:
+    explicit DisplayLock(SemaphoreHandle_t lock) : _lock(lock) {
+        if (_lock) xSemaphoreTakeRecursive(_lock, portMAX_DELAY);
+    }
+    ~DisplayLock() {
+        if (_lock) xSemaphoreGiveRecursive(_lock);
+    }
+
+private:
+    SemaphoreHandle_t _lock;
+};
+
 void DisplayManager::begin() {
+    _lock = xSemaphoreCreateRecursiveMutex();
+    DisplayLock lock(_lock);
+
     _display.init();
+    _display.initDMA();
     _display.setRotation(LCD_ROTATION);
     _display.fillScreen(COLOR_BG);
     _display.setTextColor(COLOR_TEXT);
     _display.setTextSize(1);
+    // Strings are encoded to CP437 (text_layout.h); draw bytes as glyphs
+    _display.setAttribute(lgfx::cp437_switch, true);
+    _display.setAttribute(lgfx::utf8_switch, false);
     _initialized = true;
     setBrightness(128);
+
+    // Double-buffered full-width bands: one is rendered while the other
+    // is still being pushed by DMA
+    _bandsReady = true;
+    for (int i = 0; i < 2; i++) {
+        _band[i].setColorDepth(16);
+        if (!_band[i].createSprite(LCD_WIDTH, DISPLAY_BAND_HEIGHT)) {
+            _bandsReady = false;
+        }
+        _band[i].setAttribute(lgfx::cp437_switch, true);
+        _band[i].setAttribute(lgfx::utf8_switch, false);
+    }
+    if (!_bandsReady) {
+        LOG_I(DISPLAY, "Band sprites unavailable, drawing direct");
+        _band[0].deleteSprite();
+        _band[1].deleteSprite();
+    }
+
+    memset(&_shown, 0, sizeof(_shown));
+    _shown.bg = COLOR_BG;
+    _fullRedraw = false;
+    beginScene(COLOR_BG);
 }
 
 void DisplayManager::clear() {
-    _display.fillScreen(COLOR_BG);
+    DisplayLock lock(_lock);
+    beginScene(COLOR_BG);
+    commitScene();
 }
 
 void DisplayManager::setBrightness(uint8_t brightness) {
+    DisplayLock lock(_lock);
     _display.setBrightness(brightness);
 }
 
+void DisplayManager::sleep() {
+    DisplayLock lock(_lock);
+    _display.setBrightness(0);
+    _display.sleep();
+}
+
+void DisplayManager::wakeup() {
+    DisplayLock lock(_lock);
+    _display.wakeup();
+}
+
+void DisplayManager::invalidate() {
+    DisplayLock lock(_lock);
+    _fullRedraw = true;
+}
+
 void DisplayManager::showSplash() {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
 
     // Logo area
-    _display.fillRect(0, 0, LCD_WIDTH, 80, COLOR_PRIMARY);
+    addWidget(WIDGET_FILL_RECT, 0, 0, LCD_WIDTH, 80, COLOR_PRIMARY);
 
     // Title
-    _display.setTextColor(COLOR_BG);
-    _display.setTextSize(2);
     drawCenteredText("BITSPER", 20, 2, COLOR_BG);
     drawCenteredText("WATCH", 45, 2, COLOR_BG);
 
     // Version
-    _display.setTextColor(COLOR_TEXT);
-    _display.setTextSize(1);
     drawCenteredText(FIRMWARE_VERSION, 100, 1, COLOR_TEXT);
 
     // Loading
     drawCenteredText("Iniciando...", 150, 1, COLOR_PRIMARY);
 
     // Footer
-    _display.setTextColor(0x7BEF);  // Gray
-    drawCenteredText("BitsperFoods", LCD_HEIGHT - 20, 1, 0x7BEF);
+    drawCenteredText("BitsperFoods", LCD_HEIGHT - 20, 1, 0x7BEF);  // Gray
+
+    commitScene();
 }
 
 void DisplayManager::showConnecting(const char* ssid) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("CONECTANDO", COLOR_WARNING);
 
-    _display.setTextSize(1);
     drawCenteredText("Conectando a WiFi...", 100, 1, COLOR_TEXT);
-
-    _display.setTextSize(1);
     drawCenteredText(ssid, 130, 1, COLOR_PRIMARY);
 
     // Animated dots would go here
     drawCenteredText("...", 160, 2, COLOR_WARNING);
+
+    commitScene();
 }
 
 void DisplayManager::showConnected(const char* ssid, const char* ip) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("CONECTADO", COLOR_SUCCESS);
 
-    _display.setTextSize(1);
     drawCenteredText("WiFi:", 100, 1, 0x7BEF);
     drawCenteredText(ssid, 120, 1, COLOR_TEXT);
 
@@ -71,16 +144,16 @@ void DisplayManager::showConnected(const char* ssid, const char* ip) {
     drawCenteredText(ip, 170, 1, COLOR_TEXT);
 
     drawCenteredText("OK!", 210, 2, COLOR_SUCCESS);
+
+    commitScene();
 }
 
 void DisplayManager::showAPMode(const char* ssid, const char* password) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("CONFIGURAR", COLOR_INFO);
 
-    _display.setTextSize(1);
     drawCenteredText("Conecta a WiFi:", 90, 1, COLOR_TEXT);
-
-    _display.setTextSize(1);
     drawCenteredText(ssid, 115, 1, COLOR_PRIMARY);
 
     drawCenteredText("Password:", 145, 1, COLOR_TEXT);
@@ -88,20 +161,24 @@ void DisplayManager::showAPMode(const char* ssid, const char* password) {
 
     drawCenteredText("Luego abre:", 200, 1, 0x7BEF);
     drawCenteredText("192.168.4.1", 220, 1, COLOR_WARNING);
+
+    commitScene();
 }
 
 void DisplayManager::showError(const char* message) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("ERROR", COLOR_DANGER);
 
-    _display.setTextSize(1);
     drawCenteredText(message, 120, 1, COLOR_TEXT);
-
     drawCenteredText("Reiniciando...", 180, 1, COLOR_WARNING);
+
+    commitScene();
 }
 
 void DisplayManager::showIdle(bool connected, const char* mode) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
 
     // Header with connection status
     uint16_t headerColor = connected ? COLOR_SUCCESS : COLOR_DANGER;
@@ -111,17 +188,13 @@ void DisplayManager::showIdle(bool connected, const char* mode) {
     const char* statusText = connected ? "Conectado" : "Desconectado";
     uint16_t statusColor = connected ? COLOR_SUCCESS : COLOR_DANGER;
 
-    _display.fillCircle(20, 100, 8, statusColor);
-    _display.setTextSize(1);
-    _display.setCursor(35, 95);
-    _display.setTextColor(COLOR_TEXT);
-    _display.print(statusText);
+    addWidget(WIDGET_FILL_CIRCLE, 20, 100, 8, 0, statusColor);
+    drawText(statusText, 35, 95, 1, COLOR_TEXT);
 
     // Mode
-    _display.setCursor(35, 115);
-    _display.setTextColor(0x7BEF);
-    _display.print("via ");
-    _display.print(mode);
+    char modeText[SCENE_TEXT_LEN];
+    snprintf(modeText, sizeof(modeText), "via %s", mode);
+    drawText(modeText, 35, 115, 1, 0x7BEF);
 
     // Waiting message
     drawCenteredText("Esperando", 170, 1, 0x7BEF);
@@ -129,109 +202,107 @@ void DisplayManager::showIdle(bool connected, const char* mode) {
 
     // Footer with time or info
     drawFooter("BTN: Menu", "v" FIRMWARE_VERSION);
+
+    commitScene();
 }
 
-void DisplayManager::showNotification(const char* table, const char* type,
-                                      const char* message, const char* priority) {
-    clear();
+void DisplayManager::showNotification(const NotificationData& notif, TextLayout& layout,
+                                      int queuePos, int queueTotal) {
+    DisplayLock lock(_lock);
+
+    // Measured and wrapped once per notification; re-showing it (queue
+    // advance, info screen timeout) replays the cached lines
+    if (!layout.valid) {
+        layoutNotification(notif, layout);
+    }
+
+    beginScene();
 
     // Get colors based on type/priority
-    uint16_t bgColor = getColorForType(type);
-    bool isUrgent = (strcmp(priority, "urgent") == 0 || strcmp(priority, "high") == 0);
+    uint16_t bgColor = getColorForType(notif.type);
+    bool isUrgent = (strcmp(notif.priority, "urgent") == 0 || strcmp(notif.priority, "high") == 0);
 
     // Header with alert type
-    const char* icon = getIconForType(type);
+    const char* icon = getIconForType(notif.type);
     char header[32];
     snprintf(header, sizeof(header), "%s ALERTA", icon);
     drawHeader(header, bgColor);
 
-    // Table number - BIG
-    _display.setTextSize(4);
-    char tableText[16];
-    snprintf(tableText, sizeof(tableText), "MESA %s", table);
-    drawCenteredText(tableText, 90, 3, COLOR_TEXT);
+    // Table number - BIG (shrunk by the layout if it wouldn't fit)
+    char tableText[SCENE_TEXT_LEN];
+    snprintf(tableText, sizeof(tableText), "MESA %s", notif.table);
+    drawCenteredText(tableText, 90, layout.tableSize, COLOR_TEXT);
 
     // Separator line
-    _display.drawFastHLine(10, 140, LCD_WIDTH - 20, 0x7BEF);
-
-    // Message
-    _display.setTextSize(1);
-    _display.setTextColor(COLOR_TEXT);
-    _display.setCursor(10, 155);
-
-    // Word wrap the message
-    String msg = String(message);
-    int maxWidth = LCD_WIDTH - 20;
-    int charWidth = 6;  // Approximate char width at size 1
-    int maxChars = maxWidth / charWidth;
-
-    if (msg.length() <= maxChars) {
-        drawCenteredText(message, 160, 1, COLOR_TEXT);
-    } else {
-        // Simple word wrap - first line
-        int splitPos = msg.lastIndexOf(' ', maxChars);
-        if (splitPos == -1) splitPos = maxChars;
-
-        String line1 = msg.substring(0, splitPos);
-        String line2 = msg.substring(splitPos + 1);
-
-        drawCenteredText(line1.c_str(), 155, 1, COLOR_TEXT);
-        drawCenteredText(line2.c_str(), 175, 1, COLOR_TEXT);
+    addWidget(WIDGET_HLINE, 10, 140, LCD_WIDTH - 20, 1, 0x7BEF);
+
+    // Message lines from the cache: no measuring, no heap
+    _display.setTextSize(layout.textSize);
+    int pitch = _display.fontHeight() + MSG_LINE_GAP;
+    int y = MSG_TOP;
+    for (uint8_t i = 0; i < layout.lineCount; i++) {
+        char line[SCENE_TEXT_LEN];
+        size_t len = fontEncode(notif.message + layout.start[i], layout.length[i],
+                                line, sizeof(line));
+        if (layout.truncated && i == layout.lineCount - 1) {
+            strncpy(line + len, "...", sizeof(line) - len - 1);
+        }
+        addText(line, (LCD_WIDTH - layout.width[i]) / 2, y, layout.width[i],
+                layout.textSize, COLOR_TEXT);
+        y += pitch;
     }
 
     // Footer
     if (isUrgent) {
-        _display.fillRect(0, LCD_HEIGHT - 40, LCD_WIDTH, 40, COLOR_DANGER);
+        addWidget(WIDGET_FILL_RECT, 0, LCD_HEIGHT - 40, LCD_WIDTH, 40, COLOR_DANGER);
         drawCenteredText("!! URGENTE !!", LCD_HEIGHT - 25, 1, COLOR_TEXT);
     }
 
     drawFooter("[USER] OK", "");
+
+    // Queue counter in the header, part of the same commit
+    if (queueTotal > 1) {
+        drawQueueBadge(queuePos, queueTotal);
+    }
+
+    commitScene();
 }
 
 void DisplayManager::showNotificationQueue(int current, int total) {
-    // Small indicator at top right
-    char queueText[16];
-    snprintf(queueText, sizeof(queueText), "%d/%d", current, total);
-
-    _display.fillRect(LCD_WIDTH - 40, 5, 35, 15, 0x7BEF);
-    _display.setTextColor(COLOR_BG);
-    _display.setTextSize(1);
-    _display.setCursor(LCD_WIDTH - 35, 8);
-    _display.print(queueText);
+    DisplayLock lock(_lock);
+    drawQueueBadge(current, total);
+    commitScene();
 }
 
 void DisplayManager::clearNotification() {
     showIdle(true, "BitsperBox");
 }
 
-void DisplayManager::blinkAlert(bool state) {
-    if (state) {
-        _display.invertDisplay(true);
-    } else {
-        _display.invertDisplay(false);
-    }
-}
-
 void DisplayManager::update() {
     // For any animations or updates
 }
 
 void DisplayManager::showWeakSignal(int rssi) {
+    DisplayLock lock(_lock);
     // Show a small warning banner at the top without clearing the whole screen
-    _display.fillRect(0, 0, LCD_WIDTH, 25, COLOR_WARNING);
-    _display.setTextColor(COLOR_BG);
-    _display.setTextSize(1);
-
     char msg[32];
     snprintf(msg, sizeof(msg), "Senal debil: %d dBm", rssi);
+
+    removeTagged(TAG_WEAK_SIGNAL);
+
+    uint8_t first = _scene.count;
+    addWidget(WIDGET_FILL_RECT, 0, 0, LCD_WIDTH, 25, COLOR_WARNING);
     drawCenteredText(msg, 8, 1, COLOR_BG);
+    tagWidgets(first, TAG_WEAK_SIGNAL);
+
+    commitScene();
 }
 
 void DisplayManager::showReconnecting(int attempt, int maxAttempts) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("RECONECTANDO", COLOR_WARNING);
 
-    _display.setTextSize(1);
     drawCenteredText("Conexion perdida", 80, 1, COLOR_TEXT);
 
     char attemptText[32];
@@ -245,10 +316,350 @@ void DisplayManager::showReconnecting(int attempt, int maxAttempts) {
     int barY = 160;
     int progress = (attempt * barWidth) / maxAttempts;
 
-    _display.drawRect(barX, barY, barWidth, barHeight, COLOR_PRIMARY);
-    _display.fillRect(barX + 2, barY + 2, progress - 4, barHeight - 4, COLOR_PRIMARY);
+    Widget* bar = addWidget(WIDGET_PROGRESS, barX, barY, barWidth, barHeight, COLOR_PRIMARY);
+    if (bar) bar->value = progress - 4;
 
     drawCenteredText("Espere...", 200, 1, 0x7BEF);
+
+    commitScene();
+}
+
+void DisplayManager::showStats(const char* title, const char* const* lines, int count) {
+    DisplayLock lock(_lock);
+    beginScene();
+    drawHeader(title, COLOR_INFO);
+
+    // Header takes the top 50 rows; size-1 text at 16 px pitch
+    int y = 60;
+    for (int i = 0; i < count && y < LCD_HEIGHT - 30; i++) {
+        drawText(lines[i], 4, y, 1, COLOR_TEXT);
+        y += 16;
+    }
+
+    drawFooter("BOOT: salir", "");
+
+    commitScene();
+}
+
+// ============================================
+// Scene Building
+// ============================================
+
+void DisplayManager::beginScene(uint16_t bg) {
+    _scene.bg = bg;
+    _scene.count = 0;
+}
+
+Widget* DisplayManager::addWidget(WidgetKind kind, int x, int y, int w, int h, uint16_t color) {
+    if (_scene.count >= SCENE_MAX_WIDGETS) {
+        LOG_W(DISPLAY, "Scene full, widget dropped");
+        return nullptr;
+    }
+
+    // Zero the whole slot so commitScene() can compare widgets with memcmp
+    Widget* widget = &_scene.widgets[_scene.count++];
+    memset(widget, 0, sizeof(Widget));
+    widget->kind = kind;
+    widget->x = x;
+    widget->y = y;
+    widget->w = w;
+    widget->h = h;
+    widget->color = color;
+    return widget;
+}
+
+void DisplayManager::tagWidgets(uint8_t first, uint8_t tag) {
+    for (uint8_t i = first; i < _scene.count; i++) {
+        _scene.widgets[i].tag = tag;
+    }
+}
+
+void DisplayManager::removeTagged(uint8_t tag) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < _scene.count; i++) {
+        if (_scene.widgets[i].tag != tag) {
+            if (kept != i) _scene.widgets[kept] = _scene.widgets[i];
+            kept++;
+        }
+    }
+    _scene.count = kept;
+}
+
+void DisplayManager::commitScene() {
+    if (!_initialized) return;
+
+    _dirtyCount = 0;
+
+    if (_fullRedraw || _scene.bg != _shown.bg) {
+        markDirty(0, LCD_HEIGHT);
+    } else {
+        // Compare slot by slot: a changed widget dirties both where it was
+        // and where it is now
+        uint8_t slots = max(_scene.count, _shown.count);
+        for (uint8_t i = 0; i < slots; i++) {
+            int y0, y1;
+            bool inNew = i < _scene.count;
+            bool inOld = i < _shown.count;
+
+            if (inNew && inOld &&
+                memcmp(&_scene.widgets[i], &_shown.widgets[i], sizeof(Widget)) == 0) {
+                continue;
+            }
+            if (inOld) {
+                widgetSpan(_shown.widgets[i], y0, y1);
+                markDirty(y0, y1);
+            }
+            if (inNew) {
+                widgetSpan(_scene.widgets[i], y0, y1);
+                markDirty(y0, y1);
+            }
+        }
+    }
+
+    flushDirty();
+
+    memcpy(&_shown, &_scene, sizeof(Scene));
+    _fullRedraw = false;
+}
+
+// ============================================
+// Scene Rendering
+// ============================================
+
+void DisplayManager::widgetSpan(const Widget& w, int& y0, int& y1) {
+    switch (w.kind) {
+        case WIDGET_FILL_CIRCLE:
+        case WIDGET_CIRCLE:
+            y0 = w.y - w.w;
+            y1 = w.y + w.w + 1;
+            break;
+        default:
+            y0 = w.y;
+            y1 = w.y + w.h;
+            break;
+    }
+}
+
+void DisplayManager::markDirty(int y0, int y1) {
+    if (y0 < 0) y0 = 0;
+    if (y1 > LCD_HEIGHT) y1 = LCD_HEIGHT;
+    if (y1 <= y0) return;
+
+    // Fold in every span it touches, then store the union
+    for (uint8_t i = 0; i < _dirtyCount; ) {
+        if (y0 <= _dirtyY1[i] && y1 >= _dirtyY0[i]) {
+            y0 = min(y0, (int)_dirtyY0[i]);
+            y1 = max(y1, (int)_dirtyY1[i]);
+            _dirtyCount--;
+            _dirtyY0[i] = _dirtyY0[_dirtyCount];
+            _dirtyY1[i] = _dirtyY1[_dirtyCount];
+        } else {
+            i++;
+        }
+    }
+
+    if (_dirtyCount < SCENE_MAX_DIRTY) {
+        _dirtyY0[_dirtyCount] = y0;
+        _dirtyY1[_dirtyCount] = y1;
+        _dirtyCount++;
+    } else {
+        // Out of slots - widen the last span rather than lose the update
+        _dirtyY0[_dirtyCount - 1] = min((int)_dirtyY0[_dirtyCount - 1], y0);
+        _dirtyY1[_dirtyCount - 1] = max((int)_dirtyY1[_dirtyCount - 1], y1);
+    }
+}
+
+void DisplayManager::flushDirty() {
+    if (_dirtyCount == 0) return;
+
+    _display.startWrite();
+
+    uint8_t buf = 0;
+    for (uint8_t i = 0; i < _dirtyCount; i++) {
+        for (int y = _dirtyY0[i]; y < _dirtyY1[i]; y += DISPLAY_BAND_HEIGHT) {
+            int h = min(DISPLAY_BAND_HEIGHT, _dirtyY1[i] - y);
+
+            if (_bandsReady) {
+                // Render off-screen, then let DMA push it while the next
+                // band is rendered into the other buffer
+                LGFX_Sprite& band = _band[buf];
+                renderBand(band, 0, h, y);
+                _display.pushImageDMA(0, y, LCD_WIDTH, h,
+                                      (lgfx::swap565_t*)band.getBuffer());
+                buf ^= 1;
+            } else {
+                _display.setClipRect(0, y, LCD_WIDTH, h);
+                renderBand(_display, y, h, 0);
+                _display.clearClipRect();
+            }
+        }
+    }
+
+    _display.endWrite();
+}
+
+void DisplayManager::renderBand(lgfx::LovyanGFX& gfx, int bandY, int bandH, int originY) {
+    // originY maps panel rows to target rows (band sprites start at row 0)
+    gfx.fillRect(0, bandY, LCD_WIDTH, bandH, _scene.bg);
+
+    int top = bandY + originY;
+    int bottom = top + bandH;
+
+    for (uint8_t i = 0; i < _scene.count; i++) {
+        int y0, y1;
+        widgetSpan(_scene.widgets[i], y0, y1);
+        if (y1 <= top || y0 >= bottom) continue;
+        renderWidget(gfx, _scene.widgets[i], originY);
+    }
+}
+
+void DisplayManager::renderWidget(lgfx::LovyanGFX& gfx, const Widget& w, int originY) {
+    int y = w.y - originY;
+
+    switch (w.kind) {
+        case WIDGET_FILL_RECT:
+            gfx.fillRect(w.x, y, w.w, w.h, w.color);
+            break;
+
+        case WIDGET_RECT:
+            gfx.drawRect(w.x, y, w.w, w.h, w.color);
+            break;
+
+        case WIDGET_HLINE:
+            gfx.drawFastHLine(w.x, y, w.w, w.color);
+            break;
+
+        case WIDGET_FILL_CIRCLE:
+            gfx.fillCircle(w.x, y, w.w, w.color);
+            break;
+
+        case WIDGET_CIRCLE:
+            gfx.drawCircle(w.x, y, w.w, w.color);
+            break;
+
+        case WIDGET_PROGRESS:
+            gfx.drawRect(w.x, y, w.w, w.h, w.color);
+            if (w.value > 0) {
+                gfx.fillRect(w.x + 2, y + 2, w.value, w.h - 4, w.color);
+            }
+            break;
+
+        case WIDGET_TEXT:
+            gfx.setTextSize(w.textSize);
+            gfx.setTextColor(w.color);
+            gfx.setCursor(w.x, y);
+            gfx.print(w.text);
+            break;
+
+        default:
+            break;
+    }
+}
+
+// ============================================
+// Text Layout
+// ============================================
+
+void DisplayManager::layoutNotification(const NotificationData& notif, TextLayout& layout) {
+    memset(&layout, 0, sizeof(layout));
+    const int maxWidth = LCD_WIDTH - 2 * MSG_MARGIN;
+
+    // Table heading: the biggest size that fits ("MESA Terraza 12")
+    char tableText[SCENE_TEXT_LEN];
+    snprintf(tableText, sizeof(tableText), "MESA %s", notif.table);
+    layout.tableSize = 3;
+    _display.setTextSize(layout.tableSize);
+    while (layout.tableSize > 1 && measureText(tableText, strlen(tableText)) > maxWidth) {
+        layout.tableSize--;
+        _display.setTextSize(layout.tableSize);
+    }
+
+    // Message: large when it takes only a few lines, else small with as
+    // many lines as the area holds
+    if (!wrapText(notif.message, 2, MSG_LARGE_LINES, layout)) {
+        _display.setTextSize(1);
+        int pitch = _display.fontHeight() + MSG_LINE_GAP;
+        uint8_t maxLines = min(LAYOUT_MAX_LINES, (MSG_BOTTOM - MSG_TOP) / pitch);
+        wrapText(notif.message, 1, maxLines, layout);
+    }
+    layout.valid = true;
+
+    LOG_D(DISPLAY, "Layout: %d lines at size %d%s, table size %d",
+          layout.lineCount, layout.textSize, layout.truncated ? " (truncated)" : "",
+          layout.tableSize);
+}
+
+bool DisplayManager::wrapText(const char* text, uint8_t size, uint8_t maxLines, TextLayout& layout) {
+    const int maxWidth = LCD_WIDTH - 2 * MSG_MARGIN;
+    _display.setTextSize(size);
+    layout.textSize = size;
+    layout.lineCount = 0;
+    layout.truncated = false;
+
+    size_t pos = 0;
+    while (text[pos] == ' ') pos++;
+
+    while (text[pos] != '\0' && layout.lineCount < maxLines) {
+        // Whole words while they fit; '\n' always ends the line
+        size_t end = pos;
+        size_t scan = pos;
+        while (text[scan] != '\0' && text[scan] != '\n') {
+            size_t wordEnd = scan;
+            while (text[wordEnd] != '\0' && text[wordEnd] != ' ' && text[wordEnd] != '\n') {
+                wordEnd = utf8Next(text, wordEnd);
+            }
+            if (measureText(text + pos, wordEnd - pos) > maxWidth) break;
+            end = wordEnd;
+            scan = wordEnd;
+            while (text[scan] == ' ') scan++;
+        }
+
+        // A word wider than the line is split between characters
+        if (end == pos) {
+            while (text[end] != '\0' && text[end] != '\n') {
+                size_t next = utf8Next(text, end);
+                if (end != pos && measureText(text + pos, next - pos) > maxWidth) break;
+                end = next;
+            }
+        }
+
+        uint8_t line = layout.lineCount++;
+        layout.start[line] = pos;
+        layout.length[line] = end - pos;
+        layout.width[line] = measureText(text + pos, end - pos);
+
+        // Spaces at the break and one newline belong to no line
+        pos = end;
+        while (text[pos] == ' ') pos++;
+        if (text[pos] == '\n') pos++;
+        while (text[pos] == ' ') pos++;
+    }
+
+    if (text[pos] == '\0') return true;
+
+    // Out of lines: cut the last one back until "..." fits after it
+    uint8_t last = layout.lineCount - 1;
+    const char* start = text + layout.start[last];
+    int ellipsis = _display.textWidth("...");
+    size_t len = layout.length[last];
+    while (len > 0 && measureText(start, len) + ellipsis > maxWidth) {
+        do {
+            len--;
+        } while (len > 0 && ((uint8_t)start[len] & 0xC0) == 0x80);
+    }
+    layout.length[last] = len;
+    layout.width[last] = measureText(start, len) + ellipsis;
+    layout.truncated = true;
+    return false;
+}
+
+int DisplayManager::measureText(const char* text, size_t length) {
+    // A line has to fit in one widget, with room left for "..."
+    char encoded[SCENE_TEXT_LEN];
+    if (length >= sizeof(encoded) - 3) return INT16_MAX;
+
+    fontEncode(text, length, encoded, sizeof(encoded));
+    return _display.textWidth(encoded);
 }
 
 // ============================================
@@ -270,35 +681,62 @@ const char* DisplayManager::getIconForType(const char* type) {
     return "?";
 }
 
+void DisplayManager::drawText(const char* text, int x, int y, int size, uint16_t color) {
+    // Measure with the panel's font metrics so the widget's span is exact
+    char encoded[SCENE_TEXT_LEN];
+    fontEncode(text, strlen(text), encoded, sizeof(encoded));
+    _display.setTextSize(size);
+    addText(encoded, x, y, _display.textWidth(encoded), size, color);
+}
+
 void DisplayManager::drawCenteredText(const char* text, int y, int size, uint16_t color) {
+    char encoded[SCENE_TEXT_LEN];
+    fontEncode(text, strlen(text), encoded, sizeof(encoded));
     _display.setTextSize(size);
-    _display.setTextColor(color);
 
-    int w = _display.textWidth(text);
+    int w = _display.textWidth(encoded);
     int x = (LCD_WIDTH - w) / 2;
-    _display.setCursor(x, y);
-    _display.print(text);
+    addText(encoded, x, y, w, size, color);
+}
+
+void DisplayManager::addText(const char* encoded, int x, int y, int width, int size, uint16_t color) {
+    _display.setTextSize(size);
+    Widget* widget = addWidget(WIDGET_TEXT, x, y, width, _display.fontHeight(), color);
+    if (!widget) return;
+
+    widget->textSize = size;
+    strncpy(widget->text, encoded, sizeof(widget->text) - 1);
+}
+
+void DisplayManager::drawQueueBadge(int current, int total) {
+    // Small indicator at top right
+    char queueText[16];
+    snprintf(queueText, sizeof(queueText), "%d/%d", current, total);
+
+    removeTagged(TAG_QUEUE_BADGE);
+
+    uint8_t first = _scene.count;
+    addWidget(WIDGET_FILL_RECT, LCD_WIDTH - 40, 5, 35, 15, 0x7BEF);
+    drawText(queueText, LCD_WIDTH - 35, 8, 1, COLOR_BG);
+    tagWidgets(first, TAG_QUEUE_BADGE);
 }
 
 void DisplayManager::drawHeader(const char* title, uint16_t bgColor) {
-    _display.fillRect(0, 0, LCD_WIDTH, 50, bgColor);
+    addWidget(WIDGET_FILL_RECT, 0, 0, LCD_WIDTH, 50, bgColor);
     drawCenteredText(title, 18, 1, COLOR_BG);
 }
 
 void DisplayManager::drawFooter(const char* left, const char* right) {
     int y = LCD_HEIGHT - 15;
-    _display.setTextSize(1);
-    _display.setTextColor(0x7BEF);
 
     if (strlen(left) > 0) {
-        _display.setCursor(5, y);
-        _display.print(left);
+        drawText(left, 5, y, 1, 0x7BEF);
     }
 
     if (strlen(right) > 0) {
+        _display.setTextSize(1);
         int w = _display.textWidth(right);
-        _display.setCursor(LCD_WIDTH - w - 5, y);
-        _display.print(right);
+        drawText(right, LCD_WIDTH - w - 5, y, 1, 0x7BEF);
     }
 }
 
@@ -307,7 +745,10 @@ void DisplayManager::drawFooter(const char* left, const char* right) {
 // ============================================
 
 void DisplayManager::showBLEScanning() {
-    clear();
+    DisplayLock lock(_lock);
+    // Called every 500 ms while scanning; only the dots change, so the
+    // commit below only repaints their band
+    beginScene();
     drawHeader("BLUETOOTH", COLOR_INFO);
 
     // Bluetooth icon (simple representation)
@@ -315,11 +756,8 @@ void DisplayManager::showBLEScanning() {
     int cy = 110;
 
     // Draw a stylized B for Bluetooth
-    _display.fillCircle(cx, cy, 25, COLOR_INFO);
-    _display.setTextColor(COLOR_BG);
-    _display.setTextSize(3);
-    _display.setCursor(cx - 9, cy - 12);
-    _display.print("B");
+    addWidget(WIDGET_FILL_CIRCLE, cx, cy, 25, 0, COLOR_INFO);
+    drawText("B", cx - 9, cy - 12, 3, COLOR_BG);
 
     // Scanning text
     drawCenteredText("Buscando", 160, 1, COLOR_TEXT);
@@ -333,40 +771,40 @@ void DisplayManager::showBLEScanning() {
     drawCenteredText(dotStr, 210, 2, COLOR_INFO);
 
     drawFooter("Escaneando", "BLE");
+
+    commitScene();
 }
 
 void DisplayManager::showBLEFound(const char* deviceName) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("BLE ENCONTRADO", COLOR_SUCCESS);
 
     // Success checkmark
     int cx = LCD_WIDTH / 2;
     int cy = 100;
-    _display.fillCircle(cx, cy, 25, COLOR_SUCCESS);
-    _display.setTextColor(COLOR_BG);
-    _display.setTextSize(2);
-    _display.setCursor(cx - 8, cy - 8);
-    _display.print("OK");
+    addWidget(WIDGET_FILL_CIRCLE, cx, cy, 25, 0, COLOR_SUCCESS);
+    drawText("OK", cx - 8, cy - 8, 2, COLOR_BG);
 
     drawCenteredText("Dispositivo:", 150, 1, 0x7BEF);
     drawCenteredText(deviceName, 170, 1, COLOR_TEXT);
 
     drawCenteredText("Conectando...", 210, 1, COLOR_PRIMARY);
+
+    commitScene();
 }
 
 void DisplayManager::showBLEConnecting(const char* deviceName) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("CONECTANDO BLE", COLOR_WARNING);
 
     // Bluetooth icon
     int cx = LCD_WIDTH / 2;
     int cy = 100;
-    _display.drawCircle(cx, cy, 25, COLOR_INFO);
-    _display.drawCircle(cx, cy, 20, COLOR_INFO);
-    _display.setTextColor(COLOR_INFO);
-    _display.setTextSize(2);
-    _display.setCursor(cx - 6, cy - 8);
-    _display.print("B");
+    addWidget(WIDGET_CIRCLE, cx, cy, 25, 0, COLOR_INFO);
+    addWidget(WIDGET_CIRCLE, cx, cy, 20, 0, COLOR_INFO);
+    drawText("B", cx - 6, cy - 8, 2, COLOR_INFO);
 
     drawCenteredText("Conectando a:", 150, 1, 0x7BEF);
     drawCenteredText(deviceName, 170, 1, COLOR_TEXT);
@@ -375,14 +813,17 @@ void DisplayManager::showBLEConnecting(const char* deviceName) {
     static int progress = 0;
     progress = (progress + 20) % 120;
     int barX = (LCD_WIDTH - 120) / 2;
-    _display.drawRect(barX, 200, 120, 10, COLOR_INFO);
-    _display.fillRect(barX + 2, 202, progress, 6, COLOR_INFO);
+    Widget* bar = addWidget(WIDGET_PROGRESS, barX, 200, 120, 10, COLOR_INFO);
+    if (bar) bar->value = progress;
 
     drawFooter("Espere...", "");
+
+    commitScene();
 }
 
 void DisplayManager::showBLEStatus(const char* status, const char* detail) {
-    clear();
+    DisplayLock lock(_lock);
+    beginScene();
     drawHeader("BLUETOOTH", COLOR_INFO);
 
     // Status icon based on state
@@ -392,25 +833,16 @@ void DisplayManager::showBLEStatus(const char* status, const char* detail) {
     if (strcmp(status, "NO_ADAPTER") == 0 ||
         strcmp(status, "ERROR") == 0) {
         // Error X
-        _display.fillCircle(cx, cy, 25, COLOR_DANGER);
-        _display.setTextColor(COLOR_BG);
-        _display.setTextSize(3);
-        _display.setCursor(cx - 9, cy - 12);
-        _display.print("X");
+        addWidget(WIDGET_FILL_CIRCLE, cx, cy, 25, 0, COLOR_DANGER);
+        drawText("X", cx - 9, cy - 12, 3, COLOR_BG);
     } else if (strcmp(status, "CONNECTED") == 0) {
         // Connected checkmark
-        _display.fillCircle(cx, cy, 25, COLOR_SUCCESS);
-        _display.setTextColor(COLOR_BG);
-        _display.setTextSize(2);
-        _display.setCursor(cx - 8, cy - 8);
-        _display.print("OK");
+        addWidget(WIDGET_FILL_CIRCLE, cx, cy, 25, 0, COLOR_SUCCESS);
+        drawText("OK", cx - 8, cy - 8, 2, COLOR_BG);
     } else {
         // Default Bluetooth symbol
-        _display.drawCircle(cx, cy, 25, COLOR_INFO);
-        _display.setTextColor(COLOR_INFO);
-        _display.setTextSize(2);
-        _display.setCursor(cx - 6, cy - 8);
-        _display.print("B");
+        addWidget(WIDGET_CIRCLE, cx, cy, 25, 0, COLOR_INFO);
+        drawText("B", cx - 6, cy - 8, 2, COLOR_INFO);
     }
 
     // Status text
@@ -421,4 +853,6 @@ void DisplayManager::showBLEStatus(const char* status, const char* detail) {
     }
 
     drawFooter("BLE", "v" FIRMWARE_VERSION);
+
+    commitScene();
 }
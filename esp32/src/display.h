@@ -2,7 +2,10 @@
 #define DISPLAY_H
 
 #include <LovyanGFX.hpp>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include "config.h"
+#include "notification_queue.h"
 
 // ============================================
 // Display Driver Configuration for ESP32-C6
@@ -62,8 +65,8 @@ public:
             auto cfg = _light_instance.config();
             cfg.pin_bl = LCD_BL;
             cfg.invert = false;
-            cfg.freq = 44100;
-            cfg.pwm_channel = 0;
+            cfg.freq = 44100;      // BL_PWM_FREQ (alert_effects.h)
+            cfg.pwm_channel = 0;   // BL_LEDC_CHANNEL: alert patterns fade it in hardware
             _light_instance.config(cfg);
             _panel_instance.setLight(&_light_instance);
         }
@@ -72,6 +75,45 @@ public:
     }
 };
 
+// ============================================
+// Retained Scene
+// Screens are described as a list of widgets; only the rows whose
+// widgets changed since the last commit are re-rendered into an
+// off-screen band sprite and pushed to the panel over DMA.
+// ============================================
+
+#define SCENE_MAX_WIDGETS   24
+#define SCENE_TEXT_LEN      48
+#define DISPLAY_BAND_HEIGHT 32   // Rows per off-screen band (2 bands = ~22 KB)
+#define SCENE_MAX_DIRTY     8    // Dirty row spans tracked per commit
+
+enum WidgetKind : uint8_t {
+    WIDGET_NONE,
+    WIDGET_FILL_RECT,
+    WIDGET_RECT,
+    WIDGET_HLINE,
+    WIDGET_FILL_CIRCLE,
+    WIDGET_CIRCLE,
+    WIDGET_TEXT,
+    WIDGET_PROGRESS
+};
+
+struct Widget {
+    WidgetKind kind;
+    uint8_t tag;           // Non-zero for overlays that replace each other
+    uint8_t textSize;
+    int16_t x, y, w, h;    // Circles: x/y = centre, w = radius
+    int16_t value;         // Progress bar fill width
+    uint16_t color;
+    char text[SCENE_TEXT_LEN];
+};
+
+struct Scene {
+    uint16_t bg;
+    uint8_t count;
+    Widget widgets[SCENE_MAX_WIDGETS];
+};
+
 // ============================================
 // Display Manager Class
 // ============================================
@@ -81,6 +123,8 @@ public:
     void begin();
     void clear();
     void setBrightness(uint8_t brightness);
+    void sleep();    // Panel sleep + backlight off; GRAM keeps the image
+    void wakeup();
 
     // Screen states
     void showSplash();
@@ -90,17 +134,20 @@ public:
     void showError(const char* message);
     void showIdle(bool connected, const char* mode);
 
-    // Notifications
-    void showNotification(const char* table, const char* type,
-                         const char* message, const char* priority);
+    // Notifications; `layout` is computed on first show, replayed after
+    void showNotification(const NotificationData& notif, TextLayout& layout,
+                          int queuePos = 0, int queueTotal = 0);
     void showNotificationQueue(int current, int total);
     void clearNotification();
-    void blinkAlert(bool state);
+    uint16_t getColorForType(const char* type);   // Header band; also the alert LED
 
     // Status indicators
     void showWeakSignal(int rssi);
     void showReconnecting(int attempt, int maxAttempts);
 
+    // Diagnostics (one left-aligned line per entry)
+    void showStats(const char* title, const char* const* lines, int count);
+
     // BLE Status
     void showBLEScanning();
     void showBLEFound(const char* deviceName);
@@ -109,17 +156,50 @@ public:
 
     // Utility
     void update();
+    void invalidate();  // Force a full repaint on the next commit
     LGFX* getLGFX() { return &_display; }
 
 private:
     LGFX _display;
     bool _initialized = false;
+    SemaphoreHandle_t _lock = nullptr;   // Recursive: screens nest helpers
+
+    // Retained scene: _scene is being built, _shown is what the panel holds
+    Scene _scene;
+    Scene _shown;
+    bool _fullRedraw = true;
+    LGFX_Sprite _band[2];
+    bool _bandsReady = false;
+    int16_t _dirtyY0[SCENE_MAX_DIRTY];
+    int16_t _dirtyY1[SCENE_MAX_DIRTY];
+    uint8_t _dirtyCount = 0;
+
+    // Scene building
+    void beginScene(uint16_t bg = COLOR_BG);
+    void commitScene();
+    Widget* addWidget(WidgetKind kind, int x, int y, int w, int h, uint16_t color);
+    void tagWidgets(uint8_t first, uint8_t tag);
+    void removeTagged(uint8_t tag);
+
+    // Scene rendering
+    void widgetSpan(const Widget& w, int& y0, int& y1);
+    void markDirty(int y0, int y1);
+    void renderBand(lgfx::LovyanGFX& gfx, int bandY, int bandH, int originY);
+    void renderWidget(lgfx::LovyanGFX& gfx, const Widget& w, int originY);
+    void flushDirty();
+
+    // Text layout (notification screen)
+    void layoutNotification(const NotificationData& notif, TextLayout& layout);
+    bool wrapText(const char* text, uint8_t size, uint8_t maxLines, TextLayout& layout);
+    int measureText(const char* text, size_t length);
 
-    uint16_t getColorForType(const char* type);
     const char* getIconForType(const char* type);
+    void drawText(const char* text, int x, int y, int size, uint16_t color);
+    void addText(const char* encoded, int x, int y, int width, int size, uint16_t color);
     void drawCenteredText(const char* text, int y, int size, uint16_t color);
     void drawHeader(const char* title, uint16_t bgColor);
     void drawFooter(const char* left, const char* right);
+    void drawQueueBadge(int current, int total);
 };
 
 extern DisplayManager Display;
@@ -0,0 +1,89 @@
+#include "json_arena.h"
+
+// Every block is preceded by a header holding its size, so reallocate()
+// knows how much to copy when a block can't grow in place
+static const size_t HEADER_SIZE = JSON_ARENA_HEADER_SIZE;
+
+JsonArena::JsonArena(uint8_t* buffer, size_t size)
+    : _buffer(buffer), _size(size) {}
+
+void* JsonArena::allocate(size_t size) {
+    size_t total = HEADER_SIZE + align(size);
+    if (_used + total > _size) {
+        _failures++;
+        return nullptr;
+    }
+
+    *(size_t*)(_buffer + _used) = size;
+    _last = _used;
+    _used += total;
+    if (_used > _peak) _peak = _used;
+
+    return _buffer + _last + HEADER_SIZE;
+}
+
+void JsonArena::deallocate(void* ptr) {
+    if (ptr == nullptr) return;
+
+    // Only the newest block can be handed back; the rest is reclaimed by reset()
+    if (_last != SIZE_MAX && (uint8_t*)ptr == _buffer + _last + HEADER_SIZE) {
+        _used = _last;
+        _last = SIZE_MAX;
+    }
+}
+
+void* JsonArena::reallocate(void* ptr, size_t newSize) {
+    if (ptr == nullptr) return allocate(newSize);
+
+    // Newest block: grow or shrink in place
+    if (_last != SIZE_MAX && (uint8_t*)ptr == _buffer + _last + HEADER_SIZE) {
+        size_t total = HEADER_SIZE + align(newSize);
+        if (_last + total > _size) {
+            _failures++;
+            return nullptr;
+        }
+        *(size_t*)(_buffer + _last) = newSize;
+        _used = _last + total;
+        if (_used > _peak) _peak = _used;
+        return ptr;
+    }
+
+    size_t oldSize = blockSize(ptr);
+    if (newSize <= oldSize) {
+        *(size_t*)((uint8_t*)ptr - HEADER_SIZE) = newSize;
+        return ptr;
+    }
+
+    void* moved = allocate(newSize);
+    if (moved) memcpy(moved, ptr, oldSize);
+    return moved;
+}
+
+void JsonArena::reset() {
+    _used = 0;
+    _last = SIZE_MAX;
+}
+
+size_t JsonArena::getUsed() {
+    return _used;
+}
+
+size_t JsonArena::getPeak() {
+    return _peak;
+}
+
+size_t JsonArena::getCapacity() {
+    return _size;
+}
+
+unsigned long JsonArena::getFailures() {
+    return _failures;
+}
+
+size_t JsonArena::align(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+size_t JsonArena::blockSize(void* ptr) {
+    return *(size_t*)((uint8_t*)ptr - HEADER_SIZE);
+}
@@ -0,0 +1,70 @@
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// ============================================
+// JSON Arena
+// Bump allocator for ArduinoJson documents. Memory comes from a fixed
+// buffer and is recycled wholesale with reset(), so per-message parsing
+// and serialization never touch the heap.
+//
+// ArduinoJson 7 takes variant slots a whole pool at a time, so an arena
+// must fit at least one pool plus the block header before its first
+// value; below that every assignment fails without a word.
+//
+// Arena sizes are written for the 32-bit target, where a slot is 8 B.
+// A 64-bit host (the native tests) has 16 B slots, so StaticJsonArena
+// scales its storage by the pointer size: the same number of slots fit
+// on both, and an arena that overflows on the watch overflows in tests.
+// ============================================
+
+#define JSON_ARENA_HEADER_SIZE  8
+#define JSON_ARENA_SLOT_SIZE    (2 * sizeof(void*))   // Value, type and next-slot id, padded
+#define JSON_ARENA_SCALE        (sizeof(void*) / 4)   // 1 on the target, 2 on a 64-bit host
+#define JSON_ARENA_POOL_SIZE    (ARDUINOJSON_POOL_CAPACITY * JSON_ARENA_SLOT_SIZE)
+#define JSON_ARENA_MIN_SIZE     (JSON_ARENA_POOL_SIZE + JSON_ARENA_HEADER_SIZE)
+
+class JsonArena : public ArduinoJson::Allocator {
+public:
+    JsonArena(uint8_t* buffer, size_t size);
+
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    // Drop everything - only call once the owning document is cleared
+    void reset();
+
+    size_t getUsed();
+    size_t getPeak();
+    size_t getCapacity();
+    unsigned long getFailures();
+
+private:
+    uint8_t* _buffer;
+    size_t _size;
+    size_t _used = 0;
+    size_t _last = SIZE_MAX;   // Offset of the most recent block header
+    size_t _peak = 0;
+    unsigned long _failures = 0;
+
+    static size_t align(size_t n);
+    size_t blockSize(void* ptr);
+};
+
+// N is the size on the 32-bit target
+template <size_t N>
+class StaticJsonArena : public JsonArena {
+    static constexpr size_t SIZE = N * JSON_ARENA_SCALE;
+    static_assert(SIZE > JSON_ARENA_MIN_SIZE, "JSON arena can't hold one slot pool plus strings");
+
+public:
+    StaticJsonArena() : JsonArena(_storage, SIZE) {}
+
+private:
+    alignas(8) uint8_t _storage[SIZE];
+};
+
+#endif // JSON_ARENA_H
@@ -0,0 +1,195 @@
+#include "latency_monitor.h"
+#include "debug_log.h"
+
+LatencyMonitor Latency;
+
+// Bucket upper edges in ms; anything above the last edge lands in the
+// final (open) bucket
+static const uint16_t LATENCY_BUCKET_EDGES[LATENCY_BUCKETS - 1] = {
+    5, 10, 20, 50, 100, 200, 500, 1000, 2000
+};
+
+// Timestamps below this are the local millis() fallback, not box time
+#define LATENCY_MIN_EPOCH_MS 1600000000000ULL
+
+// ============================================
+// Recording
+// ============================================
+
+void LatencyMonitor::record(const InboxItem& item, uint32_t takenUs, uint32_t pixelUs) {
+    const NotificationData& notif = item.data;
+    uint32_t deviceMs = (pixelUs - notif.rxUs) / 1000;
+
+    portENTER_CRITICAL(&_mux);
+    bool synced = _clockSynced;
+    int64_t offsetMs = _clockOffsetMs;
+    portEXIT_CRITICAL(&_mux);
+
+    // Network leg: box timestamp -> frame received, in box time
+    bool haveNetwork = false;
+    uint32_t networkMs = 0;
+    if (synced && notif.timestamp >= LATENCY_MIN_EPOCH_MS) {
+        int64_t rxServerMs = (int64_t)millis() + offsetMs
+                             - (int64_t)((micros() - notif.rxUs) / 1000);
+        int64_t delta = rxServerMs - (int64_t)notif.timestamp;
+        networkMs = delta > 0 ? (uint32_t)delta : 0;  // Residual skew can go negative
+        haveNetwork = true;
+    }
+
+    portENTER_CRITICAL(&_mux);
+    TransportLatency& stats = _stats[item.source];
+    addSample(stats.device, deviceMs);
+    if (haveNetwork) {
+        addSample(stats.network, networkMs);
+    }
+    addStage(stats.parse, notif.parsedUs - notif.rxUs);
+    addStage(stats.queue, takenUs - notif.parsedUs);
+    addStage(stats.render, pixelUs - takenUs);
+    portEXIT_CRITICAL(&_mux);
+
+    LOG_D(LAT, "%s: net %s%lu ms, parse %lu us, queue %lu us, render %lu us (device %lu ms)",
+          getSourceName(item.source),
+          haveNetwork ? "" : "~", (unsigned long)networkMs,
+          (unsigned long)(notif.parsedUs - notif.rxUs),
+          (unsigned long)(takenUs - notif.parsedUs),
+          (unsigned long)(pixelUs - takenUs),
+          (unsigned long)deviceMs);
+}
+
+void LatencyMonitor::addSample(LatencyHistogram& hist, uint32_t ms) {
+    uint8_t bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && ms > LATENCY_BUCKET_EDGES[bucket]) {
+        bucket++;
+    }
+
+    hist.counts[bucket]++;
+    hist.samples++;
+    if (ms > hist.maxMs) {
+        hist.maxMs = ms;
+    }
+}
+
+void LatencyMonitor::addStage(LatencyStage& stage, uint32_t us) {
+    stage.lastUs = us;
+    if (us > stage.maxUs) {
+        stage.maxUs = us;
+    }
+}
+
+void LatencyMonitor::clear() {
+    portENTER_CRITICAL(&_mux);
+    memset(_stats, 0, sizeof(_stats));
+    portEXIT_CRITICAL(&_mux);
+}
+
+// ============================================
+// Clock Sync
+// ============================================
+
+void LatencyMonitor::onSyncReply(uint64_t serverMs, uint32_t clientSentMs) {
+    if (serverMs < LATENCY_MIN_EPOCH_MS) return;
+
+    uint32_t now = millis();
+    uint32_t rtt = now - clientSentMs;
+
+    // Assume a symmetric path: the box stamped its reply half an RTT ago
+    int64_t offset = (int64_t)serverMs + rtt / 2 - (int64_t)now;
+
+    portENTER_CRITICAL(&_mux);
+    _clockOffsetMs = offset;
+    _clockRttMs = rtt;
+    _clockSynced = true;
+    portEXIT_CRITICAL(&_mux);
+
+    LOG_I(LAT, "Clock synced: offset %lld ms, RTT %lu ms",
+          (long long)offset, (unsigned long)rtt);
+}
+
+void LatencyMonitor::onServerTime(uint64_t serverMs) {
+    if (serverMs < LATENCY_MIN_EPOCH_MS) return;
+
+    portENTER_CRITICAL(&_mux);
+    int64_t sample = (int64_t)serverMs + _clockRttMs / 2 - (int64_t)millis();
+
+    if (!_clockSynced) {
+        _clockOffsetMs = sample;
+        _clockSynced = true;
+    } else {
+        // Track crystal drift without letting one delayed ping jump the offset
+        _clockOffsetMs += (sample - _clockOffsetMs) / CLOCK_SYNC_SMOOTHING;
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+bool LatencyMonitor::isClockSynced() {
+    return _clockSynced;
+}
+
+int64_t LatencyMonitor::getClockOffset() {
+    portENTER_CRITICAL(&_mux);
+    int64_t offset = _clockOffsetMs;
+    portEXIT_CRITICAL(&_mux);
+    return offset;
+}
+
+uint32_t LatencyMonitor::getClockRtt() {
+    return _clockRttMs;
+}
+
+// ============================================
+// Reporting
+// ============================================
+
+TransportLatency LatencyMonitor::snapshot(NotificationSource source) {
+    portENTER_CRITICAL(&_mux);
+    TransportLatency copy = _stats[source];
+    portEXIT_CRITICAL(&_mux);
+    return copy;
+}
+
+uint32_t LatencyMonitor::percentileMs(const LatencyHistogram& hist, uint8_t pct) {
+    if (hist.samples == 0) return 0;
+
+    // Upper edge of the bucket holding the pct-th sample
+    uint32_t target = (hist.samples * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < LATENCY_BUCKETS - 1; i++) {
+        seen += hist.counts[i];
+        if (seen >= target) {
+            return min((uint32_t)LATENCY_BUCKET_EDGES[i], hist.maxMs);
+        }
+    }
+    return hist.maxMs;
+}
+
+void LatencyMonitor::writeTransport(JsonObject out, const TransportLatency& stats) {
+    out["n"] = stats.device.samples;
+
+    JsonArray net = out["net"].to<JsonArray>();
+    JsonArray dev = out["dev"].to<JsonArray>();
+    for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+        net.add(stats.network.counts[i]);
+        dev.add(stats.device.counts[i]);
+    }
+    out["net_max"] = stats.network.maxMs;
+    out["dev_max"] = stats.device.maxMs;
+    out["parse_max_us"] = stats.parse.maxUs;
+    out["queue_max_us"] = stats.queue.maxUs;
+    out["render_max_us"] = stats.render.maxUs;
+}
+
+void LatencyMonitor::writeJson(JsonObject out) {
+    JsonArray edges = out["edges"].to<JsonArray>();
+    for (uint8_t i = 0; i < LATENCY_BUCKETS - 1; i++) {
+        edges.add(LATENCY_BUCKET_EDGES[i]);
+    }
+
+    JsonObject clock = out["clock"].to<JsonObject>();
+    clock["synced"] = _clockSynced;
+    clock["offset"] = getClockOffset();
+    clock["rtt"] = _clockRttMs;
+
+    writeTransport(out["ws"].to<JsonObject>(), snapshot(SOURCE_WEBSOCKET));
+    writeTransport(out["ble"].to<JsonObject>(), snapshot(SOURCE_BLE));
+    writeTransport(out["realtime"].to<JsonObject>(), snapshot(SOURCE_REALTIME));
+}
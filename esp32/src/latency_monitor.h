@@ -0,0 +1,76 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include "app_events.h"
+
+// ============================================
+// Notification Latency Monitor
+// Per-transport histograms of where the time goes between the box
+// creating an alert and the watch showing it:
+//   network  server timestamp -> frame received (needs clock sync)
+//   device   frame received   -> pixels on the panel
+// plus last/max of the device-side stages (parse, queue, render).
+// ============================================
+
+#define LATENCY_BUCKETS     10   // Upper edges in LATENCY_BUCKET_EDGES, last is open
+#define LATENCY_TRANSPORTS  3    // SOURCE_WEBSOCKET, SOURCE_BLE, SOURCE_REALTIME
+#define CLOCK_SYNC_SMOOTHING 8   // One-way samples move the offset by 1/N
+
+struct LatencyHistogram {
+    uint32_t counts[LATENCY_BUCKETS];
+    uint32_t samples;
+    uint32_t maxMs;
+};
+
+struct LatencyStage {
+    uint32_t lastUs;
+    uint32_t maxUs;
+};
+
+struct TransportLatency {
+    LatencyHistogram network;
+    LatencyHistogram device;
+    LatencyStage parse;      // Frame received -> decoded
+    LatencyStage queue;      // Decoded -> picked up by the UI task
+    LatencyStage render;     // Picked up -> panel updated
+};
+
+class LatencyMonitor {
+public:
+    // Called by the UI task once the notification is on the panel
+    void record(const InboxItem& item, uint32_t takenUs, uint32_t pixelUs);
+
+    // Box clock. Two-way: the box echoes our send time (register reply).
+    // One-way: a bare server time (ping), corrected by the last RTT.
+    void onSyncReply(uint64_t serverMs, uint32_t clientSentMs);
+    void onServerTime(uint64_t serverMs);
+    bool isClockSynced();
+    int64_t getClockOffset();
+    uint32_t getClockRtt();
+
+    // Copies for other tasks (heartbeat, debug screen)
+    TransportLatency snapshot(NotificationSource source);
+    static uint32_t percentileMs(const LatencyHistogram& hist, uint8_t pct);
+    void writeJson(JsonObject out);
+
+    void clear();
+
+private:
+    TransportLatency _stats[LATENCY_TRANSPORTS] = {};
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    bool _clockSynced = false;
+    int64_t _clockOffsetMs = 0;   // server ms = millis() + offset
+    uint32_t _clockRttMs = 0;
+
+    static void addSample(LatencyHistogram& hist, uint32_t ms);
+    static void addStage(LatencyStage& stage, uint32_t us);
+    static void writeTransport(JsonObject out, const TransportLatency& stats);
+};
+
+extern LatencyMonitor Latency;
+
+#endif // LATENCY_MONITOR_H
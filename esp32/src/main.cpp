@@ -16,7 +16,22 @@
 #include "wifi_manager.h"
 #include "web_portal.h"
 #include "websocket_client.h"
+#include "realtime_client.h"
 #include "ble_client.h"
+#include "notification_queue.h"
+#include "recent_ids.h"
+#include "app_events.h"
+#include "latency_monitor.h"
+#include "power_manager.h"
+#include "notification_log.h"
+#include "boot_timeline.h"
+#include "transport_manager.h"
+#include "metrics.h"
+#include "debug_log.h"
+#include "alert_effects.h"
+#include "subscription_filter.h"
+#include "ota_updater.h"
+#include "benchmark.h"
 
 // ============================================
 // Global State
@@ -31,52 +46,80 @@ enum DeviceState {
 };
 
 DeviceState currentState = STATE_BOOT;
-DeviceConfig deviceConfig;
 unsigned long lastUpdate = 0;
 bool shouldRestart = false;
 unsigned long restartTime = 0;
 
-// Notification state
+// Notification state (the queue head is what's on screen).
+// Owned by the UI task.
 bool hasActiveNotification = false;
 unsigned long notificationTime = 0;
-NotificationData currentNotification;
+uint32_t shownNotificationSeq = 0;
+char shownNotificationId[sizeof(NotificationData::id)] = "";
+
+// Temporary info screen (BOOT short press, WiFi connected) - UI task
+enum InfoScreen {
+    INFO_NONE,
+    INFO_CONNECTION,    // SSID / IP
+    INFO_LATENCY        // Latency histograms (second BOOT press)
+};
+InfoScreen infoScreen = INFO_NONE;
+unsigned long infoScreenUntil = 0;
 
-// Button state
-volatile bool btnUserPressed = false;
-volatile bool btnBootPressed = false;
-unsigned long btnUserPressTime = 0;
-unsigned long btnBootPressTime = 0;
+// Tasks
+TaskHandle_t inputTaskHandle = nullptr;
+TaskHandle_t uiTaskHandle = nullptr;
+TaskHandle_t netTaskHandle = nullptr;
+TaskHandle_t bleTaskHandle = nullptr;
+TaskHandle_t loopTaskHandle = nullptr;      // Arduino loop(), parked outside AP mode
 
-// Long press detection
-#define LONG_PRESS_TIME 3000  // 3 seconds for factory reset
+// Button edges, delivered from the ISRs to the input task
+#define BTN_NOTIFY_USER   (1 << 0)
+#define BTN_NOTIFY_BOOT   (1 << 1)
 
-// Alert blinking
-bool alertBlinkState = false;
-unsigned long lastBlink = 0;
+// Long press detection
+#define LONG_PRESS_TIME   3000  // 3 seconds for factory reset
+#define BTN_DEBOUNCE_TIME 50    // Ignore edges closer than this
+#define BTN_HOLD_POLL     50    // BOOT hold is sampled this often
 
 // Connection mode tracking
 bool useWiFi = true;
 bool useBLE = true;
-bool wifiConnected = false;
-bool bleConnected = false;
+bool directMode = false;               // Supabase Realtime instead of the box
+volatile bool wifiConnected = false;   // Written by the network task
+volatile bool bleConnected = false;    // Written by the BLE task
+volatile bool apModeRequested = false; // UI task asks, the network task switches
 
 // ============================================
 // Forward Declarations
 // ============================================
 void updateConnectionStatus();
+void showQueueHead();
+void showInfoScreen(InfoScreen screen, unsigned long duration);
+void restoreNotifications();
+void enterAPMode();
 
 // ============================================
 // Button Handling
 // ============================================
 
+// The ISRs only forward the edge; timing and long-press detection
+// happen in the input task
+
 void IRAM_ATTR onUserButtonPress() {
-    btnUserPressed = true;
-    btnUserPressTime = millis();
+    BaseType_t woken = pdFALSE;
+    if (inputTaskHandle) {
+        xTaskNotifyFromISR(inputTaskHandle, BTN_NOTIFY_USER, eSetBits, &woken);
+    }
+    if (woken) portYIELD_FROM_ISR();
 }
 
 void IRAM_ATTR onBootButtonPress() {
-    btnBootPressed = true;
-    btnBootPressTime = millis();
+    BaseType_t woken = pdFALSE;
+    if (inputTaskHandle) {
+        xTaskNotifyFromISR(inputTaskHandle, BTN_NOTIFY_BOOT, eSetBits, &woken);
+    }
+    if (woken) portYIELD_FROM_ISR();
 }
 
 void setupButtons() {
@@ -86,109 +129,434 @@ void setupButtons() {
     attachInterrupt(digitalPinToInterrupt(BTN_USER), onUserButtonPress, FALLING);
     attachInterrupt(digitalPinToInterrupt(BTN_BOOT), onBootButtonPress, FALLING);
 
-    Serial.println("[BTN] Buttons initialized");
+    LOG_I(BTN, "Buttons initialized");
+}
+
+void handleBootHold(unsigned long pressTime) {
+    // Follow the hold; only this task sleeps while the button is down
+    while (digitalRead(BTN_BOOT) == LOW) {
+        if (millis() - pressTime > LONG_PRESS_TIME) {
+            LOG_I(BTN, "Long press detected - Factory Reset!");
+            Events.signal(EVT_FACTORY_RESET);
+            return;
+        }
+        vTaskDelay(pdMS_TO_TICKS(BTN_HOLD_POLL));
+    }
+
+    LOG_I(BTN, "BOOT button released");
+    Events.signal(EVT_BTN_BOOT);
+}
+
+void inputTask(void* param) {
+    unsigned long lastUser = 0;
+    unsigned long lastBoot = 0;
+
+    for (;;) {
+        uint32_t edges = 0;
+        xTaskNotifyWait(0, 0xFFFFFFFF, &edges, portMAX_DELAY);
+        uint32_t startUs = micros();
+        unsigned long now = millis();
+
+        if ((edges & BTN_NOTIFY_USER) && now - lastUser > BTN_DEBOUNCE_TIME) {
+            lastUser = now;
+            LOG_I(BTN, "USER button pressed");
+            Events.signal(EVT_BTN_USER);
+        }
+
+        if ((edges & BTN_NOTIFY_BOOT) && now - lastBoot > BTN_DEBOUNCE_TIME) {
+            handleBootHold(now);
+            // Release bounce would otherwise count as a new press
+            lastBoot = millis();
+        }
+
+        Metrics.lap(LOOP_INPUT, startUs);
+    }
+}
+
+// ============================================
+// Notification Handling
+// ============================================
+
+void reportUserAction(AckKind kind, const char* id) {
+    // The box only needs to hear it once: over the link carrying alerts
+    Transports.getActiveTransport()->queueAck(kind, id);
+}
+
+void showQueueHead() {
+    const QueuedNotification* head = NotifQueue.front();
+    if (!head) return;
+
+    // An alert always takes over a temporary info screen
+    infoScreen = INFO_NONE;
+
+    // Restart the auto-dismiss timer only when a different alert takes the screen
+    if (head->seq != shownNotificationSeq) {
+        shownNotificationSeq = head->seq;
+        notificationTime = millis();
+        reportUserAction(ACK_DISPLAYED, head->data.id);
+        Metrics.count(METRIC_DISPLAYED);
+    } else if (strcmp(head->data.id, shownNotificationId) != 0) {
+        // A repeat merged into the alert on screen: the box tracks its id too
+        reportUserAction(ACK_DISPLAYED, head->data.id);
+    }
+    strncpy(shownNotificationId, head->data.id, sizeof(shownNotificationId) - 1);
+    hasActiveNotification = true;
+
+    // High / urgent: LED and backlight pattern in hardware, no UI timer
+    Effects.start(AlertEffects::patternForRank(head->rank), Display.getColorForType(head->data.type));
+
+    // Live queue counter in the header; the layout is cached in the slot
+    const NotificationData& notif = head->data;
+    Display.showNotification(notif, *NotifQueue.frontLayout(), 1, NotifQueue.count());
+
+    LOG_D(NOTIF, "Showing: Table %s - %s (%s), %d queued",
+          notif.table, notif.type, notif.priority, NotifQueue.count());
 }
 
-void dismissNotification() {
+bool showNotification(NotificationData& notif) {
+    // The box filters too; this covers older boxes and direct mode
+    if (!Subscription.accept(notif)) {
+        LOG_D(NOTIF, "Not subscribed: Table %s - %s (%s)", notif.table, notif.type, notif.priority);
+        return false;
+    }
+
+    // In "both" mode the box sends every alert over WiFi and BLE
+    if (RecentIds.checkAndRemember(notif)) {
+        LOG_D(NOTIF, "Duplicate ignored: Table %s - %s (id %s)",
+              notif.table, notif.type, notif.id);
+        return false;
+    }
+
+    if (NotifQueue.push(notif) == QUEUE_DROPPED) {
+        return false;
+    }
+
+    // Persist before anything can reboot us; evictions get acked
+    NotifLog.append(notif);
+    NotifLog.sync(NotifQueue);
+
+    // Redraw the head; when it didn't change only the counter band repaints
+    showQueueHead();
+    return true;
+}
+
+void dismissNotification(bool byUser) {
+    // Dismiss the head and advance to the next queued notification.
+    // The box hears it for every id merged into the head, not just the latest
+    if (byUser) {
+        const QueuedNotification* head = NotifQueue.front();
+        for (uint8_t i = 0; i < head->absorbedCount; i++) {
+            reportUserAction(ACK_DISMISSED, head->absorbed[i]);
+        }
+        reportUserAction(ACK_DISMISSED, head->data.id);
+    }
+    NotifQueue.pop();
+    NotifLog.sync(NotifQueue);
+    Effects.stop();
+    LOG_I(NOTIF, "Notification dismissed (%d remaining)", NotifQueue.count());
+
+    if (!NotifQueue.isEmpty()) {
+        showQueueHead();
+        return;
+    }
+
     hasActiveNotification = false;
-    Display.blinkAlert(false);
+    shownNotificationSeq = 0;
+    shownNotificationId[0] = '\0';
     // Use updateConnectionStatus() to show correct WiFi/BLE status
     updateConnectionStatus();
-    Serial.println("[NOTIF] Notification dismissed");
 }
 
-void handleButtons() {
-    // USER button - dismiss notification
-    if (btnUserPressed) {
-        btnUserPressed = false;
-        Serial.println("[BTN] USER button pressed");
+void updateNotificationTimer() {
+    if (!hasActiveNotification) return;
 
-        if (hasActiveNotification) {
-            dismissNotification();
-        }
+    // Auto-dismiss after timeout
+    if (millis() - notificationTime >= NOTIFICATION_TIMEOUT) {
+        LOG_I(NOTIF, "Auto-dismissing after timeout");
+        dismissNotification(false);
+        return;
+    }
+
+    // The alert pattern runs in hardware; only its backlight fade re-arms
+    Effects.loop();
+}
+
+void showInfoScreen(InfoScreen screen, unsigned long duration) {
+    // Caller has drawn the screen; the UI task restores idle afterwards
+    infoScreen = screen;
+    infoScreenUntil = millis() + duration;
+}
+
+void updateInfoScreen() {
+    if (infoScreen != INFO_NONE && (long)(millis() - infoScreenUntil) >= 0) {
+        infoScreen = INFO_NONE;
+        updateConnectionStatus();
+    }
+}
+
+void formatTransportLatency(const char* name, NotificationSource source, char lines[][32]) {
+    TransportLatency stats = Latency.snapshot(source);
+
+    snprintf(lines[0], 32, "%s: %lu alertas", name, (unsigned long)stats.device.samples);
+    snprintf(lines[1], 32, " red  p50 %lu p95 %lu ms",
+             (unsigned long)LatencyMonitor::percentileMs(stats.network, 50),
+             (unsigned long)LatencyMonitor::percentileMs(stats.network, 95));
+    snprintf(lines[2], 32, " disp p50 %lu p95 %lu ms",
+             (unsigned long)LatencyMonitor::percentileMs(stats.device, 50),
+             (unsigned long)LatencyMonitor::percentileMs(stats.device, 95));
+    snprintf(lines[3], 32, " max red %lu disp %lu ms",
+             (unsigned long)stats.network.maxMs, (unsigned long)stats.device.maxMs);
+}
+
+void showLatencyScreen() {
+    char lines[9][32];
+    if (directMode) {
+        formatTransportLatency("Supabase", SOURCE_REALTIME, &lines[0]);
+    } else {
+        formatTransportLatency("WiFi", SOURCE_WEBSOCKET, &lines[0]);
+    }
+    formatTransportLatency("BLE", SOURCE_BLE, &lines[4]);
+
+    if (Latency.isClockSynced()) {
+        snprintf(lines[8], 32, "Reloj %+lld ms rtt %lu",
+                 (long long)Latency.getClockOffset(), (unsigned long)Latency.getClockRtt());
+    } else {
+        snprintf(lines[8], 32, "Reloj sin sincronizar");
+    }
+
+    const char* rows[9];
+    for (int i = 0; i < 9; i++) rows[i] = lines[i];
+    Display.showStats("LATENCIA", rows, 9);
+}
+
+// ============================================
+// UI Task
+// Sleeps until an event arrives or the next timer (auto-dismiss,
+// alert backlight re-arm, info screen) is due - nothing is polled.
+// ============================================
+
+static unsigned long msUntil(unsigned long deadline, unsigned long now) {
+    long remaining = (long)(deadline - now);
+    return remaining > 0 ? (unsigned long)remaining : 0;
+}
+
+bool isIdleScreen() {
+    return !hasActiveNotification && infoScreen == INFO_NONE;
+}
+
+TickType_t nextUiTimeout() {
+    unsigned long now = millis();
+    unsigned long wait = ULONG_MAX;
+
+    if (hasActiveNotification) {
+        wait = msUntil(notificationTime + NOTIFICATION_TIMEOUT, now);
+        wait = min(wait, Effects.msUntilRefresh());
+    }
+    if (infoScreen != INFO_NONE) {
+        wait = min(wait, msUntil(infoScreenUntil, now));
     }
+    wait = min(wait, Power.msUntilPanelStep(isIdleScreen()));
 
-    // BOOT button - check for long press to factory reset
-    if (btnBootPressed) {
-        // Check if still held
-        if (digitalRead(BTN_BOOT) == LOW) {
-            unsigned long holdTime = millis() - btnBootPressTime;
+    return wait == ULONG_MAX ? portMAX_DELAY : pdMS_TO_TICKS(wait);
+}
 
-            if (holdTime > LONG_PRESS_TIME) {
-                btnBootPressed = false;
-                Serial.println("[BTN] Long press detected - Factory Reset!");
+void handleUiEvents(EventBits_t bits) {
+    if (bits & EVT_FACTORY_RESET) {
+        Display.showError("Factory Reset...");
+        vTaskDelay(pdMS_TO_TICKS(1000));  // Rebooting anyway; let it be read
 
-                Display.showError("Factory Reset...");
-                delay(1000);
+        NotifLog.clear();
+        Storage.clearConfig();
+        Log.flush();
+        ESP.restart();
+    }
 
-                Storage.clearConfig();
-                ESP.restart();
+    // Alerts and presses wake the panel; a press that only woke the
+    // screen does nothing else
+    if (bits & (EVT_NOTIFICATION | EVT_BTN_USER | EVT_BTN_BOOT)) {
+        if (Power.wake() && !(bits & EVT_NOTIFICATION)) {
+            bits &= ~(EVT_BTN_USER | EVT_BTN_BOOT);
+        }
+    }
+
+    if (bits & EVT_NOTIFICATION) {
+        // Read in place; the slot goes back to the transports afterwards
+        InboxItem* item;
+        while ((item = Events.takeNotification()) != nullptr) {
+            uint32_t takenUs = micros();
+            if (showNotification(item->data)) {
+                Latency.record(*item, takenUs, micros());
+                Boot.mark(BOOT_FIRST_NOTIF);
             }
+            Events.releaseNotification(item);
+        }
+    }
+
+    // USER button - dismiss notification and advance the queue
+    if ((bits & EVT_BTN_USER) && hasActiveNotification) {
+        dismissNotification(true);
+    }
+
+    // BOOT short press - connection info, then latency stats, then back
+    if ((bits & EVT_BTN_BOOT) && currentState == STATE_CONNECTED && !hasActiveNotification) {
+        if (infoScreen == INFO_CONNECTION) {
+            showLatencyScreen();
+            showInfoScreen(INFO_LATENCY, LATENCY_SCREEN_TIME);
+        } else if (infoScreen == INFO_LATENCY) {
+            infoScreen = INFO_NONE;
+            updateConnectionStatus();
         } else {
-            btnBootPressed = false;
-            Serial.println("[BTN] BOOT button released");
-
-            // Short press - show connection info
-            if (currentState == STATE_CONNECTED && !hasActiveNotification) {
-                Display.showConnected(WifiMgr.getSSID().c_str(), WifiMgr.getIPAddress().c_str());
-                delay(3000);
-                // Use updateConnectionStatus() to show correct WiFi/BLE status
-                updateConnectionStatus();
+            Display.showConnected(WifiMgr.getSSID().c_str(), WifiMgr.getIPAddress().c_str());
+            showInfoScreen(INFO_CONNECTION, INFO_SCREEN_TIME);
+        }
+    }
+
+    // WiFi associated in the background: brief "connected" screen
+    if ((bits & EVT_WIFI_UP) && !hasActiveNotification && infoScreen == INFO_NONE) {
+        Display.showConnected(WifiMgr.getSSID().c_str(), WifiMgr.getIPAddress().c_str());
+        showInfoScreen(INFO_CONNECTION, CONNECTED_SCREEN_TIME);
+    }
+
+    // Without BLE to fall back on, WiFi failing means reconfiguring
+    if (bits & EVT_WIFI_FAILED) {
+        if (!useBLE) {
+            // The network task owns WiFi and the sockets: it shuts them
+            // down and switches to AP mode between two of its loops
+            LOG_W(STATE, "WiFi unavailable and no BLE fallback, entering AP mode");
+            if (netTaskHandle) {
+                apModeRequested = true;
+            } else {
+                enterAPMode();
+                xTaskNotifyGive(loopTaskHandle);
             }
+            return;
         }
+        LOG_W(STATE, "WiFi unavailable, staying on BLE");
+    }
+
+    if (bits & EVT_LINK_CHANGED) {
+        updateConnectionStatus();
+    }
+}
+
+void uiTask(void* param) {
+    for (;;) {
+        EventBits_t bits = Events.wait(EVT_ALL_UI, nextUiTimeout());
+        uint32_t startUs = micros();
+        handleUiEvents(bits);
+
+        // Timers
+        updateNotificationTimer();
+        updateInfoScreen();
+        Power.updatePanel(isIdleScreen());
+
+        // Update display animations
+        Display.update();
+
+        Metrics.lap(LOOP_UI, startUs);
     }
 }
 
 // ============================================
-// Notification Handling
+// Network / BLE Tasks
+// The transport libraries are poll-driven; each gets its own task so a
+// slow BLE connect or WiFi check can't hold up incoming frames.
 // ============================================
 
-void showNotification(NotificationData& notif) {
-    hasActiveNotification = true;
-    notificationTime = millis();
-    currentNotification = notif;
+void netTask(void* param) {
+    for (;;) {
+        // The UI task gave up on WiFi: close the links, then the portal
+        // takes over from the parked loop task
+        if (apModeRequested) {
+            if (directMode) {
+                Realtime.disconnect();
+            } else {
+                WsClient.disconnect();
+            }
+            Metrics.endHttp();
+            enterAPMode();
+            xTaskNotifyGive(loopTaskHandle);
+            netTaskHandle = nullptr;
+            vTaskDelete(NULL);
+        }
 
-    Display.showNotification(notif.table, notif.type, notif.message, notif.priority);
+        // WiFi connection monitoring with auto-reconnect
+        uint32_t t = micros();
+        WifiMgr.loop();
+        t = Metrics.lap(LOOP_WIFI, t);
 
-    Serial.printf("[NOTIF] Showing: Table %s - %s (%s)\n",
-                  notif.table, notif.type, notif.priority);
-}
+        if (directMode) {
+            // Supabase Realtime client loop (direct mode, no box)
+            Realtime.loop();
+            t = Metrics.lap(LOOP_REALTIME, t);
+        } else {
+            // WebSocket client loop (for BitsperBox mode via WiFi)
+            WsClient.loop();
 
-void updateNotificationBlink() {
-    if (!hasActiveNotification) return;
+            // Keep or roll back a new image, restart into a downloaded one
+            Ota.loop();
+            t = Metrics.lap(LOOP_WS, t);
+        }
 
-    // Only blink for urgent/high priority
-    bool shouldBlink = (strcmp(currentNotification.priority, "urgent") == 0 ||
-                        strcmp(currentNotification.priority, "high") == 0);
+        // "both" mode: pick the primary, park or wake BLE
+        Transports.loop();
+        Metrics.lap(LOOP_TRANSPORT, t);
 
-    if (!shouldBlink) return;
+        // /metrics for the fleet dashboard, served once associated
+        if (WifiMgr.isConnected()) {
+            Metrics.beginHttp();
+            Metrics.handleHttp();
+        }
 
-    if (millis() - lastBlink > ALERT_BLINK_INTERVAL) {
-        lastBlink = millis();
-        alertBlinkState = !alertBlinkState;
-        Display.blinkAlert(alertBlinkState);
+        // Longer in power-saving profiles so the CPU can idle between frames
+        vTaskDelay(pdMS_TO_TICKS(Power.getNetPollInterval()));
     }
+}
 
-    // Auto-dismiss after timeout
-    if (millis() - notificationTime > NOTIFICATION_TIMEOUT) {
-        Serial.println("[NOTIF] Auto-dismissing after timeout");
-        dismissNotification();
+void bleTask(void* param) {
+    for (;;) {
+        uint32_t startUs = micros();
+        BleClient.loop();
+        Metrics.lap(LOOP_BLE, startUs);
+        vTaskDelay(pdMS_TO_TICKS(BLE_POLL_INTERVAL));
     }
 }
 
+void startTasks() {
+    const DeviceConfig& deviceConfig = Storage.getConfig();
+
+    // Input and UI run in every state (factory reset works from AP mode)
+    xTaskCreate(inputTask, "input", TASK_INPUT_STACK, nullptr, TASK_INPUT_PRIORITY, &inputTaskHandle);
+    xTaskCreate(uiTask, "ui", TASK_UI_STACK, nullptr, TASK_UI_PRIORITY, &uiTaskHandle);
+
+    if (currentState == STATE_CONNECTED && directMode) {
+        xTaskCreate(netTask, "net", TASK_NET_STACK_TLS, nullptr, TASK_NET_PRIORITY, &netTaskHandle);
+    } else if (currentState == STATE_CONNECTED && strcmp(deviceConfig.mode, "bitsperbox") == 0) {
+        if (useWiFi) {
+            xTaskCreate(netTask, "net", TASK_NET_STACK, nullptr, TASK_NET_PRIORITY, &netTaskHandle);
+        }
+        if (useBLE) {
+            xTaskCreate(bleTask, "ble", TASK_BLE_STACK, nullptr, TASK_BLE_PRIORITY, &bleTaskHandle);
+        }
+    }
+
+    LOG_I(INIT, "Tasks started (net: %s, ble: %s)",
+          netTaskHandle ? "YES" : "NO", bleTaskHandle ? "YES" : "NO");
+}
+
 // ============================================
 // State Machine
 // ============================================
 
 void enterAPMode() {
-    Serial.println("[STATE] Entering AP Mode");
+    LOG_I(STATE, "Entering AP Mode");
     currentState = STATE_AP_MODE;
 
     WifiMgr.startAPMode();
     Portal.begin();
 
     Portal.onConfigSaved([]() {
-        Serial.println("[STATE] Config saved, scheduling restart...");
+        LOG_I(STATE, "Config saved, scheduling restart...");
         shouldRestart = true;
         restartTime = millis() + 3000;
     });
@@ -198,10 +566,10 @@ void updateConnectionStatus() {
     // Update display based on any active connection
     bool anyConnected = wifiConnected || bleConnected;
 
-    Serial.printf("[DISPLAY] updateConnectionStatus: wifi=%d, ble=%d, hasNotif=%d\n",
-                  wifiConnected, bleConnected, hasActiveNotification);
+    LOG_D(DISPLAY, "updateConnectionStatus: wifi=%d, ble=%d, hasNotif=%d",
+          wifiConnected, bleConnected, hasActiveNotification);
 
-    if (!hasActiveNotification) {
+    if (!hasActiveNotification && infoScreen == INFO_NONE) {
         String modeText;
         if (wifiConnected && bleConnected) {
             modeText = "WiFi+BLE";
@@ -212,28 +580,26 @@ void updateConnectionStatus() {
         } else {
             modeText = "Desconectado";
         }
-        Serial.printf("[DISPLAY] Showing idle screen: connected=%d, mode=%s\n", anyConnected, modeText.c_str());
+        LOG_D(DISPLAY, "Showing idle screen: connected=%d, mode=%s", anyConnected, modeText.c_str());
         Display.showIdle(anyConnected, modeText.c_str());
     }
 }
 
 void startWebSocketClient() {
-    Serial.println("[STATE] Starting WebSocket client");
+    const DeviceConfig& deviceConfig = Storage.getConfig();
+    LOG_I(STATE, "Starting WebSocket client");
 
-    // Set up notification callback
-    WsClient.onNotification([](NotificationData& notif) {
-        showNotification(notif);
-    });
+    // Notifications go straight to the event bus (see transport.h)
 
     // Set up connection status callback
     WsClient.onConnectionChange([](bool connected) {
         wifiConnected = connected;
         if (connected) {
-            Serial.println("[WS] Connected to BitsperBox via WiFi!");
+            LOG_I(WS, "Connected to BitsperBox via WiFi!");
         } else {
-            Serial.println("[WS] Disconnected from BitsperBox (WiFi)");
+            LOG_W(WS, "Disconnected from BitsperBox (WiFi)");
         }
-        updateConnectionStatus();
+        Events.signal(EVT_LINK_CHANGED);
     });
 
     // Connect to BitsperBox
@@ -241,7 +607,8 @@ void startWebSocketClient() {
 }
 
 void startBLEClient() {
-    Serial.println("[STATE] Starting BLE client");
+    const DeviceConfig& deviceConfig = Storage.getConfig();
+    LOG_I(STATE, "Starting BLE client");
 
     // Initialize BLE
     BleClient.begin();
@@ -249,30 +616,22 @@ void startBLEClient() {
     // Set target BLE address from config (if configured via captive portal)
     if (strlen(deviceConfig.ble_server_address) > 0) {
         BleClient.setTargetAddress(deviceConfig.ble_server_address);
-        Serial.printf("[BLE] Using configured BLE address: %s (%s)\n",
-                      deviceConfig.ble_server_address, deviceConfig.ble_server_name);
-    }
-
-    // Set up notification callback - convert BLE notification to standard format
-    BleClient.onNotification([](BLENotificationData& bleNotif) {
-        NotificationData notif;
-        strncpy(notif.table, bleNotif.table, sizeof(notif.table));
-        strncpy(notif.type, bleNotif.type, sizeof(notif.type));
-        strncpy(notif.message, bleNotif.message, sizeof(notif.message));
-        strncpy(notif.priority, bleNotif.priority, sizeof(notif.priority));
-        notif.timestamp = bleNotif.timestamp;
-        showNotification(notif);
-    });
+        LOG_I(BLE, "Using configured BLE address: %s (%s)",
+              deviceConfig.ble_server_address, deviceConfig.ble_server_name);
+    }
+
+    // Notifications go straight to the event bus (see transport.h)
 
     // Set up connection status callback
     BleClient.onConnectionChange([](bool connected) {
         bleConnected = connected;
         if (connected) {
-            Serial.println("[BLE] Connected to BitsperBox via Bluetooth!");
+            Boot.mark(BOOT_BLE);
+            LOG_I(BLE, "Connected to BitsperBox via Bluetooth!");
         } else {
-            Serial.println("[BLE] Disconnected from BitsperBox (Bluetooth)");
+            LOG_W(BLE, "Disconnected from BitsperBox (Bluetooth)");
         }
-        updateConnectionStatus();
+        Events.signal(EVT_LINK_CHANGED);
     });
 
     // Register device with BitsperBox
@@ -282,19 +641,44 @@ void startBLEClient() {
     BleClient.startScan();
 }
 
+void startRealtimeClient() {
+    const DeviceConfig& deviceConfig = Storage.getConfig();
+    LOG_I(STATE, "Starting Supabase Realtime client (direct mode)");
+
+    // Notifications go straight to the event bus (see transport.h)
+
+    // "WiFi" on the idle screen means alerts can arrive, i.e. joined
+    Realtime.onConnectionChange([](bool connected) {
+        wifiConnected = connected;
+        if (connected) {
+            Boot.mark(BOOT_WS);
+            LOG_I(RT, "Subscribed to Supabase Realtime!");
+        } else {
+            LOG_W(RT, "Lost Supabase Realtime subscription");
+        }
+        Events.signal(EVT_LINK_CHANGED);
+    });
+
+    Realtime.begin(deviceConfig.supabase_url, deviceConfig.supabase_key, deviceConfig.restaurant_id);
+}
+
 void enterConnectedMode() {
-    Serial.println("[STATE] Entering Connected Mode");
+    const DeviceConfig& deviceConfig = Storage.getConfig();
+    LOG_I(STATE, "Entering Connected Mode");
     currentState = STATE_CONNECTED;
 
-    delay(2000);  // Show connected screen briefly
-
     // Determine connection modes from config
+    // Direct mode talks to Supabase over WiFi; there is no box to reach over BLE
     const char* connMode = deviceConfig.connection_mode;
-    useWiFi = (strcmp(connMode, "wifi") == 0 || strcmp(connMode, "both") == 0);
-    useBLE = (strcmp(connMode, "ble") == 0 || strcmp(connMode, "both") == 0);
+    directMode = strcmp(deviceConfig.mode, "direct") == 0;
+    useWiFi = directMode || strcmp(connMode, "wifi") == 0 || strcmp(connMode, "both") == 0;
+    useBLE = !directMode && (strcmp(connMode, "ble") == 0 || strcmp(connMode, "both") == 0);
+
+    LOG_I(STATE, "Connection mode: %s (WiFi: %s, BLE: %s)",
+          connMode, useWiFi ? "YES" : "NO", useBLE ? "YES" : "NO");
 
-    Serial.printf("[STATE] Connection mode: %s (WiFi: %s, BLE: %s)\n",
-                  connMode, useWiFi ? "YES" : "NO", useBLE ? "YES" : "NO");
+    // BLE carries alerts until the WebSocket proves healthy
+    Transports.begin(useWiFi, useBLE, directMode);
 
     // Start connection clients based on mode
     if (strcmp(deviceConfig.mode, "bitsperbox") == 0) {
@@ -304,13 +688,38 @@ void enterConnectedMode() {
         if (useBLE) {
             startBLEClient();
         }
+    } else if (directMode) {
+        startRealtimeClient();
     } else {
-        // Direct mode - TODO: Implement Supabase client
-        Serial.println("[STATE] Direct mode not yet implemented");
+        LOG_W(STATE, "Unknown mode '%s'", deviceConfig.mode);
     }
 
-    // Show idle screen with initial status
-    updateConnectionStatus();
+    // Leave the WiFi "connected" screen up briefly without blocking;
+    // the UI task switches to the idle screen when it expires
+    if (WifiMgr.isConnected()) {
+        showInfoScreen(INFO_CONNECTION, CONNECTED_SCREEN_TIME);
+    } else if (!useWiFi || useBLE) {
+        // WiFi-only keeps the "connecting" screen until it associates
+        updateConnectionStatus();
+    }
+
+    restoreNotifications();
+}
+
+void restoreNotifications() {
+    // Alerts still undismissed when we lost power come back first; the
+    // id cache keeps a box resend of the same alert from doubling up
+    NotifLog.restore([](NotificationData& notif) {
+        RecentIds.checkAndRemember(notif);
+        NotifQueue.push(notif);
+    });
+
+    // Restored entries may have merged in the queue
+    NotifLog.sync(NotifQueue);
+
+    if (!NotifQueue.isEmpty()) {
+        showQueueHead();
+    }
 }
 
 // ============================================
@@ -320,7 +729,9 @@ void enterConnectedMode() {
 void setup() {
     // Initialize Serial
     Serial.begin(115200);
-    delay(1000);
+#if !FAST_BOOT
+    delay(1000);  // Give the USB CDC monitor time to attach
+#endif
 
     Serial.println();
     Serial.println("========================================");
@@ -328,15 +739,38 @@ void setup() {
     Serial.println("   Firmware v" FIRMWARE_VERSION);
     Serial.println("========================================");
 
+    // Everything below logs through the ring; drained by a low-priority task
+    Log.begin();
+
     // Initialize display first for visual feedback
-    Serial.println("[INIT] Initializing display...");
+    LOG_I(INIT, "Initializing display...");
     Display.begin();
     Display.showSplash();
+    Boot.mark(BOOT_DISPLAY);
+
+    // Status LED (RMT) and backlight fades; needs the backlight channel
+    Effects.begin();
 
     // Initialize storage
-    Serial.println("[INIT] Initializing storage...");
+    LOG_I(INIT, "Initializing storage...");
     Storage.begin();
 
+    // Task communication must exist before any client callback can fire
+    Events.begin();
+
+#if BENCHMARK_BUILD
+    // Benchmark firmware: measure the hot paths, then stay parked
+    // (loop() sleeps outside AP mode)
+    Bench.run();
+    return;
+#endif
+
+    // Undismissed alerts from before the last reset
+    NotifLog.begin();
+
+    // New image on probation? (the bootloader rolls back if it resets first)
+    Ota.begin();
+
     // Initialize buttons
     setupButtons();
 
@@ -344,99 +778,89 @@ void setup() {
     WifiMgr.begin();
 
     // Print device info
-    Serial.printf("[INFO] Device ID: %s\n", Storage.getDeviceId().c_str());
-    Serial.printf("[INFO] Chip: %s Rev %d\n", ESP.getChipModel(), ESP.getChipRevision());
-    Serial.printf("[INFO] Flash: %d MB\n", ESP.getFlashChipSize() / 1024 / 1024);
-    Serial.printf("[INFO] Free heap: %d bytes\n", ESP.getFreeHeap());
+    LOG_I(INFO, "Device ID: %s", Storage.getDeviceId().c_str());
+    LOG_I(INFO, "Chip: %s Rev %d", ESP.getChipModel(), ESP.getChipRevision());
+    LOG_I(INFO, "Flash: %d MB", ESP.getFlashChipSize() / 1024 / 1024);
+    LOG_I(INFO, "Free heap: %d bytes", ESP.getFreeHeap());
 
-    delay(1500);
+#if !FAST_BOOT
+    delay(1500);  // Leave the splash up
+#endif
 
-    // Check if configured
+    // Config was read once by Storage.begin()
+    const DeviceConfig& deviceConfig = Storage.getConfig();
     if (Storage.isConfigured()) {
-        Serial.println("[INIT] Configuration found, loading...");
-
-        if (Storage.loadConfig(deviceConfig)) {
-            Serial.printf("[INIT] Mode: %s\n", deviceConfig.mode);
-            Serial.printf("[INIT] Connection: %s\n", deviceConfig.connection_mode);
-            Serial.printf("[INIT] BitsperBox IP: %s:%d\n",
-                          deviceConfig.bitsperbox_ip, deviceConfig.bitsperbox_port);
-
-            // Determine connection modes
-            const char* connMode = deviceConfig.connection_mode;
-            bool needWiFi = (strcmp(connMode, "wifi") == 0 || strcmp(connMode, "both") == 0);
-            bool needBLE = (strcmp(connMode, "ble") == 0 || strcmp(connMode, "both") == 0);
-
-            // Try to connect to WiFi if needed
-            currentState = STATE_CONNECTING;
-            bool wifiOk = false;
-
-            if (needWiFi) {
-                wifiOk = WifiMgr.connect(deviceConfig.wifi_ssid, deviceConfig.wifi_password);
-                if (!wifiOk) {
-                    Serial.println("[INIT] WiFi connection failed");
-                }
-            }
-
-            // If WiFi is not required, or WiFi succeeded, or BLE is available as fallback
-            if (wifiOk || needBLE || !needWiFi) {
-                enterConnectedMode();
-            } else {
-                Serial.println("[INIT] No connection method available, entering AP mode");
+        Boot.mark(BOOT_CONFIG);
+        LOG_I(INIT, "Mode: %s", deviceConfig.mode);
+        LOG_I(INIT, "Connection: %s", deviceConfig.connection_mode);
+        LOG_I(INIT, "BitsperBox IP: %s:%d",
+              deviceConfig.bitsperbox_ip, deviceConfig.bitsperbox_port);
+
+        // Radio sleep / TX power must be set before associating
+        Power.begin(deviceConfig.power_profile);
+
+        // Declared on register; also checked on every alert
+        Subscription.load(deviceConfig);
+
+        // Determine connection modes
+        const char* connMode = deviceConfig.connection_mode;
+        bool direct = strcmp(deviceConfig.mode, "direct") == 0;
+        bool needWiFi = direct || strcmp(connMode, "wifi") == 0 || strcmp(connMode, "both") == 0;
+        bool needBLE = !direct && (strcmp(connMode, "ble") == 0 || strcmp(connMode, "both") == 0);
+
+        currentState = STATE_CONNECTING;
+
+        // WiFi associates in the background while BLE starts, so a
+        // "both" device is usable over BLE right away
+        if (needWiFi) {
+            WifiMgr.setConnectionCallback([](bool connected) {
+                if (!connected) return;
+                Boot.mark(BOOT_WIFI);
+                Events.signal(EVT_WIFI_UP);
+            });
+            WifiMgr.setConnectFailedCallback([]() {
+                Events.signal(EVT_WIFI_FAILED);
+            });
+
+            Display.showConnecting(deviceConfig.wifi_ssid);
+            if (!WifiMgr.connect(deviceConfig.wifi_ssid, deviceConfig.wifi_password) && !needBLE) {
+                LOG_I(INIT, "No connection method available, entering AP mode");
                 enterAPMode();
             }
-        } else {
-            enterAPMode();
+        }
+
+        if (currentState == STATE_CONNECTING) {
+            enterConnectedMode();
         }
     } else {
-        Serial.println("[INIT] No configuration, entering AP mode");
+        LOG_I(INIT, "No configuration, entering AP mode");
         enterAPMode();
     }
 
-    Serial.println("[INIT] Setup complete!");
+    loopTaskHandle = xTaskGetCurrentTaskHandle();
+    startTasks();
+    Boot.mark(BOOT_TASKS);
+
+    LOG_I(INIT, "Setup complete!");
 }
 
 void loop() {
+    // Connected mode runs entirely in its own tasks; stay parked unless
+    // the UI task falls back to the captive portal
+    if (currentState != STATE_AP_MODE) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        return;
+    }
+
     // Handle scheduled restart
     if (shouldRestart && millis() > restartTime) {
-        Serial.println("[SYSTEM] Restarting...");
+        LOG_I(SYSTEM, "Restarting...");
+        Log.flush();
         ESP.restart();
     }
 
-    // Handle buttons
-    handleButtons();
-
-    // State-specific updates
-    switch (currentState) {
-        case STATE_AP_MODE:
-            Portal.handleClient();
-            break;
-
-        case STATE_CONNECTED:
-            // WiFi connection monitoring with auto-reconnect
-            if (useWiFi) {
-                WifiMgr.loop();
-            }
-
-            // WebSocket client loop (for BitsperBox mode via WiFi)
-            if (strcmp(deviceConfig.mode, "bitsperbox") == 0) {
-                if (useWiFi) {
-                    WsClient.loop();
-                }
-                if (useBLE) {
-                    BleClient.loop();
-                }
-            }
-
-            // Update notification blinking
-            updateNotificationBlink();
-            break;
-
-        default:
-            break;
-    }
-
-    // Update display animations
-    Display.update();
+    // Captive portal (WebServer is poll-driven)
+    Portal.handleClient();
 
     delay(10);
 }
@@ -0,0 +1,150 @@
+#include "metrics.h"
+#include "debug_log.h"
+#include "config.h"
+#include "storage.h"
+#include "app_events.h"
+#include "notification_queue.h"
+#include "recent_ids.h"
+#include "sequence_tracker.h"
+#include "websocket_client.h"
+#include "ble_client.h"
+#include "realtime_client.h"
+#include "transport_manager.h"
+
+MetricsRegistry Metrics;
+
+// JSON keys, indexed by MetricLoop
+static const char* LOOP_NAMES[LOOP_COUNT] = { "input", "ui", "wifi", "ws", "rt", "xport", "ble" };
+
+uint32_t MetricsRegistry::lap(MetricLoop loop, uint32_t startUs) {
+    uint32_t now = micros();
+    uint32_t us = now - startUs;
+
+    // Only the owning task writes this entry; readers accept a torn read
+    LoopStat& stat = _loops[loop];
+    if (stat.count == 0) {
+        stat.avgUs = us;
+    } else {
+        stat.avgUs += ((int32_t)us - (int32_t)stat.avgUs) >> METRICS_AVG_SHIFT;
+    }
+    if (us > stat.maxUs) {
+        stat.maxUs = us;
+    }
+    stat.count++;
+    return now;
+}
+
+void MetricsRegistry::count(MetricCounter counter) {
+    portENTER_CRITICAL(&_mux);
+    _counters[counter]++;
+    portEXIT_CRITICAL(&_mux);
+}
+
+uint32_t MetricsRegistry::get(MetricCounter counter) {
+    return _counters[counter];
+}
+
+LoopStat MetricsRegistry::getLoop(MetricLoop loop) {
+    return _loops[loop];
+}
+
+void MetricsRegistry::writeJson(JsonObject out) {
+    // [free, minimum ever, largest free block]
+    JsonArray heap = out["heap"].to<JsonArray>();
+    heap.add(ESP.getFreeHeap());
+    heap.add(ESP.getMinFreeHeap());
+    heap.add(ESP.getMaxAllocHeap());
+
+    // name: [avg us, max us]
+    JsonObject loops = out["loop"].to<JsonObject>();
+    for (uint8_t i = 0; i < LOOP_COUNT; i++) {
+        if (_loops[i].count == 0) continue;
+        JsonArray entry = loops[LOOP_NAMES[i]].to<JsonArray>();
+        entry.add(_loops[i].avgUs);
+        entry.add(_loops[i].maxUs);
+    }
+
+    // [ws, ble, realtime]
+    JsonArray rx = out["rx"].to<JsonArray>();
+    rx.add(_counters[METRIC_RX_WS]);
+    rx.add(_counters[METRIC_RX_BLE]);
+    rx.add(_counters[METRIC_RX_REALTIME]);
+
+    out["shown"] = _counters[METRIC_DISPLAYED];
+    out["dup"] = RecentIds.getDuplicateCount();
+
+    // [inbox full, queue full, acks]
+    JsonArray drop = out["drop"].to<JsonArray>();
+    drop.add(Events.getInboxDropped());
+    drop.add(NotifQueue.getDroppedCount());
+    drop.add(WsClient.getAcksDropped() + BleClient.getAcksDropped() + Realtime.getAcksDropped());
+
+    // [json parse, binary decode, BLE frames lost in reassembly]
+    JsonArray err = out["err"].to<JsonArray>();
+    err.add(_counters[METRIC_JSON_ERRORS]);
+    err.add(WsClient.getDecodeErrors() + BleClient.getDecodeErrors() + Realtime.getDecodeErrors());
+    err.add(BleClient.getFramesDropped());
+
+    // [ws, ble, realtime]
+    JsonArray rc = out["rc"].to<JsonArray>();
+    rc.add(_counters[METRIC_WS_RECONNECTS]);
+    rc.add(_counters[METRIC_BLE_RECONNECTS]);
+    rc.add(_counters[METRIC_RT_RECONNECTS]);
+
+    // [resync requests, sequence numbers given up on]
+    JsonArray seq = out["seq"].to<JsonArray>();
+    seq.add(Sequences.getResyncs());
+    seq.add(Sequences.getLost());
+}
+
+// ============================================
+// HTTP Endpoint
+// ============================================
+
+void MetricsRegistry::beginHttp() {
+    if (_server) return;
+
+    _server = new WebServer(METRICS_HTTP_PORT);
+    _server->on("/metrics", HTTP_GET, [this]() { handleMetrics(); });
+    _server->begin();
+
+    LOG_I(METRICS, "Serving /metrics on port %d", METRICS_HTTP_PORT);
+}
+
+void MetricsRegistry::handleHttp() {
+    if (_server) {
+        _server->handleClient();
+    }
+}
+
+void MetricsRegistry::endHttp() {
+    if (!_server) return;
+
+    _server->stop();
+    delete _server;
+    _server = nullptr;
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void MetricsRegistry::handleMetrics() {
+    _doc.clear();
+    _arena.reset();
+
+    _doc["device_id"] = Storage.getDeviceId().c_str();
+    _doc["firmware"] = FIRMWARE_VERSION;
+    _doc["uptime"] = millis() / 1000;
+    _doc["rssi"] = WiFi.RSSI();
+    writeJson(_doc["metrics"].to<JsonObject>());
+    Transports.writeJson(_doc["transport"].to<JsonObject>());
+
+    if (_doc.overflowed() || measureJson(_doc) >= sizeof(_buffer)) {
+        _server->send(500, "text/plain", "metrics too large");
+        return;
+    }
+
+    serializeJson(_doc, _buffer, sizeof(_buffer));
+    _server->send(200, "application/json", _buffer);
+}
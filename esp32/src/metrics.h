@@ -0,0 +1,89 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <WebServer.h>
+#include <freertos/FreeRTOS.h>
+#include "json_arena.h"
+
+// ============================================
+// Runtime Metrics
+// Loop time per subsystem, heap low-water mark and the counters a
+// fleet dashboard needs to spot a degraded watch: reconnects, parse
+// failures, BLE frames lost, notifications received / shown / dropped.
+// Exported compactly in the WebSocket heartbeat and as JSON on
+// http://<watch>:8080/metrics while connected to WiFi (port 80 is the
+// captive portal's, which can start while this server is still up).
+// ============================================
+
+#define METRICS_HTTP_PORT     8080
+#define METRICS_ARENA_SIZE    2048
+#define METRICS_BUFFER_SIZE   1536
+#define METRICS_AVG_SHIFT     4       // Loop average is an EMA over ~2^4 iterations
+
+// Instrumented loops (each written by one task only)
+enum MetricLoop : uint8_t {
+    LOOP_INPUT,      // Button edge handling
+    LOOP_UI,         // UI events, timers and display commits
+    LOOP_WIFI,       // WifiMgr.loop()
+    LOOP_WS,         // WsClient.loop()
+    LOOP_REALTIME,   // Realtime.loop() (direct mode)
+    LOOP_TRANSPORT,  // Transports.loop()
+    LOOP_BLE,        // BleClient.loop()
+    LOOP_COUNT
+};
+
+// Counters bumped where the event happens (any task)
+enum MetricCounter : uint8_t {
+    METRIC_RX_WS,             // Notifications into the inbox, per source
+    METRIC_RX_BLE,            //   (same order as NotificationSource)
+    METRIC_RX_REALTIME,
+    METRIC_DISPLAYED,         // Took the screen
+    METRIC_JSON_ERRORS,       // Frames that failed to parse (any transport)
+    METRIC_WS_RECONNECTS,     // Link lost, reconnect to follow
+    METRIC_BLE_RECONNECTS,
+    METRIC_RT_RECONNECTS,
+    METRIC_COUNTER_COUNT
+};
+
+struct LoopStat {
+    uint32_t count;
+    uint32_t avgUs;           // Exponential moving average
+    uint32_t maxUs;           // Since boot
+};
+
+class MetricsRegistry {
+public:
+    // Record the section that started at `startUs`; returns micros() so
+    // consecutive sections chain: t = Metrics.lap(LOOP_WIFI, t);
+    uint32_t lap(MetricLoop loop, uint32_t startUs);
+    void count(MetricCounter counter);
+
+    uint32_t get(MetricCounter counter);
+    LoopStat getLoop(MetricLoop loop);
+
+    // Compact form (heartbeat): arrays, loops that ran only
+    void writeJson(JsonObject out);
+
+    // /metrics endpoint (network task, STA mode only)
+    void beginHttp();             // Once WiFi is up; no-op if already serving
+    void handleHttp();
+    void endHttp();               // Leaving STA mode
+
+private:
+    LoopStat _loops[LOOP_COUNT] = {};
+    uint32_t _counters[METRIC_COUNTER_COUNT] = {};
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    WebServer* _server = nullptr;
+    StaticJsonArena<METRICS_ARENA_SIZE> _arena;
+    JsonDocument _doc{&_arena};
+    char _buffer[METRICS_BUFFER_SIZE];
+
+    void handleMetrics();
+};
+
+extern MetricsRegistry Metrics;
+
+#endif // METRICS_H
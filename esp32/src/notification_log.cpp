@@ -0,0 +1,300 @@
+#include "notification_log.h"
+#include "debug_log.h"
+#include <esp_rom_crc.h>
+#include <stddef.h>
+
+NotificationLog NotifLog;
+
+static_assert(sizeof(LogRecord) <= LOG_RECORD_SIZE, "LogRecord must fit one slot");
+static_assert(LOG_SECTOR_SIZE % LOG_RECORD_SIZE == 0, "Slots must not straddle sectors");
+
+static const uint32_t FNV_OFFSET = 2166136261UL;
+static const uint32_t FNV_PRIME = 16777619UL;
+
+void NotificationLog::begin() {
+    _partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                          (esp_partition_subtype_t)LOG_PARTITION_SUBTYPE,
+                                          LOG_PARTITION_LABEL);
+    if (_partition == nullptr) {
+        LOG_W(LOG, "No '" LOG_PARTITION_LABEL "' partition - notifications won't persist");
+        return;
+    }
+
+    _slots = min((uint32_t)LOG_MAX_SLOTS, (uint32_t)(_partition->size / LOG_RECORD_SIZE));
+    _slots -= _slots % LOG_SLOTS_PER_SECTOR;
+
+    // The head follows the newest valid record
+    uint32_t maxSeq = 0;
+    int newest = -1;
+    LogRecord record;
+    for (uint16_t slot = 0; slot < _slots; slot++) {
+        if (readRecord(slot, record) && record.seq > maxSeq) {
+            maxSeq = record.seq;
+            newest = slot;
+        }
+    }
+
+    _nextSeq = maxSeq + 1;
+    _head = newest >= 0 ? (newest + 1) % _slots : 0;
+
+    // A torn write (brownout) leaves a non-blank slot mid-sector; start
+    // the next sector instead of writing over it
+    if (_head % LOG_SLOTS_PER_SECTOR != 0 && !slotIsBlank(_head)) {
+        _head = ((_head / LOG_SLOTS_PER_SECTOR + 1) * LOG_SLOTS_PER_SECTOR) % _slots;
+    }
+
+    _ops = xQueueCreate(LOG_QUEUE_DEPTH, sizeof(LogOp));
+    xTaskCreate(writerTask, "notiflog", LOG_TASK_STACK, this, LOG_TASK_PRIORITY, nullptr);
+
+    LOG_I(LOG, "Notification log: %d slots, head %d, next seq %lu",
+          _slots, _head, (unsigned long)_nextSeq);
+}
+
+bool NotificationLog::isAvailable() {
+    return _partition != nullptr && _ops != nullptr;
+}
+
+// ============================================
+// Boot Replay
+// ============================================
+
+int NotificationLog::restore(std::function<void(NotificationData&)> callback) {
+    if (!isAvailable()) return 0;
+
+    struct Pending {
+        uint32_t seq;
+        uint16_t slot;
+    };
+    Pending pending[LOG_MAX_SLOTS];
+    uint16_t count = 0;
+
+    LogRecord record;
+    for (uint16_t slot = 0; slot < _slots; slot++) {
+        if (readRecord(slot, record) && record.ackMark == LOG_ACK_PENDING) {
+            // Insertion sort by seq so alerts come back in arrival order
+            uint16_t pos = count++;
+            while (pos > 0 && pending[pos - 1].seq > record.seq) {
+                pending[pos] = pending[pos - 1];
+                pos--;
+            }
+            pending[pos] = { record.seq, slot };
+        }
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (!readRecord(pending[i].slot, record)) continue;
+
+        // Latency stamps belong to the previous boot
+        record.data.rxUs = 0;
+        record.data.parsedUs = 0;
+
+        track(record, pending[i].slot);
+        callback(record.data);
+    }
+
+    if (count > 0) {
+        LOG_I(LOG, "Restored %d undismissed notifications", count);
+    }
+    return count;
+}
+
+// ============================================
+// Producers (UI task)
+// ============================================
+
+void NotificationLog::append(const NotificationData& notif) {
+    if (!isAvailable()) return;
+
+    LogOp op;
+    memset(&op, 0, sizeof(op));
+    op.kind = LOG_OP_WRITE;
+    op.slot = _head;
+    op.seq = _nextSeq;
+
+    LogRecord& record = op.record;
+    record.magic = LOG_MAGIC;
+    record.seq = _nextSeq++;
+    record.key = keyFor(notif.table, notif.type);
+    record.data = notif;
+    record.crc = checksum(record);
+    record.ackMark = LOG_ACK_PENDING;
+
+    _head = (_head + 1) % _slots;
+
+    if (post(op)) {
+        track(record, op.slot);
+    }
+}
+
+void NotificationLog::sync(NotificationQueue& queue) {
+    if (!isAvailable()) return;
+
+    // Dismissed, auto-dismissed or evicted: no longer worth restoring
+    for (int i = _liveCount - 1; i >= 0; i--) {
+        if (!queue.contains(_live[i].table, _live[i].type)) {
+            acknowledgeAt(i);
+        }
+    }
+}
+
+void NotificationLog::track(const LogRecord& record, uint16_t slot) {
+    // A newer record for the same table+type supersedes the older one
+    // (the queue merged them)
+    for (int i = _liveCount - 1; i >= 0; i--) {
+        if (_live[i].key == record.key) {
+            acknowledgeAt(i);
+        }
+    }
+
+    if (_liveCount >= LOG_LIVE_MAX) {
+        acknowledgeAt(0);
+    }
+
+    LiveRecord& live = _live[_liveCount++];
+    live.key = record.key;
+    live.seq = record.seq;
+    live.slot = slot;
+    strncpy(live.table, record.data.table, sizeof(live.table) - 1);
+    live.table[sizeof(live.table) - 1] = '\0';
+    strncpy(live.type, record.data.type, sizeof(live.type) - 1);
+    live.type[sizeof(live.type) - 1] = '\0';
+}
+
+void NotificationLog::acknowledgeAt(uint8_t liveIndex) {
+    LogOp op;
+    op.kind = LOG_OP_ACK;
+    op.slot = _live[liveIndex].slot;
+    op.seq = _live[liveIndex].seq;
+    post(op);
+
+    for (uint8_t i = liveIndex; i + 1 < _liveCount; i++) {
+        _live[i] = _live[i + 1];
+    }
+    _liveCount--;
+}
+
+bool NotificationLog::post(const LogOp& op) {
+    // Never wait on the writer: a lost write only means one alert
+    // won't come back after a reboot
+    if (xQueueSend(_ops, &op, 0) != pdTRUE) {
+        _droppedWrites++;
+        LOG_W(LOG, "Write queue full, dropped (%lu dropped)", _droppedWrites);
+        return false;
+    }
+    return true;
+}
+
+// ============================================
+// Writer Task
+// ============================================
+
+void NotificationLog::writerTask(void* param) {
+    NotificationLog* log = static_cast<NotificationLog*>(param);
+    LogOp op;
+
+    for (;;) {
+        if (xQueueReceive(log->_ops, &op, portMAX_DELAY) == pdTRUE) {
+            log->processOp(op);
+        }
+    }
+}
+
+void NotificationLog::processOp(const LogOp& op) {
+    size_t offset = (size_t)op.slot * LOG_RECORD_SIZE;
+
+    if (op.kind == LOG_OP_ACK) {
+        // The sector may have been recycled since; never mark a newer
+        // record (or a blank slot) as dismissed
+        uint32_t header[2];
+        esp_partition_read(_partition, offset, header, sizeof(header));
+        if (header[0] != LOG_MAGIC || header[1] != op.seq) return;
+
+        uint32_t done = LOG_ACK_DONE;
+        esp_partition_write(_partition, offset + offsetof(LogRecord, ackMark), &done, sizeof(done));
+        return;
+    }
+
+    uint16_t sector = op.slot / LOG_SLOTS_PER_SECTOR;
+    bool firstInSector = op.slot % LOG_SLOTS_PER_SECTOR == 0;
+
+    if (firstInSector) {
+        ensureErased(sector);
+    }
+
+    esp_err_t err = esp_partition_write(_partition, offset, &op.record, sizeof(LogRecord));
+    if (err != ESP_OK) {
+        LOG_E(LOG, "Write failed at slot %d: %s", op.slot, esp_err_to_name(err));
+    }
+
+    // Erase the next sector now, while the current one still has room,
+    // so a burst of alerts never waits on an erase cycle
+    if (firstInSector) {
+        ensureErased((sector + 1) % (_slots / LOG_SLOTS_PER_SECTOR));
+    }
+}
+
+void NotificationLog::ensureErased(uint16_t sector) {
+    if (_erasedSector == sector) return;
+
+    esp_partition_erase_range(_partition, (size_t)sector * LOG_SECTOR_SIZE, LOG_SECTOR_SIZE);
+    _erasedSector = sector;
+}
+
+// ============================================
+// Maintenance
+// ============================================
+
+void NotificationLog::clear() {
+    if (_partition == nullptr) return;
+
+    esp_partition_erase_range(_partition, 0, _partition->size);
+    _head = 0;
+    _nextSeq = 1;
+    _liveCount = 0;
+    _erasedSector = -1;
+    LOG_I(LOG, "Notification log erased");
+}
+
+uint16_t NotificationLog::getPendingCount() {
+    return _liveCount;
+}
+
+unsigned long NotificationLog::getDroppedWrites() {
+    return _droppedWrites;
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+bool NotificationLog::readRecord(uint16_t slot, LogRecord& record) {
+    if (esp_partition_read(_partition, (size_t)slot * LOG_RECORD_SIZE,
+                           &record, sizeof(LogRecord)) != ESP_OK) {
+        return false;
+    }
+    return record.magic == LOG_MAGIC && record.crc == checksum(record);
+}
+
+bool NotificationLog::slotIsBlank(uint16_t slot) {
+    uint32_t words[4];
+    if (esp_partition_read(_partition, (size_t)slot * LOG_RECORD_SIZE,
+                           words, sizeof(words)) != ESP_OK) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        if (words[i] != 0xFFFFFFFFUL) return false;
+    }
+    return true;
+}
+
+uint32_t NotificationLog::keyFor(const char* table, const char* type) {
+    uint32_t hash = FNV_OFFSET;
+    for (const char* p = table; *p; p++) hash = (hash ^ (uint8_t)*p) * FNV_PRIME;
+    hash = (hash ^ '|') * FNV_PRIME;
+    for (const char* p = type; *p; p++) hash = (hash ^ (uint8_t)*p) * FNV_PRIME;
+    return hash;
+}
+
+uint32_t NotificationLog::checksum(const LogRecord& record) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&record, offsetof(LogRecord, crc));
+}
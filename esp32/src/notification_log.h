@@ -0,0 +1,108 @@
+#ifndef NOTIFICATION_LOG_H
+#define NOTIFICATION_LOG_H
+
+#include <Arduino.h>
+#include <functional>
+#include <esp_partition.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "notification_queue.h"
+
+// ============================================
+// Persistent Notification Log
+// Append-only ring of fixed-size records in the "notiflog" flash
+// partition. A record is dismissed by clearing its ack word in place
+// (1 -> 0 needs no erase), so the only erases are one sector per
+// LOG_SLOTS_PER_SECTOR alerts, done ahead of time by the writer task.
+// Pending records are replayed into the queue on boot.
+// ============================================
+
+#define LOG_PARTITION_LABEL   "notiflog"
+#define LOG_PARTITION_SUBTYPE 0x40        // Custom data subtype (partitions.csv)
+#define LOG_RECORD_SIZE       512
+#define LOG_SECTOR_SIZE       4096
+#define LOG_SLOTS_PER_SECTOR  (LOG_SECTOR_SIZE / LOG_RECORD_SIZE)
+#define LOG_MAX_SLOTS         128         // 64 KB partition
+#define LOG_LIVE_MAX          MAX_NOTIFICATIONS
+#define LOG_QUEUE_DEPTH       8           // Writes waiting for the writer task
+#define LOG_TASK_STACK        3072
+#define LOG_TASK_PRIORITY     1           // Below everything that matters
+
+#define LOG_MAGIC             0x4C474F4EUL  // "NOGL"
+#define LOG_ACK_PENDING       0xFFFFFFFFUL
+#define LOG_ACK_DONE          0x00000000UL
+
+struct LogRecord {
+    uint32_t magic;
+    uint32_t seq;              // Monotonic across the whole log
+    uint32_t key;              // table|type hash (the queue's merge key)
+    NotificationData data;
+    uint32_t crc;              // CRC32 of everything above
+    uint32_t ackMark;          // LOG_ACK_PENDING until dismissed
+};
+
+class NotificationLog {
+public:
+    // Scan the partition and start the writer task
+    void begin();
+    bool isAvailable();
+
+    // Replay pending records (oldest first) at boot
+    int restore(std::function<void(NotificationData&)> callback);
+
+    // UI task: never blocks on flash
+    void append(const NotificationData& notif);
+    void sync(NotificationQueue& queue);   // Ack records no longer queued
+
+    // Factory reset (blocking erase)
+    void clear();
+
+    uint16_t getPendingCount();
+    unsigned long getDroppedWrites();
+
+private:
+    enum LogOpKind : uint8_t { LOG_OP_WRITE, LOG_OP_ACK };
+
+    struct LogOp {
+        LogOpKind kind;
+        uint16_t slot;
+        uint32_t seq;          // Record expected in the slot
+        LogRecord record;      // LOG_OP_WRITE only
+    };
+
+    struct LiveRecord {
+        uint32_t key;
+        uint32_t seq;
+        uint16_t slot;
+        char table[16];
+        char type[32];
+    };
+
+    const esp_partition_t* _partition = nullptr;
+    QueueHandle_t _ops = nullptr;
+    uint16_t _slots = 0;
+    uint16_t _head = 0;          // Next slot to write
+    uint32_t _nextSeq = 1;
+    int16_t _erasedSector = -1;  // Writer: sector known to be blank
+    unsigned long _droppedWrites = 0;
+
+    LiveRecord _live[LOG_LIVE_MAX];
+    uint8_t _liveCount = 0;
+
+    static void writerTask(void* param);
+    void processOp(const LogOp& op);
+    void ensureErased(uint16_t sector);
+
+    bool readRecord(uint16_t slot, LogRecord& record);
+    bool slotIsBlank(uint16_t slot);
+    void track(const LogRecord& record, uint16_t slot);
+    void acknowledgeAt(uint8_t liveIndex);
+    bool post(const LogOp& op);
+
+    static uint32_t keyFor(const char* table, const char* type);
+    static uint32_t checksum(const LogRecord& record);
+};
+
+extern NotificationLog NotifLog;
+
+#endif // NOTIFICATION_LOG_H
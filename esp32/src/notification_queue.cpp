@@ -0,0 +1,188 @@
+#include "notification_queue.h"
+#include "debug_log.h"
+
+NotificationQueue NotifQueue;
+
+QueuePushResult NotificationQueue::push(const NotificationData& notif) {
+    uint8_t rank = priorityRank(notif.priority);
+
+    // De-duplicate by table+type: refresh the queued entry, keep its age
+    int dup = findDuplicate(notif);
+    if (dup >= 0) {
+        uint8_t slot = _order[dup];
+        QueuedNotification& entry = _slots[slot];
+
+        // The box tracks each id: keep the one being replaced
+        if (entry.data.id[0] != '\0' && strcmp(entry.data.id, notif.id) != 0) {
+            absorbId(entry, entry.data.id);
+        }
+
+        // Never demote an entry because a repeat came in lower
+        char priority[sizeof(entry.data.priority)];
+        memcpy(priority, entry.data.priority, sizeof(priority));
+        entry.data = notif;
+        entry.layout.valid = false;   // Message may have changed
+        if (rank < entry.rank) {
+            memcpy(entry.data.priority, priority, sizeof(priority));
+            rank = entry.rank;
+        }
+        entry.rank = rank;
+
+        removeAt(dup);
+        insertOrdered(slot);
+
+        LOG_D(QUEUE, "Merged duplicate: Table %s - %s (%d queued)",
+              notif.table, notif.type, _count);
+        return QUEUE_MERGED;
+    }
+
+    QueuePushResult result = QUEUE_ADDED;
+
+    if (_count >= MAX_NOTIFICATIONS) {
+        // Tail is the lowest-priority, newest entry
+        uint8_t tailSlot = _order[_count - 1];
+        if (_slots[tailSlot].rank >= rank) {
+            _dropped++;
+            LOG_W(QUEUE, "Full, dropped: Table %s - %s (%lu dropped)",
+                  notif.table, notif.type, _dropped);
+            return QUEUE_DROPPED;
+        }
+
+        LOG_W(QUEUE, "Full, evicting: Table %s - %s",
+              _slots[tailSlot].data.table, _slots[tailSlot].data.type);
+        _slots[tailSlot].seq = 0;
+        removeAt(_count - 1);
+        _dropped++;
+        result = QUEUE_EVICTED;
+    }
+
+    int slot = freeSlot();
+    QueuedNotification& entry = _slots[slot];
+    entry.data = notif;
+    entry.rank = rank;
+    entry.seq = _nextSeq++;
+    if (_nextSeq == 0) _nextSeq = 1;
+    entry.queuedAt = millis();
+    entry.layout.valid = false;
+    entry.absorbedCount = 0;
+
+    insertOrdered(slot);
+
+    LOG_D(QUEUE, "Queued: Table %s - %s (%s), %d queued",
+          notif.table, notif.type, notif.priority, _count);
+    return result;
+}
+
+const QueuedNotification* NotificationQueue::front() {
+    if (_count == 0) return nullptr;
+    return &_slots[_order[0]];
+}
+
+TextLayout* NotificationQueue::frontLayout() {
+    if (_count == 0) return nullptr;
+    return &_slots[_order[0]].layout;
+}
+
+bool NotificationQueue::pop() {
+    if (_count == 0) return false;
+
+    _slots[_order[0]].seq = 0;
+    removeAt(0);
+    return true;
+}
+
+void NotificationQueue::clear() {
+    for (uint8_t i = 0; i < MAX_NOTIFICATIONS; i++) {
+        _slots[i].seq = 0;
+    }
+    _count = 0;
+}
+
+bool NotificationQueue::contains(const char* table, const char* type) {
+    for (uint8_t i = 0; i < _count; i++) {
+        const NotificationData& queued = _slots[_order[i]].data;
+        if (strcmp(queued.table, table) == 0 && strcmp(queued.type, type) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t NotificationQueue::count() {
+    return _count;
+}
+
+bool NotificationQueue::isEmpty() {
+    return _count == 0;
+}
+
+unsigned long NotificationQueue::getDroppedCount() {
+    return _dropped;
+}
+
+uint8_t NotificationQueue::priorityRank(const char* priority) {
+    if (strcmp(priority, "urgent") == 0) return PRIORITY_URGENT;
+    if (strcmp(priority, "high") == 0) return PRIORITY_HIGH;
+    if (strcmp(priority, "low") == 0) return PRIORITY_LOW;
+    return PRIORITY_MEDIUM;
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+int NotificationQueue::findDuplicate(const NotificationData& notif) {
+    for (uint8_t i = 0; i < _count; i++) {
+        const NotificationData& queued = _slots[_order[i]].data;
+        if (strcmp(queued.table, notif.table) == 0 &&
+            strcmp(queued.type, notif.type) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int NotificationQueue::freeSlot() {
+    for (uint8_t i = 0; i < MAX_NOTIFICATIONS; i++) {
+        if (_slots[i].seq == 0) return i;
+    }
+    return 0;  // Unreachable while _count < MAX_NOTIFICATIONS
+}
+
+void NotificationQueue::removeAt(uint8_t pos) {
+    for (uint8_t i = pos; i + 1 < _count; i++) {
+        _order[i] = _order[i + 1];
+    }
+    _count--;
+}
+
+void NotificationQueue::insertOrdered(uint8_t slot) {
+    uint8_t pos = _count;
+    while (pos > 0 && ranksBefore(slot, _order[pos - 1])) {
+        _order[pos] = _order[pos - 1];
+        pos--;
+    }
+    _order[pos] = slot;
+    _count++;
+}
+
+bool NotificationQueue::ranksBefore(uint8_t a, uint8_t b) {
+    if (_slots[a].rank != _slots[b].rank) return _slots[a].rank > _slots[b].rank;
+    return _slots[a].seq < _slots[b].seq;
+}
+
+void NotificationQueue::absorbId(QueuedNotification& entry, const char* id) {
+    const size_t idSize = sizeof(entry.absorbed[0]);
+
+    // Full: the oldest id goes without a dismiss ack
+    if (entry.absorbedCount >= QUEUE_ABSORBED_IDS) {
+        LOG_W(QUEUE, "Table %s - %s merged too often, id %s not tracked",
+              entry.data.table, entry.data.type, entry.absorbed[0]);
+        memmove(entry.absorbed[0], entry.absorbed[1], (QUEUE_ABSORBED_IDS - 1) * idSize);
+        entry.absorbedCount--;
+    }
+
+    strncpy(entry.absorbed[entry.absorbedCount], id, idSize - 1);
+    entry.absorbed[entry.absorbedCount][idSize - 1] = '\0';
+    entry.absorbedCount++;
+}
@@ -0,0 +1,91 @@
+#ifndef NOTIFICATION_QUEUE_H
+#define NOTIFICATION_QUEUE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "text_layout.h"
+
+// ============================================
+// Notification Queue
+// Fixed-capacity, allocation-free priority queue.
+// Ordered by priority (urgent > high > medium > low), then by age.
+// ============================================
+
+struct NotificationData {
+    char id[48];
+    char table[16];
+    char type[32];
+    char message[256];
+    char priority[16];
+    uint64_t timestamp;       // ms since epoch from the box, 0 if it sent none
+    uint32_t rxUs;            // micros() when the frame reached the transport
+    uint32_t parsedUs;        // micros() when decoding finished
+};
+
+enum NotificationPriority : uint8_t {
+    PRIORITY_LOW,
+    PRIORITY_MEDIUM,
+    PRIORITY_HIGH,
+    PRIORITY_URGENT
+};
+
+enum QueuePushResult {
+    QUEUE_ADDED,     // New entry
+    QUEUE_MERGED,    // Same table+type already queued - entry refreshed
+    QUEUE_EVICTED,   // Queue full - lowest-priority entry replaced
+    QUEUE_DROPPED    // Queue full and nothing ranked below it
+};
+
+#define QUEUE_ABSORBED_IDS 4   // Earlier ids a merged entry keeps for the box's dismiss acks
+
+struct QueuedNotification {
+    NotificationData data;
+    uint32_t seq;              // Arrival order, never 0 for a live entry
+    unsigned long queuedAt;    // millis() when first queued
+    uint8_t rank;              // NotificationPriority
+    TextLayout layout;         // Filled by the display the first time it's shown
+
+    // Ids of the repeats merged into this entry before data.id, oldest first
+    char absorbed[QUEUE_ABSORBED_IDS][sizeof(NotificationData::id)];
+    uint8_t absorbedCount;
+};
+
+class NotificationQueue {
+public:
+    QueuePushResult push(const NotificationData& notif);
+
+    // Head of the queue (highest priority, oldest), nullptr when empty
+    const QueuedNotification* front();
+
+    // The head's cached layout (UI task; the display fills it in)
+    TextLayout* frontLayout();
+
+    // Dismiss the head; returns false if the queue was empty
+    bool pop();
+
+    void clear();
+    bool contains(const char* table, const char* type);
+    uint8_t count();
+    bool isEmpty();
+    unsigned long getDroppedCount();
+
+    static uint8_t priorityRank(const char* priority);
+
+private:
+    QueuedNotification _slots[MAX_NOTIFICATIONS];
+    uint8_t _order[MAX_NOTIFICATIONS];   // Slot indices, head first
+    uint8_t _count = 0;
+    uint32_t _nextSeq = 1;
+    unsigned long _dropped = 0;
+
+    int findDuplicate(const NotificationData& notif);
+    int freeSlot();
+    void removeAt(uint8_t pos);
+    void insertOrdered(uint8_t slot);
+    bool ranksBefore(uint8_t a, uint8_t b);
+    static void absorbId(QueuedNotification& entry, const char* id);
+};
+
+extern NotificationQueue NotifQueue;
+
+#endif // NOTIFICATION_QUEUE_H
@@ -0,0 +1,389 @@
+#include "ota_updater.h"
+#include "config.h"
+#include "debug_log.h"
+#include "notification_queue.h"
+
+OtaUpdater Ota;
+
+// The core marks a freshly updated image valid before setup() unless
+// told otherwise; we only keep it once it has proved itself (loop())
+extern "C" bool verifyRollbackLater() {
+    return true;
+}
+
+void OtaUpdater::begin() {
+    _target = esp_ota_get_next_update_partition(nullptr);
+
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    esp_ota_img_states_t state;
+    _pendingVerify = esp_ota_get_state_partition(running, &state) == ESP_OK &&
+                     state == ESP_OTA_IMG_PENDING_VERIFY;
+    _rolledBack = esp_ota_get_last_invalid_partition() != nullptr;
+
+    if (_pendingVerify) {
+        LOG_W(OTA, "Firmware " FIRMWARE_VERSION " on probation in %s until it reaches the box",
+              running->label);
+    }
+    if (_rolledBack) {
+        LOG_W(OTA, "Last update didn't boot, back on %s", running->label);
+    }
+    if (_target == nullptr) {
+        LOG_W(OTA, "No second app slot (old partition table) - updates need USB");
+    }
+}
+
+// ============================================
+// Network Task
+// ============================================
+
+bool OtaUpdater::onOffer(const char* version, uint32_t size, const char* sha256Hex) {
+    if (_target == nullptr) {
+        _error = "no_slot";
+        _changed = true;
+        return false;
+    }
+
+    // Already running it, or the current image isn't confirmed yet
+    if (strcmp(version, FIRMWARE_VERSION) == 0 || _pendingVerify) return false;
+
+    uint8_t hash[32];
+    if (!parseHash(sha256Hex, hash) || size == 0 || size > _target->size ||
+        strlen(version) >= OTA_VERSION_LEN) {
+        LOG_W(OTA, "Unusable offer for %s (%lu bytes)", version, (unsigned long)size);
+        _error = "bad_offer";
+        _changed = true;
+        return false;
+    }
+
+    portENTER_CRITICAL(&_mux);
+    OtaState state = _state;
+    bool cleaning = _abort;
+    portEXIT_CRITICAL(&_mux);
+
+    if (state == OTA_REBOOTING || cleaning) return false;
+
+    if (state == OTA_DOWNLOADING) {
+        // Offered again after a reconnect: carry on where we are
+        if (strcmp(version, _version) == 0 && memcmp(hash, _expected, sizeof(hash)) == 0) {
+            return true;
+        }
+        // A different image: drop this one, the box offers again
+        onCancel();
+        return false;
+    }
+
+    strncpy(_version, version, sizeof(_version) - 1);
+    _version[sizeof(_version) - 1] = '\0';
+    memcpy(_expected, hash, sizeof(hash));
+    _size = size;
+    _written = 0;
+    _chunkReady = false;
+    _awaiting = false;
+    _retries = 0;
+    _requestedAt = 0;
+    _error = nullptr;
+
+    if (_task == nullptr) {
+        xTaskCreate(writerTask, "ota", OTA_TASK_STACK, this, OTA_TASK_PRIORITY, &_task);
+    }
+    setState(OTA_DOWNLOADING);
+
+    LOG_W(OTA, "Updating to %s (%lu bytes) into %s", _version, (unsigned long)_size, _target->label);
+    return true;
+}
+
+void OtaUpdater::onCancel() {
+    if (getState() != OTA_DOWNLOADING) return;
+
+    LOG_W(OTA, "Update to %s cancelled at %lu/%lu bytes",
+          _version, (unsigned long)_written, (unsigned long)_size);
+
+    portENTER_CRITICAL(&_mux);
+    _abort = true;
+    _awaiting = false;
+    portEXIT_CRITICAL(&_mux);
+
+    setState(OTA_IDLE);
+    xTaskNotifyGive(_task);
+}
+
+void OtaUpdater::onChunk(uint32_t offset, const uint8_t* data, size_t length) {
+    portENTER_CRITICAL(&_mux);
+    bool expected = _state == OTA_DOWNLOADING && _awaiting && !_chunkReady &&
+                    offset == _written && length > 0 && length <= OTA_CHUNK_SIZE &&
+                    offset + length <= _size;
+    portEXIT_CRITICAL(&_mux);
+
+    // A late answer to a request we already repeated
+    if (!expected) {
+        LOG_D(OTA, "Unexpected chunk at %lu (%u bytes), ignored", (unsigned long)offset, (unsigned)length);
+        return;
+    }
+
+    // The writer only touches the buffer once it's marked ready
+    memcpy(_chunk, data, length);
+    _chunkLen = length;
+
+    portENTER_CRITICAL(&_mux);
+    _chunkReady = true;
+    _awaiting = false;
+    _retries = 0;
+    portEXIT_CRITICAL(&_mux);
+
+    xTaskNotifyGive(_task);
+}
+
+bool OtaUpdater::takeRequest(uint32_t& offset, uint32_t& length) {
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&_mux);
+    bool busy = _state != OTA_DOWNLOADING || _chunkReady || _written >= _size;
+    bool awaiting = _awaiting;
+    uint32_t written = _written;
+    portEXIT_CRITICAL(&_mux);
+
+    if (busy) return false;
+
+    if (awaiting) {
+        if (now - _requestedAt < OTA_CHUNK_TIMEOUT) return false;
+        if (++_retries > OTA_MAX_RETRIES) {
+            fail("timeout");
+            return false;
+        }
+        LOG_W(OTA, "Chunk at %lu not received, asking again", (unsigned long)written);
+    } else if (now - _requestedAt < OTA_CHUNK_INTERVAL || !isIdleForOta(now)) {
+        // Throttled, or alerts are coming in
+        return false;
+    }
+
+    offset = written;
+    length = min(_size - written, (uint32_t)OTA_CHUNK_SIZE);
+
+    portENTER_CRITICAL(&_mux);
+    _awaiting = true;
+    portEXIT_CRITICAL(&_mux);
+    _requestedAt = now;
+    return true;
+}
+
+void OtaUpdater::onLinkUp() {
+    _linkUp = true;
+
+    // A request outstanding on the old connection is gone with it
+    portENTER_CRITICAL(&_mux);
+    _awaiting = false;
+    portEXIT_CRITICAL(&_mux);
+}
+
+void OtaUpdater::loop() {
+    unsigned long now = millis();
+
+    // A new image is kept once it has been up a while and reached the
+    // box; one that can't get there goes back to the previous slot
+    if (_pendingVerify) {
+        if (_linkUp && now >= OTA_VERIFY_UPTIME) {
+            esp_ota_mark_app_valid_cancel_rollback();
+            _pendingVerify = false;
+            _changed = true;
+            LOG_W(OTA, "Firmware " FIRMWARE_VERSION " confirmed");
+        } else if (now >= OTA_VERIFY_TIMEOUT) {
+            LOG_E(OTA, "Firmware " FIRMWARE_VERSION " never reached the box, rolling back");
+            Log.flush();
+            esp_ota_mark_app_invalid_rollback_and_reboot();
+        }
+    }
+
+    // Restart into the new image between alerts; the notification log
+    // brings back anything still undismissed if we can't wait
+    if (getState() == OTA_REBOOTING && now - _readyAt >= OTA_RESTART_DELAY) {
+        bool idle = NotifQueue.isEmpty() && isIdleForOta(now);
+        if (idle || now - _readyAt >= OTA_RESTART_MAX_WAIT) {
+            LOG_W(OTA, "Restarting into %s", _version);
+            Log.flush();
+            ESP.restart();
+        }
+    }
+}
+
+void OtaUpdater::onNotification() {
+    _lastNotification = max(millis(), 1UL);
+}
+
+bool OtaUpdater::takeChanged() {
+    portENTER_CRITICAL(&_mux);
+    bool changed = _changed;
+    _changed = false;
+    portEXIT_CRITICAL(&_mux);
+    return changed;
+}
+
+OtaState OtaUpdater::getState() {
+    portENTER_CRITICAL(&_mux);
+    OtaState state = _state;
+    portEXIT_CRITICAL(&_mux);
+    return state;
+}
+
+void OtaUpdater::writeJson(JsonObject out) {
+    OtaState state = getState();
+    out["state"] = stateName(state);
+    out["ab"] = _target != nullptr;
+    if (state != OTA_IDLE) {
+        out["version"] = _version;
+        out["done"] = _written;
+        out["total"] = _size;
+    }
+    if (_error != nullptr) out["error"] = _error;
+    if (_pendingVerify) out["verifying"] = true;
+    if (_rolledBack) out["rolled_back"] = true;
+}
+
+// ============================================
+// Writer Task
+// ============================================
+
+void OtaUpdater::writerTask(void* param) {
+    OtaUpdater* self = static_cast<OtaUpdater*>(param);
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->writeChunk();
+    }
+}
+
+void OtaUpdater::writeChunk() {
+    portENTER_CRITICAL(&_mux);
+    bool abort = _abort;
+    bool ready = _chunkReady;
+    portEXIT_CRITICAL(&_mux);
+
+    if (abort) {
+        if (_handle != 0) {
+            esp_ota_abort(_handle);
+            _handle = 0;
+            mbedtls_sha256_free(&_sha);
+        }
+        portENTER_CRITICAL(&_mux);
+        _abort = false;
+        _chunkReady = false;
+        portEXIT_CRITICAL(&_mux);
+        return;
+    }
+    if (!ready) return;
+
+    if (_handle == 0) {
+        // Sequential writes erase a sector at a time as they go, not
+        // the whole slot up front (seconds of flash busy)
+        if (esp_ota_begin(_target, OTA_WITH_SEQUENTIAL_WRITES, &_handle) != ESP_OK) {
+            _handle = 0;
+            fail("begin");
+            return;
+        }
+        mbedtls_sha256_init(&_sha);
+        mbedtls_sha256_starts(&_sha, 0);
+    }
+
+    if (esp_ota_write(_handle, _chunk, _chunkLen) != ESP_OK) {
+        fail("write");
+        return;
+    }
+    mbedtls_sha256_update(&_sha, _chunk, _chunkLen);
+
+    portENTER_CRITICAL(&_mux);
+    uint32_t before = _written;
+    _written += _chunkLen;
+    _chunkReady = false;
+    bool complete = _written >= _size;
+    portEXIT_CRITICAL(&_mux);
+
+    // Every 10%
+    if (before * 10 / _size != _written * 10 / _size) {
+        LOG_I(OTA, "%lu/%lu bytes", (unsigned long)_written, (unsigned long)_size);
+    }
+
+    if (complete) {
+        finish();
+    }
+}
+
+void OtaUpdater::finish() {
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&_sha, digest);
+    mbedtls_sha256_free(&_sha);
+
+    if (memcmp(digest, _expected, sizeof(digest)) != 0) {
+        fail("hash");
+        return;
+    }
+
+    // Checks the image itself; frees the handle either way
+    esp_err_t err = esp_ota_end(_handle);
+    _handle = 0;
+    if (err != ESP_OK) {
+        fail(err == ESP_ERR_OTA_VALIDATE_FAILED ? "image" : "end");
+        return;
+    }
+
+    if (esp_ota_set_boot_partition(_target) != ESP_OK) {
+        fail("boot");
+        return;
+    }
+
+    _readyAt = millis();
+    setState(OTA_REBOOTING);
+    LOG_W(OTA, "Update to %s verified, restarting when idle", _version);
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void OtaUpdater::fail(const char* error) {
+    // Either task; the writer releases the slot
+    LOG_E(OTA, "Update to %s failed: %s (%lu/%lu bytes)",
+          _version, error, (unsigned long)_written, (unsigned long)_size);
+
+    portENTER_CRITICAL(&_mux);
+    _error = error;
+    _awaiting = false;
+    _abort = true;
+    portEXIT_CRITICAL(&_mux);
+
+    setState(OTA_FAILED);
+    xTaskNotifyGive(_task);
+}
+
+void OtaUpdater::setState(OtaState state) {
+    portENTER_CRITICAL(&_mux);
+    _state = state;
+    _changed = true;
+    portEXIT_CRITICAL(&_mux);
+}
+
+bool OtaUpdater::isIdleForOta(unsigned long now) {
+    return _lastNotification == 0 || now - _lastNotification >= OTA_QUIET_AFTER_NOTIF;
+}
+
+bool OtaUpdater::parseHash(const char* hex, uint8_t* out) {
+    if (hex == nullptr || strlen(hex) != 64) return false;
+
+    for (int i = 0; i < 64; i++) {
+        char c = tolower((unsigned char)hex[i]);
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') nibble = c - '0';
+        else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+        else return false;
+
+        if (i % 2 == 0) out[i / 2] = nibble << 4;
+        else out[i / 2] |= nibble;
+    }
+    return true;
+}
+
+const char* OtaUpdater::stateName(OtaState state) {
+    switch (state) {
+        case OTA_DOWNLOADING: return "downloading";
+        case OTA_REBOOTING:   return "rebooting";
+        case OTA_FAILED:      return "failed";
+        default:              return "idle";
+    }
+}
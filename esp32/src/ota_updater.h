@@ -0,0 +1,115 @@
+#ifndef OTA_UPDATER_H
+#define OTA_UPDATER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <esp_ota_ops.h>
+#include <mbedtls/sha256.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// ============================================
+// Streaming A/B Firmware Updater
+// The box offers an image ("ota_offer": version, size, SHA-256) and we
+// pull it one chunk at a time over the WebSocket ("ota_chunk" out, a
+// bpw1 OTA chunk frame back). Each chunk goes straight into the
+// inactive app slot from a low-priority writer task; nothing but the
+// chunk in flight is buffered. Only one chunk is ever outstanding, and
+// requests pause while notifications are arriving, so an update never
+// competes with live alerts.
+//
+// A finished image must match the offered hash and pass the IDF image
+// check before it becomes the boot slot. After the restart it runs
+// "pending verify": it is kept once it has reached the box and stayed
+// up for OTA_VERIFY_UPTIME, and the bootloader falls back to the old
+// slot if it resets before that.
+// ============================================
+
+#define OTA_CHUNK_SIZE          4096      // Bytes per request (one flash sector)
+#define OTA_CHUNK_INTERVAL      100UL     // ms between requests (~40 KB/s ceiling)
+#define OTA_QUIET_AFTER_NOTIF   3000UL    // ms to hold off after a notification arrives
+#define OTA_CHUNK_TIMEOUT       10000UL   // ms before asking for a chunk again
+#define OTA_MAX_RETRIES         5         // Unanswered requests in a row before giving up
+#define OTA_RESTART_DELAY       2000UL    // ms for the final status to reach the box
+#define OTA_RESTART_MAX_WAIT    120000UL  // ms to wait for an empty queue before restarting anyway
+#define OTA_VERIFY_UPTIME       60000UL   // ms a new image must run, registered, before it's kept
+#define OTA_VERIFY_TIMEOUT      600000UL  // ms to reach the box before rolling back
+#define OTA_VERSION_LEN         16
+#define OTA_TASK_STACK          4096
+#define OTA_TASK_PRIORITY       1         // Flash writes wait for everything else
+
+enum OtaState : uint8_t {
+    OTA_IDLE,
+    OTA_DOWNLOADING,
+    OTA_REBOOTING,      // Verified and set as the boot slot
+    OTA_FAILED
+};
+
+class OtaUpdater {
+public:
+    // Boot: is this a new image on probation, did the last one roll back?
+    void begin();
+
+    // Network task
+    bool onOffer(const char* version, uint32_t size, const char* sha256Hex);
+    void onCancel();
+    void onChunk(uint32_t offset, const uint8_t* data, size_t length);
+    bool takeRequest(uint32_t& offset, uint32_t& length);  // Next chunk to ask for, if due
+    void onLinkUp();            // Registered with the box
+    void loop();                // Probation and restart timers
+
+    // Any transport: a notification arrived, leave the link to it
+    void onNotification();
+
+    // State changed since the last call (worth a status frame of its own)
+    bool takeChanged();
+
+    OtaState getState();
+    void writeJson(JsonObject out);
+
+private:
+    OtaState _state = OTA_IDLE;
+    const esp_partition_t* _target = nullptr;   // Inactive slot, nullptr = no A/B layout
+    esp_ota_handle_t _handle = 0;
+    mbedtls_sha256_context _sha;
+    TaskHandle_t _task = nullptr;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    // Offered image
+    char _version[OTA_VERSION_LEN] = {0};
+    uint32_t _size = 0;
+    uint8_t _expected[32];
+    const char* _error = nullptr;
+
+    // Transfer: one chunk requested or waiting for the writer at a time
+    uint32_t _written = 0;        // Writer: bytes in flash
+    uint8_t _chunk[OTA_CHUNK_SIZE];
+    size_t _chunkLen = 0;
+    bool _chunkReady = false;     // Handed to the writer, not written yet
+    bool _awaiting = false;       // Requested, not arrived yet
+    bool _abort = false;          // Writer: drop the session
+    uint8_t _retries = 0;
+    unsigned long _requestedAt = 0;
+    unsigned long _lastNotification = 0;
+    unsigned long _readyAt = 0;
+    bool _changed = false;
+
+    // This boot
+    bool _pendingVerify = false;
+    bool _rolledBack = false;
+    bool _linkUp = false;
+
+    static void writerTask(void* param);
+    void writeChunk();
+    void finish();
+    void fail(const char* error);
+    void setState(OtaState state);
+    bool isIdleForOta(unsigned long now);
+
+    static bool parseHash(const char* hex, uint8_t* out);
+    static const char* stateName(OtaState state);
+};
+
+extern OtaUpdater Ota;
+
+#endif // OTA_UPDATER_H
@@ -0,0 +1,281 @@
+// Generated by scripts/embed_portal.py from portal/index.html - do not edit
+#ifndef PORTAL_HTML_H
+#define PORTAL_HTML_H
+
+#include <Arduino.h>
+
+// 17620 bytes of HTML, gzip -9
+#define PORTAL_HTML_GZ_LEN 4284
+
+static const uint8_t PORTAL_HTML_GZ[PORTAL_HTML_GZ_LEN] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x1c, 0xed, 0x72, 0xdb, 0x36,
+    0xf2, 0x7f, 0x9f, 0x02, 0x55, 0xa6, 0x27, 0xa9, 0xd5, 0xb7, 0x3f, 0xe2, 0xc8, 0xb6, 0x3a, 0x75,
+    0xe2, 0x5e, 0x73, 0xd3, 0xa4, 0x99, 0xda, 0xb9, 0xce, 0x5d, 0xdb, 0xc9, 0x40, 0x24, 0x24, 0xa1,
+    0x21, 0x09, 0x16, 0x00, 0xfd, 0xd1, 0x5c, 0xee, 0x5d, 0xee, 0x01, 0xee, 0x05, 0xee, 0x6f, 0x5f,
+    0xec, 0x76, 0x01, 0x92, 0x22, 0x29, 0x90, 0x92, 0x1c, 0x3b, 0x13, 0x5b, 0x04, 0x81, 0xdd, 0xc5,
+    0x7e, 0xef, 0x02, 0xf6, 0xd9, 0xe7, 0x2f, 0x7e, 0x78, 0x7e, 0xfd, 0x8f, 0x37, 0x97, 0x64, 0xa5,
+    0xc3, 0x60, 0xf6, 0xd9, 0x59, 0xf6, 0x83, 0x51, 0x7f, 0xf6, 0x19, 0x81, 0xaf, 0xb3, 0x90, 0x69,
+    0x4a, 0xbc, 0x15, 0x95, 0x8a, 0xe9, 0xf3, 0xf6, 0xdb, 0xeb, 0x6f, 0xfb, 0x27, 0xed, 0xe2, 0xab,
+    0x88, 0x86, 0xec, 0xbc, 0x7d, 0xc3, 0xd9, 0x6d, 0x2c, 0xa4, 0x6e, 0x13, 0x4f, 0x44, 0x9a, 0x45,
+    0x30, 0xf5, 0x96, 0xfb, 0x7a, 0x75, 0xee, 0xb3, 0x1b, 0xee, 0xb1, 0xbe, 0x79, 0xe8, 0xf1, 0x88,
+    0x6b, 0x4e, 0x83, 0xbe, 0xf2, 0x68, 0xc0, 0xce, 0xc7, 0x83, 0x51, 0x2f, 0xa4, 0x77, 0x3c, 0x4c,
+    0xc2, 0xc2, 0x48, 0xa2, 0x98, 0x34, 0x8f, 0x74, 0x0e, 0x23, 0x91, 0xc8, 0x90, 0x69, 0xae, 0x03,
+    0x36, 0xbb, 0xe0, 0x5a, 0xc5, 0x4c, 0xfe, 0x44, 0xb5, 0xb7, 0x22, 0x57, 0x4c, 0x27, 0xf1, 0xd9,
+    0xd0, 0xbe, 0xb1, 0xb3, 0x94, 0xbe, 0xcf, 0x3e, 0xe3, 0xd7, 0x97, 0xe4, 0x03, 0x99, 0x8b, 0xbb,
+    0xbe, 0xe2, 0x7f, 0xf0, 0x68, 0x39, 0x85, 0xcf, 0xd2, 0x07, 0xf0, 0x30, 0x74, 0x4a, 0x42, 0x2a,
+    0x97, 0x3c, 0x9a, 0x92, 0xd1, 0x29, 0x89, 0xa9, 0xef, 0x9b, 0xf7, 0xf0, 0xf9, 0x63, 0xbe, 0x78,
+    0x2e, 0xfc, 0x7b, 0xf2, 0x21, 0x7f, 0xc4, 0xaf, 0x05, 0x6c, 0xae, 0xbf, 0xa0, 0x21, 0x0f, 0xee,
+    0xa7, 0xa4, 0x4f, 0xe3, 0x38, 0x60, 0x7d, 0x75, 0xaf, 0x34, 0x0b, 0x7b, 0xe4, 0x22, 0xe0, 0xd1,
+    0xfb, 0x57, 0xd4, 0xbb, 0x32, 0xcf, 0xdf, 0xc2, 0xcc, 0x1e, 0x69, 0x5f, 0xb1, 0xa5, 0x60, 0xe4,
+    0xed, 0xcb, 0x76, 0x8f, 0xfc, 0x28, 0xe6, 0x42, 0x8b, 0x1e, 0x51, 0x34, 0x52, 0x7d, 0xd8, 0x24,
+    0x5f, 0x9c, 0x96, 0x60, 0xcf, 0xa9, 0xf7, 0x7e, 0x29, 0x45, 0x12, 0xf9, 0x53, 0x02, 0xa0, 0x18,
+    0x95, 0xfd, 0xa5, 0xa4, 0x3e, 0x07, 0x66, 0x76, 0xc6, 0x07, 0x47, 0x3e, 0x5b, 0xf6, 0xc8, 0x93,
+    0x31, 0x1d, 0xd3, 0x09, 0x23, 0xa3, 0x2f, 0xf0, 0xf3, 0xf1, 0x64, 0x7c, 0xc0, 0xc8, 0x78, 0x34,
+    0xfa, 0xa2, 0x5b, 0x06, 0xe5, 0x89, 0x40, 0xc8, 0x29, 0x79, 0xb2, 0x58, 0x54, 0x70, 0x84, 0x3c,
+    0xea, 0xaf, 0x18, 0x5f, 0xae, 0xf4, 0x14, 0xd7, 0xdd, 0xac, 0xca, 0xaf, 0x73, 0x3e, 0x4c, 0x46,
+    0xf1, 0x9d, 0xf3, 0x15, 0xb0, 0x4e, 0x6b, 0x11, 0x9a, 0xd5, 0xc5, 0x29, 0x6b, 0xae, 0x0d, 0x50,
+    0x01, 0x28, 0xd0, 0x2f, 0x81, 0xf7, 0x20, 0x5e, 0x2b, 0xfa, 0x29, 0x39, 0x34, 0x0b, 0xd6, 0x5c,
+    0x27, 0x34, 0xd1, 0x02, 0xd9, 0x9d, 0xaf, 0x1c, 0x7e, 0x49, 0xbe, 0x03, 0xbd, 0x83, 0x85, 0x5f,
+    0x0e, 0xd7, 0xe0, 0x56, 0x76, 0xa8, 0x2c, 0x07, 0xcd, 0xee, 0x74, 0x9f, 0x06, 0x7c, 0x09, 0x90,
+    0x3c, 0x60, 0x10, 0x93, 0x0d, 0x1b, 0x01, 0x5c, 0x07, 0x75, 0xc4, 0xa6, 0xd0, 0x57, 0xe3, 0x0a,
+    0x82, 0x8c, 0x83, 0xa3, 0x91, 0xff, 0xac, 0xca, 0x44, 0xa3, 0x04, 0xa0, 0x51, 0x0c, 0xc0, 0x9f,
+    0x54, 0xf9, 0x64, 0x5e, 0xde, 0xa6, 0x2c, 0x7e, 0x3a, 0x1a, 0x55, 0xf8, 0x6f, 0x76, 0x9f, 0x33,
+    0xf1, 0xa4, 0x99, 0xaa, 0x41, 0x6a, 0x3c, 0xdc, 0xaf, 0xa1, 0xee, 0xf8, 0xf8, 0xb8, 0x96, 0xb4,
+    0xf1, 0xc4, 0x49, 0x5a, 0xa6, 0xbc, 0xa1, 0x88, 0x84, 0x8a, 0xa9, 0xc7, 0x8a, 0x04, 0x14, 0x45,
+    0xf1, 0x9c, 0x4a, 0x5f, 0x95, 0x24, 0xe1, 0xc1, 0x48, 0x85, 0x90, 0xa2, 0xce, 0xca, 0xe5, 0x9c,
+    0x76, 0x26, 0x47, 0x47, 0xbd, 0xec, 0xff, 0x68, 0x30, 0x3a, 0xaa, 0x28, 0x66, 0x6a, 0x7f, 0xa8,
+    0xd6, 0x89, 0x02, 0x1a, 0x8f, 0x6b, 0xd4, 0xcc, 0xa5, 0x81, 0x15, 0xde, 0x6d, 0xae, 0xb5, 0xc0,
+    0xe1, 0x0d, 0x88, 0x5c, 0x89, 0x00, 0xb8, 0xe6, 0x20, 0x69, 0xdc, 0x75, 0x2b, 0x2d, 0xee, 0x6d,
+    0x35, 0x71, 0x99, 0x7b, 0xca, 0xce, 0xc3, 0x2a, 0xba, 0x26, 0x15, 0x31, 0xfa, 0xa9, 0x25, 0x58,
+    0xfa, 0x42, 0x48, 0x20, 0x36, 0x89, 0xc1, 0x69, 0x79, 0x54, 0xb1, 0xf2, 0xb4, 0x80, 0x69, 0x8d,
+    0xde, 0x0e, 0xe4, 0x60, 0x36, 0x3d, 0xde, 0x7b, 0xcf, 0x3e, 0x57, 0x71, 0x40, 0x41, 0x9e, 0x8b,
+    0x80, 0x55, 0x5e, 0x19, 0xf3, 0xe8, 0x73, 0xf0, 0x45, 0xca, 0x6d, 0x24, 0x4b, 0x1a, 0xd7, 0xab,
+    0x60, 0xc6, 0x90, 0x41, 0x94, 0x84, 0x0d, 0x42, 0x77, 0xee, 0x7e, 0xcd, 0x99, 0x8a, 0xfa, 0xa7,
+    0xae, 0x60, 0xb2, 0xc1, 0xcb, 0xcc, 0x27, 0x6d, 0xbe, 0xa9, 0x68, 0xcc, 0xd1, 0xe8, 0x8b, 0xc7,
+    0x63, 0xc0, 0x6f, 0x89, 0xd2, 0x7c, 0x71, 0xdf, 0x4f, 0x43, 0x96, 0x7b, 0xd2, 0x76, 0x93, 0x72,
+    0x5a, 0x7b, 0xd9, 0x98, 0xbe, 0x05, 0x2d, 0x20, 0x2c, 0x60, 0x21, 0x20, 0x28, 0x19, 0x15, 0x44,
+    0x39, 0x16, 0x54, 0xf8, 0x9b, 0x6f, 0x69, 0x1e, 0x08, 0xef, 0xbd, 0x9b, 0xb5, 0x27, 0x27, 0x27,
+    0xf5, 0x64, 0x1e, 0x6c, 0x51, 0xa3, 0x63, 0xb7, 0xcc, 0x79, 0x14, 0x27, 0xfa, 0x67, 0x7d, 0x1f,
+    0xb3, 0xf3, 0x16, 0x2a, 0x70, 0xeb, 0xd7, 0x5e, 0x69, 0x2c, 0xa6, 0x4a, 0xdd, 0x82, 0x38, 0xaa,
+    0xe3, 0xa0, 0x21, 0x73, 0x26, 0x71, 0x54, 0xc1, 0x16, 0x3d, 0x5d, 0xd9, 0x4e, 0x2a, 0x74, 0x0c,
+    0x53, 0x35, 0xb6, 0x8e, 0xb6, 0xd5, 0x60, 0xcf, 0x93, 0x5d, 0xed, 0xd9, 0xe5, 0x61, 0x36, 0x44,
+    0xb6, 0xe1, 0xb2, 0x46, 0x3d, 0xf3, 0x6f, 0x70, 0xb0, 0x6b, 0x10, 0x2d, 0xb2, 0xfa, 0x78, 0x9b,
+    0xc5, 0x6e, 0xe0, 0x07, 0x75, 0x99, 0xbf, 0xe7, 0x1a, 0x93, 0x07, 0x08, 0xf1, 0x34, 0xf2, 0x00,
+    0x4c, 0x24, 0x22, 0x56, 0x2b, 0x91, 0xe9, 0x42, 0x78, 0x89, 0xca, 0x98, 0x6b, 0x9f, 0x2a, 0x2c,
+    0x16, 0x89, 0xc6, 0x8c, 0xa1, 0x0a, 0xa8, 0xc0, 0x8f, 0x3a, 0x67, 0x55, 0xf1, 0xf9, 0x22, 0x8a,
+    0x00, 0x07, 0x17, 0x11, 0x41, 0xd1, 0xa6, 0x28, 0x85, 0x24, 0x7d, 0x72, 0xf1, 0xf2, 0xaf, 0x64,
+    0x9e, 0xc0, 0xa6, 0xa2, 0x4a, 0x50, 0x80, 0x25, 0x7d, 0x9c, 0x0c, 0xc9, 0xca, 0x46, 0x9c, 0xca,
+    0x35, 0x19, 0xdf, 0x55, 0x9c, 0x0f, 0x8c, 0xf4, 0xc1, 0x34, 0xe1, 0xbd, 0x66, 0x48, 0x5e, 0x12,
+    0x46, 0x28, 0xaf, 0x85, 0xc4, 0xff, 0x0e, 0x47, 0xb5, 0xc9, 0xc9, 0x1d, 0x83, 0xa9, 0xa1, 0x70,
+    0xae, 0xa3, 0x0a, 0x6d, 0xe5, 0x14, 0xc1, 0xa1, 0x27, 0xbb, 0x68, 0xdf, 0x64, 0xdf, 0xf8, 0x56,
+    0xab, 0x7d, 0x55, 0x48, 0x5e, 0x22, 0x15, 0x4a, 0x2c, 0x16, 0x7c, 0xd3, 0x27, 0x6d, 0x4b, 0x7f,
+    0x4c, 0xe4, 0xe1, 0x28, 0xc7, 0x29, 0x78, 0xc1, 0x80, 0x00, 0x78, 0xd5, 0xc8, 0x9b, 0xc1, 0x22,
+    0x09, 0x02, 0x9b, 0xa9, 0x55, 0xd8, 0x64, 0xe4, 0x64, 0xc5, 0x33, 0x25, 0x10, 0xa8, 0x22, 0x32,
+    0x69, 0x84, 0x34, 0x5d, 0x89, 0x9b, 0x8d, 0x74, 0xad, 0xac, 0x84, 0xe9, 0xbe, 0x27, 0xe3, 0xa7,
+    0x29, 0x17, 0x8f, 0xba, 0xcd, 0xc4, 0x59, 0x35, 0x64, 0x7e, 0x23, 0x54, 0x67, 0x24, 0x72, 0xb0,
+    0x7b, 0x8d, 0x76, 0xbc, 0x05, 0xaf, 0x35, 0x3f, 0xc8, 0x62, 0x73, 0x35, 0x36, 0xe6, 0xe5, 0x9c,
+    0x3a, 0xe0, 0xf0, 0xb1, 0x3e, 0x7b, 0x38, 0xf8, 0x64, 0xe5, 0x1d, 0x98, 0x2a, 0xa7, 0x21, 0x3f,
+    0x39, 0x6e, 0x8c, 0x4d, 0xc7, 0xd5, 0x50, 0x5c, 0x5f, 0x22, 0x94, 0x09, 0x3b, 0xdc, 0x4a, 0x98,
+    0xcf, 0x94, 0xd7, 0x40, 0xd7, 0xb8, 0x2e, 0x6f, 0x2a, 0x85, 0xb0, 0x46, 0xb1, 0x67, 0x7b, 0xaf,
+    0xa6, 0x5c, 0x6e, 0x7a, 0xe6, 0xd4, 0x5f, 0xb2, 0x3a, 0x47, 0xc4, 0x23, 0x74, 0x94, 0x7d, 0x47,
+    0x64, 0x7d, 0x78, 0x56, 0x53, 0xd8, 0xed, 0xb3, 0xfa, 0x7c, 0x16, 0xdc, 0xc8, 0xf1, 0x96, 0xe4,
+    0xe6, 0xb0, 0x46, 0x49, 0xb4, 0x88, 0xa7, 0x64, 0x0f, 0xf9, 0x56, 0x9d, 0x7a, 0x10, 0xd0, 0x58,
+    0x71, 0x28, 0xa7, 0xc1, 0xa1, 0x1b, 0xef, 0x5e, 0x76, 0xe1, 0xe9, 0x60, 0xa3, 0xa2, 0xa7, 0x73,
+    0x06, 0x14, 0x7e, 0xdc, 0xb0, 0xe2, 0x54, 0xcb, 0xca, 0x0a, 0xce, 0x9f, 0xf8, 0xb7, 0x9c, 0x44,
+    0x4c, 0x43, 0xba, 0xf0, 0xbe, 0x82, 0xcc, 0xa3, 0x2e, 0x6f, 0xbc, 0x43, 0x92, 0xd0, 0x18, 0xc9,
+    0x8d, 0xc7, 0x8b, 0xa9, 0x04, 0x67, 0x58, 0xef, 0xc6, 0x7d, 0xaa, 0x56, 0xcc, 0xdf, 0x74, 0x04,
+    0x07, 0xfb, 0xe6, 0x10, 0x3b, 0x56, 0x87, 0x8e, 0x9a, 0xa1, 0xc9, 0xab, 0x37, 0xa6, 0x0e, 0x1f,
+    0x37, 0x59, 0xe8, 0x76, 0xb5, 0x8d, 0x1e, 0xcf, 0xed, 0xf0, 0x72, 0x41, 0x7d, 0xa8, 0xd0, 0x73,
+    0xb7, 0x6e, 0x16, 0x9c, 0x6c, 0xd4, 0x63, 0x88, 0x7c, 0x11, 0x88, 0xdb, 0x3e, 0x28, 0x81, 0xa9,
+    0xe5, 0x1f, 0xb4, 0x99, 0x14, 0x77, 0x5d, 0x70, 0xc6, 0x75, 0x0e, 0x3e, 0xee, 0x1c, 0x46, 0xab,
+    0xa2, 0x1c, 0xed, 0xe3, 0x87, 0xb7, 0x4a, 0xac, 0xa1, 0xf8, 0xd8, 0xa8, 0x2d, 0x4c, 0xb1, 0xdd,
+    0x9f, 0xc3, 0x76, 0x19, 0x8b, 0xf6, 0x28, 0x54, 0x36, 0x79, 0x95, 0xc9, 0x7d, 0xab, 0xac, 0x5d,
+    0x7c, 0x1e, 0x60, 0xbf, 0x0e, 0xd6, 0x56, 0xd5, 0xd4, 0x39, 0x57, 0x01, 0x5d, 0x34, 0x70, 0x38,
+    0xde, 0x6a, 0x51, 0x54, 0x31, 0xff, 0x97, 0xd1, 0x42, 0x60, 0xdf, 0xad, 0x64, 0xf9, 0x1c, 0x06,
+    0xb1, 0xf3, 0xf6, 0x50, 0x85, 0x6d, 0x28, 0xf1, 0x3f, 0xc9, 0x98, 0x4b, 0x65, 0xc8, 0x1e, 0xe5,
+    0xf7, 0x47, 0xc7, 0xd6, 0xe2, 0x86, 0x40, 0x78, 0x50, 0xe7, 0x45, 0x28, 0xa5, 0x95, 0xb6, 0x00,
+    0x86, 0xa8, 0xdc, 0xf2, 0x06, 0x47, 0xcd, 0x38, 0x95, 0x96, 0x22, 0x5a, 0x3a, 0xa3, 0x63, 0x51,
+    0x26, 0x57, 0xc9, 0x3c, 0xe4, 0x3a, 0xcd, 0xe1, 0xcb, 0x2e, 0xd9, 0xbc, 0x79, 0x98, 0x53, 0x3e,
+    0x69, 0xb2, 0xcc, 0xda, 0x2e, 0xa6, 0xa5, 0xd0, 0x76, 0x31, 0x47, 0xa3, 0xf9, 0xa1, 0x7f, 0xe2,
+    0xea, 0x62, 0x66, 0xc2, 0xae, 0x2d, 0x6a, 0x72, 0x99, 0x36, 0xf4, 0x66, 0xea, 0x63, 0xf5, 0x78,
+    0xcf, 0xde, 0x5d, 0xa3, 0x27, 0x88, 0x45, 0x96, 0x6f, 0x2f, 0xf8, 0x1d, 0xf3, 0xab, 0xe4, 0x5a,
+    0xfd, 0xd9, 0xec, 0x69, 0x05, 0x6c, 0xa1, 0x5d, 0xe3, 0x32, 0x6d, 0x87, 0x38, 0xdc, 0x55, 0xa5,
+    0xa1, 0xea, 0xd0, 0xd7, 0xbc, 0xb9, 0xea, 0x0c, 0x1e, 0xb9, 0xb0, 0x73, 0x37, 0x22, 0xb0, 0xfd,
+    0xa4, 0xc1, 0x8b, 0x8d, 0x06, 0xcf, 0x4e, 0x6b, 0xe6, 0x82, 0xa7, 0xc3, 0x7e, 0x7c, 0x53, 0xff,
+    0xef, 0xc9, 0xe1, 0xe1, 0xe1, 0x8e, 0xcd, 0x8a, 0x8c, 0x95, 0x91, 0xc0, 0x32, 0x06, 0x62, 0x48,
+    0x91, 0x63, 0x96, 0x80, 0xb3, 0x61, 0xda, 0xca, 0x3f, 0x1b, 0xda, 0xc3, 0x88, 0x33, 0x6c, 0xc7,
+    0xa7, 0x5d, 0x7e, 0x9f, 0xdf, 0x10, 0x2f, 0xa0, 0x4a, 0x9d, 0xb7, 0xf2, 0x6e, 0x73, 0x6b, 0xdd,
+    0xf5, 0x2f, 0xbe, 0xb7, 0xad, 0xd4, 0xc2, 0x4b, 0x33, 0x61, 0x35, 0x2e, 0x9d, 0x24, 0x00, 0x8e,
+    0x71, 0x65, 0x46, 0x01, 0x44, 0xde, 0x85, 0x6d, 0x11, 0xee, 0x17, 0x1f, 0x67, 0x67, 0x43, 0x98,
+    0x56, 0xc0, 0x6b, 0x1f, 0xd7, 0xcf, 0xd8, 0xfc, 0x33, 0x6b, 0x80, 0xca, 0x05, 0x5f, 0x62, 0x17,
+    0xa8, 0x45, 0xa8, 0xc9, 0xa4, 0xce, 0x5b, 0x43, 0x45, 0x6f, 0x58, 0x8b, 0x84, 0x4c, 0xaf, 0x04,
+    0x4c, 0x79, 0xf3, 0xc3, 0xd5, 0x75, 0xab, 0xb0, 0xd8, 0x00, 0xf8, 0xbc, 0xdf, 0x27, 0x57, 0x9a,
+    0xc5, 0x64, 0x3c, 0x2d, 0x16, 0xe7, 0xd7, 0x58, 0x9c, 0xf7, 0xfb, 0xf5, 0x24, 0x63, 0xf7, 0xae,
+    0xb2, 0x67, 0xbb, 0xef, 0xc9, 0xec, 0xcc, 0x14, 0x71, 0xe9, 0xbc, 0x28, 0x09, 0x5b, 0xb3, 0x31,
+    0xf0, 0x1a, 0xc6, 0x66, 0xe4, 0x9a, 0xc7, 0x82, 0xf8, 0x0c, 0x31, 0xb1, 0x3b, 0xc0, 0x03, 0x6c,
+    0x99, 0x38, 0x80, 0x94, 0xb9, 0x5f, 0xa8, 0xfe, 0x1d, 0x18, 0xcd, 0x02, 0xdb, 0xe4, 0x2a, 0x2e,
+    0x01, 0x95, 0xb2, 0xcc, 0x84, 0x0f, 0x90, 0x8c, 0x03, 0x1b, 0x44, 0xe4, 0x05, 0xdc, 0x7b, 0x7f,
+    0xde, 0x52, 0x4c, 0xe3, 0x4e, 0x3b, 0x6d, 0x18, 0x6e, 0x77, 0x6b, 0x40, 0x1a, 0xb0, 0xb6, 0x3c,
+    0xb3, 0x3d, 0x28, 0x74, 0x05, 0xa2, 0x65, 0x0f, 0xa3, 0x0c, 0x8a, 0x77, 0xa1, 0xf0, 0x01, 0xec,
+    0x0d, 0x0d, 0x12, 0x18, 0x41, 0x14, 0x0d, 0x90, 0x0a, 0x3b, 0xc2, 0x3a, 0xae, 0x35, 0xfb, 0xcb,
+    0x93, 0xf1, 0xe4, 0x64, 0x72, 0x7c, 0x72, 0x5a, 0x91, 0x70, 0xd3, 0x4a, 0x53, 0xa4, 0xb4, 0x66,
+    0x17, 0x80, 0x50, 0x0b, 0xa1, 0x57, 0x7b, 0x2c, 0xc5, 0x12, 0xaa, 0x35, 0xbb, 0xe2, 0x51, 0x96,
+    0x38, 0x7b, 0x4c, 0x51, 0xc9, 0x45, 0x03, 0x88, 0xb3, 0xa1, 0xe1, 0xea, 0xc3, 0x38, 0x7e, 0xcb,
+    0x17, 0xdc, 0xc5, 0x72, 0x1c, 0x7f, 0x34, 0x9e, 0x1b, 0x24, 0xfb, 0x33, 0xfd, 0xf0, 0xf8, 0x01,
+    0x4c, 0x47, 0xb6, 0xed, 0xcd, 0xef, 0x4c, 0xcd, 0xc1, 0x79, 0x4b, 0x22, 0x99, 0xff, 0xb8, 0xdc,
+    0x26, 0x85, 0x96, 0x4a, 0x56, 0xc9, 0x16, 0x74, 0x1e, 0x14, 0xc4, 0xa9, 0xf4, 0x30, 0xfe, 0x78,
+    0x5a, 0x6f, 0x90, 0x78, 0x2b, 0xe6, 0xbd, 0x67, 0xfe, 0x83, 0xd4, 0x9f, 0x7c, 0x45, 0x3e, 0x41,
+    0x2a, 0xb9, 0x29, 0x00, 0x98, 0x07, 0x49, 0xe8, 0xad, 0xa2, 0x84, 0x86, 0x73, 0xa1, 0x20, 0xe3,
+    0x90, 0x14, 0xc2, 0xdb, 0x3d, 0x48, 0x8a, 0x29, 0x4d, 0xe7, 0x1c, 0x72, 0x3f, 0xea, 0x6f, 0x03,
+    0x58, 0x74, 0x75, 0xa6, 0x2d, 0xd0, 0x9a, 0xfd, 0x78, 0xf9, 0xfc, 0x87, 0x57, 0x97, 0xaf, 0x5f,
+    0x7c, 0xf3, 0xe2, 0x87, 0xd4, 0xed, 0xed, 0x27, 0x70, 0x07, 0xca, 0xaa, 0xdb, 0x2f, 0x7b, 0xee,
+    0xc9, 0xd4, 0x1a, 0xf5, 0x73, 0x13, 0x02, 0x48, 0x47, 0xad, 0xc4, 0x6d, 0x44, 0x92, 0x28, 0x60,
+    0x4a, 0x91, 0x8b, 0xef, 0x2f, 0x41, 0x09, 0x82, 0xfb, 0xee, 0x56, 0x6f, 0x9e, 0x95, 0xee, 0x56,
+    0x85, 0xd0, 0xb6, 0xfa, 0xd9, 0xc8, 0xae, 0x7e, 0x7e, 0x92, 0xf9, 0xf9, 0x1f, 0x21, 0x8e, 0x5b,
+    0x79, 0x38, 0xfd, 0x7b, 0x9a, 0x22, 0x5a, 0x15, 0xb3, 0x0f, 0xad, 0x0c, 0x50, 0x56, 0x7b, 0x16,
+    0x75, 0x17, 0x86, 0x5e, 0xa7, 0x15, 0x64, 0xa7, 0x4e, 0x75, 0x53, 0x8d, 0x82, 0xfc, 0xe2, 0x22,
+    0x81, 0x05, 0x12, 0x69, 0x60, 0xca, 0x50, 0xe1, 0x60, 0xb1, 0x45, 0x5a, 0x13, 0x7a, 0x70, 0xff,
+    0x59, 0xc5, 0x9a, 0xd3, 0x95, 0x0f, 0xcc, 0x6a, 0x74, 0xc2, 0x1a, 0xe9, 0xec, 0xb5, 0x08, 0xe7,
+    0x92, 0x61, 0x90, 0x0b, 0x28, 0xd2, 0x50, 0x2f, 0xe7, 0xa2, 0x9d, 0x99, 0xd3, 0x90, 0xd4, 0xcc,
+    0x94, 0xca, 0x12, 0x01, 0xfb, 0x09, 0x0a, 0x40, 0x8f, 0xad, 0x44, 0x00, 0x59, 0xc6, 0x79, 0xeb,
+    0x0a, 0x0d, 0xdd, 0x03, 0xa1, 0x50, 0x22, 0x40, 0x51, 0x3d, 0xc9, 0xe7, 0x8c, 0xe8, 0x04, 0xbd,
+    0x4b, 0xab, 0x96, 0x26, 0xd0, 0x0c, 0x2d, 0xa9, 0x62, 0x11, 0xdd, 0x8d, 0x9a, 0xfc, 0x1c, 0x26,
+    0xa5, 0x68, 0xfd, 0x8c, 0x54, 0xad, 0x9f, 0x4a, 0x94, 0xad, 0x91, 0xc0, 0xe6, 0x03, 0xc3, 0xf8,
+    0xd6, 0x8e, 0x6a, 0x8c, 0x4a, 0x5a, 0xd6, 0x5e, 0xc8, 0x6b, 0xcc, 0x28, 0x7a, 0x9b, 0x7d, 0x55,
+    0x77, 0x8e, 0x57, 0x26, 0x1e, 0xaa, 0xb9, 0x2f, 0xa0, 0xe0, 0x36, 0x99, 0xf6, 0x8d, 0x20, 0x85,
+    0x40, 0xfb, 0x58, 0x6a, 0x0c, 0x7b, 0xda, 0xa6, 0xc1, 0x27, 0xb9, 0x06, 0x17, 0x68, 0x31, 0x86,
+    0xfc, 0x10, 0x3d, 0x46, 0x66, 0xd8, 0x7c, 0x72, 0x1f, 0x55, 0x2e, 0x2a, 0xc3, 0x8a, 0xfb, 0x3e,
+    0x8b, 0x32, 0x55, 0x00, 0x78, 0xef, 0xa0, 0x36, 0x93, 0x39, 0xab, 0xed, 0xd3, 0xde, 0x30, 0xf0,
+    0xd3, 0x1a, 0x86, 0x79, 0xda, 0xb2, 0x8b, 0x75, 0x88, 0x33, 0x79, 0x3b, 0x78, 0xf0, 0xb4, 0x37,
+    0x62, 0xaa, 0xb7, 0x42, 0x9d, 0xe0, 0xaa, 0xf1, 0xb3, 0x7a, 0xd2, 0x14, 0x72, 0xe5, 0xe2, 0xce,
+    0xd4, 0xeb, 0x85, 0x3e, 0xa8, 0x79, 0xae, 0x4b, 0x34, 0x91, 0xa0, 0x14, 0xbd, 0xad, 0x3d, 0xb2,
+    0x5a, 0xb8, 0x58, 0xd9, 0x61, 0xab, 0xb4, 0x5c, 0xd8, 0x1f, 0x1a, 0x90, 0x6b, 0xdb, 0xf5, 0xc5,
+    0xb4, 0x29, 0x17, 0x70, 0x6d, 0xbb, 0x6f, 0x39, 0x56, 0x46, 0x8e, 0xbd, 0xf5, 0x5a, 0x29, 0xd6,
+    0x83, 0xb2, 0x02, 0x2c, 0x83, 0xc2, 0x9b, 0x1e, 0xeb, 0xda, 0xd5, 0x30, 0xa1, 0x78, 0x9d, 0x63,
+    0x7d, 0x9b, 0xa3, 0x5e, 0x6b, 0xf6, 0x0d, 0x5c, 0x07, 0x53, 0xf2, 0xc2, 0xa8, 0x26, 0x79, 0x8d,
+    0x2d, 0xa3, 0xc7, 0x2a, 0x37, 0xac, 0xeb, 0x04, 0x04, 0x96, 0x65, 0xb3, 0x83, 0xcc, 0xb6, 0x73,
+    0xd7, 0x1c, 0x14, 0x4d, 0xab, 0xc6, 0xb8, 0x33, 0xcf, 0x19, 0x0a, 0x80, 0xc7, 0x22, 0x0d, 0xf1,
+    0x10, 0x6d, 0x12, 0x72, 0x03, 0x06, 0xce, 0x36, 0x10, 0xbf, 0xed, 0xef, 0xd8, 0xad, 0x1d, 0xa6,
+    0xaa, 0x9f, 0x66, 0x50, 0xaf, 0x98, 0x62, 0x52, 0x90, 0x71, 0xc5, 0x99, 0x5e, 0xfe, 0x36, 0x25,
+    0xe9, 0xab, 0xbf, 0x25, 0x34, 0xea, 0x91, 0x0b, 0x2a, 0x25, 0xed, 0x81, 0x97, 0xf4, 0x78, 0x44,
+    0xeb, 0x3d, 0xfd, 0x2b, 0xe1, 0x9b, 0x02, 0x8b, 0x41, 0xbd, 0xba, 0xe4, 0x0d, 0xee, 0x3e, 0x3d,
+    0x48, 0x4f, 0xfd, 0x3b, 0xd4, 0xc7, 0xb2, 0x4e, 0xe5, 0x45, 0x6c, 0x2a, 0xc2, 0x2c, 0xe3, 0xa3,
+    0x01, 0x9e, 0x28, 0xa3, 0x15, 0xa6, 0xda, 0x34, 0xbb, 0xfc, 0x3d, 0x81, 0x64, 0x69, 0x0e, 0xe6,
+    0x24, 0x48, 0x47, 0x32, 0x4f, 0x84, 0x2c, 0x82, 0xd4, 0x49, 0x74, 0xcf, 0x86, 0x76, 0xed, 0x4e,
+    0x80, 0xb1, 0x56, 0x05, 0x1a, 0xbe, 0x59, 0x09, 0x09, 0x9b, 0x36, 0xb7, 0xf6, 0x00, 0x9c, 0x4e,
+    0x24, 0xe8, 0x1d, 0x84, 0x52, 0xb9, 0x84, 0x1f, 0x78, 0x02, 0x36, 0xa7, 0x9a, 0x49, 0x4e, 0xf7,
+    0x03, 0x0e, 0x65, 0x38, 0x56, 0xca, 0x48, 0x39, 0x24, 0x68, 0x40, 0x1e, 0x0f, 0xb1, 0x5f, 0x04,
+    0x08, 0x10, 0x24, 0xc8, 0x75, 0x09, 0xf4, 0xca, 0x06, 0x98, 0xa0, 0x42, 0x66, 0xbb, 0xb5, 0x8c,
+    0xff, 0x27, 0x58, 0xb5, 0x22, 0xbf, 0x27, 0x8c, 0x50, 0x0d, 0xa0, 0x41, 0x04, 0x9d, 0x1b, 0xea,
+    0xfd, 0xf9, 0x5f, 0x41, 0xce, 0x89, 0x16, 0x3e, 0x55, 0xdd, 0xfd, 0xf5, 0x65, 0xf1, 0xee, 0x0f,
+    0x70, 0x6d, 0xca, 0xa1, 0x1a, 0xd7, 0xa0, 0x10, 0xa4, 0x13, 0x30, 0x0c, 0xb8, 0x84, 0x46, 0x1a,
+    0x12, 0x1d, 0xd4, 0xea, 0xe8, 0xcf, 0xff, 0x85, 0xa8, 0x32, 0x80, 0x3d, 0x84, 0xfa, 0xae, 0xdb,
+    0xa0, 0x27, 0xf0, 0x5a, 0x3d, 0x0a, 0x89, 0x1a, 0xbb, 0x36, 0x2e, 0x1a, 0xc7, 0xfd, 0xf1, 0xa4,
+    0x47, 0x26, 0xa3, 0x7a, 0x22, 0xb0, 0x1b, 0x80, 0x84, 0x13, 0x1a, 0x30, 0xa9, 0x29, 0xe9, 0x44,
+    0xe0, 0xa2, 0x93, 0x08, 0xa5, 0x2f, 0x3d, 0xd4, 0x26, 0x43, 0x97, 0x68, 0xa2, 0xab, 0xe0, 0x8f,
+    0xb3, 0x70, 0x60, 0x3a, 0xe5, 0xf8, 0xad, 0x7f, 0x2b, 0x69, 0x3c, 0xc5, 0x6f, 0xa7, 0x78, 0xbe,
+    0x7f, 0x9c, 0x5d, 0x01, 0x29, 0xbb, 0x66, 0xe3, 0xe9, 0x52, 0x1f, 0xe8, 0x79, 0x5e, 0xd1, 0x07,
+    0x1e, 0x36, 0x04, 0x02, 0x4b, 0x50, 0x89, 0x2f, 0xa6, 0x0c, 0x9a, 0x8b, 0xbb, 0x35, 0x6f, 0x6e,
+    0x29, 0x07, 0x65, 0xcd, 0x6d, 0x7d, 0xdc, 0x9a, 0x91, 0xef, 0x03, 0x0a, 0xf8, 0x51, 0x3c, 0x20,
+    0xa8, 0x1d, 0x8a, 0xbe, 0x6d, 0x28, 0xa0, 0x4e, 0x09, 0x4a, 0x08, 0xde, 0x30, 0x9f, 0x4b, 0xe2,
+    0x25, 0xa0, 0xde, 0xf4, 0x11, 0xe0, 0xc7, 0xf4, 0x1e, 0xaf, 0x14, 0x95, 0x51, 0xd0, 0xa5, 0x20,
+    0xa6, 0xe1, 0x04, 0x26, 0xe5, 0x3f, 0xc6, 0x2e, 0x12, 0xb9, 0xac, 0x22, 0x79, 0x6b, 0x86, 0xd8,
+    0x3e, 0x65, 0x52, 0x01, 0xdf, 0x1b, 0xc9, 0x85, 0xc4, 0x02, 0x0e, 0x2f, 0xa4, 0xf2, 0x70, 0x57,
+    0x47, 0x08, 0xfb, 0x85, 0x85, 0xbb, 0x79, 0xc2, 0x51, 0xc1, 0x05, 0x5e, 0xa3, 0xf9, 0xec, 0xe5,
+    0x91, 0x60, 0x8b, 0xaf, 0x40, 0x52, 0x98, 0xc5, 0x87, 0x7b, 0x2e, 0x9d, 0x80, 0x97, 0x0c, 0xf4,
+    0x43, 0x56, 0x1e, 0x40, 0x0e, 0x02, 0x9a, 0x4e, 0x2c, 0xbb, 0x99, 0xda, 0xd7, 0xdf, 0x35, 0x87,
+    0xf3, 0xc3, 0x29, 0x49, 0x5b, 0x9e, 0x17, 0xe2, 0x8e, 0xbc, 0x7c, 0x43, 0x3a, 0x58, 0x78, 0x9a,
+    0x54, 0xde, 0xd4, 0xa7, 0x98, 0xcb, 0xab, 0x7d, 0x93, 0x79, 0x1e, 0xef, 0x9b, 0xcb, 0xaf, 0xc3,
+    0x3f, 0x8f, 0x5b, 0xb3, 0xc3, 0x2c, 0xf8, 0xaf, 0x49, 0x6b, 0x0c, 0xf8, 0x40, 0x36, 0x7a, 0xd2,
+    0xc2, 0x46, 0x3a, 0x3f, 0x52, 0x15, 0xcf, 0x99, 0x94, 0xf7, 0xe4, 0x0d, 0x7f, 0x80, 0x8b, 0x9c,
+    0xcf, 0xdf, 0x01, 0x21, 0x36, 0x09, 0xb3, 0x1f, 0x4b, 0xae, 0xf2, 0xef, 0x99, 0x0b, 0x9e, 0xdb,
+    0xa4, 0x1f, 0xfb, 0xea, 0xe1, 0x9f, 0xff, 0xd1, 0x90, 0x6d, 0xa0, 0xe1, 0xb1, 0x7a, 0xf7, 0xf9,
+    0x26, 0x01, 0xaf, 0x29, 0x76, 0x23, 0x28, 0xbd, 0x41, 0xb7, 0x26, 0x09, 0xaf, 0xd2, 0xe7, 0xf6,
+    0x76, 0x70, 0x70, 0x70, 0xb8, 0x6b, 0xad, 0xf6, 0x9d, 0x49, 0xe5, 0xa7, 0xe4, 0x9b, 0xe0, 0x96,
+    0xde, 0xab, 0x22, 0xa3, 0x50, 0xbe, 0x46, 0xda, 0x91, 0xb8, 0xdd, 0x94, 0x72, 0x7d, 0x39, 0x50,
+    0xee, 0x28, 0x59, 0x78, 0xe8, 0x1d, 0xaa, 0xd8, 0x4b, 0xe5, 0x96, 0x3d, 0x39, 0x58, 0x97, 0x5b,
+    0xf9, 0x41, 0x42, 0x6b, 0xf6, 0xd7, 0x04, 0xb4, 0x08, 0x38, 0x69, 0x2b, 0xca, 0x44, 0x52, 0xcf,
+    0x74, 0x9a, 0xab, 0xa5, 0xd2, 0xd9, 0x10, 0x53, 0x82, 0xb4, 0xdf, 0x5f, 0xd8, 0xed, 0x19, 0x16,
+    0xd5, 0x71, 0x41, 0xf3, 0x6f, 0x28, 0xfa, 0x53, 0x89, 0x27, 0xff, 0xd8, 0x42, 0x03, 0x51, 0xd9,
+    0x26, 0xda, 0xe9, 0x9a, 0xbe, 0x45, 0x12, 0xd9, 0xbe, 0x79, 0xd6, 0x66, 0xb3, 0x75, 0xeb, 0x87,
+    0xea, 0x99, 0x44, 0x01, 0x06, 0xce, 0x38, 0x2d, 0xef, 0x70, 0x38, 0x24, 0x6f, 0x63, 0x1f, 0xf2,
+    0x9b, 0xec, 0x0c, 0xcd, 0x44, 0x36, 0x55, 0x3e, 0x10, 0x16, 0x5e, 0x82, 0x7a, 0x31, 0x58, 0x32,
+    0x7d, 0x69, 0xaf, 0x7b, 0x5e, 0xdc, 0xbf, 0xf4, 0x3b, 0xed, 0xb4, 0xcf, 0xdd, 0xee, 0x0e, 0x0c,
+    0x4b, 0x4c, 0x46, 0x0d, 0x94, 0x66, 0xcd, 0xc2, 0x36, 0xf9, 0x8a, 0x18, 0xaa, 0xc8, 0xf9, 0x39,
+    0x6e, 0x00, 0x66, 0x92, 0xaf, 0x49, 0x3b, 0x77, 0x61, 0x6d, 0x32, 0x25, 0xed, 0x76, 0xe5, 0x7c,
+    0xac, 0x11, 0x99, 0x6d, 0xe5, 0xee, 0x84, 0xcd, 0x4c, 0xfd, 0x44, 0x74, 0xb6, 0x6f, 0xe9, 0x46,
+    0x57, 0xe8, 0x84, 0x56, 0xf7, 0x89, 0xab, 0xdc, 0x98, 0x6b, 0x58, 0x6f, 0x3a, 0x9e, 0x6e, 0xb2,
+    0x20, 0xbb, 0x93, 0xf7, 0x57, 0xe9, 0x8d, 0xc5, 0x4e, 0xdb, 0xde, 0x50, 0x4d, 0xf5, 0x16, 0xf1,
+    0x1a, 0xb4, 0x5f, 0x91, 0x76, 0xeb, 0x57, 0x24, 0xd4, 0x36, 0x45, 0x31, 0x87, 0x91, 0x89, 0x43,
+    0xd2, 0x57, 0x2b, 0x71, 0x3b, 0x04, 0x43, 0x58, 0x5f, 0x99, 0x29, 0xcd, 0x40, 0xa5, 0xc3, 0x56,
+    0xc8, 0x4f, 0xc0, 0x3a, 0x80, 0xb1, 0xc1, 0xcc, 0x7f, 0xfd, 0x8b, 0x54, 0x76, 0x59, 0x61, 0x66,
+    0x06, 0xe0, 0x22, 0x60, 0xe5, 0xf5, 0x46, 0xf4, 0x3b, 0x2f, 0x7f, 0x19, 0xef, 0x8c, 0x7d, 0x37,
+    0x59, 0x16, 0x1b, 0x8b, 0x1b, 0xf2, 0x2c, 0xb8, 0x7f, 0x23, 0xc8, 0x9c, 0x03, 0x28, 0x41, 0x7b,
+    0x33, 0x68, 0x4f, 0xcd, 0x59, 0xf7, 0x82, 0x76, 0x42, 0x86, 0xdc, 0x7a, 0x28, 0xae, 0x75, 0xa8,
+    0xda, 0x09, 0x15, 0x70, 0xd6, 0x81, 0xa9, 0x46, 0x2b, 0x31, 0x9e, 0x11, 0xeb, 0xc4, 0xcb, 0x7a,
+    0xc2, 0x17, 0x55, 0xd9, 0x56, 0xdd, 0x4e, 0x23, 0xcd, 0x79, 0x99, 0x0c, 0x24, 0x63, 0xd0, 0x7a,
+    0x6e, 0x2f, 0x93, 0x20, 0xd1, 0x93, 0x76, 0x79, 0xdf, 0x1f, 0x09, 0x0b, 0x14, 0x7b, 0x24, 0xe0,
+    0x07, 0x15, 0xe0, 0xdb, 0xe1, 0xf0, 0x78, 0x13, 0xca, 0x61, 0x95, 0x44, 0xe7, 0x05, 0x35, 0xb0,
+    0x35, 0x8f, 0x46, 0x8a, 0xc8, 0x04, 0x2f, 0x5c, 0x12, 0xbd, 0x62, 0x85, 0x53, 0x65, 0x22, 0xec,
+    0xc8, 0x2d, 0x9e, 0xd2, 0x4e, 0xc9, 0x10, 0x9b, 0x74, 0x50, 0x51, 0xf9, 0xf6, 0x13, 0xf0, 0xb3,
+    0x08, 0x07, 0xa0, 0x40, 0xa1, 0x6c, 0xcf, 0xce, 0x09, 0x85, 0xf8, 0x47, 0x6e, 0xb9, 0x5e, 0x91,
+    0xdb, 0x15, 0xd5, 0x64, 0x05, 0xf5, 0xd4, 0x9c, 0x31, 0x6c, 0x5d, 0x22, 0x58, 0x25, 0xc8, 0x82,
+    0xca, 0x9e, 0x01, 0x75, 0xcb, 0x48, 0x2c, 0x82, 0xa0, 0x08, 0xe9, 0x76, 0xc5, 0x41, 0xd3, 0x4c,
+    0x4b, 0x10, 0x8b, 0x1e, 0x48, 0x0f, 0x94, 0xf1, 0x13, 0xb8, 0x4e, 0x32, 0x95, 0x04, 0x1a, 0xea,
+    0x3a, 0x73, 0x7f, 0x9b, 0x00, 0x5c, 0x20, 0xf0, 0x9e, 0x60, 0x5d, 0x0d, 0xf4, 0x6f, 0xc6, 0x1c,
+    0x84, 0x8d, 0x3b, 0xec, 0x24, 0x32, 0xe8, 0x91, 0x80, 0x2b, 0xfd, 0xd2, 0xef, 0x01, 0x14, 0x28,
+    0x42, 0x81, 0x00, 0x16, 0xc6, 0xfa, 0xfe, 0x1a, 0xf8, 0x56, 0xd5, 0x8b, 0x05, 0x83, 0x1d, 0xe3,
+    0x9a, 0xee, 0x86, 0x24, 0x06, 0x80, 0x30, 0xea, 0x48, 0x72, 0x3e, 0x23, 0x72, 0xf0, 0x9b, 0x12,
+    0x51, 0xa7, 0x5b, 0x37, 0x49, 0xe1, 0xa4, 0x0f, 0xce, 0xe4, 0x13, 0x5d, 0xc8, 0x0a, 0xc5, 0xe4,
+    0x90, 0x35, 0x7e, 0xa9, 0x41, 0xba, 0xd3, 0x81, 0x82, 0x64, 0xa4, 0xd3, 0xa1, 0x3d, 0x32, 0xef,
+    0x22, 0xb8, 0xf9, 0x40, 0x2a, 0xc5, 0x49, 0x9f, 0x50, 0xf3, 0xa1, 0xbb, 0x6d, 0x39, 0xc4, 0xf1,
+    0x4b, 0x0a, 0x7b, 0xc1, 0xfb, 0x4d, 0x86, 0x1c, 0x40, 0xfb, 0xd5, 0x79, 0xca, 0x01, 0x33, 0x8a,
+    0x37, 0x95, 0x6a, 0xc0, 0xa0, 0x01, 0xa9, 0x41, 0x26, 0x88, 0x6e, 0xcd, 0x5e, 0xcc, 0xaf, 0x90,
+    0x20, 0xd0, 0xb6, 0xa3, 0x05, 0x88, 0xb7, 0x0f, 0x0a, 0x17, 0xa6, 0xd3, 0xfb, 0x55, 0x79, 0xcb,
+    0xd1, 0xf6, 0x13, 0x4d, 0x4f, 0x37, 0xf2, 0xc5, 0x60, 0x30, 0xb0, 0xd9, 0x46, 0x0d, 0x57, 0xcc,
+    0xd6, 0x98, 0xbe, 0xe6, 0x21, 0x13, 0x09, 0x70, 0xc5, 0x70, 0xa4, 0x28, 0xe2, 0x01, 0x94, 0xb9,
+    0x5c, 0x77, 0xda, 0x5f, 0xb7, 0xbb, 0x3f, 0x8f, 0x7e, 0x6d, 0x12, 0x78, 0x0f, 0xaf, 0x98, 0xd4,
+    0x6c, 0xfb, 0xa3, 0x73, 0xb4, 0xce, 0x04, 0x2d, 0x8e, 0xee, 0x80, 0x47, 0x11, 0x93, 0xdf, 0x5d,
+    0xbf, 0xfa, 0x1e, 0xc4, 0xba, 0xc2, 0x28, 0xb0, 0x3f, 0x3b, 0xcc, 0x8d, 0x93, 0xd6, 0x0c, 0xdd,
+    0x60, 0x4e, 0x29, 0x06, 0xcd, 0x5a, 0xa6, 0x7c, 0x74, 0xa8, 0x9e, 0x87, 0xd6, 0xda, 0x61, 0xf5,
+    0xba, 0xb7, 0xcf, 0x46, 0x5c, 0x7b, 0x58, 0x1c, 0x1f, 0x6f, 0xdf, 0xc3, 0xa5, 0x94, 0x90, 0xed,
+    0xd2, 0x20, 0x4d, 0xdd, 0x1b, 0x76, 0xe0, 0xbc, 0x39, 0xbb, 0x4e, 0x1a, 0xcd, 0x25, 0xb8, 0x0b,
+    0x2a, 0x55, 0xc7, 0xe8, 0x7b, 0x65, 0x4f, 0x92, 0x61, 0x17, 0x8c, 0x18, 0x9b, 0x98, 0x91, 0xfe,
+    0xd1, 0x08, 0xe3, 0xc6, 0x5f, 0x9e, 0x3c, 0x3b, 0x7e, 0xfa, 0xec, 0xd4, 0xf9, 0x03, 0x82, 0x89,
+    0x8b, 0x29, 0x19, 0x80, 0xa7, 0x5b, 0x00, 0x1c, 0x6d, 0x03, 0x70, 0x52, 0x07, 0xe0, 0xa8, 0x00,
+    0xa0, 0x3c, 0xe1, 0xa8, 0x3a, 0x61, 0x0b, 0x47, 0x4a, 0x27, 0x7e, 0xd5, 0xab, 0xd6, 0x75, 0x71,
+    0x22, 0x3b, 0xd7, 0x68, 0x6f, 0x97, 0xef, 0x4e, 0x3a, 0x9a, 0x99, 0x2c, 0x1e, 0xae, 0x31, 0x55,
+    0x67, 0xb8, 0xb9, 0x6d, 0xb6, 0x4d, 0xc8, 0xf8, 0x5a, 0xb2, 0x05, 0x38, 0xa6, 0xd5, 0xf9, 0xb8,
+    0xdd, 0x23, 0x6b, 0x92, 0x7a, 0x24, 0x72, 0x6b, 0x6b, 0xee, 0x25, 0x8b, 0x75, 0x70, 0xba, 0xac,
+    0x74, 0x7e, 0x8f, 0x69, 0x27, 0xf0, 0xa4, 0xf3, 0x4b, 0x1b, 0x6d, 0x27, 0x1a, 0xe0, 0xe1, 0x20,
+    0xb8, 0x40, 0x53, 0x4c, 0x76, 0x86, 0xed, 0xe1, 0xb2, 0x47, 0x5a, 0xbf, 0xfc, 0xd2, 0x6e, 0x75,
+    0xd1, 0x9a, 0x7e, 0xc1, 0x23, 0x7e, 0x87, 0x2a, 0xa6, 0x3e, 0xac, 0x54, 0x33, 0x9b, 0x26, 0xb9,
+    0x49, 0x4b, 0xa2, 0x01, 0x8b, 0x3c, 0x79, 0x1f, 0xe3, 0x95, 0x78, 0x23, 0x61, 0x3c, 0x90, 0x7a,
+    0x7a, 0x78, 0x4a, 0xd2, 0xf4, 0x24, 0xc7, 0x6b, 0x0d, 0xd6, 0x14, 0xd6, 0x0e, 0x24, 0xa9, 0xc2,
+    0xae, 0xcc, 0xac, 0x22, 0x2a, 0xab, 0xe8, 0x16, 0x59, 0x41, 0xe9, 0x23, 0xeb, 0xe6, 0x0b, 0x40,
+    0x9d, 0x8c, 0xfe, 0x08, 0xfc, 0x7c, 0x2d, 0xc0, 0x39, 0x12, 0xa0, 0xd2, 0x1c, 0x36, 0x4a, 0x50,
+    0x15, 0x23, 0x9b, 0xf6, 0x36, 0x0b, 0xcb, 0xb9, 0x87, 0xd4, 0xef, 0xac, 0x50, 0x38, 0x19, 0x94,
+    0xc9, 0xa4, 0xf8, 0x20, 0x22, 0x7c, 0xdc, 0x31, 0x17, 0xcc, 0xce, 0x48, 0x61, 0xb5, 0xf9, 0x75,
+    0xaa, 0x4e, 0x77, 0xbb, 0xc2, 0x9b, 0xb3, 0xc1, 0x5d, 0x49, 0x2b, 0x9c, 0xeb, 0x3d, 0xba, 0xba,
+    0xfb, 0xa5, 0x73, 0xc7, 0xec, 0x10, 0x14, 0xf5, 0x7f, 0x2e, 0x67, 0x67, 0x2a, 0xa4, 0x41, 0x30,
+    0xeb, 0x5c, 0x2a, 0x2d, 0x88, 0x16, 0x21, 0x25, 0xff, 0x3e, 0x02, 0xfe, 0x2e, 0x21, 0xe9, 0x31,
+    0x9d, 0x5a, 0xfb, 0x7a, 0x17, 0x4b, 0x81, 0x2d, 0x94, 0x8d, 0xa5, 0xb8, 0xa7, 0x1e, 0xf1, 0x1f,
+    0xc1, 0x5e, 0x90, 0xa5, 0xd6, 0x5e, 0xfc, 0x01, 0x1e, 0x7a, 0x31, 0xa5, 0x1a, 0x4c, 0xa6, 0x47,
+    0xb2, 0xb9, 0x68, 0x13, 0x8f, 0x67, 0x5b, 0xeb, 0x83, 0xdd, 0x35, 0xf4, 0xc7, 0xb5, 0x20, 0xff,
+    0x53, 0x2c, 0xc8, 0xaf, 0x1c, 0x33, 0xef, 0x66, 0x4c, 0xc8, 0x5a, 0x64, 0x69, 0xcf, 0x74, 0x71,
+    0xf6, 0xd1, 0x5b, 0x73, 0x62, 0x5c, 0x30, 0x2b, 0x7c, 0xdc, 0xbd, 0x9c, 0x7b, 0x97, 0x16, 0x14,
+    0xd9, 0x6a, 0x7c, 0xdc, 0xab, 0x18, 0x4c, 0xdb, 0x00, 0xdd, 0x81, 0x31, 0x91, 0x41, 0x7a, 0x6c,
+    0x60, 0xba, 0x3a, 0xf8, 0x8b, 0x26, 0xed, 0x07, 0x00, 0x73, 0x17, 0x39, 0x0f, 0xa4, 0xac, 0x9f,
+    0xb2, 0xa7, 0x0c, 0xac, 0xcc, 0xa4, 0x72, 0x79, 0x73, 0x0d, 0xf5, 0x4b, 0x4c, 0x97, 0x50, 0x1d,
+    0x68, 0x00, 0xb2, 0xc0, 0x5a, 0x42, 0x69, 0xaa, 0xb9, 0x07, 0x99, 0x2d, 0x93, 0x37, 0xe0, 0xcc,
+    0x97, 0x7f, 0x70, 0x28, 0x26, 0x7c, 0xb2, 0x90, 0x22, 0x24, 0x0b, 0x50, 0xa5, 0x15, 0x64, 0xc4,
+    0x90, 0xbf, 0x17, 0xa1, 0xc4, 0x4c, 0xa6, 0xd6, 0x47, 0xb0, 0x09, 0x67, 0xeb, 0x0d, 0xb3, 0x60,
+    0x88, 0x37, 0xc1, 0x3f, 0x2b, 0xd7, 0x0d, 0x6d, 0x33, 0xd8, 0x2e, 0xe7, 0x66, 0x5b, 0xeb, 0x06,
+    0x3b, 0x01, 0x57, 0xda, 0x3c, 0xbd, 0x96, 0x21, 0xf9, 0x15, 0xd8, 0x0d, 0x46, 0xe0, 0xe2, 0xf4,
+    0xcf, 0x16, 0xbc, 0x03, 0x77, 0x5c, 0x4d, 0x0f, 0x4b, 0xa9, 0xe1, 0xc7, 0x62, 0x41, 0x0d, 0x5b,
+    0x7c, 0x69, 0xff, 0x3a, 0x08, 0xff, 0x83, 0x11, 0xfc, 0x73, 0x22, 0x9f, 0x15, 0xf2, 0xed, 0xe2,
+    0xe5, 0xb8, 0xd3, 0xec, 0x7e, 0x70, 0xda, 0x08, 0x3c, 0x1b, 0xda, 0x9b, 0xc1, 0x67, 0x43, 0xfb,
+    0xc7, 0x4b, 0xfe, 0x0f, 0xb8, 0xfd, 0x96, 0x54, 0xd4, 0x44, 0x00, 0x00,
+};
+
+#endif // PORTAL_HTML_H
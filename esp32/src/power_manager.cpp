@@ -0,0 +1,189 @@
+#include "power_manager.h"
+#include "debug_log.h"
+#include "display.h"
+#include <esp_pm.h>
+
+PowerManager Power;
+
+static const PowerProfileConfig PROFILES[] = {
+    //  name           wifiSleep          light  adaptTx  bright dim  dimAfter  offAfter  poll
+    { "performance", WIFI_PS_NONE,      false, false,   128,   128, 0,        0,        5  },
+    { "balanced",    WIFI_PS_MIN_MODEM, false, true,    128,   32,  15000,    0,        10 },
+    { "saver",       WIFI_PS_MAX_MODEM, true,  true,    96,    16,  10000,    30000,    20 },
+};
+
+// Lowest to highest; adaptive TX steps one level per RSSI check
+static const wifi_power_t TX_LEVELS[] = {
+    WIFI_POWER_8_5dBm,
+    WIFI_POWER_11dBm,
+    WIFI_POWER_13dBm,
+    WIFI_POWER_15dBm,
+    WIFI_POWER_17dBm,
+    WIFI_POWER_19_5dBm
+};
+static const uint8_t TX_MAX_LEVEL = sizeof(TX_LEVELS) / sizeof(TX_LEVELS[0]) - 1;
+
+void PowerManager::begin(const char* profile) {
+    _profile = POWER_BALANCED;
+    for (uint8_t i = 0; i < sizeof(PROFILES) / sizeof(PROFILES[0]); i++) {
+        if (profile != nullptr && strcmp(profile, PROFILES[i].name) == 0) {
+            _profile = (PowerProfile)i;
+        }
+    }
+
+    LOG_I(POWER, "Profile: %s", getProfileName());
+
+    _panel = PANEL_ON;
+    _lastActivity = millis();
+    Display.setBrightness(cfg().brightness);
+
+    applyWiFi();
+    configureLightSleep();
+}
+
+const PowerProfileConfig& PowerManager::cfg() {
+    return PROFILES[_profile];
+}
+
+PowerProfile PowerManager::getProfile() {
+    return _profile;
+}
+
+const char* PowerManager::getProfileName() {
+    return cfg().name;
+}
+
+// ============================================
+// Radio
+// ============================================
+
+void PowerManager::applyWiFi() {
+    // Modem sleep keeps the association and wakes for every DTIM beacon
+    // (max modem sleep: every listen interval), so queued frames, the
+    // 20 s heartbeat and the WebSocket ping all still go out on time
+    WiFi.setSleep(cfg().wifiSleep);
+    resetTxPower();
+
+    LOG_I(POWER, "WiFi sleep: %s, TX power: %s",
+          cfg().wifiSleep == WIFI_PS_NONE ? "DISABLED" :
+          cfg().wifiSleep == WIFI_PS_MIN_MODEM ? "MODEM (DTIM)" : "MAX MODEM",
+          cfg().adaptiveTx ? "ADAPTIVE" : "MAX (19.5dBm)");
+}
+
+void PowerManager::configureLightSleep() {
+    esp_pm_config_t pm = {};
+    pm.max_freq_mhz = getCpuFrequencyMhz();
+    pm.min_freq_mhz = cfg().lightSleep ? getXtalFrequencyMhz() : getCpuFrequencyMhz();
+    pm.light_sleep_enable = cfg().lightSleep;
+
+    // Needs CONFIG_PM_ENABLE (and tickless idle for light sleep) in the
+    // framework build; without it we keep modem sleep only
+    esp_err_t err = esp_pm_configure(&pm);
+    if (err != ESP_OK) {
+        if (cfg().lightSleep) {
+            LOG_I(POWER, "Light sleep unavailable (%s), using modem sleep only",
+                  esp_err_to_name(err));
+        }
+        return;
+    }
+
+    if (cfg().lightSleep) {
+        LOG_I(POWER, "Automatic light sleep enabled (%d-%d MHz)",
+              pm.min_freq_mhz, pm.max_freq_mhz);
+    }
+}
+
+void PowerManager::adaptTxPower(int rssi) {
+    if (!cfg().adaptiveTx) return;
+
+    uint8_t level = _txLevel;
+    if (rssi < POWER_RSSI_CRITICAL) {
+        level = TX_MAX_LEVEL;
+    } else if (rssi < POWER_RSSI_WEAK && level < TX_MAX_LEVEL) {
+        level++;
+    } else if (rssi > POWER_RSSI_STRONG && level > 0) {
+        level--;
+    }
+
+    if (level != _txLevel) {
+        setTxLevel(level);
+        LOG_D(POWER, "RSSI %d dBm -> TX power %.1f dBm",
+              rssi, TX_LEVELS[_txLevel] / 4.0f);
+    }
+}
+
+void PowerManager::resetTxPower() {
+    // Start (and re-associate) at full power; adaptation steps down
+    setTxLevel(TX_MAX_LEVEL);
+}
+
+void PowerManager::setTxLevel(uint8_t level) {
+    _txLevel = level;
+    WiFi.setTxPower(TX_LEVELS[level]);
+}
+
+uint16_t PowerManager::getNetPollInterval() {
+    return cfg().netPollInterval;
+}
+
+// ============================================
+// Panel
+// ============================================
+
+bool PowerManager::wake() {
+    _lastActivity = millis();
+    if (_panel == PANEL_ON) return false;
+
+    if (_panel == PANEL_OFF) {
+        Display.wakeup();
+    }
+    Display.setBrightness(cfg().brightness);
+    _panel = PANEL_ON;
+
+    LOG_I(POWER, "Panel awake");
+    return true;
+}
+
+void PowerManager::updatePanel(bool idleScreen) {
+    // Alerts and info screens always stay at full brightness
+    if (!idleScreen) {
+        _lastActivity = millis();
+        return;
+    }
+
+    unsigned long idle = millis() - _lastActivity;
+
+    if (cfg().panelOffAfter > 0 && idle >= cfg().panelOffAfter && _panel != PANEL_OFF) {
+        Display.sleep();
+        _panel = PANEL_OFF;
+        LOG_I(POWER, "Panel asleep");
+    } else if (cfg().dimAfter > 0 && idle >= cfg().dimAfter && _panel == PANEL_ON) {
+        Display.setBrightness(cfg().dimBrightness);
+        _panel = PANEL_DIMMED;
+        LOG_I(POWER, "Backlight dimmed");
+    }
+}
+
+unsigned long PowerManager::msUntilPanelStep(bool idleScreen) {
+    if (!idleScreen) return ULONG_MAX;
+
+    unsigned long idle = millis() - _lastActivity;
+    unsigned long next = ULONG_MAX;
+
+    if (_panel == PANEL_ON && cfg().dimAfter > 0) {
+        next = cfg().dimAfter > idle ? cfg().dimAfter - idle : 0;
+    }
+    if (_panel != PANEL_OFF && cfg().panelOffAfter > 0) {
+        unsigned long off = cfg().panelOffAfter > idle ? cfg().panelOffAfter - idle : 0;
+        next = min(next, off);
+    }
+    return next;
+}
+
+PanelPower PowerManager::getPanelState() {
+    return _panel;
+}
+
+uint8_t PowerManager::getBrightness() {
+    return cfg().brightness;
+}
@@ -0,0 +1,77 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "config.h"
+
+// ============================================
+// Power Manager
+// Power profiles for battery shifts: WiFi modem sleep, automatic light
+// sleep, RSSI-adaptive TX power and idle-screen backlight/panel sleep.
+// ============================================
+
+enum PowerProfile : uint8_t {
+    POWER_PERFORMANCE,   // Radio always on, full TX power (previous behaviour)
+    POWER_BALANCED,      // Modem sleep every DTIM, dim when idle
+    POWER_SAVER          // Max modem sleep + light sleep, panel off when idle
+};
+
+enum PanelPower : uint8_t {
+    PANEL_ON,
+    PANEL_DIMMED,
+    PANEL_OFF
+};
+
+struct PowerProfileConfig {
+    const char* name;
+    wifi_ps_type_t wifiSleep;
+    bool lightSleep;            // Automatic light sleep when all tasks block
+    bool adaptiveTx;            // Lower TX power while the AP is close
+    uint8_t brightness;
+    uint8_t dimBrightness;
+    unsigned long dimAfter;     // Idle screen -> dimmed (0 = never)
+    unsigned long panelOffAfter; // Idle screen -> panel asleep (0 = never)
+    uint16_t netPollInterval;   // ms between WebSocket polls
+};
+
+// TX power adaptation thresholds (dBm)
+#define POWER_RSSI_STRONG   -55   // Above this, step TX power down
+#define POWER_RSSI_WEAK     -70   // Below this, step TX power up
+#define POWER_RSSI_CRITICAL -80   // Below this, jump straight to max
+
+class PowerManager {
+public:
+    // Apply the configured profile ("performance", "balanced", "saver")
+    void begin(const char* profile);
+
+    PowerProfile getProfile();
+    const char* getProfileName();
+
+    // WiFi (network task / WiFi manager)
+    void applyWiFi();
+    void adaptTxPower(int rssi);
+    void resetTxPower();
+    uint16_t getNetPollInterval();
+
+    // Panel (UI task)
+    bool wake();                        // True if the panel was dimmed or off
+    void updatePanel(bool idleScreen);
+    unsigned long msUntilPanelStep(bool idleScreen);
+    PanelPower getPanelState();
+    uint8_t getBrightness();            // Full brightness of the profile
+
+private:
+    PowerProfile _profile = POWER_PERFORMANCE;
+    PanelPower _panel = PANEL_ON;
+    unsigned long _lastActivity = 0;
+    uint8_t _txLevel = 0;               // Index into the TX power table
+
+    const PowerProfileConfig& cfg();
+    void configureLightSleep();
+    void setTxLevel(uint8_t level);
+};
+
+extern PowerManager Power;
+
+#endif // POWER_MANAGER_H
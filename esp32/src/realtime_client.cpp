@@ -0,0 +1,344 @@
+#include "realtime_client.h"
+#include "debug_log.h"
+#include "metrics.h"
+
+SupabaseRealtimeClient Realtime;
+
+// Alert types the watch shows; the rest of the table is for dashboards
+// (same list as the box, RealtimeManager.handleMenuProNotification)
+static const char* RT_ALERT_TYPES[] = { "waiter_called", "bill_ready", "payment_confirmed" };
+
+void SupabaseRealtimeClient::begin(const char* url, const char* apiKey, const char* restaurantId) {
+    // Host only: drop the scheme, any port and any path
+    const char* host = strstr(url, "://");
+    host = host ? host + 3 : url;
+    size_t hostLen = strcspn(host, ":/");
+    hostLen = min(hostLen, sizeof(_host) - 1);
+    memcpy(_host, host, hostLen);
+    _host[hostLen] = '\0';
+
+    strncpy(_apiKey, apiKey, sizeof(_apiKey) - 1);
+    snprintf(_path, sizeof(_path), RT_PATH "?apikey=%s&vsn=" RT_VSN, apiKey);
+    snprintf(_topic, sizeof(_topic), "realtime:bitsperwatch-%s", restaurantId);
+    snprintf(_filter, sizeof(_filter), "restaurant_id=eq.%s", restaurantId);
+
+    LOG_I(RT, "Initializing Supabase Realtime at %s (restaurant %s)", _host, restaurantId);
+
+    // Only the keys we use are kept when parsing; rows carry every column
+    if (_rxFilter.isNull()) {
+        _rxFilter["event"] = true;
+        _rxFilter["ref"] = true;
+        JsonObject payload = _rxFilter["payload"].to<JsonObject>();
+        payload["status"] = true;
+        payload["message"] = true;
+        payload["response"]["reason"] = true;
+        JsonObject data = payload["data"].to<JsonObject>();
+        data["type"] = true;
+        JsonObject record = data["record"].to<JsonObject>();
+        record["id"] = true;
+        record["table_number"] = true;
+        record["type"] = true;
+        record["title"] = true;
+        record["message"] = true;
+        record["priority"] = true;
+
+        // A filter that didn't fit keeps nothing: joins and alerts would
+        // all parse to null
+        _rxFilterOk = !_rxFilter.overflowed() && _rxFilterArena.getFailures() == 0;
+        if (!_rxFilterOk) {
+            LOG_E(RT, "Parse filter doesn't fit its arena (%u/%u bytes), parsing unfiltered",
+                  (unsigned)_rxFilterArena.getUsed(), (unsigned)_rxFilterArena.getCapacity());
+        }
+    }
+
+    // Server certificate isn't pinned (the project host is configurable);
+    // beginSslWithCA is the place to add a root CA if that changes
+    _ws.beginSSL(_host, RT_PORT, _path);
+    _ws.onEvent([this](WStype_t type, uint8_t* payload, size_t length) {
+        handleEvent(type, payload, length);
+    });
+    _ws.setReconnectInterval(_currentBackoff);
+
+    LOG_I(RT, "- Channel %s, heartbeat %lus", _topic, RT_HEARTBEAT_INTERVAL / 1000);
+}
+
+void SupabaseRealtimeClient::loop() {
+    _ws.loop();
+    if (!_socketUp) return;
+
+    unsigned long now = millis();
+
+    // Join went unanswered: start over on a fresh socket
+    if (!_joined && _joinRef != 0 && now - _joinSentAt > RT_JOIN_TIMEOUT) {
+        dropSocket("join timeout");
+        return;
+    }
+
+    if (_heartbeatSentAt != 0 && now - _heartbeatSentAt > RT_HEARTBEAT_TIMEOUT) {
+        dropSocket("heartbeat timeout");
+        return;
+    }
+
+    if (now - _lastHeartbeat >= RT_HEARTBEAT_INTERVAL) {
+        sendHeartbeat();
+    }
+
+    // Coalesced acks / user actions
+    if (_joined && _acks.isDue()) {
+        sendAcks();
+    }
+}
+
+void SupabaseRealtimeClient::disconnect() {
+    _ws.disconnect();
+    _socketUp = false;
+    setJoined(false);
+}
+
+bool SupabaseRealtimeClient::isConnected() {
+    return _joined;
+}
+
+unsigned long SupabaseRealtimeClient::getReconnectAttempts() {
+    return _reconnectAttempts;
+}
+
+uint32_t SupabaseRealtimeClient::getRtt() {
+    return _rttMs;
+}
+
+void SupabaseRealtimeClient::onConnectionChange(std::function<void(bool)> callback) {
+    _onConnectionChange = callback;
+}
+
+// ============================================
+// Socket Events
+// ============================================
+
+void SupabaseRealtimeClient::handleEvent(WStype_t type, uint8_t* payload, size_t length) {
+    _rxUs = micros();          // Start of the notification latency trail
+
+    switch (type) {
+        case WStype_DISCONNECTED:
+            LOG_W(RT, "Disconnected from Supabase Realtime");
+            if (_socketUp) Metrics.count(METRIC_RT_RECONNECTS);
+            _socketUp = false;
+            _reconnectAttempts++;
+            setJoined(false);
+
+            _currentBackoff = min(_currentBackoff * 2, RT_MAX_BACKOFF);
+            _ws.setReconnectInterval(_currentBackoff);
+            LOG_I(RT, "Reconnect attempt %lu, next in %lu ms",
+                  _reconnectAttempts, _currentBackoff);
+            break;
+
+        case WStype_CONNECTED:
+            LOG_I(RT, "TLS socket open, joining channel");
+            _socketUp = true;
+            _heartbeatSentAt = 0;
+            _lastHeartbeat = millis();
+            sendJoin();
+            break;
+
+        case WStype_TEXT:
+            handleMessage(payload, length);
+            break;
+
+        case WStype_ERROR:
+            LOG_E(RT, "Error: %s", payload);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void SupabaseRealtimeClient::handleMessage(uint8_t* payload, size_t length) {
+    _rxDoc.clear();
+    _rxArena.reset();
+    DeserializationError error = _rxFilterOk
+        ? deserializeJson(_rxDoc, payload, length, DeserializationOption::Filter(_rxFilter))
+        : deserializeJson(_rxDoc, payload, length);
+
+    if (error) {
+        LOG_E(RT, "JSON parse error: %s (%u bytes, arena %u/%u)", error.c_str(),
+              (unsigned)length, (unsigned)_rxArena.getUsed(), (unsigned)_rxArena.getCapacity());
+        Metrics.count(METRIC_JSON_ERRORS);
+        return;
+    }
+
+    const char* event = _rxDoc["event"] | "";
+    JsonVariantConst body = _rxDoc["payload"];
+
+    if (strcmp(event, "postgres_changes") == 0) {
+        handleChange(body);
+    }
+    else if (strcmp(event, "phx_reply") == 0) {
+        // Refs go out as decimal strings; pushes from the server have none
+        handleReply(strtoul(_rxDoc["ref"] | "0", nullptr, 10), body);
+    }
+    else if (strcmp(event, "system") == 0) {
+        // Subscription status from the postgres_changes extension
+        LOG_I(RT, "System: %s (%s)", body["message"] | "", body["status"] | "");
+        if (strcmp(body["status"] | "", "error") == 0) {
+            dropSocket("subscription error");
+        }
+    }
+    else if (strcmp(event, "phx_error") == 0 || strcmp(event, "phx_close") == 0) {
+        dropSocket(event);
+    }
+}
+
+void SupabaseRealtimeClient::handleReply(uint32_t ref, JsonVariantConst payload) {
+    bool ok = strcmp(payload["status"] | "", "ok") == 0;
+
+    if (ref != 0 && ref == _heartbeatRef) {
+        _rttMs = millis() - _heartbeatSentAt;
+        _heartbeatSentAt = 0;
+        _heartbeatRef = 0;
+        return;
+    }
+
+    if (ref != 0 && ref == _joinRef) {
+        if (!ok) {
+            LOG_E(RT, "Join rejected: %s", payload["response"]["reason"] | "unknown");
+            dropSocket("join rejected");
+            return;
+        }
+
+        LOG_I(RT, "Joined %s (" RT_TABLE " INSERTs)", _topic);
+        _reconnectAttempts = 0;
+        _currentBackoff = RT_MIN_BACKOFF;  // Reset backoff once actually subscribed
+        _ws.setReconnectInterval(_currentBackoff);
+        setJoined(true);
+    }
+}
+
+void SupabaseRealtimeClient::handleChange(JsonVariantConst payload) {
+    JsonVariantConst record = payload["data"]["record"];
+    const char* alert = record["type"] | "";
+
+    bool shown = false;
+    for (const char* type : RT_ALERT_TYPES) {
+        if (strcmp(alert, type) == 0) {
+            shown = true;
+            break;
+        }
+    }
+    if (!shown) return;
+
+    // Rows have no epoch ms the latency monitor can use (and there is no
+    // box clock to sync with), so network latency isn't measured here
+    const char* message = record["message"] | "";
+    InboxItem* item = decodeFields(record["id"] | "", record["table_number"] | "", alert,
+                                   message[0] ? message : (record["title"] | ""),
+                                   record["priority"] | "medium", (uint64_t)millis(), _rxUs);
+
+    // Malformed, or the inbox is full: never queued, so no ack
+    if (item == nullptr) return;
+
+    queueAck(ACK_RECEIVED, item->data.id);
+    publishNotification(item);
+}
+
+// ============================================
+// Outgoing Frames
+// ============================================
+
+void SupabaseRealtimeClient::sendJoin() {
+    JsonDocument& doc = beginFrame(_topic, "phx_join");
+    _joinRef = _txRef;
+    _joinSentAt = millis();
+
+    JsonObject payload = doc["payload"].to<JsonObject>();
+    JsonObject config = payload["config"].to<JsonObject>();
+    config["broadcast"]["self"] = false;
+    config["presence"]["key"] = "";
+
+    JsonObject change = config["postgres_changes"].to<JsonArray>().add<JsonObject>();
+    change["event"] = "INSERT";
+    change["schema"] = "public";
+    change["table"] = RT_TABLE;
+    change["filter"] = (const char*)_filter;
+
+    // Anon key doubles as the access token (rows are read under its RLS role)
+    payload["access_token"] = (const char*)_apiKey;
+
+    sendFrame();
+}
+
+void SupabaseRealtimeClient::sendHeartbeat() {
+    JsonDocument& doc = beginFrame("phoenix", "heartbeat");
+    _heartbeatRef = _txRef;
+    doc["payload"].to<JsonObject>();
+
+    _lastHeartbeat = millis();
+    _heartbeatSentAt = max(_lastHeartbeat, 1UL);  // 0 is "none outstanding"
+    sendFrame();
+}
+
+void SupabaseRealtimeClient::sendAcks() {
+    // Broadcast on our own channel: whoever listens (dashboard, box)
+    // gets the same acks/displayed/dismissed lists the box receives
+    JsonDocument& doc = beginFrame(_topic, "broadcast");
+    JsonObject payload = doc["payload"].to<JsonObject>();
+    payload["type"] = "broadcast";
+    payload["event"] = "acks";
+
+    JsonObject frame = payload["payload"].to<JsonObject>();
+    frame["device_id"] = Storage.getDeviceId().c_str();
+    uint8_t count = _acks.copyInto(frame, ACK_BATCH_MAX);
+    if (!sendFrame()) return;   // Still pending: retried on the next loop
+
+    _acks.consume(count);
+    LOG_D(RT, "Broadcast %d acks in one frame", count);
+}
+
+JsonDocument& SupabaseRealtimeClient::beginFrame(const char* topic, const char* event) {
+    _txDoc.clear();
+    _txArena.reset();
+    _txDoc["topic"] = topic;
+    _txDoc["event"] = event;
+
+    // Phoenix refs are strings; replies echo them back
+    char ref[12];
+    _txRef = _nextRef++;
+    snprintf(ref, sizeof(ref), "%lu", (unsigned long)_txRef);
+    _txDoc["ref"] = ref;
+    return _txDoc;
+}
+
+bool SupabaseRealtimeClient::sendFrame() {
+    char buffer[RT_TX_BUFFER_SIZE];
+
+    if (_txDoc.overflowed() || measureJson(_txDoc) >= sizeof(buffer)) {
+        LOG_E(RT, "Outgoing frame too large, dropped (%s)",
+              (const char*)(_txDoc["event"] | "?"));
+        return false;
+    }
+
+    size_t len = serializeJson(_txDoc, buffer, sizeof(buffer));
+    return _ws.sendTXT(buffer, len);
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void SupabaseRealtimeClient::setJoined(bool joined) {
+    if (!joined) {
+        _joinRef = 0;
+        _heartbeatRef = 0;
+        _heartbeatSentAt = 0;
+    }
+    if (joined == _joined) return;
+
+    _joined = joined;
+    if (_onConnectionChange) _onConnectionChange(joined);
+}
+
+void SupabaseRealtimeClient::dropSocket(const char* reason) {
+    LOG_W(RT, "%s, reconnecting...", reason);
+    // The library reconnects after the backoff interval; we rejoin then
+    disconnect();
+}
@@ -0,0 +1,107 @@
+#ifndef REALTIME_CLIENT_H
+#define REALTIME_CLIENT_H
+
+#include <Arduino.h>
+#include <WebSocketsClient.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "storage.h"
+#include "json_arena.h"
+#include "transport.h"
+
+// ============================================
+// Supabase Realtime Client (direct mode)
+// The watch joins the restaurant's menu_pro_notifications feed itself
+// over a TLS WebSocket (Phoenix channel protocol, vsn 1.0.0), so alerts
+// no longer go through the box. Rows are decoded into inbox slots like
+// any other transport; acks go out as a channel broadcast.
+// ============================================
+
+#define RT_PORT                 443
+#define RT_PATH                 "/realtime/v1/websocket"
+#define RT_VSN                  "1.0.0"
+#define RT_TABLE                "menu_pro_notifications"
+
+#define RT_HEARTBEAT_INTERVAL   25000UL   // Phoenix closes sockets silent for ~60s
+#define RT_HEARTBEAT_TIMEOUT    10000UL   // Reply must arrive within this
+#define RT_JOIN_TIMEOUT         10000UL   // phx_join reply
+#define RT_MIN_BACKOFF          2000UL
+#define RT_MAX_BACKOFF          60000UL
+
+// Fixed JSON memory; rows carry every column, the filter keeps ours
+#define RT_RX_ARENA_SIZE        2048
+#define RT_TX_ARENA_SIZE        2048      // Slot pool + join config + access token
+#define RT_FILTER_ARENA_SIZE    2048      // Slot pool + the nested filter keys
+#define RT_TX_BUFFER_SIZE       1024
+
+class SupabaseRealtimeClient : public Transport {
+public:
+    SupabaseRealtimeClient() : Transport(SOURCE_REALTIME) {}
+
+    // url: "https://<project>.supabase.co"; key: anon key
+    void begin(const char* url, const char* apiKey, const char* restaurantId);
+    void loop();
+    void disconnect();
+
+    // Joined and subscribed, not just a socket
+    bool isConnected() override;
+
+    // Status
+    unsigned long getReconnectAttempts();
+    uint32_t getRtt();            // Last heartbeat round trip in ms, 0 = none yet
+
+    // Callback for connection status changes
+    void onConnectionChange(std::function<void(bool)> callback);
+
+private:
+    WebSocketsClient _ws;
+    bool _socketUp = false;
+    bool _joined = false;
+    bool _rxFilterOk = false;    // Parse filter built; parse unfiltered otherwise
+    unsigned long _reconnectAttempts = 0;
+    unsigned long _currentBackoff = RT_MIN_BACKOFF;
+    uint32_t _rxUs = 0;          // micros() when the current frame arrived
+
+    // Phoenix refs; replies are matched on these
+    uint32_t _nextRef = 1;
+    uint32_t _txRef = 0;             // Ref of the frame being built
+    uint32_t _joinRef = 0;
+    uint32_t _heartbeatRef = 0;
+    unsigned long _joinSentAt = 0;
+    unsigned long _heartbeatSentAt = 0;   // 0 = no heartbeat outstanding
+    unsigned long _lastHeartbeat = 0;
+    uint32_t _rttMs = 0;
+
+    char _host[96] = {0};
+    char _path[sizeof(RT_PATH) + 16 + sizeof(DeviceConfig::supabase_key)] = {0};
+    char _topic[16 + sizeof(DeviceConfig::restaurant_id)] = {0};
+    char _filter[16 + sizeof(DeviceConfig::restaurant_id)] = {0};
+    char _apiKey[sizeof(DeviceConfig::supabase_key)] = {0};
+
+    std::function<void(bool)> _onConnectionChange = nullptr;
+
+    // Preallocated decode/encode state
+    StaticJsonArena<RT_RX_ARENA_SIZE> _rxArena;
+    StaticJsonArena<RT_TX_ARENA_SIZE> _txArena;
+    StaticJsonArena<RT_FILTER_ARENA_SIZE> _rxFilterArena;
+    JsonDocument _rxDoc{&_rxArena};
+    JsonDocument _txDoc{&_txArena};
+    JsonDocument _rxFilter{&_rxFilterArena};
+
+    void handleEvent(WStype_t type, uint8_t* payload, size_t length);
+    void handleMessage(uint8_t* payload, size_t length);
+    void handleReply(uint32_t ref, JsonVariantConst payload);
+    void handleChange(JsonVariantConst payload);
+    void sendJoin();
+    void sendHeartbeat();
+    void sendAcks();
+    void setJoined(bool joined);
+    void dropSocket(const char* reason);
+
+    JsonDocument& beginFrame(const char* topic, const char* event);
+    bool sendFrame();
+};
+
+extern SupabaseRealtimeClient Realtime;
+
+#endif // REALTIME_CLIENT_H
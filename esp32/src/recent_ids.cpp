@@ -0,0 +1,67 @@
+#include "recent_ids.h"
+
+RecentIdCache RecentIds;
+
+static const uint32_t FNV_OFFSET = 2166136261UL;
+static const uint32_t FNV_PRIME = 16777619UL;
+
+bool RecentIdCache::checkAndRemember(const NotificationData& notif) {
+    uint32_t key = keyFor(notif);
+    if (key == 0) return false;
+
+    for (uint8_t i = 0; i < RECENT_IDS_CAPACITY; i++) {
+        if (_keys[i] == key) {
+            _duplicates++;
+            return true;
+        }
+    }
+
+    _keys[_next] = key;
+    _next = (_next + 1) % RECENT_IDS_CAPACITY;
+    return false;
+}
+
+void RecentIdCache::clear() {
+    memset(_keys, 0, sizeof(_keys));
+    _next = 0;
+}
+
+unsigned long RecentIdCache::getDuplicateCount() {
+    return _duplicates;
+}
+
+uint32_t RecentIdCache::keyFor(const NotificationData& notif) {
+    uint32_t hash = FNV_OFFSET;
+
+    if (notif.id[0] != '\0') {
+        hash = fnv1a(hash, notif.id);
+    } else {
+        // No id from the box - fall back to what it sent, identical in the
+        // WebSocket and BLE copies. Nothing local (receive time) goes in
+        if (notif.table[0] == '\0' && notif.type[0] == '\0' &&
+            notif.message[0] == '\0' && notif.timestamp == 0) {
+            return 0;
+        }
+
+        char ts[24];
+        snprintf(ts, sizeof(ts), "%llu", (unsigned long long)notif.timestamp);
+        hash = fnv1a(hash, notif.table);
+        hash = fnv1a(hash, "|");
+        hash = fnv1a(hash, notif.type);
+        hash = fnv1a(hash, "|");
+        hash = fnv1a(hash, notif.message);
+        hash = fnv1a(hash, "|");
+        hash = fnv1a(hash, ts);
+    }
+
+    // 0 marks an empty slot (and "no key")
+    return hash != 0 ? hash : 1;
+}
+
+uint32_t RecentIdCache::fnv1a(uint32_t hash, const char* str) {
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
@@ -0,0 +1,36 @@
+#ifndef RECENT_IDS_H
+#define RECENT_IDS_H
+
+#include <Arduino.h>
+#include "notification_queue.h"
+
+// ============================================
+// Recent Notification ID Cache
+// Fixed-size set of hashed notification keys, shared by the WebSocket
+// and BLE paths so an alert delivered over both is shown only once.
+// ============================================
+
+#define RECENT_IDS_CAPACITY 32   // Oldest key is overwritten when full
+
+class RecentIdCache {
+public:
+    // Returns true if this notification was already seen; otherwise
+    // remembers it and returns false. One with nothing to key on (no id,
+    // table, alert, message or box timestamp) is never a duplicate
+    bool checkAndRemember(const NotificationData& notif);
+
+    void clear();
+    unsigned long getDuplicateCount();
+
+private:
+    uint32_t _keys[RECENT_IDS_CAPACITY] = {0};
+    uint8_t _next = 0;
+    unsigned long _duplicates = 0;
+
+    static uint32_t keyFor(const NotificationData& notif);   // 0: nothing to key on
+    static uint32_t fnv1a(uint32_t hash, const char* str);
+};
+
+extern RecentIdCache RecentIds;
+
+#endif // RECENT_IDS_H
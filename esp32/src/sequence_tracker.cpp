@@ -0,0 +1,150 @@
+#include "sequence_tracker.h"
+#include "debug_log.h"
+
+SequenceTracker Sequences;
+
+void SequenceTracker::onReceived(uint32_t seq, uint32_t prevSeq) {
+    if (seq == 0) return;
+
+    portENTER_CRITICAL(&_mux);
+
+    // Nothing to compare with until a box that numbers has registered;
+    // at or below _last is a replay or the other link's copy
+    if (_epoch == 0 || seq <= _last) {
+        portEXIT_CRITICAL(&_mux);
+        return;
+    }
+
+    if (prevSeq != 0 && prevSeq + 1 < seq) {
+        skipFiltered(prevSeq, seq);
+    }
+
+    // Further ahead than the box keeps: what falls out of the window
+    // can't be resent anyway
+    uint32_t offset = seq - _last - 1;
+    if (offset >= SEQ_WINDOW) {
+        skipTo(seq - SEQ_WINDOW);
+        offset = SEQ_WINDOW - 1;
+    }
+
+    _window |= 1ULL << offset;
+    advance();
+    if (_window != 0 && _gapSince == 0) {
+        _gapSince = max(millis(), 1UL);
+    }
+
+    portEXIT_CRITICAL(&_mux);
+}
+
+void SequenceTracker::onRegistered(uint32_t epoch, uint32_t seq) {
+    portENTER_CRITICAL(&_mux);
+
+    if (epoch != _epoch) {
+        // First registration since boot, or the box restarted: its
+        // numbers start over and ours mean nothing to it
+        _epoch = epoch;
+        _last = seq;
+        _window = 0;
+        _gapSince = 0;
+        _askedAt = 0;
+    } else if (seq > _last) {
+        // Below `seq` the box has nothing left to replay
+        skipTo(seq);
+        advance();
+    }
+
+    portEXIT_CRITICAL(&_mux);
+
+    LOG_I(SEQ, "Epoch %lu, resuming after #%lu", (unsigned long)epoch, (unsigned long)seq);
+}
+
+void SequenceTracker::onResynced(uint32_t to) {
+    portENTER_CRITICAL(&_mux);
+    if (to > _last) {
+        skipTo(to);
+        advance();
+    }
+    _askedAt = 0;
+    portEXIT_CRITICAL(&_mux);
+}
+
+bool SequenceTracker::takeGap(uint32_t& from, uint32_t& to) {
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&_mux);
+    bool due = _window != 0 && now - _gapSince >= SEQ_GAP_GRACE &&
+               (_askedAt == 0 || now - _askedAt >= SEQ_RESYNC_RETRY);
+    if (due) {
+        // Bit 0 is clear (advance() would have taken it): the hole runs
+        // up to the first number received past it
+        from = _last + 1;
+        to = _last + __builtin_ctzll(_window);
+        _askedAt = max(now, 1UL);
+        _resyncs++;
+    }
+    portEXIT_CRITICAL(&_mux);
+
+    if (due) {
+        LOG_W(SEQ, "Missing #%lu-#%lu, asking the box", (unsigned long)from, (unsigned long)to);
+    }
+    return due;
+}
+
+uint32_t SequenceTracker::getEpoch() {
+    return _epoch;
+}
+
+uint32_t SequenceTracker::getLastContiguous() {
+    return _last;
+}
+
+unsigned long SequenceTracker::getResyncs() {
+    return _resyncs;
+}
+
+unsigned long SequenceTracker::getLost() {
+    return _lost;
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void SequenceTracker::skipTo(uint32_t seq) {
+    // Everything up to `seq` counts as handled; holes there are lost
+    uint32_t span = seq - _last;
+    uint64_t passed = span >= SEQ_WINDOW ? _window : _window & ((1ULL << span) - 1);
+    _lost += span - __builtin_popcountll(passed);
+    shiftTo(seq);
+}
+
+void SequenceTracker::shiftTo(uint32_t seq) {
+    uint32_t span = seq - _last;
+    _window = span >= SEQ_WINDOW ? 0 : _window >> span;
+    _last = seq;
+}
+
+void SequenceTracker::skipFiltered(uint32_t prevSeq, uint32_t seq) {
+    // Numbers strictly between prevSeq and seq weren't meant for us
+    if (prevSeq <= _last) {
+        shiftTo(seq - 1);
+        return;
+    }
+
+    uint32_t end = min(seq - 1, _last + SEQ_WINDOW);
+    for (uint32_t n = prevSeq + 1; n <= end; n++) {
+        _window |= 1ULL << (n - _last - 1);
+    }
+}
+
+void SequenceTracker::advance() {
+    while (_window & 1) {
+        _window >>= 1;
+        _last++;
+    }
+
+    if (_window == 0) {
+        _gapSince = 0;
+        _askedAt = 0;
+    }
+}
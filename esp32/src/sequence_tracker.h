@@ -0,0 +1,64 @@
+#ifndef SEQUENCE_TRACKER_H
+#define SEQUENCE_TRACKER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+
+// ============================================
+// Notification Sequence Tracker
+// The box numbers every notification, once for both links, and starts
+// over each time it restarts (a new "epoch"). We keep the last number
+// received without a hole plus a window of what arrived past it: a
+// gap shows up as soon as a later number does, and only the missing
+// run is asked for again ("resync"). The register message carries the
+// last contiguous number, so a reconnect replays just what was sent
+// while we were away.
+// ============================================
+
+#define SEQ_WINDOW          64        // Numbers tracked past the contiguous one (= box journal)
+#define SEQ_GAP_GRACE       1000      // ms before asking: WS and BLE may deliver out of order
+#define SEQ_RESYNC_RETRY    5000      // ms before asking again for an unanswered range
+
+class SequenceTracker {
+public:
+    // Transport tasks: a numbered notification made it into the inbox
+    // (0 = old box, not numbered). `prevSeq` is the box's previous one
+    // for this watch: the numbers in between matched other watches'
+    // subscription filters and are no gap (0 = not filtered)
+    void onReceived(uint32_t seq, uint32_t prevSeq);
+
+    // "registered": the box's epoch and the number it resumes after
+    void onRegistered(uint32_t epoch, uint32_t seq);
+
+    // "resynced": the box has resent all it still had up to `to`
+    void onResynced(uint32_t to);
+
+    // The oldest open hole, if it's due to be asked for (marks it asked)
+    bool takeGap(uint32_t& from, uint32_t& to);
+
+    // For the register message; epoch 0 = not registered since boot
+    uint32_t getEpoch();
+    uint32_t getLastContiguous();
+
+    unsigned long getResyncs();   // Ranges asked for
+    unsigned long getLost();      // Numbers given up on
+
+private:
+    uint32_t _epoch = 0;
+    uint32_t _last = 0;
+    uint64_t _window = 0;         // Bit i: _last + 1 + i received
+    unsigned long _gapSince = 0;  // millis() the oldest hole opened, 0 = none
+    unsigned long _askedAt = 0;   // millis() of the unanswered resync, 0 = none
+    unsigned long _resyncs = 0;
+    unsigned long _lost = 0;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    void skipTo(uint32_t seq);
+    void shiftTo(uint32_t seq);
+    void skipFiltered(uint32_t prevSeq, uint32_t seq);
+    void advance();
+};
+
+extern SequenceTracker Sequences;
+
+#endif // SEQUENCE_TRACKER_H
@@ -1,8 +1,18 @@
 #include "storage.h"
+#include "debug_log.h"
 #include <WiFi.h>
+#include <esp_rom_crc.h>
+#include <stddef.h>
 
 StorageManager Storage;
 
+// Keys written by the per-key format (before the config blob)
+static const char* const LEGACY_KEYS[] = {
+    "wifi_ssid", "wifi_pass", "mode", "conn_mode", "bb_ip", "bb_port",
+    "ble_addr", "ble_name", "sb_url", "sb_key", "rest_id", "dev_name",
+    "power", "configured"
+};
+
 void StorageManager::begin() {
     _prefs.begin("bitsperwatch", false);
 
@@ -14,17 +24,152 @@ void StorageManager::begin() {
              mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
     _deviceId = String(macStr);
 
-    Serial.printf("[Storage] Initialized. Device ID: %s\n", _deviceId.c_str());
+    // Only NVS read of the config for the whole boot
+    readConfig(_config);
+
+    LOG_I(STORAGE, "Initialized. Device ID: %s", _deviceId.c_str());
+}
+
+const DeviceConfig& StorageManager::getConfig() {
+    return _config;
 }
 
 bool StorageManager::loadConfig(DeviceConfig& config) {
+    memcpy(&config, &_config, sizeof(DeviceConfig));
+    return config.configured;
+}
+
+bool StorageManager::saveConfig(const DeviceConfig& config) {
+    DeviceConfig updated;
+    memcpy(&updated, &config, sizeof(DeviceConfig));
+    updated.configured = true;
+
+    // Saving the portal form again with nothing changed costs no flash write
+    if (memcmp(&updated, &_config, sizeof(DeviceConfig)) == 0) {
+        LOG_I(STORAGE, "Configuration unchanged, not written");
+        return true;
+    }
+
+    if (!writeBlob(updated)) {
+        LOG_E(STORAGE, "Failed to save configuration");
+        return false;
+    }
+
+    memcpy(&_config, &updated, sizeof(DeviceConfig));
+    LOG_I(STORAGE, "Configuration saved");
+    return true;
+}
+
+bool StorageManager::isConfigured() {
+    return _config.configured;
+}
+
+void StorageManager::clearConfig() {
+    _prefs.clear();
+    memset(&_config, 0, sizeof(DeviceConfig));
+    LOG_I(STORAGE, "Configuration cleared (factory reset)");
+}
+
+const String& StorageManager::getDeviceId() {
+    return _deviceId;
+}
+
+bool StorageManager::getBoxEndpoint(char* host, size_t hostSize, uint16_t& port) {
+    // isKey() first: a missing key makes getString() log an error
+    host[0] = '\0';
+    if (!_prefs.isKey(BOX_HOST_KEY) || _prefs.getString(BOX_HOST_KEY, host, hostSize) == 0) {
+        return false;
+    }
+    port = _prefs.getUShort(BOX_PORT_KEY, 3334);
+    return host[0] != '\0';
+}
+
+void StorageManager::saveBoxEndpoint(const char* host, uint16_t port) {
+    char current[32];
+    uint16_t currentPort = 0;
+    if (getBoxEndpoint(current, sizeof(current), currentPort) &&
+        strcmp(current, host) == 0 && currentPort == port) {
+        return;
+    }
+
+    _prefs.putString(BOX_HOST_KEY, host);
+    _prefs.putUShort(BOX_PORT_KEY, port);
+    LOG_I(STORAGE, "Box endpoint cached: %s:%d", host, port);
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+bool StorageManager::readConfig(DeviceConfig& config) {
+    // One blob read into a stack buffer (no String allocations)
+    ConfigBlob blob;
+    size_t len = _prefs.getBytes(CONFIG_BLOB_KEY, &blob, sizeof(blob));
+
+    if (len == sizeof(blob) && blob.magic == CONFIG_BLOB_MAGIC &&
+        blob.version == CONFIG_BLOB_VERSION && blob.size == sizeof(DeviceConfig) &&
+        blob.crc == esp_rom_crc32_le(0, (const uint8_t*)&blob.config, sizeof(DeviceConfig))) {
+        memcpy(&config, &blob.config, sizeof(DeviceConfig));
+        LOG_I(STORAGE, "Config loaded. Mode: %s, WiFi: %s",
+              config.mode, config.wifi_ssid);
+        return config.configured;
+    }
+
+    // Older layout: a prefix of this one, the new fields start zeroed
+    size_t header = offsetof(ConfigBlob, config);
+    if (len > header && blob.magic == CONFIG_BLOB_MAGIC && blob.version < CONFIG_BLOB_VERSION &&
+        blob.size < sizeof(DeviceConfig) && len >= header + blob.size &&
+        blob.crc == esp_rom_crc32_le(0, (const uint8_t*)&blob.config, blob.size)) {
+        memset(&config, 0, sizeof(DeviceConfig));
+        memcpy(&config, &blob.config, blob.size);
+        if (writeBlob(config)) {
+            LOG_I(STORAGE, "Config blob v%d upgraded to v%d", blob.version, CONFIG_BLOB_VERSION);
+        }
+        return config.configured;
+    }
+
+    if (len > 0) {
+        LOG_W(STORAGE, "Config blob rejected (%u bytes)", (unsigned)len);
+    }
+
+    // First boot after the format change: convert the per-key config once
+    if (!readLegacyConfig(config)) {
+        memset(&config, 0, sizeof(DeviceConfig));
+        LOG_I(STORAGE, "No configuration found");
+        return false;
+    }
+
+    if (writeBlob(config)) {
+        for (const char* key : LEGACY_KEYS) {
+            _prefs.remove(key);
+        }
+        LOG_I(STORAGE, "Migrated per-key config to blob");
+    }
+
+    LOG_I(STORAGE, "Config loaded. Mode: %s, WiFi: %s",
+          config.mode, config.wifi_ssid);
+    return true;
+}
+
+bool StorageManager::writeBlob(const DeviceConfig& config) {
+    ConfigBlob blob;
+    memset(&blob, 0, sizeof(blob));
+    blob.magic = CONFIG_BLOB_MAGIC;
+    blob.version = CONFIG_BLOB_VERSION;
+    blob.size = sizeof(DeviceConfig);
+    memcpy(&blob.config, &config, sizeof(DeviceConfig));
+    blob.crc = esp_rom_crc32_le(0, (const uint8_t*)&blob.config, sizeof(DeviceConfig));
+
+    return _prefs.putBytes(CONFIG_BLOB_KEY, &blob, sizeof(blob)) == sizeof(blob);
+}
+
+bool StorageManager::readLegacyConfig(DeviceConfig& config) {
     // Clear struct
     memset(&config, 0, sizeof(DeviceConfig));
 
     // Check if configured
     config.configured = _prefs.getBool("configured", false);
     if (!config.configured) {
-        Serial.println("[Storage] No configuration found");
         return false;
     }
 
@@ -65,55 +210,9 @@ bool StorageManager::loadConfig(DeviceConfig& config) {
     String devName = _prefs.getString("dev_name", "BitsperWatch");
     strncpy(config.device_name, devName.c_str(), sizeof(config.device_name) - 1);
 
-    Serial.printf("[Storage] Config loaded. Mode: %s, WiFi: %s\n",
-                  config.mode, config.wifi_ssid);
-
-    return true;
-}
-
-bool StorageManager::saveConfig(const DeviceConfig& config) {
-    // Save WiFi
-    _prefs.putString("wifi_ssid", config.wifi_ssid);
-    _prefs.putString("wifi_pass", config.wifi_password);
-
-    // Save mode
-    _prefs.putString("mode", config.mode);
-
-    // Save connection mode
-    _prefs.putString("conn_mode", config.connection_mode);
-
-    // Save BitsperBox settings
-    _prefs.putString("bb_ip", config.bitsperbox_ip);
-    _prefs.putUShort("bb_port", config.bitsperbox_port);
-
-    // Save BLE settings
-    _prefs.putString("ble_addr", config.ble_server_address);
-    _prefs.putString("ble_name", config.ble_server_name);
+    // Load power profile
+    String power = _prefs.getString("power", "balanced");
+    strncpy(config.power_profile, power.c_str(), sizeof(config.power_profile) - 1);
 
-    // Save Supabase settings
-    _prefs.putString("sb_url", config.supabase_url);
-    _prefs.putString("sb_key", config.supabase_key);
-    _prefs.putString("rest_id", config.restaurant_id);
-
-    // Save device name
-    _prefs.putString("dev_name", config.device_name);
-
-    // Mark as configured
-    _prefs.putBool("configured", true);
-
-    Serial.println("[Storage] Configuration saved");
     return true;
 }
-
-bool StorageManager::isConfigured() {
-    return _prefs.getBool("configured", false);
-}
-
-void StorageManager::clearConfig() {
-    _prefs.clear();
-    Serial.println("[Storage] Configuration cleared (factory reset)");
-}
-
-String StorageManager::getDeviceId() {
-    return _deviceId;
-}
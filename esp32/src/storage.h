@@ -6,8 +6,17 @@
 
 // ============================================
 // Configuration Storage (NVS)
+// The config is one versioned, CRC-checked blob (key "cfg"), read once
+// in begin() and served from RAM; saveConfig() and clearConfig() keep
+// the cached copy in step. Older per-key configs are migrated on boot.
 // ============================================
 
+#define CONFIG_BLOB_KEY      "cfg"
+#define CONFIG_BLOB_MAGIC    0x46435742UL  // "BWCF"
+#define CONFIG_BLOB_VERSION  2             // Bump when DeviceConfig changes layout
+#define BOX_HOST_KEY         "bb_last_ip"    // Cached box endpoint (outside the blob)
+#define BOX_PORT_KEY         "bb_last_port"
+
 struct DeviceConfig {
     // WiFi
     char wifi_ssid[64];
@@ -35,17 +44,38 @@ struct DeviceConfig {
     // Device info
     char device_name[32];
 
+    // Power profile: "performance", "balanced", "saver"
+    char power_profile[12];
+
     // Flags
     bool configured;
+
+    // Subscription filter (subscription_filter.h), empty / 0 = everything.
+    // New fields go last: an older blob is read as a prefix (v1 ends above)
+    char filter_zones[32];        // Table-label prefixes: "T, B"
+    char filter_tables[48];       // Table number ranges: "1-12, 20"
+    uint8_t filter_alerts;        // SUB_ALERT_* bits
+    uint8_t filter_min_priority;  // NotificationPriority
+};
+
+struct ConfigBlob {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;             // sizeof(DeviceConfig) when written
+    uint32_t crc;              // CRC32 of config
+    DeviceConfig config;
 };
 
 class StorageManager {
 public:
     void begin();
 
+    // Cached config (all zero when not configured)
+    const DeviceConfig& getConfig();
+
     // Load/Save full config
-    bool loadConfig(DeviceConfig& config);
-    bool saveConfig(const DeviceConfig& config);
+    bool loadConfig(DeviceConfig& config);   // Copy of the cached config
+    bool saveConfig(const DeviceConfig& config);   // No write if unchanged
 
     // Check if configured
     bool isConfigured();
@@ -54,11 +84,21 @@ public:
     void clearConfig();
 
     // Get device unique ID (from MAC)
-    String getDeviceId();
+    const String& getDeviceId();
+
+    // Last box endpoint that accepted our register (configured or found
+    // over mDNS); tried first on the next boot. Empty host when none
+    bool getBoxEndpoint(char* host, size_t hostSize, uint16_t& port);
+    void saveBoxEndpoint(const char* host, uint16_t port);   // No write if unchanged
 
 private:
     Preferences _prefs;
     String _deviceId;
+    DeviceConfig _config;
+
+    bool readConfig(DeviceConfig& config);
+    bool readLegacyConfig(DeviceConfig& config);
+    bool writeBlob(const DeviceConfig& config);
 };
 
 extern StorageManager Storage;
@@ -0,0 +1,160 @@
+#include "subscription_filter.h"
+#include "debug_log.h"
+
+SubscriptionFilter Subscription;
+
+// By SUB_ALERT_* bit
+static const char* const ALERT_TYPES[SUB_ALERT_TYPES] = {
+    "waiter_called", "bill_ready", "payment_confirmed", "urgent"
+};
+
+static const char* const PRIORITY_NAMES[] = { "low", "medium", "high", "urgent" };
+
+void SubscriptionFilter::load(const DeviceConfig& config) {
+    _zoneCount = 0;
+    _rangeCount = 0;
+    _alerts = config.filter_alerts & ((1 << SUB_ALERT_TYPES) - 1);
+    _minRank = min(config.filter_min_priority, (uint8_t)PRIORITY_URGENT);
+
+    // "T, B" -> "t", "b"
+    const char* p = config.filter_zones;
+    while (*p && _zoneCount < SUB_MAX_ZONES) {
+        while (*p == ',' || *p == ' ') p++;
+        size_t len = 0;
+        char* zone = _zones[_zoneCount];
+        while (*p && *p != ',') {
+            if (len < SUB_ZONE_LEN - 1) zone[len++] = tolower((unsigned char)*p);
+            p++;
+        }
+        while (len > 0 && zone[len - 1] == ' ') len--;
+        zone[len] = '\0';
+        if (len > 0) _zoneCount++;
+    }
+
+    // "1-12, 20" -> [1, 12], [20, 20]
+    p = config.filter_tables;
+    while (*p && _rangeCount < SUB_MAX_RANGES) {
+        char* end;
+        long lo = strtol(p, &end, 10);
+        if (end == p) {
+            p++;
+            continue;
+        }
+        long hi = lo;
+        p = end;
+        while (*p == ' ') p++;
+        if (*p == '-') {
+            hi = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        if (lo >= 0 && hi >= lo && hi <= UINT16_MAX) {
+            _ranges[_rangeCount][0] = lo;
+            _ranges[_rangeCount][1] = hi;
+            _rangeCount++;
+        }
+    }
+
+    if (!isEmpty()) {
+        LOG_I(NOTIF, "Subscription: %d zones, %d table ranges, alerts 0x%02X, from %s",
+              _zoneCount, _rangeCount, _alerts, PRIORITY_NAMES[_minRank]);
+    }
+}
+
+bool SubscriptionFilter::isEmpty() {
+    return _zoneCount == 0 && _rangeCount == 0 && _alerts == 0 && _minRank == PRIORITY_LOW;
+}
+
+bool SubscriptionFilter::accept(const NotificationData& notif) {
+    if (isEmpty()) return true;
+
+    bool match = NotificationQueue::priorityRank(notif.priority) >= _minRank && matchesTable(notif.table);
+    if (match && _alerts != 0) {
+        int bit = alertBit(notif.type);
+        match = bit >= 0 && (_alerts & (1 << bit));
+    }
+
+    if (!match) _filtered++;
+    return match;
+}
+
+void SubscriptionFilter::writeJson(JsonObject out) {
+    if (_zoneCount > 0) {
+        JsonArray zones = out["zones"].to<JsonArray>();
+        for (uint8_t i = 0; i < _zoneCount; i++) zones.add(_zones[i]);
+    }
+    if (_rangeCount > 0) {
+        JsonArray tables = out["tables"].to<JsonArray>();
+        for (uint8_t i = 0; i < _rangeCount; i++) {
+            JsonArray range = tables.add<JsonArray>();
+            range.add(_ranges[i][0]);
+            range.add(_ranges[i][1]);
+        }
+    }
+    if (_alerts != 0) {
+        JsonArray alerts = out["alerts"].to<JsonArray>();
+        for (uint8_t i = 0; i < SUB_ALERT_TYPES; i++) {
+            if (_alerts & (1 << i)) alerts.add(ALERT_TYPES[i]);
+        }
+    }
+    if (_minRank != PRIORITY_LOW) {
+        out["min_priority"] = PRIORITY_NAMES[_minRank];
+    }
+}
+
+unsigned long SubscriptionFilter::getFiltered() {
+    return _filtered;
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+bool SubscriptionFilter::matchesTable(const char* label) {
+    if (_zoneCount == 0 && _rangeCount == 0) return true;
+
+    char zone[SUB_ZONE_LEN];
+    int number = splitTable(label, zone, sizeof(zone));
+
+    // Cut at NotificationData.table before its number: the box matched
+    // the whole label, so only what's left can be checked
+    bool cut = number < 0 && strlen(label) >= sizeof(NotificationData::table) - 1;
+
+    if (_zoneCount > 0) {
+        bool found = false;
+        for (uint8_t i = 0; i < _zoneCount && !found; i++) {
+            found = cut ? strncmp(zone, _zones[i], strlen(zone)) == 0
+                        : strcmp(zone, _zones[i]) == 0;
+        }
+        if (!found) return false;
+    }
+
+    if (_rangeCount > 0 && !cut) {
+        for (uint8_t i = 0; i < _rangeCount; i++) {
+            if (number >= _ranges[i][0] && number <= _ranges[i][1]) return true;
+        }
+        return false;
+    }
+    return true;
+}
+
+int SubscriptionFilter::alertBit(const char* type) {
+    for (uint8_t i = 0; i < SUB_ALERT_TYPES; i++) {
+        if (strcmp(type, ALERT_TYPES[i]) == 0) return i;
+    }
+    return -1;
+}
+
+int SubscriptionFilter::splitTable(const char* label, char* zone, size_t zoneSize) {
+    // Zone: lower-cased text before the first digit, minus trailing
+    // separators. Number: the digits after it, -1 if there are none
+    size_t len = 0;
+    const char* p = label;
+    while (*p && !isdigit((unsigned char)*p)) {
+        if (len < zoneSize - 1) zone[len++] = tolower((unsigned char)*p);
+        p++;
+    }
+    while (len > 0 && (zone[len - 1] == ' ' || zone[len - 1] == '-' || zone[len - 1] == '_')) len--;
+    zone[len] = '\0';
+
+    return isdigit((unsigned char)*p) ? atoi(p) : -1;
+}
@@ -0,0 +1,65 @@
+#ifndef SUBSCRIPTION_FILTER_H
+#define SUBSCRIPTION_FILTER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "storage.h"
+#include "notification_queue.h"
+
+// ============================================
+// Subscription Filter
+// Which alerts this watch is for: zones, table ranges, alert types and
+// a minimum priority, set in the portal (DeviceConfig). Sent in the
+// register message so the box only sends what matches; applied again
+// here as a safety net (older boxes, direct mode, BLE fan-out).
+//
+// A table label splits into a zone (the text before the first digit,
+// case-insensitive: "T12" -> "t", "Terraza 3" -> "terraza") and a
+// number. The box does the same (src/utils/subscriptionFilter.ts) on
+// the full label, so zones go out whole. A label cut short by
+// NotificationData.table only has to match a zone as far as it goes.
+// Every criterion that is set must match; an empty filter takes all.
+// ============================================
+
+#define SUB_MAX_ZONES       4
+#define SUB_ZONE_LEN        sizeof(DeviceConfig::filter_zones)   // A lone zone may fill the setting
+#define SUB_MAX_RANGES      8
+
+// DeviceConfig.filter_alerts bits: bit n is wire alert code n + 1
+#define SUB_ALERT_WAITER_CALLED      (1 << 0)
+#define SUB_ALERT_BILL_READY         (1 << 1)
+#define SUB_ALERT_PAYMENT_CONFIRMED  (1 << 2)
+#define SUB_ALERT_URGENT             (1 << 3)
+#define SUB_ALERT_TYPES              4
+
+class SubscriptionFilter {
+public:
+    // Parses the config's zone / table lists once
+    void load(const DeviceConfig& config);
+    bool isEmpty();
+
+    // UI task: false (and counted) for an alert this watch is not for
+    bool accept(const NotificationData& notif);
+
+    // "filter" of the register message (only when not empty)
+    void writeJson(JsonObject out);
+
+    unsigned long getFiltered();
+
+private:
+    char _zones[SUB_MAX_ZONES][SUB_ZONE_LEN] = {};
+    uint8_t _zoneCount = 0;
+    uint16_t _ranges[SUB_MAX_RANGES][2] = {};
+    uint8_t _rangeCount = 0;
+    uint8_t _alerts = 0;
+    uint8_t _minRank = PRIORITY_LOW;
+    unsigned long _filtered = 0;
+
+    bool matchesTable(const char* label);
+    int alertBit(const char* type);
+    static int splitTable(const char* label, char* zone, size_t zoneSize);
+};
+
+extern SubscriptionFilter Subscription;
+
+#endif // SUBSCRIPTION_FILTER_H
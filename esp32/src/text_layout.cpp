@@ -0,0 +1,73 @@
+#include "text_layout.h"
+
+// Latin-1 code points used in Spanish text -> CP437 glyph. CP437 has no
+// accented Á Í Ó Ú, so those fall back to the plain capital
+struct GlyphMap {
+    uint16_t codepoint;
+    char glyph;
+};
+
+static const GlyphMap CP437_MAP[] = {
+    { 0xE1, '\xA0' },   // á
+    { 0xE9, '\x82' },   // é
+    { 0xED, '\xA1' },   // í
+    { 0xF3, '\xA2' },   // ó
+    { 0xFA, '\xA3' },   // ú
+    { 0xFC, '\x81' },   // ü
+    { 0xF1, '\xA4' },   // ñ
+    { 0xD1, '\xA5' },   // Ñ
+    { 0xC9, '\x90' },   // É
+    { 0xDC, '\x9A' },   // Ü
+    { 0xBF, '\xA8' },   // ¿
+    { 0xA1, '\xAD' },   // ¡
+    { 0xAA, '\xA6' },   // ª
+    { 0xBA, '\xA7' },   // º
+    { 0xB0, '\xF8' },   // °
+    { 0xC1, 'A' },      // Á
+    { 0xCD, 'I' },      // Í
+    { 0xD3, 'O' },      // Ó
+    { 0xDA, 'U' },      // Ú
+};
+
+size_t utf8Next(const char* text, size_t pos) {
+    if (text[pos] == '\0') return pos;
+    pos++;
+    while (((uint8_t)text[pos] & 0xC0) == 0x80) {
+        pos++;
+    }
+    return pos;
+}
+
+size_t fontEncode(const char* utf8, size_t length, char* out, size_t outSize) {
+    size_t written = 0;
+    size_t pos = 0;
+
+    while (pos < length && utf8[pos] != '\0' && written + 1 < outSize) {
+        uint8_t lead = (uint8_t)utf8[pos];
+        size_t next = min(utf8Next(utf8, pos), length);
+
+        if (lead < 0x80) {
+            out[written++] = (char)lead;
+        } else {
+            // Two-byte sequences cover all of Latin-1; anything longer
+            // (emoji, CJK) has no glyph in this font anyway
+            uint16_t codepoint = 0;
+            if ((lead & 0xE0) == 0xC0 && next - pos == 2) {
+                codepoint = ((lead & 0x1F) << 6) | ((uint8_t)utf8[pos + 1] & 0x3F);
+            }
+
+            char glyph = '?';
+            for (const GlyphMap& entry : CP437_MAP) {
+                if (entry.codepoint == codepoint) {
+                    glyph = entry.glyph;
+                    break;
+                }
+            }
+            out[written++] = glyph;
+        }
+        pos = next;
+    }
+
+    out[written] = '\0';
+    return written;
+}
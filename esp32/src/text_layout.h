@@ -0,0 +1,37 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <Arduino.h>
+
+// ============================================
+// Text Layout
+// Where a notification's lines break, worked out once with the panel's
+// real font metrics and kept beside the notification in its queue
+// slot. Re-showing a queued alert replays the cached lines instead of
+// measuring and wrapping again.
+// The built-in font is code page 437, so UTF-8 text (Spanish accents,
+// ñ, ¿¡) is encoded to it byte for byte before measuring or drawing.
+// ============================================
+
+#define LAYOUT_MAX_LINES    9      // Message lines on the notification screen
+
+struct TextLayout {
+    bool valid;                            // Cleared when the text changes
+    bool truncated;                        // Last line ends in "..."
+    uint8_t textSize;                      // Message text size
+    uint8_t tableSize;                     // "MESA n" heading text size
+    uint8_t lineCount;
+    uint8_t start[LAYOUT_MAX_LINES];       // Byte offset into the UTF-8 message
+    uint8_t length[LAYOUT_MAX_LINES];      // Bytes of the message on this line
+    int16_t width[LAYOUT_MAX_LINES];       // Pixels, ellipsis included
+};
+
+// Encode `length` bytes of UTF-8 for the display font; always
+// NUL-terminates. Characters the font lacks become their unaccented
+// letter or '?'. Returns the encoded length
+size_t fontEncode(const char* utf8, size_t length, char* out, size_t outSize);
+
+// Byte offset of the character after the one starting at `pos`
+size_t utf8Next(const char* text, size_t pos);
+
+#endif // TEXT_LAYOUT_H
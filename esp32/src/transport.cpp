@@ -0,0 +1,77 @@
+#include "transport.h"
+#include "wire_protocol.h"
+#include "metrics.h"
+#include "debug_log.h"
+#include "sequence_tracker.h"
+#include "ota_updater.h"
+
+// ============================================
+// Shared Notification Pipeline
+// ============================================
+
+InboxItem* Transport::decodeBinary(const uint8_t* data, size_t length, uint32_t rxUs) {
+    InboxItem* item = Events.reserveNotification(_source);
+    if (item == nullptr) return nullptr;
+
+    if (!wireDecodeNotification(data, length, item->data, &item->seq, &item->prevSeq)) {
+        _decodeErrors++;
+        LOG_W(XPORT, "%s: malformed binary notification (%u bytes)",
+              getTransportName(), (unsigned)length);
+        Events.releaseNotification(item);
+        return nullptr;
+    }
+
+    finishDecode(item, rxUs);
+    return item;
+}
+
+InboxItem* Transport::decodeJson(JsonVariantConst msg, uint32_t rxUs) {
+    InboxItem* item = decodeFields(msg["id"] | "", msg["table"] | "", msg["alert"] | "",
+                                   msg["message"] | "", msg["priority"] | "medium",
+                                   msg["timestamp"] | (uint64_t)0, rxUs);
+    if (item) {
+        item->seq = msg["seq"] | (uint32_t)0;
+        item->prevSeq = msg["prev_seq"] | (uint32_t)0;
+    }
+    return item;
+}
+
+InboxItem* Transport::decodeFields(const char* id, const char* table, const char* alert,
+                                   const char* message, const char* priority,
+                                   uint64_t timestamp, uint32_t rxUs) {
+    InboxItem* item = Events.reserveNotification(_source);
+    if (item == nullptr) return nullptr;
+
+    // Slot comes zeroed; strncpy leaves the terminator in place
+    NotificationData& notif = item->data;
+    strncpy(notif.id, id ? id : "", sizeof(notif.id) - 1);
+    strncpy(notif.table, table ? table : "", sizeof(notif.table) - 1);
+    strncpy(notif.type, alert ? alert : "", sizeof(notif.type) - 1);
+    strncpy(notif.message, message ? message : "", sizeof(notif.message) - 1);
+    strncpy(notif.priority, priority ? priority : "medium", sizeof(notif.priority) - 1);
+    notif.timestamp = timestamp;
+
+    finishDecode(item, rxUs);
+    return item;
+}
+
+void Transport::publishNotification(InboxItem* item) {
+    // Only what reached the inbox counts: a dropped one is resynced later
+    Sequences.onReceived(item->seq, item->prevSeq);
+    Ota.onNotification();   // Firmware chunks wait for the burst to pass
+    Metrics.count((MetricCounter)(METRIC_RX_WS + _source));
+    Events.commitNotification(item);
+}
+
+// ============================================
+// Private Helper Methods
+// ============================================
+
+void Transport::finishDecode(InboxItem* item, uint32_t rxUs) {
+    NotificationData& notif = item->data;
+    notif.rxUs = rxUs;
+    notif.parsedUs = micros();
+
+    LOG_I(XPORT, "%s >>> NOTIFICATION: Table %s, Type: %s, Priority: %s, ID %s",
+          getTransportName(), notif.table, notif.type, notif.priority, notif.id);
+}
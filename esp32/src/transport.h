@@ -0,0 +1,63 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "app_events.h"
+#include "ack_batcher.h"
+
+// ============================================
+// Transport
+// Common base of the links to the box (WebSocket, BLE) and the one
+// notification pipeline they share: a frame is decoded once, straight
+// into a reserved inbox slot, and the UI task gets the slot index -
+// NotificationData is never copied between the transport and the UI.
+// ============================================
+
+class Transport {
+public:
+    explicit Transport(NotificationSource source) : _source(source) {}
+    virtual ~Transport() {}
+
+    virtual bool isConnected() = 0;
+
+    NotificationSource getSource() { return _source; }
+    const char* getTransportName() { return getSourceName(_source); }
+    unsigned long getDecodeErrors() { return _decodeErrors; }
+    unsigned long getAcksDropped() { return _acks.getDropped(); }
+
+    // Coalesced into the transport's next ack frame (any task)
+    void queueAck(AckKind kind, const char* id) { _acks.add(kind, id); }
+
+#if BENCHMARK_BUILD
+    // On-target benchmarks: forget pending acks, as if they went out
+    void discardAcksForBench() { _acks.consume(_acks.pending()); }
+#endif
+
+protected:
+    AckBatcher _acks;
+
+    // Decode a bpw1 frame / a JSON "notification" message into a new
+    // inbox slot. nullptr when malformed or the inbox is full; otherwise
+    // the slot is the caller's until publishNotification()
+    InboxItem* decodeBinary(const uint8_t* data, size_t length, uint32_t rxUs);
+    InboxItem* decodeJson(JsonVariantConst msg, uint32_t rxUs);
+
+    // Same, from fields already pulled out of some other shape (a
+    // Supabase row); nullptr strings are stored empty
+    InboxItem* decodeFields(const char* id, const char* table, const char* alert,
+                            const char* message, const char* priority,
+                            uint64_t timestamp, uint32_t rxUs);
+
+    // Hand the slot to the UI task (don't touch it afterwards)
+    void publishNotification(InboxItem* item);
+
+private:
+    NotificationSource _source;
+    unsigned long _decodeErrors = 0;
+
+    void finishDecode(InboxItem* item, uint32_t rxUs);
+};
+
+#endif // TRANSPORT_H
@@ -0,0 +1,136 @@
+#include "transport_manager.h"
+#include "debug_log.h"
+#include "websocket_client.h"
+#include "ble_client.h"
+#include "realtime_client.h"
+
+TransportManager Transports;
+
+static const char* TRANSPORT_NAMES[TRANSPORT_COUNT] = { "ws", "ble" };
+
+static Transport* const LINKS[TRANSPORT_COUNT] = { &WsClient, &BleClient };
+
+void TransportManager::begin(bool useWiFi, bool useBLE, bool direct) {
+    _direct = direct;
+    _arbitrate = !direct && useWiFi && useBLE;
+    _primary = useWiFi && !useBLE ? TRANSPORT_WS : TRANSPORT_BLE;
+    _wsHealthySince = 0;
+
+    LOG_I(XPORT, "Arbitration %s", _arbitrate ? "ON (WiFi primary, BLE standby)" : "OFF");
+}
+
+// ============================================
+// Arbitration (network task)
+// ============================================
+
+void TransportManager::loop() {
+    sample();
+    if (!_arbitrate) return;
+
+    unsigned long now = millis();
+
+    if (!wsHealthy()) {
+        _wsHealthySince = 0;
+        if (_primary != TRANSPORT_BLE) {
+            const TransportQuality& ws = _quality[TRANSPORT_WS];
+            promote(TRANSPORT_BLE, !ws.up ? "WebSocket down" :
+                                   ws.lossPct > TRANSPORT_LOSS_MAX ? "ping loss" :
+                                   ws.rttMs > TRANSPORT_RTT_MAX ? "high RTT" : "weak WiFi");
+            _failovers++;
+        }
+    } else {
+        if (_wsHealthySince == 0) {
+            _wsHealthySince = now;
+        }
+        // Hysteresis: a link that just came back has to hold before BLE lets go
+        if (_primary != TRANSPORT_WS && now - _wsHealthySince >= TRANSPORT_PROMOTE_DELAY) {
+            promote(TRANSPORT_WS, "WebSocket healthy");
+        }
+    }
+
+    applyStandby();
+}
+
+void TransportManager::sample() {
+    TransportQuality& ws = _quality[TRANSPORT_WS];
+    bool wsUp = WsClient.isConnected();
+    if (ws.up && !wsUp) ws.drops++;
+    ws.up = wsUp;
+    ws.rssi = wsUp ? WiFi.RSSI() : 0;
+    ws.rttMs = WsClient.getRtt();
+    ws.lossPct = WsClient.getProbeLoss();
+
+    TransportQuality& ble = _quality[TRANSPORT_BLE];
+    bool bleUp = BleClient.isConnected();
+    if (ble.up && !bleUp && !BleClient.isStandby()) ble.drops++;
+    ble.up = bleUp;
+    ble.rssi = bleUp ? BleClient.getRssi() : 0;
+}
+
+bool TransportManager::wsHealthy() {
+    const TransportQuality& ws = _quality[TRANSPORT_WS];
+    return ws.up &&
+           WsClient.getMissedPongs() == 0 &&
+           ws.lossPct <= TRANSPORT_LOSS_MAX &&
+           (ws.rttMs == 0 || ws.rttMs <= TRANSPORT_RTT_MAX) &&
+           (ws.rssi == 0 || ws.rssi >= TRANSPORT_WIFI_RSSI_MIN);
+}
+
+void TransportManager::promote(TransportId id, const char* reason) {
+    _primary = id;
+    LOG_I(XPORT, "Primary -> %s (%s)", getPrimaryName(), reason);
+}
+
+void TransportManager::applyStandby() {
+    // BLE can only park once it knows where the box is; until then it
+    // keeps connecting so a later failover needs no scan
+    bool standby = _primary == TRANSPORT_WS && BleClient.hasKnownAddress();
+    BleClient.setStandby(standby);
+
+    // With nothing else listening, a dead socket must be noticed quickly
+    WsClient.setProbeInterval(standby ? TRANSPORT_STANDBY_PROBE : WS_PROBE_INTERVAL);
+}
+
+// ============================================
+// Status
+// ============================================
+
+TransportId TransportManager::getPrimary() {
+    return _primary;
+}
+
+const char* TransportManager::getPrimaryName() {
+    return TRANSPORT_NAMES[_primary];
+}
+
+Transport* TransportManager::getActiveTransport() {
+    if (_direct) return &Realtime;
+
+    Transport* primary = LINKS[_primary];
+    if (_arbitrate && !primary->isConnected()) {
+        Transport* other = LINKS[_primary == TRANSPORT_WS ? TRANSPORT_BLE : TRANSPORT_WS];
+        if (other->isConnected()) return other;
+    }
+    return primary;
+}
+
+unsigned long TransportManager::getFailovers() {
+    return _failovers;
+}
+
+void TransportManager::writeJson(JsonObject out) {
+    out["primary"] = _direct ? "realtime" : getPrimaryName();
+    out["arbitrate"] = _arbitrate;
+    out["failovers"] = _failovers;
+    out["ble_standby"] = BleClient.isStandby();
+
+    for (uint8_t i = 0; i < TRANSPORT_COUNT; i++) {
+        const TransportQuality& q = _quality[i];
+        JsonObject t = out[TRANSPORT_NAMES[i]].to<JsonObject>();
+        t["up"] = q.up;
+        t["rssi"] = q.rssi;
+        t["rtt"] = q.rttMs;
+        t["loss"] = q.lossPct;
+        t["drops"] = q.drops;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef TRANSPORT_MANAGER_H
+#define TRANSPORT_MANAGER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "transport.h"
+
+// ============================================
+// Transport Manager
+// "both" mode: WiFi (WebSocket) is primary while its link is healthy
+// and BLE waits in standby - disconnected, box address known, no
+// scanning - so the shared 2.4 GHz radio isn't split between them.
+// When the WebSocket degrades or drops, BLE is promoted straight away
+// with a directed reconnect.
+// ============================================
+
+#define TRANSPORT_WIFI_RSSI_MIN    -82    // dBm; below this WiFi is not trusted
+#define TRANSPORT_RTT_MAX          1500   // ms ping/pong RTT considered healthy
+#define TRANSPORT_LOSS_MAX         25     // % of recent pings lost
+#define TRANSPORT_PROMOTE_DELAY    15000  // WS healthy this long before BLE goes to standby
+#define TRANSPORT_STANDBY_PROBE    5000   // WS ping interval while BLE is in standby
+
+enum TransportId : uint8_t {
+    TRANSPORT_WS,
+    TRANSPORT_BLE,
+    TRANSPORT_COUNT
+};
+
+struct TransportQuality {
+    bool up;
+    int8_t rssi;             // dBm, 0 = unknown
+    uint32_t rttMs;          // 0 = unknown (BLE has no ping)
+    uint8_t lossPct;
+    uint32_t drops;          // Up -> down transitions since boot
+};
+
+class TransportManager {
+public:
+    // Arbitration only in "both" mode; otherwise quality is just tracked.
+    // Direct mode has a single link (Supabase Realtime)
+    void begin(bool useWiFi, bool useBLE, bool direct = false);
+
+    // Network task
+    void loop();
+
+    TransportId getPrimary();
+    const char* getPrimaryName();
+    Transport* getActiveTransport();    // Primary if up, else whichever is
+    unsigned long getFailovers();
+
+    void writeJson(JsonObject out);
+
+private:
+    bool _arbitrate = false;
+    bool _direct = false;
+    TransportId _primary = TRANSPORT_BLE;   // WiFi earns primary once healthy
+    unsigned long _wsHealthySince = 0;
+    unsigned long _failovers = 0;
+    TransportQuality _quality[TRANSPORT_COUNT] = {};
+
+    void sample();
+    bool wsHealthy();
+    void promote(TransportId id, const char* reason);
+    void applyStandby();
+};
+
+extern TransportManager Transports;
+
+#endif // TRANSPORT_MANAGER_H
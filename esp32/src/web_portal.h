@@ -4,12 +4,37 @@
 #include <Arduino.h>
 #include <WebServer.h>
 #include <DNSServer.h>
+#include <freertos/FreeRTOS.h>
 #include "storage.h"
 
 // ============================================
 // Web Portal for Configuration
+// The page is static and stored gzipped in flash (portal/index.html,
+// embedded into portal_html.h at build time); scan results are written
+// into a fixed stack buffer. Nothing here builds a large String.
+// WiFi and BLE scans run in the background: /scan and /scanble answer
+// at once with the cached (or still-growing) result list.
 // ============================================
 
+#define PORTAL_SCAN_BUFFER       2048   // Bytes of scan JSON per response
+#define PORTAL_SCAN_MAX_RESULTS  24     // Networks / BLE devices kept per scan
+#define PORTAL_SCAN_MAX_AGE      30000  // Older results trigger a rescan (ms)
+#define PORTAL_BLE_SCAN_TIME     5      // Seconds
+
+struct PortalScanEntry {
+    char name[33];           // SSID or BLE device name
+    char address[18];        // BLE only
+    int8_t rssi;
+    bool encrypted;          // WiFi only
+};
+
+struct PortalScanCache {
+    PortalScanEntry entries[PORTAL_SCAN_MAX_RESULTS];
+    uint8_t count;
+    bool scanning;
+    unsigned long updatedAt; // millis() when the last scan finished, 0 = never
+};
+
 class WebPortal {
 public:
     void begin();
@@ -26,15 +51,29 @@ private:
     bool _running = false;
     std::function<void()> _onConfigSaved = nullptr;
 
+    // Allocated while the portal runs; the BLE cache is filled from the
+    // BLE stack's task
+    PortalScanCache* _wifiScan = nullptr;
+    PortalScanCache* _bleScan = nullptr;
+    portMUX_TYPE _scanMux = portMUX_INITIALIZER_UNLOCKED;
+
+    friend class PortalScanCallbacks;
+
     void handleRoot();
     void handleSave();
     void handleScan();
     void handleScanBLE();
+    void handleInfo();
     void handleNotFound();
 
-    String generateHTML();
-    String scanNetworks();
-    String scanBLEDevices();
+    void startWiFiScan();
+    void pollWiFiScan();
+    void startBLEScan();
+    void addBLEResult(const char* name, const char* address, int rssi);
+    void finishBLEScan();
+
+    bool shouldRescan(const PortalScanCache* cache);
+    size_t writeScanJson(char* out, size_t size, const PortalScanCache* cache, bool ble);
 };
 
 extern WebPortal Portal;
@@ -1,16 +1,66 @@
 #include "websocket_client.h"
+#include "debug_log.h"
 #include "display.h"
+#include "wire_protocol.h"
+#include "latency_monitor.h"
+#include "metrics.h"
+#include "power_manager.h"
+#include "boot_timeline.h"
+#include "transport_manager.h"
+#include "box_discovery.h"
+#include "sequence_tracker.h"
+#include "subscription_filter.h"
+#include "ota_updater.h"
 
 BitsperBoxClient WsClient;
 
 void BitsperBoxClient::begin(const char* host, uint16_t port) {
-    Serial.printf("[WS] Initializing connection to BitsperBox at %s:%d\n", host, port);
+    LOG_I(WS, "Initializing connection to BitsperBox at %s:%d", host, port);
 
-    // Store host and port for reconnection
-    strncpy(_host, host, sizeof(_host) - 1);
-    _port = port;
+    strncpy(_configuredHost, host, sizeof(_configuredHost) - 1);
+    _configuredPort = port;
 
-    _ws.begin(host, port, "/");
+    // The endpoint that last worked comes first: the Pi may have moved
+    // since the portal was filled in
+    if (!Storage.getBoxEndpoint(_host, sizeof(_host), _port)) {
+        strncpy(_host, host, sizeof(_host) - 1);
+        _port = port;
+    }
+
+    // Only the keys we use are kept when parsing; everything else is skipped
+    if (_filter.isNull()) {
+        _filter["type"] = true;
+        _filter["id"] = true;
+        _filter["table"] = true;
+        _filter["alert"] = true;
+        _filter["message"] = true;
+        _filter["priority"] = true;
+        _filter["timestamp"] = true;
+        _filter["wire"] = true;
+        _filter["client_time"] = true;
+        _filter["server_time"] = true;
+        _filter["level"] = true;
+        _filter["seq"] = true;
+        _filter["prev_seq"] = true;
+        _filter["seq_epoch"] = true;
+        _filter["to"] = true;
+        _filter["version"] = true;
+        _filter["size"] = true;
+        _filter["sha256"] = true;
+
+        // A filter that didn't fit keeps nothing at all: every frame
+        // would parse to null
+        _filterOk = !_filter.overflowed() && _filterArena.getFailures() == 0;
+        if (!_filterOk) {
+            LOG_E(WS, "Parse filter doesn't fit its arena (%u/%u bytes), parsing unfiltered",
+                  (unsigned)_filterArena.getUsed(), (unsigned)_filterArena.getCapacity());
+        }
+    }
+
+    // No IP configured and nothing cached: wait for discovery
+    if (_host[0] != '\0') {
+        _ws.begin(_host, _port, "/");
+    }
     _ws.onEvent([this](WStype_t type, uint8_t* payload, size_t length) {
         handleEvent(type, payload, length);
     });
@@ -22,19 +72,29 @@ void BitsperBoxClient::begin(const char* host, uint16_t port) {
     // Start with fast reconnect interval (will use exponential backoff on failures)
     _ws.setReconnectInterval(_currentBackoff);
 
-    // Enable ping/pong heartbeat: ping every 15s, timeout 5s, disconnect after 2 failures
-    // More aggressive than before (was 30s/10s/2)
-    _ws.enableHeartbeat(15000, 5000, 2);
+    // Ping/pong heartbeat is our own probe() (15s ping, 5s timeout,
+    // disconnect after 2 misses) so RTT and loss can be measured
 
     _lastReconnect = millis();
 
-    Serial.println("[WS] Client initialized with stability improvements");
-    Serial.printf("[WS] - Heartbeat: 15s ping, 5s timeout\n");
-    Serial.printf("[WS] - Initial reconnect interval: %lu ms\n", _currentBackoff);
+    LOG_I(WS, "Client initialized with stability improvements");
+    LOG_I(WS, "- Heartbeat: %lus ping, %lus timeout",
+          WS_PROBE_INTERVAL / 1000, WS_PROBE_TIMEOUT / 1000);
+    LOG_I(WS, "- Initial reconnect interval: %lu ms", _currentBackoff);
 }
 
 void BitsperBoxClient::loop() {
-    _ws.loop();
+    if (_host[0] != '\0') {
+        _ws.loop();
+    }
+
+    // Box not answering where we think it is: look for it on the LAN
+    updateDiscovery();
+
+    // Liveness plus RTT / loss for the transport manager
+    if (_connected) {
+        probe();
+    }
 
     // Send our own heartbeat every 20 seconds (in addition to WebSocket ping/pong)
     if (_connected && millis() - _lastHeartbeat > 20000) {
@@ -42,10 +102,37 @@ void BitsperBoxClient::loop() {
         _lastHeartbeat = millis();
     }
 
+    // Coalesced acks / user actions (the heartbeat may have taken them)
+    if (_connected && _acks.isDue()) {
+        sendAcks();
+    }
+
+    // A hole in the box's numbering: ask for just that run
+    uint32_t from, to;
+    if (_connected && Sequences.takeGap(from, to)) {
+        sendResync(from, to);
+    }
+
+    // Firmware update: the next chunk when it's due, and state changes
+    // right away rather than on the next heartbeat
+    uint32_t offset, length;
+    if (_connected && Ota.takeRequest(offset, length)) {
+        sendOtaRequest(offset, length);
+    }
+    if (_connected && Ota.takeChanged()) {
+        sendOtaStatus();
+    }
+
+    // Remote log tail, while the box has one open ("log_tail")
+    if (_connected && Log.getTailLevel() != LOG_NONE && millis() - _lastLogTail > LOG_TAIL_INTERVAL) {
+        sendLogTail();
+        _lastLogTail = millis();
+    }
+
     // Connection watchdog: if we haven't received anything in 60 seconds, force reconnect
     if (_connected && millis() - _lastActivity > 60000) {
-        Serial.println("[WS] Connection watchdog triggered - no activity for 60s");
-        Serial.println("[WS] Forcing reconnect...");
+        LOG_W(WS, "Connection watchdog triggered - no activity for 60s");
+        LOG_I(WS, "Forcing reconnect...");
         _ws.disconnect();
         _connected = false;
         // The library will auto-reconnect
@@ -59,7 +146,7 @@ void BitsperBoxClient::loop() {
         if (timeSinceLastReconnect > _currentBackoff * 2) {
             _currentBackoff = min(_currentBackoff * 2, WS_MAX_BACKOFF);
             _ws.setReconnectInterval(_currentBackoff);
-            Serial.printf("[WS] Increased reconnect interval to %lu ms\n", _currentBackoff);
+            LOG_I(WS, "Increased reconnect interval to %lu ms", _currentBackoff);
         }
     }
 }
@@ -73,8 +160,12 @@ bool BitsperBoxClient::isConnected() {
     return _connected;
 }
 
+bool BitsperBoxClient::isBinaryWire() {
+    return _binaryWire;
+}
+
 void BitsperBoxClient::forceReconnect() {
-    Serial.println("[WS] Force reconnect requested");
+    LOG_I(WS, "Force reconnect requested");
     _ws.disconnect();
     _connected = false;
     _reconnectAttempts = 0;
@@ -82,11 +173,9 @@ void BitsperBoxClient::forceReconnect() {
     _ws.setReconnectInterval(_currentBackoff);
 
     // Re-initialize connection
-    _ws.begin(_host, _port, "/");
-}
-
-void BitsperBoxClient::onNotification(std::function<void(NotificationData&)> callback) {
-    _onNotification = callback;
+    if (_host[0] != '\0') {
+        _ws.begin(_host, _port, "/");
+    }
 }
 
 void BitsperBoxClient::onConnectionChange(std::function<void(bool)> callback) {
@@ -94,33 +183,42 @@ void BitsperBoxClient::onConnectionChange(std::function<void(bool)> callback) {
 }
 
 void BitsperBoxClient::handleEvent(WStype_t type, uint8_t* payload, size_t length) {
+    _rxUs = micros();          // Start of the notification latency trail
     _lastActivity = millis();  // Update activity timestamp on any event
 
     switch (type) {
         case WStype_DISCONNECTED:
-            Serial.println("[WS] Disconnected from BitsperBox");
+            LOG_W(WS, "Disconnected from BitsperBox");
+            if (_connected) Metrics.count(METRIC_WS_RECONNECTS);
             _connected = false;
             _reconnectAttempts++;
             _lastReconnect = millis();
 
+            // A tail belongs to the box session that asked for it
+            Log.setTailLevel(LOG_NONE);
+
             // Apply exponential backoff
             _currentBackoff = min(_currentBackoff * 2, WS_MAX_BACKOFF);
             _ws.setReconnectInterval(_currentBackoff);
 
-            Serial.printf("[WS] Reconnect attempt %d, next in %lu ms\n",
-                         _reconnectAttempts, _currentBackoff);
+            LOG_I(WS, "Reconnect attempt %d, next in %lu ms",
+                 _reconnectAttempts, _currentBackoff);
 
             if (_onConnectionChange) _onConnectionChange(false);
             break;
 
         case WStype_CONNECTED:
-            Serial.printf("[WS] Connected to BitsperBox: %s\n", payload);
+            LOG_I(WS, "Connected to BitsperBox: %s", payload);
             _connected = true;
             _reconnectAttempts = 0;
             _currentBackoff = WS_MIN_BACKOFF;  // Reset backoff on successful connection
             _ws.setReconnectInterval(_currentBackoff);
             _lastActivity = millis();
             _lastHeartbeat = millis();
+            _binaryWire = false;  // Renegotiated by every register
+            _lastProbe = millis();
+            _pingSentAt = 0;
+            _missedPongs = 0;
 
             sendRegister();
             if (_onConnectionChange) _onConnectionChange(true);
@@ -131,22 +229,28 @@ void BitsperBoxClient::handleEvent(WStype_t type, uint8_t* payload, size_t lengt
             break;
 
         case WStype_PING:
-            Serial.println("[WS] Ping received");
+            LOG_D(WS, "Ping received");
             _lastActivity = millis();
             break;
 
         case WStype_PONG:
-            Serial.println("[WS] Pong received");
             _lastActivity = millis();
+            if (_pingSentAt != 0) {
+                _rttMs = millis() - _pingSentAt;
+                _pingSentAt = 0;
+                _missedPongs = 0;
+                recordProbe(false);
+            }
+            LOG_D(WS, "Pong received (RTT %lu ms)", (unsigned long)_rttMs);
             break;
 
         case WStype_ERROR:
-            Serial.printf("[WS] Error: %s\n", payload);
+            LOG_E(WS, "Error: %s", payload);
             _reconnectAttempts++;
             break;
 
         case WStype_BIN:
-            Serial.printf("[WS] Binary data received (%d bytes)\n", length);
+            handleBinary(payload, length);
             break;
 
         default:
@@ -154,92 +258,163 @@ void BitsperBoxClient::handleEvent(WStype_t type, uint8_t* payload, size_t lengt
     }
 }
 
+#if BENCHMARK_BUILD
+void BitsperBoxClient::decodeForBench(uint8_t* frame, size_t length) {
+    if (length > 0 && frame[0] == WIRE_MAGIC) {
+        handleBinary(frame, length);
+    } else {
+        handleMessage(frame, length);
+    }
+}
+#endif
+
 void BitsperBoxClient::handleMessage(uint8_t* payload, size_t length) {
-    Serial.printf("[WS] Message received: %s\n", payload);
+    // Payload is not guaranteed to be NUL-terminated
+    LOG_D(WS, "Message received (%u bytes): %.*s",
+          (unsigned)length, (int)min(length, (size_t)128), (const char*)payload);
     _lastActivity = millis();
 
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, payload, length);
+    _rxDoc.clear();
+    _rxArena.reset();
+    DeserializationError error = _filterOk
+        ? deserializeJson(_rxDoc, payload, length, DeserializationOption::Filter(_filter))
+        : deserializeJson(_rxDoc, payload, length);
 
     if (error) {
-        Serial.printf("[WS] JSON parse error: %s\n", error.c_str());
+        LOG_E(WS, "JSON parse error: %s (arena %u/%u bytes)", error.c_str(),
+              (unsigned)_rxArena.getUsed(), (unsigned)_rxArena.getCapacity());
+        Metrics.count(METRIC_JSON_ERRORS);
         return;
     }
 
-    const char* msgType = doc["type"] | "";
+    const char* msgType = _rxDoc["type"] | "";
 
     // Handle different message types
     if (strcmp(msgType, "notification") == 0) {
-        NotificationData notif;
-        memset(&notif, 0, sizeof(NotificationData));
+        deliverNotification(decodeJson(_rxDoc, _rxUs));
+    }
+    else if (strcmp(msgType, "welcome") == 0) {
+        LOG_I(WS, "Received welcome from BitsperBox");
+    }
+    else if (strcmp(msgType, "registered") == 0) {
+        LOG_I(WS, "Device registered successfully with BitsperBox");
+        Boot.mark(BOOT_WS);
 
-        strncpy(notif.table, doc["table"] | "", sizeof(notif.table) - 1);
-        strncpy(notif.type, doc["alert"] | "", sizeof(notif.type) - 1);
-        strncpy(notif.message, doc["message"] | "", sizeof(notif.message) - 1);
-        strncpy(notif.priority, doc["priority"] | "medium", sizeof(notif.priority) - 1);
-        notif.timestamp = doc["timestamp"] | millis();
+        // The box confirms the binary protocol if it will use it
+        _binaryWire = strcmp(_rxDoc["wire"] | "", WIRE_PROTOCOL_NAME) == 0;
+        if (_binaryWire) {
+            LOG_I(WS, "Binary notifications (" WIRE_PROTOCOL_NAME ") negotiated");
+        }
 
-        Serial.printf("[WS] >>> NOTIFICATION: Table %s, Type: %s, Priority: %s\n",
-                      notif.table, notif.type, notif.priority);
+        // Next boot starts here, wherever the box was found
+        Storage.saveBoxEndpoint(_host, _port);
 
-        if (_onNotification) {
-            _onNotification(notif);
+        // Counts toward keeping a freshly updated image; resumes a transfer
+        Ota.onLinkUp();
+
+        // Replays of what we missed follow this message
+        if (_rxDoc["seq_epoch"].is<uint32_t>()) {
+            Sequences.onRegistered(_rxDoc["seq_epoch"].as<uint32_t>(), _rxDoc["seq"] | (uint32_t)0);
         }
 
-        // Send acknowledgment
-        const char* notifId = doc["id"] | "";
-        if (strlen(notifId) > 0) {
-            sendAck(notifId);
+        // Box clock, from the echo of our register send time
+        if (_rxDoc["server_time"].is<uint64_t>() && _rxDoc["client_time"].is<uint32_t>()) {
+            Latency.onSyncReply(_rxDoc["server_time"].as<uint64_t>(),
+                                _rxDoc["client_time"].as<uint32_t>());
         }
     }
-    else if (strcmp(msgType, "welcome") == 0) {
-        Serial.println("[WS] Received welcome from BitsperBox");
-    }
-    else if (strcmp(msgType, "registered") == 0) {
-        Serial.println("[WS] Device registered successfully with BitsperBox");
-    }
     else if (strcmp(msgType, "ping") == 0) {
+        // Keeps the box clock offset from drifting between registers
+        if (_rxDoc["server_time"].is<uint64_t>()) {
+            Latency.onServerTime(_rxDoc["server_time"].as<uint64_t>());
+        }
+
         // Respond to application-level ping
-        JsonDocument pong;
-        pong["type"] = "pong";
-        pong["device_id"] = Storage.getDeviceId();
-        String pongStr;
-        serializeJson(pong, pongStr);
-        _ws.sendTXT(pongStr);
-        Serial.println("[WS] Responded to ping with pong");
+        beginFrame("pong");
+        sendFrame();
+        LOG_D(WS, "Responded to ping with pong");
+    }
+    else if (strcmp(msgType, "resynced") == 0) {
+        // The resent notifications came first; the rest of the range is gone
+        Sequences.onResynced(_rxDoc["to"] | (uint32_t)0);
+    }
+    else if (strcmp(msgType, "log_tail") == 0) {
+        // Field debugging: the box asks for our log lines up to `level`
+        uint8_t level = min(_rxDoc["level"] | (uint8_t)LOG_NONE, (uint8_t)LOG_DEBUG);
+        Log.setTailLevel(level);
+        LOG_W(WS, "Remote log tail %s (level %d)", level != LOG_NONE ? "on" : "off", level);
+    }
+    else if (strcmp(msgType, "ota_offer") == 0) {
+        // Chunks are pulled from loop(); a declined offer shows in the status
+        Ota.onOffer(_rxDoc["version"] | "", _rxDoc["size"] | (uint32_t)0, _rxDoc["sha256"] | "");
+    }
+    else if (strcmp(msgType, "ota_cancel") == 0) {
+        Ota.onCancel();
     }
 }
 
-void BitsperBoxClient::sendRegister() {
-    JsonDocument doc;
-    doc["type"] = "register";
-    doc["device_id"] = Storage.getDeviceId();
-
-    // Load device name from config
-    DeviceConfig config;
-    if (Storage.loadConfig(config)) {
-        doc["name"] = config.device_name;
-    } else {
-        doc["name"] = "BitsperWatch";
+void BitsperBoxClient::handleBinary(uint8_t* payload, size_t length) {
+    _lastActivity = millis();
+
+    if (!wireIsBinary(payload, length)) {
+        LOG_W(WS, "Unknown binary data received (%d bytes)", length);
+        return;
     }
 
+    uint32_t offset;
+    const uint8_t* chunk;
+    size_t chunkLength;
+    if (wireMessageType(payload) == WIRE_MSG_OTA_CHUNK) {
+        if (wireDecodeOtaChunk(payload, length, offset, chunk, chunkLength)) {
+            Ota.onChunk(offset, chunk, chunkLength);
+        }
+        return;
+    }
+
+    deliverNotification(decodeBinary(payload, length, _rxUs));
+}
+
+void BitsperBoxClient::deliverNotification(InboxItem* item) {
+    // Malformed, or the inbox is full: never queued, so no ack
+    if (item == nullptr) return;
+
+    // Acknowledged with the next batch, not a frame of its own
+    queueAck(ACK_RECEIVED, item->data.id);
+    publishNotification(item);
+}
+
+void BitsperBoxClient::sendRegister() {
+    JsonDocument& doc = beginFrame("register");
+
+    const DeviceConfig& config = Storage.getConfig();
+    doc["name"] = config.configured ? config.device_name : "BitsperWatch";
+
     doc["firmware"] = FIRMWARE_VERSION;
     doc["rssi"] = WiFi.RSSI();
+    doc["wire"] = WIRE_PROTOCOL_NAME;  // Offer binary notifications; JSON otherwise
+    doc["client_time"] = (uint32_t)millis();  // Echoed back for clock sync
+
+    // Where the box should resume (nothing the first time since boot)
+    if (Sequences.getEpoch() != 0) {
+        doc["seq_epoch"] = Sequences.getEpoch();
+        doc["last_seq"] = Sequences.getLastContiguous();
+    }
 
-    String json;
-    serializeJson(doc, json);
+    // Only what this watch is for (the box sends everything otherwise)
+    if (!Subscription.isEmpty()) {
+        Subscription.writeJson(doc["filter"].to<JsonObject>());
+    }
 
-    Serial.printf("[WS] Sending register: %s\n", json.c_str());
-    _ws.sendTXT(json);
+    LOG_I(WS, "Sending register");
+    sendFrame();
 }
 
 void BitsperBoxClient::sendHeartbeat() {
-    JsonDocument doc;
-    doc["type"] = "heartbeat";
-    doc["device_id"] = Storage.getDeviceId();
+    JsonDocument& doc = beginFrame("heartbeat");
     doc["uptime"] = millis() / 1000;
     doc["free_heap"] = ESP.getFreeHeap();
     doc["rssi"] = WiFi.RSSI();
+    doc["power"] = Power.getProfileName();
 
     // Add signal quality indicator
     int rssi = WiFi.RSSI();
@@ -249,24 +424,143 @@ void BitsperBoxClient::sendHeartbeat() {
     else if (rssi > -80) doc["signal"] = "weak";
     else doc["signal"] = "very_weak";
 
-    String json;
-    serializeJson(doc, json);
-    _ws.sendTXT(json);
+    // Notification latency histograms (WS and BLE)
+    Latency.writeJson(doc["latency"].to<JsonObject>());
 
-    Serial.printf("[WS] Heartbeat sent (RSSI: %d dBm)\n", rssi);
+    // Link quality and which transport is primary
+    Transports.writeJson(doc["transport"].to<JsonObject>());
+
+    // Time from reset to each boot milestone, until one heartbeat got it out
+    bool withBoot = !_bootReported;
+    if (withBoot) {
+        Boot.writeJson(doc["boot"].to<JsonObject>());
+    }
+
+    // Loop times, heap low-water mark, reconnect / error / drop counters
+    Metrics.writeJson(doc["metrics"].to<JsonObject>());
+
+    // Firmware slot and update progress, for the box's rollout waves
+    Ota.writeJson(doc["ota"].to<JsonObject>());
+
+    // Pending acks ride along instead of going out on their own
+    uint8_t acks = _acks.copyInto(doc.as<JsonObject>(), ACK_PIGGYBACK_MAX);
+
+    if (sendFrame()) {
+        _acks.consume(acks);
+        if (withBoot) _bootReported = true;
+    }
+
+    LOG_D(WS, "Heartbeat sent (RSSI: %d dBm)", rssi);
+}
+
+void BitsperBoxClient::sendAcks() {
+    JsonDocument& doc = beginFrame("acks");
+    uint8_t count = _acks.copyInto(doc.as<JsonObject>(), ACK_BATCH_MAX);
+    if (!sendFrame()) return;   // Still pending: retried on the next loop
+
+    _acks.consume(count);
+    LOG_D(WS, "Sent %d acks in one frame", count);
+}
+
+void BitsperBoxClient::sendResync(uint32_t from, uint32_t to) {
+    JsonDocument& doc = beginFrame("resync");
+    doc["seq_epoch"] = Sequences.getEpoch();
+    doc["from"] = from;
+    doc["to"] = to;
+    sendFrame();
+}
+
+void BitsperBoxClient::sendOtaRequest(uint32_t offset, uint32_t length) {
+    JsonDocument& doc = beginFrame("ota_chunk");
+    doc["offset"] = offset;
+    doc["length"] = length;
+    sendFrame();
+}
+
+void BitsperBoxClient::sendOtaStatus() {
+    JsonDocument& doc = beginFrame("ota_status");
+    Ota.writeJson(doc["ota"].to<JsonObject>());
+    sendFrame();
 }
 
-void BitsperBoxClient::sendAck(const char* notificationId) {
-    JsonDocument doc;
-    doc["type"] = "ack";
-    doc["notification_id"] = notificationId;
-    doc["device_id"] = Storage.getDeviceId();
+void BitsperBoxClient::sendLogTail() {
+    // No logging here: it would tail itself
+    char text[LOG_TAIL_BUFFER];
+    if (Log.takeTail(text, sizeof(text)) == 0) return;
 
-    String json;
-    serializeJson(doc, json);
-    _ws.sendTXT(json);
+    JsonDocument& doc = beginFrame("log");
+    doc["text"] = text;
+    doc["dropped"] = Log.getDropped();
+    sendFrame();
+}
+
+JsonDocument& BitsperBoxClient::beginFrame(const char* type) {
+    _txDoc.clear();
+    _txArena.reset();
+    _txDoc["type"] = type;
+    _txDoc["device_id"] = Storage.getDeviceId().c_str();
+    return _txDoc;
+}
+
+bool BitsperBoxClient::sendFrame() {
+    if (_txDoc.overflowed() || measureJson(_txDoc) >= sizeof(_txBuffer)) {
+        LOG_E(WS, "Outgoing frame too large, dropped (%s)",
+              (const char*)(_txDoc["type"] | "?"));
+        return false;
+    }
+
+    size_t len = serializeJson(_txDoc, _txBuffer, sizeof(_txBuffer));
+    return _ws.sendTXT(_txBuffer, len);
+}
+
+void BitsperBoxClient::setProbeInterval(unsigned long interval) {
+    _probeInterval = interval;
+}
 
-    Serial.printf("[WS] Sent ack for notification: %s\n", notificationId);
+uint32_t BitsperBoxClient::getRtt() {
+    return _rttMs;
+}
+
+uint8_t BitsperBoxClient::getMissedPongs() {
+    return _missedPongs;
+}
+
+uint8_t BitsperBoxClient::getProbeLoss() {
+    if (_probeCount == 0) return 0;
+    return __builtin_popcount(_probeHistory) * 100 / _probeCount;
+}
+
+void BitsperBoxClient::probe() {
+    unsigned long now = millis();
+
+    if (_pingSentAt != 0) {
+        if (now - _pingSentAt < WS_PROBE_TIMEOUT) return;
+
+        _pingSentAt = 0;
+        _missedPongs++;
+        recordProbe(true);
+        LOG_W(WS, "Pong timeout (%d in a row)", _missedPongs);
+
+        if (_missedPongs >= WS_PROBE_MAX_MISSES) {
+            LOG_W(WS, "Link dead, forcing reconnect...");
+            _ws.disconnect();
+            _connected = false;
+            return;
+        }
+    }
+
+    if (now - _lastProbe >= _probeInterval) {
+        _lastProbe = now;
+        _pingSentAt = max(now, 1UL);  // 0 is "none outstanding"
+        _ws.sendPing();
+    }
+}
+
+void BitsperBoxClient::recordProbe(bool lost) {
+    _probeHistory = (_probeHistory << 1) | (lost ? 1 : 0);
+    if (_probeCount < WS_PROBE_HISTORY) {
+        _probeCount++;
+    }
 }
 
 unsigned long BitsperBoxClient::getReconnectAttempts() {
@@ -276,3 +570,58 @@ unsigned long BitsperBoxClient::getReconnectAttempts() {
 unsigned long BitsperBoxClient::getCurrentBackoff() {
     return _currentBackoff;
 }
+
+const char* BitsperBoxClient::getHost() {
+    return _host;
+}
+
+uint16_t BitsperBoxClient::getPort() {
+    return _port;
+}
+
+void BitsperBoxClient::updateDiscovery() {
+    if (_connected) {
+        Discovery.cancel();
+        return;
+    }
+
+    char host[sizeof(_host)];
+    uint16_t port = 0;
+    if (Discovery.poll(host, sizeof(host), port)) {
+        if (strcmp(host, _host) != 0 || port != _port) {
+            useEndpoint(host, port, "mDNS");
+        }
+        return;
+    }
+    if (Discovery.isRunning() || WiFi.status() != WL_CONNECTED) return;
+
+    // Nothing to connect to, or the current endpoint keeps failing
+    bool noEndpoint = _host[0] == '\0';
+    bool failing = _reconnectAttempts >= WS_DISCOVERY_AFTER;
+    if (!noEndpoint && !failing) return;
+    if (_lastDiscovery != 0 && millis() - _lastDiscovery < WS_DISCOVERY_INTERVAL) return;
+
+    _lastDiscovery = millis();
+    Discovery.start();
+
+    // A stale cached endpoint gives way to the configured one while the
+    // query runs; whichever answers first wins
+    if (failing && _configuredHost[0] != '\0' &&
+        (strcmp(_host, _configuredHost) != 0 || _port != _configuredPort)) {
+        useEndpoint(_configuredHost, _configuredPort, "configured");
+    }
+}
+
+void BitsperBoxClient::useEndpoint(const char* host, uint16_t port, const char* reason) {
+    LOG_I(WS, "Switching to %s:%u (%s)", host, port, reason);
+
+    strncpy(_host, host, sizeof(_host) - 1);
+    _host[sizeof(_host) - 1] = '\0';
+    _port = port;
+
+    _ws.disconnect();
+    _reconnectAttempts = 0;
+    _currentBackoff = WS_MIN_BACKOFF;
+    _ws.setReconnectInterval(_currentBackoff);
+    _ws.begin(_host, _port, "/");
+}
@@ -7,6 +7,9 @@
 #include <ArduinoJson.h>
 #include "storage.h"
 #include "config.h"
+#include "notification_queue.h"
+#include "json_arena.h"
+#include "transport.h"
 
 // ============================================
 // WebSocket Client for BitsperBox
@@ -17,56 +20,117 @@
 #define WS_MIN_BACKOFF 1000UL     // Start with 1 second
 #define WS_MAX_BACKOFF 30000UL    // Max 30 seconds between retries
 
-struct NotificationData {
-    char table[16];
-    char type[32];
-    char message[256];
-    char priority[16];
-    unsigned long timestamp;
-};
+// Endpoint recovery: cached endpoint first, then the configured one,
+// with an mDNS lookup (box_discovery.h) running alongside
+#define WS_DISCOVERY_AFTER     3         // Failed connects before looking around
+#define WS_DISCOVERY_INTERVAL  30000UL   // Between lookups while still failing
+
+// Ping/pong probe: liveness, RTT and loss (transport arbitration)
+#define WS_PROBE_INTERVAL   15000UL   // Normal ping interval
+#define WS_PROBE_TIMEOUT    5000UL    // Pong must arrive within this
+#define WS_PROBE_MAX_MISSES 2         // Reconnect after this many in a row
+#define WS_PROBE_HISTORY    8         // Pings the loss figure covers
+
+// Fixed JSON memory (no per-message heap allocation)
+#define WS_RX_ARENA_SIZE 2048     // Filtered incoming message
+#define WS_TX_ARENA_SIZE 6144     // Outgoing frames; a full heartbeat is ~270 slots (4 pools) + strings
+#define WS_TX_BUFFER_SIZE 3072    // Serialized outgoing frame, ~2.8 KB worst-case heartbeat (member: too big for the net task stack)
+#define WS_FILTER_ARENA_SIZE 2048 // One slot pool plus the ~20 filter keys
 
-class BitsperBoxClient {
+class BitsperBoxClient : public Transport {
 public:
+    BitsperBoxClient() : Transport(SOURCE_WEBSOCKET) {}
+
     void begin(const char* host, uint16_t port);
     void loop();
     void disconnect();
     void forceReconnect();
 
-    bool isConnected();
-    void sendAck(const char* notificationId);
+    bool isConnected() override;
+    bool isBinaryWire();
+
+    // Link quality (network task)
+    void setProbeInterval(unsigned long interval);
+    uint32_t getRtt();            // Last ping/pong RTT in ms, 0 = none yet
+    uint8_t getMissedPongs();     // Consecutive, reset by a pong
+    uint8_t getProbeLoss();       // % of the last WS_PROBE_HISTORY pings
 
     // Status
+    const char* getHost();        // Endpoint in use (cached, configured or discovered)
+    uint16_t getPort();
     unsigned long getReconnectAttempts();
     unsigned long getCurrentBackoff();
 
-    // Callback when notification received
-    void onNotification(std::function<void(NotificationData&)> callback);
-
     // Callback for connection status changes
     void onConnectionChange(std::function<void(bool)> callback);
 
+#if BENCHMARK_BUILD
+    // On-target benchmarks: a received text or bpw1 frame (by its first
+    // byte), through the same decode path; may write into `frame`
+    void decodeForBench(uint8_t* frame, size_t length);
+#endif
+
 private:
     WebSocketsClient _ws;
     bool _connected = false;
+    bool _binaryWire = false;    // Box confirmed bpw1 binary notifications
+    bool _bootReported = false;  // Boot timeline rides every heartbeat until one is sent
+    bool _filterOk = false;      // Parse filter built; parse unfiltered otherwise
     unsigned long _lastReconnect = 0;
     unsigned long _lastHeartbeat = 0;
     unsigned long _lastActivity = 0;
+    unsigned long _lastLogTail = 0;
     unsigned long _reconnectAttempts = 0;
-
-    // Host info for reconnection
+    uint32_t _rxUs = 0;          // micros() when the current frame arrived
+
+    // Ping/pong probe
+    unsigned long _probeInterval = WS_PROBE_INTERVAL;
+    unsigned long _lastProbe = 0;
+    unsigned long _pingSentAt = 0;   // 0 = no ping outstanding
+    uint32_t _rttMs = 0;
+    uint8_t _missedPongs = 0;
+    uint8_t _probeHistory = 0;       // Bit set = ping lost, newest in bit 0
+    uint8_t _probeCount = 0;
+
+    // Endpoint in use, and the one typed into the portal (may be empty)
     char _host[64] = {0};
     uint16_t _port = 3334;
+    char _configuredHost[64] = {0};
+    uint16_t _configuredPort = 3334;
+    unsigned long _lastDiscovery = 0;
 
     // Exponential backoff
     unsigned long _currentBackoff = WS_MIN_BACKOFF;
 
-    std::function<void(NotificationData&)> _onNotification = nullptr;
     std::function<void(bool)> _onConnectionChange = nullptr;
 
+    // Preallocated decode/encode state
+    StaticJsonArena<WS_RX_ARENA_SIZE> _rxArena;
+    StaticJsonArena<WS_TX_ARENA_SIZE> _txArena;
+    StaticJsonArena<WS_FILTER_ARENA_SIZE> _filterArena;
+    JsonDocument _rxDoc{&_rxArena};
+    JsonDocument _txDoc{&_txArena};
+    char _txBuffer[WS_TX_BUFFER_SIZE];
+    JsonDocument _filter{&_filterArena};
+
     void handleEvent(WStype_t type, uint8_t* payload, size_t length);
     void handleMessage(uint8_t* payload, size_t length);
+    void handleBinary(uint8_t* payload, size_t length);
+    void deliverNotification(InboxItem* item);
     void sendRegister();
     void sendHeartbeat();
+    void sendAcks();
+    void sendResync(uint32_t from, uint32_t to);
+    void sendOtaRequest(uint32_t offset, uint32_t length);
+    void sendOtaStatus();
+    void sendLogTail();
+    void updateDiscovery();
+    void useEndpoint(const char* host, uint16_t port, const char* reason);
+    void probe();
+    void recordProbe(bool lost);
+
+    JsonDocument& beginFrame(const char* type);
+    bool sendFrame();   // False when dropped as too large or not sent
 };
 
 extern BitsperBoxClient WsClient;
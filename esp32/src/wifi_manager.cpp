@@ -1,8 +1,30 @@
 #include "wifi_manager.h"
+#include "debug_log.h"
 #include "display.h"
+#include "power_manager.h"
 
 WiFiManager_ WifiMgr;
 
+// Last AP we associated with. RTC memory survives software resets
+// (restart after config save, crash), so even the boot connect can skip
+// the channel scan; a power cycle starts with a full scan.
+#define WIFI_AP_CACHE_MAGIC 0x57494649UL  // "WIFI"
+
+struct WiFiApCache {
+    uint32_t magic;
+    uint32_t ssidHash;
+    uint8_t bssid[6];
+    uint8_t channel;
+};
+
+RTC_DATA_ATTR static WiFiApCache apCache;
+
+static uint32_t hashSsid(const char* ssid) {
+    uint32_t hash = 2166136261UL;
+    for (const char* p = ssid; *p; p++) hash = (hash ^ (uint8_t)*p) * 16777619UL;
+    return hash;
+}
+
 // Static callback wrapper for WiFi events
 static void onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
     WifiMgr.handleWiFiEvent(event, info);
@@ -21,12 +43,9 @@ void WiFiManager_::begin() {
     // Persist WiFi config to flash for faster reconnection
     WiFi.persistent(true);
 
-    // Disable WiFi power saving for more stable connection
-    // This increases power consumption but improves reliability
-    WiFi.setSleep(false);
-
-    // Set WiFi TX power to maximum for better range
-    WiFi.setTxPower(WIFI_POWER_19_5dBm);
+    // Modem sleep and TX power come from the power profile (performance
+    // until the config is loaded: no sleep, max TX power)
+    Power.applyWiFi();
 
     // ═══════════════════════════════════════════════════════════════════
     // Register WiFi event handlers for instant disconnect detection
@@ -40,56 +59,75 @@ void WiFiManager_::begin() {
     snprintf(apSSID, sizeof(apSSID), "%s%02X%02X", WIFI_AP_SSID_PREFIX, mac[4], mac[5]);
     _apSSID = String(apSSID);
 
-    Serial.println("[WiFi] Manager initialized with stability improvements");
-    Serial.println("[WiFi] - Auto-reconnect: ENABLED");
-    Serial.println("[WiFi] - Power save: DISABLED");
-    Serial.println("[WiFi] - TX Power: MAX (19.5dBm)");
-    Serial.printf("[WiFi] AP SSID will be: %s\n", _apSSID.c_str());
+    LOG_I(WIFI, "Manager initialized with stability improvements");
+    LOG_I(WIFI, "- Auto-reconnect: ENABLED");
+    LOG_I(WIFI, "AP SSID will be: %s", _apSSID.c_str());
 }
 
 void WiFiManager_::handleWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
     switch (event) {
         case ARDUINO_EVENT_WIFI_STA_START:
-            Serial.println("[WiFi] Station started");
+            LOG_I(WIFI, "Station started");
             break;
 
         case ARDUINO_EVENT_WIFI_STA_CONNECTED:
-            Serial.println("[WiFi] Connected to AP");
+            LOG_I(WIFI, "Connected to AP");
             _reconnectAttempts = 0;
             _currentBackoff = WIFI_MIN_BACKOFF;
             break;
 
         case ARDUINO_EVENT_WIFI_STA_GOT_IP:
-            Serial.printf("[WiFi] Got IP: %s\n", WiFi.localIP().toString().c_str());
-            Serial.printf("[WiFi] RSSI: %d dBm (Signal: %s)\n",
-                         WiFi.RSSI(), getSignalQuality(WiFi.RSSI()));
+            LOG_I(WIFI, "Got IP: %s in %lu ms%s", WiFi.localIP().toString().c_str(),
+                 millis() - _connectStart, _fastConnect ? " (fast connect)" : "");
+            LOG_I(WIFI, "RSSI: %d dBm (Signal: %s), Channel: %d",
+                 WiFi.RSSI(), getSignalQuality(WiFi.RSSI()), WiFi.channel());
+
+            // Remember the AP for the next (re)connect
+            apCache.magic = WIFI_AP_CACHE_MAGIC;
+            apCache.ssidHash = hashSsid(_ssid);
+            memcpy(apCache.bssid, WiFi.BSSID(), sizeof(apCache.bssid));
+            apCache.channel = WiFi.channel();
+
             _state = WIFI_STATE_CONNECTED;
             _reconnectAttempts = 0;
             _currentBackoff = WIFI_MIN_BACKOFF;
             _reconnectScheduled = false;  // Clear any pending reconnect
+            _failureReported = false;
+            _hasConnected = true;
             if (_onConnectionChange) _onConnectionChange(true);
             break;
 
         case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
             {
                 wifi_err_reason_t reason = (wifi_err_reason_t)info.wifi_sta_disconnected.reason;
-                Serial.printf("[WiFi] Disconnected! Reason: %d (%s)\n",
-                             reason, getDisconnectReason(reason));
+                LOG_W(WIFI, "Disconnected! Reason: %d (%s)",
+                     reason, getDisconnectReason(reason));
+
+                // Re-associate at full power; adaptation starts over
+                Power.resetTxPower();
+
+                // A failed attempt: the driver keeps retrying until loop()
+                // times it out, but a miss on the cached AP (it moved
+                // channel, or we roamed) goes straight to a full scan
+                if (_state == WIFI_STATE_CONNECTING) {
+                    if (_fastConnect) _fastFailed = true;
+                    break;
+                }
 
                 if (_state == WIFI_STATE_CONNECTED) {
                     _state = WIFI_STATE_DISCONNECTED;
                     if (_onConnectionChange) _onConnectionChange(false);
-                }
 
-                // Don't auto-reconnect if in AP mode or if manually disconnected
-                if (_state != WIFI_STATE_AP_MODE && !_manualDisconnect) {
-                    scheduleReconnect();
+                    // Don't auto-reconnect if manually disconnected
+                    if (!_manualDisconnect) {
+                        scheduleReconnect();
+                    }
                 }
             }
             break;
 
         case ARDUINO_EVENT_WIFI_STA_LOST_IP:
-            Serial.println("[WiFi] Lost IP address");
+            LOG_W(WIFI, "Lost IP address");
             break;
 
         default:
@@ -130,71 +168,105 @@ void WiFiManager_::scheduleReconnect() {
     _reconnectAttempts++;
 
     if (_reconnectAttempts > WIFI_MAX_RECONNECT_ATTEMPTS) {
-        Serial.printf("[WiFi] Max reconnect attempts (%d) reached. Starting AP mode.\n",
-                     WIFI_MAX_RECONNECT_ATTEMPTS);
-        startAPMode();
-        return;
+        if (!_onConnectFailed) {
+            LOG_W(WIFI, "Max reconnect attempts (%d) reached. Starting AP mode.",
+                 WIFI_MAX_RECONNECT_ATTEMPTS);
+            startAPMode();
+            return;
+        }
+
+        // The owner decides (BLE may still be up); keep trying slowly
+        LOG_W(WIFI, "Max reconnect attempts (%d) reached, retrying every %lu ms",
+             WIFI_MAX_RECONNECT_ATTEMPTS, WIFI_MAX_BACKOFF);
+        _reconnectAttempts = WIFI_MAX_RECONNECT_ATTEMPTS;
+        reportFailure();
+        if (_state == WIFI_STATE_AP_MODE) return;
     }
 
     // Calculate backoff with exponential increase
     _currentBackoff = min(_currentBackoff * 2, WIFI_MAX_BACKOFF);
 
-    Serial.printf("[WiFi] Scheduling reconnect attempt %d/%d in %lu ms\n",
-                 _reconnectAttempts, WIFI_MAX_RECONNECT_ATTEMPTS, _currentBackoff);
+    LOG_I(WIFI, "Scheduling reconnect attempt %d/%d in %lu ms",
+         _reconnectAttempts, WIFI_MAX_RECONNECT_ATTEMPTS, _currentBackoff);
 
     _nextReconnect = millis() + _currentBackoff;
     _reconnectScheduled = true;
 }
 
 bool WiFiManager_::connect(const char* ssid, const char* password) {
-    Serial.printf("[WiFi] Connecting to %s...\n", ssid);
-    Display.showConnecting(ssid);
+    if (ssid == nullptr || strlen(ssid) == 0) {
+        LOG_I(WIFI, "No SSID configured");
+        return false;
+    }
+
+    strncpy(_ssid, ssid, sizeof(_ssid) - 1);
+    _ssid[sizeof(_ssid) - 1] = '\0';
+    strncpy(_password, password, sizeof(_password) - 1);
+    _password[sizeof(_password) - 1] = '\0';
 
+    _manualDisconnect = false;
+    _failureReported = false;
+    _hasConnected = false;
+    startConnect();
+    return true;
+}
+
+void WiFiManager_::startConnect() {
     _state = WIFI_STATE_CONNECTING;
     _connectStart = millis();
-    _manualDisconnect = false;
+    _fastFailed = false;
 
     WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid, password);
-
-    // Non-blocking wait with visual feedback
-    int dots = 0;
-    while (WiFi.status() != WL_CONNECTED) {
-        if (millis() - _connectStart > WIFI_CONNECT_TIMEOUT) {
-            Serial.println("\n[WiFi] Connection timeout!");
-            _state = WIFI_STATE_ERROR;
-            Display.showError("WiFi timeout");
-            return false;
-        }
-        delay(250);
-        Serial.print(".");
-        dots++;
-        if (dots % 20 == 0) Serial.println();
+
+    // Skip the all-channel scan when we know where the AP was
+    _fastConnect = apCache.magic == WIFI_AP_CACHE_MAGIC &&
+                   apCache.ssidHash == hashSsid(_ssid);
+
+    if (_fastConnect) {
+        LOG_I(WIFI, "Connecting to %s (cached %02X:%02X:%02X:%02X:%02X:%02X, ch %d)...",
+             _ssid, apCache.bssid[0], apCache.bssid[1], apCache.bssid[2],
+             apCache.bssid[3], apCache.bssid[4], apCache.bssid[5], apCache.channel);
+        WiFi.begin(_ssid, _password, apCache.channel, apCache.bssid);
+    } else {
+        LOG_I(WIFI, "Connecting to %s...", _ssid);
+        WiFi.begin(_ssid, _password);
     }
+}
 
-    Serial.println();
-    Serial.printf("[WiFi] Connected! IP: %s\n", WiFi.localIP().toString().c_str());
-    Serial.printf("[WiFi] RSSI: %d dBm (Signal: %s)\n", WiFi.RSSI(), getSignalQuality(WiFi.RSSI()));
-    Serial.printf("[WiFi] Channel: %d\n", WiFi.channel());
+void WiFiManager_::checkConnectTimeout() {
+    unsigned long limit = _fastConnect ? WIFI_FAST_CONNECT_TIMEOUT : WIFI_CONNECT_TIMEOUT;
+    if (!_fastFailed && millis() - _connectStart <= limit) return;
 
-    _state = WIFI_STATE_CONNECTED;
-    _reconnectAttempts = 0;
-    _currentBackoff = WIFI_MIN_BACKOFF;
-    _reconnectScheduled = false;  // Clear any pending reconnect
-    Display.showConnected(ssid, WiFi.localIP().toString().c_str());
+    if (_fastConnect) {
+        LOG_W(WIFI, "Cached AP not answering, falling back to a full scan");
+        apCache.magic = 0;
+        startConnect();
+        return;
+    }
 
-    return true;
-}
+    LOG_W(WIFI, "Connection timeout!");
+    WiFi.disconnect();
+    _state = WIFI_STATE_ERROR;
 
-bool WiFiManager_::connectFromConfig() {
-    DeviceConfig config;
-    if (!Storage.loadConfig(config)) {
-        Serial.println("[WiFi] No saved configuration");
-        return false;
+    // Only the first connect gives up on a timeout; a reconnect goes
+    // through the backoff and reports once its attempts run out
+    if (!_hasConnected) reportFailure();
+
+    if (_state != WIFI_STATE_AP_MODE) {
+        scheduleReconnect();
     }
+}
 
-    if (strlen(config.wifi_ssid) == 0) {
-        Serial.println("[WiFi] No SSID configured");
+void WiFiManager_::reportFailure() {
+    if (_failureReported || !_onConnectFailed) return;
+    _failureReported = true;
+    _onConnectFailed();
+}
+
+bool WiFiManager_::connectFromConfig() {
+    const DeviceConfig& config = Storage.getConfig();
+    if (!config.configured) {
+        LOG_I(WIFI, "No saved configuration");
         return false;
     }
 
@@ -206,11 +278,11 @@ void WiFiManager_::disconnect() {
     _reconnectScheduled = false;
     WiFi.disconnect(true);
     _state = WIFI_STATE_DISCONNECTED;
-    Serial.println("[WiFi] Disconnected (manual)");
+    LOG_I(WIFI, "Disconnected (manual)");
 }
 
 void WiFiManager_::startAPMode() {
-    Serial.printf("[WiFi] Starting AP Mode: %s\n", _apSSID.c_str());
+    LOG_I(WIFI, "Starting AP Mode: %s", _apSSID.c_str());
 
     _reconnectScheduled = false;
     WiFi.mode(WIFI_AP);
@@ -219,7 +291,7 @@ void WiFiManager_::startAPMode() {
     delay(100);  // Wait for AP to start
 
     IPAddress apIP = WiFi.softAPIP();
-    Serial.printf("[WiFi] AP Started. IP: %s\n", apIP.toString().c_str());
+    LOG_I(WIFI, "AP Started. IP: %s", apIP.toString().c_str());
 
     _state = WIFI_STATE_AP_MODE;
     Display.showAPMode(_apSSID.c_str(), WIFI_AP_PASSWORD);
@@ -231,7 +303,7 @@ void WiFiManager_::stopAPMode() {
     _state = WIFI_STATE_DISCONNECTED;
     _reconnectAttempts = 0;
     _currentBackoff = WIFI_MIN_BACKOFF;
-    Serial.println("[WiFi] AP Mode stopped");
+    LOG_I(WIFI, "AP Mode stopped");
 }
 
 bool WiFiManager_::isAPMode() {
@@ -269,7 +341,16 @@ void WiFiManager_::setConnectionCallback(std::function<void(bool)> callback) {
     _onConnectionChange = callback;
 }
 
+void WiFiManager_::setConnectFailedCallback(std::function<void()> callback) {
+    _onConnectFailed = callback;
+}
+
 void WiFiManager_::loop() {
+    // Connect attempt in progress (fast connect first, then full scan)
+    if (_state == WIFI_STATE_CONNECTING) {
+        checkConnectTimeout();
+    }
+
     // Handle scheduled reconnection with exponential backoff
     // Only attempt if we're actually disconnected
     if (_reconnectScheduled && millis() >= _nextReconnect) {
@@ -277,24 +358,27 @@ void WiFiManager_::loop() {
 
         // Double-check we're not already connected
         if (WiFi.status() == WL_CONNECTED || _state == WIFI_STATE_CONNECTED) {
-            Serial.println("[WiFi] Already connected, skipping scheduled reconnect");
+            LOG_I(WIFI, "Already connected, skipping scheduled reconnect");
             return;
         }
 
-        Serial.printf("[WiFi] Attempting reconnect (attempt %d)...\n", _reconnectAttempts);
+        LOG_I(WIFI, "Attempting reconnect (attempt %d)...", _reconnectAttempts);
 
-        WiFi.disconnect();
-        delay(100);
-        connectFromConfig();
+        if (strlen(_ssid) > 0) {
+            startConnect();
+        } else {
+            connectFromConfig();
+        }
     }
 
     // Periodic RSSI monitoring (every 30 seconds when connected)
     if (_state == WIFI_STATE_CONNECTED && millis() - _lastRssiCheck > 30000) {
         _lastRssiCheck = millis();
         int rssi = WiFi.RSSI();
+        Power.adaptTxPower(rssi);
 
         if (rssi < -80) {
-            Serial.printf("[WiFi] WARNING: Weak signal! RSSI: %d dBm\n", rssi);
+            LOG_W(WIFI, "WARNING: Weak signal! RSSI: %d dBm", rssi);
             Display.showWeakSignal(rssi);
         }
     }
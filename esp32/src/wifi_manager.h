@@ -16,7 +16,8 @@
 // Reconnection settings
 #define WIFI_MIN_BACKOFF 1000UL      // Start with 1 second
 #define WIFI_MAX_BACKOFF 30000UL     // Max 30 seconds between retries
-#define WIFI_MAX_RECONNECT_ATTEMPTS 10  // Before switching to AP mode
+#define WIFI_MAX_RECONNECT_ATTEMPTS 10  // Before reporting WiFi as unavailable
+#define WIFI_FAST_CONNECT_TIMEOUT 3000UL // Cached BSSID/channel, before a full scan
 
 enum WiFiState {
     WIFI_STATE_DISCONNECTED,
@@ -30,7 +31,8 @@ class WiFiManager_ {
 public:
     void begin();
 
-    // Connection
+    // Connection (non-blocking: progress arrives through handleWiFiEvent()
+    // and loop(); returns false only when there is nothing to connect to)
     bool connect(const char* ssid, const char* password);
     bool connectFromConfig();
     void disconnect();
@@ -58,6 +60,11 @@ public:
     // Callback for connection state changes
     void setConnectionCallback(std::function<void(bool)> callback);
 
+    // Called once per outage when WiFi gives up: the first connect timed
+    // out or the reconnect attempts ran out (reconnects keep going at the
+    // max backoff). Without it the manager falls back to AP mode itself.
+    void setConnectFailedCallback(std::function<void()> callback);
+
 private:
     WiFiState _state = WIFI_STATE_DISCONNECTED;
     String _apSSID;
@@ -65,6 +72,16 @@ private:
     unsigned long _connectStart = 0;
     int _reconnectAttempts = 0;
 
+    // Credentials for reconnects
+    char _ssid[33] = "";
+    char _password[65] = "";
+
+    // Fast connect: the current attempt targets the cached BSSID/channel
+    bool _fastConnect = false;
+    volatile bool _fastFailed = false;   // Set from the WiFi event task
+    bool _failureReported = false;
+    bool _hasConnected = false;          // Got an IP since connect(): timeouts are reconnects
+
     // Exponential backoff
     unsigned long _currentBackoff = WIFI_MIN_BACKOFF;
     unsigned long _nextReconnect = 0;
@@ -76,8 +93,12 @@ private:
 
     // Callback
     std::function<void(bool)> _onConnectionChange = nullptr;
+    std::function<void()> _onConnectFailed = nullptr;
 
     // Helper methods
+    void startConnect();
+    void checkConnectTimeout();
+    void reportFailure();
     void scheduleReconnect();
     const char* getDisconnectReason(wifi_err_reason_t reason);
     const char* getSignalQuality(int rssi);
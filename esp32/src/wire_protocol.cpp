@@ -0,0 +1,150 @@
+#include "wire_protocol.h"
+#include "debug_log.h"
+
+static const char* const ALERT_NAMES[] = {
+    "",
+    "waiter_called",
+    "bill_ready",
+    "payment_confirmed",
+    "urgent"
+};
+
+static const char* const PRIORITY_NAMES[] = {
+    "low",
+    "medium",
+    "high",
+    "urgent"
+};
+
+static void copyField(char* dest, size_t destSize, const uint8_t* value, uint8_t len) {
+    size_t n = min((size_t)len, destSize - 1);
+    memcpy(dest, value, n);
+    dest[n] = '\0';
+}
+
+static void formatUuid(char* dest, size_t destSize, const uint8_t* raw) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    if (destSize < 37) return;
+
+    char* p = dest;
+    for (int i = 0; i < 16; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) *p++ = '-';
+        *p++ = HEX_DIGITS[raw[i] >> 4];
+        *p++ = HEX_DIGITS[raw[i] & 0x0F];
+    }
+    *p = '\0';
+}
+
+bool wireIsBinary(const uint8_t* data, size_t length) {
+    return length >= WIRE_HEADER_SIZE && data[0] == WIRE_MAGIC;
+}
+
+static uint32_t readU32(const uint8_t* value) {
+    return value[0] | (value[1] << 8) | (value[2] << 16) | ((uint32_t)value[3] << 24);
+}
+
+bool wireDecodeNotification(const uint8_t* data, size_t length, NotificationData& out,
+                            uint32_t* seq, uint32_t* prevSeq) {
+    if (!wireIsBinary(data, length)) return false;
+
+    if (data[1] != WIRE_VERSION) {
+        LOG_W(WIRE, "Unsupported version %d", data[1]);
+        return false;
+    }
+    if (data[2] != WIRE_MSG_NOTIFICATION) {
+        LOG_W(WIRE, "Unexpected message type 0x%02X", data[2]);
+        return false;
+    }
+
+    memset(&out, 0, sizeof(NotificationData));
+    strncpy(out.priority, "medium", sizeof(out.priority) - 1);
+    if (seq) *seq = 0;
+    if (prevSeq) *prevSeq = 0;
+
+    size_t pos = WIRE_HEADER_SIZE;
+    while (pos + 2 <= length) {
+        uint8_t tag = data[pos];
+        uint8_t len = data[pos + 1];
+        const uint8_t* value = data + pos + 2;
+
+        if (pos + 2 + len > length) {
+            LOG_W(WIRE, "Truncated field");
+            return false;
+        }
+
+        switch (tag) {
+            case WIRE_TAG_ID:
+                copyField(out.id, sizeof(out.id), value, len);
+                break;
+
+            case WIRE_TAG_ID_UUID:
+                if (len == 16) formatUuid(out.id, sizeof(out.id), value);
+                break;
+
+            case WIRE_TAG_TABLE:
+                copyField(out.table, sizeof(out.table), value, len);
+                break;
+
+            case WIRE_TAG_ALERT_CODE:
+                if (len == 1 && value[0] > WIRE_ALERT_OTHER && value[0] <= WIRE_ALERT_URGENT) {
+                    strncpy(out.type, ALERT_NAMES[value[0]], sizeof(out.type) - 1);
+                }
+                break;
+
+            case WIRE_TAG_ALERT:
+                copyField(out.type, sizeof(out.type), value, len);
+                break;
+
+            case WIRE_TAG_PRIORITY:
+                if (len == 1 && value[0] <= PRIORITY_URGENT) {
+                    strncpy(out.priority, PRIORITY_NAMES[value[0]], sizeof(out.priority) - 1);
+                }
+                break;
+
+            case WIRE_TAG_MESSAGE:
+                copyField(out.message, sizeof(out.message), value, len);
+                break;
+
+            case WIRE_TAG_TIMESTAMP:
+                if (len == 8) {
+                    uint64_t ts = 0;
+                    for (int i = 7; i >= 0; i--) ts = (ts << 8) | value[i];
+                    out.timestamp = ts;
+                }
+                break;
+
+            case WIRE_TAG_SEQ:
+                if (len == 4 && seq) *seq = readU32(value);
+                break;
+
+            case WIRE_TAG_PREV_SEQ:
+                if (len == 4 && prevSeq) *prevSeq = readU32(value);
+                break;
+
+            default:
+                // Unknown tag - skip it
+                break;
+        }
+
+        pos += 2 + len;
+    }
+
+    return true;
+}
+
+uint8_t wireMessageType(const uint8_t* data) {
+    return data[2];
+}
+
+bool wireDecodeOtaChunk(const uint8_t* data, size_t length, uint32_t& offset,
+                        const uint8_t*& chunk, size_t& chunkLength) {
+    if (!wireIsBinary(data, length) || data[1] != WIRE_VERSION ||
+        data[2] != WIRE_MSG_OTA_CHUNK || length <= WIRE_OTA_HEADER_SIZE) {
+        return false;
+    }
+
+    offset = readU32(data + WIRE_HEADER_SIZE);
+    chunk = data + WIRE_OTA_HEADER_SIZE;
+    chunkLength = length - WIRE_OTA_HEADER_SIZE;
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef WIRE_PROTOCOL_H
+#define WIRE_PROTOCOL_H
+
+#include <Arduino.h>
+#include "notification_queue.h"
+
+// ============================================
+// BitsperWatch Binary Wire Protocol ("bpw1")
+// Compact TLV framing for notifications over WebSocket (binary frames)
+// and BLE. Announced in the register message; JSON stays the fallback.
+//
+//   [magic 0xB7][version][msg type] then repeated [tag][len][value]
+//
+// Unknown tags are skipped so newer boxes stay compatible. Firmware
+// chunks (ota_updater.h) carry raw bytes instead of TLV fields:
+//
+//   [magic 0xB7][version][0x02][offset: 4 bytes, little-endian][data]
+// ============================================
+
+#define WIRE_PROTOCOL_NAME  "bpw1"
+#define WIRE_MAGIC          0xB7
+#define WIRE_VERSION        1
+#define WIRE_HEADER_SIZE    3
+
+// Message types
+#define WIRE_MSG_NOTIFICATION  0x01
+#define WIRE_MSG_OTA_CHUNK     0x02
+
+#define WIRE_OTA_HEADER_SIZE   (WIRE_HEADER_SIZE + 4)
+
+// Field tags
+#define WIRE_TAG_ID            0x01  // string
+#define WIRE_TAG_TABLE         0x02  // string
+#define WIRE_TAG_ALERT_CODE    0x03  // 1 byte, see WIRE_ALERT_*
+#define WIRE_TAG_ALERT         0x04  // string (types without a code)
+#define WIRE_TAG_PRIORITY      0x05  // 1 byte, NotificationPriority
+#define WIRE_TAG_MESSAGE       0x06  // string
+#define WIRE_TAG_TIMESTAMP     0x07  // 8 bytes, little-endian ms epoch
+#define WIRE_TAG_ID_UUID       0x08  // 16 raw bytes of a canonical UUID id
+#define WIRE_TAG_SEQ           0x09  // 4 bytes, little-endian sequence_tracker.h number
+#define WIRE_TAG_PREV_SEQ      0x0A  // 4 bytes, the previous number sent to this watch
+
+// Alert type codes
+#define WIRE_ALERT_OTHER              0
+#define WIRE_ALERT_WAITER_CALLED      1
+#define WIRE_ALERT_BILL_READY         2
+#define WIRE_ALERT_PAYMENT_CONFIRMED  3
+#define WIRE_ALERT_URGENT             4
+
+// True if the buffer starts with a bpw1 header
+bool wireIsBinary(const uint8_t* data, size_t length);
+
+// Decode a bpw1 notification straight into `out`; false on malformed input.
+// `seq` / `prevSeq` (optional) get the box's numbering, 0 if it sent none
+bool wireDecodeNotification(const uint8_t* data, size_t length, NotificationData& out,
+                            uint32_t* seq = nullptr, uint32_t* prevSeq = nullptr);
+
+// Message type of a bpw1 buffer (call wireIsBinary() first)
+uint8_t wireMessageType(const uint8_t* data);
+
+// Split a bpw1 firmware chunk; `chunk` points into `data`
+bool wireDecodeOtaChunk(const uint8_t* data, size_t length, uint32_t& offset,
+                        const uint8_t*& chunk, size_t& chunkLength);
+
+#endif // WIRE_PROTOCOL_H
@@ -0,0 +1,106 @@
+#ifndef TEST_FIXTURES_H
+#define TEST_FIXTURES_H
+
+#include <Arduino.h>
+#include "wire_protocol.h"
+#include "app_events.h"
+#include "ble_framing.h"
+
+// ============================================
+// Host Test Fixtures
+// Sample frames shared by the native suites: the alert the on-target
+// bench uses (src/benchmark.cpp), as JSON and as bpw1, a builder for
+// other bpw1 frames and one for BLE fragments.
+// ============================================
+
+#define SAMPLE_ID        "0d6c9a8e-5a43-4a8e-9f51-3b0b2f6f1c11"
+#define SAMPLE_TABLE     "12"
+#define SAMPLE_ALERT     "waiter_called"
+#define SAMPLE_MESSAGE   "La mesa 12 solicita atenci\xC3\xB3n del mesero, por favor ac\xC3\xA9rquese"
+#define SAMPLE_TIMESTAMP 1718000000000ULL
+
+static const char SAMPLE_JSON[] =
+    "{\"type\":\"notification\",\"id\":\"" SAMPLE_ID "\","
+    "\"table\":\"" SAMPLE_TABLE "\",\"alert\":\"" SAMPLE_ALERT "\","
+    "\"message\":\"" SAMPLE_MESSAGE "\","
+    "\"priority\":\"high\",\"timestamp\":1718000000000,\"seq\":7,\"prev_seq\":6}";
+
+// bpw1 frame: header, then fields appended in call order
+class WireBuilder {
+public:
+    explicit WireBuilder(uint8_t type = WIRE_MSG_NOTIFICATION) {
+        _buf[0] = WIRE_MAGIC;
+        _buf[1] = WIRE_VERSION;
+        _buf[2] = type;
+        _len = WIRE_HEADER_SIZE;
+    }
+
+    WireBuilder& raw(uint8_t tag, const void* value, uint8_t len) {
+        _buf[_len++] = tag;
+        _buf[_len++] = len;
+        memcpy(_buf + _len, value, len);
+        _len += len;
+        return *this;
+    }
+
+    WireBuilder& str(uint8_t tag, const char* value) {
+        return raw(tag, value, (uint8_t)strlen(value));
+    }
+
+    WireBuilder& u8(uint8_t tag, uint8_t value) {
+        return raw(tag, &value, 1);
+    }
+
+    WireBuilder& u32(uint8_t tag, uint32_t value) {
+        uint8_t le[4];
+        for (uint8_t i = 0; i < 4; i++) le[i] = (uint8_t)(value >> (8 * i));
+        return raw(tag, le, 4);
+    }
+
+    WireBuilder& u64(uint8_t tag, uint64_t value) {
+        uint8_t le[8];
+        for (uint8_t i = 0; i < 8; i++) le[i] = (uint8_t)(value >> (8 * i));
+        return raw(tag, le, 8);
+    }
+
+    // The sample alert as bpw1
+    WireBuilder& sample() {
+        return str(WIRE_TAG_ID, SAMPLE_ID)
+            .str(WIRE_TAG_TABLE, SAMPLE_TABLE)
+            .u8(WIRE_TAG_ALERT_CODE, WIRE_ALERT_WAITER_CALLED)
+            .u8(WIRE_TAG_PRIORITY, PRIORITY_HIGH)
+            .str(WIRE_TAG_MESSAGE, SAMPLE_MESSAGE)
+            .u64(WIRE_TAG_TIMESTAMP, SAMPLE_TIMESTAMP);
+    }
+
+    uint8_t* data() { return _buf; }
+    size_t length() { return _len; }
+
+private:
+    uint8_t _buf[512];
+    size_t _len;
+};
+
+// One BLE fragment of `payload` into `out`; returns the packet length
+static inline size_t bleFragment(uint8_t* out, uint8_t seq, uint8_t index, uint8_t count,
+                                 const char* payload, size_t length) {
+    out[0] = BLE_FRAG_MARKER;
+    out[1] = seq;
+    out[2] = index;
+    out[3] = count;
+    memcpy(out + BLE_FRAG_HEADER_SIZE, payload, length);
+    return BLE_FRAG_HEADER_SIZE + length;
+}
+
+// Release every slot the UI task would have taken; returns how many
+static inline int drainInbox() {
+    int n = 0;
+    InboxItem* item;
+    while ((item = Events.takeNotification()) != nullptr) {
+        Events.releaseNotification(item);
+        n++;
+    }
+    return n;
+}
+
+#endif // TEST_FIXTURES_H
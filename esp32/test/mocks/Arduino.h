@@ -0,0 +1,150 @@
+#ifndef MOCK_ARDUINO_H
+#define MOCK_ARDUINO_H
+
+// ============================================
+// Host Mocks (env:native)
+// Just enough of the Arduino core, ESP-IDF and the board libraries for
+// the firmware modules to build and run on the host under Unity. Time
+// is a mock clock that only moves when a test (or delay()) moves it;
+// tasks are never started, so everything runs on the test's thread.
+// ============================================
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <functional>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define PROGMEM
+#define F(x) x
+
+#define LOW             0
+#define HIGH            1
+#define INPUT_PULLUP    2
+#define FALLING         2
+#define CHANGE          3
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+
+class String {
+public:
+    String() {}
+    String(const char* c) : _s(c ? c : "") {}
+    String(const std::string& s) : _s(s) {}
+    String(int v) : _s(std::to_string(v)) {}
+    String(unsigned int v) : _s(std::to_string(v)) {}
+    String(long v) : _s(std::to_string(v)) {}
+    String(unsigned long v) : _s(std::to_string(v)) {}
+
+    const char* c_str() const { return _s.c_str(); }
+    size_t length() const { return _s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    int toInt() const { return atoi(_s.c_str()); }
+
+    int lastIndexOf(char c, unsigned int from) const {
+        size_t p = _s.rfind(c, from);
+        return p == std::string::npos ? -1 : (int)p;
+    }
+    String substring(unsigned int from, unsigned int to) const { return String(_s.substr(from, to - from)); }
+    String substring(unsigned int from) const { return String(_s.substr(from)); }
+    void toLowerCase() { for (char& c : _s) c = (char)tolower((unsigned char)c); }
+
+    String& operator+=(const String& o) { _s += o._s; return *this; }
+    String& operator+=(const char* o) { _s += o; return *this; }
+    bool operator==(const String& o) const { return _s == o._s; }
+    bool operator==(const char* o) const { return _s == o; }
+    friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+
+private:
+    std::string _s;
+};
+
+// Serial goes to stdout
+class HardwareSerial {
+public:
+    void begin(int) {}
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+    void print(const char* s) { fputs(s, stdout); }
+    void println(const char* s = "") { puts(s); }
+    void println(const String& s) { puts(s.c_str()); }
+    size_t write(const uint8_t* data, size_t n) { return fwrite(data, 1, n, stdout); }
+    size_t write(uint8_t c) { return fputc(c, stdout) == EOF ? 0 : 1; }
+    void flush() { fflush(stdout); }
+    int availableForWrite() { return 4096; }
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    void restart() { _restarts++; }
+    uint32_t getFreeHeap() { return 200000; }
+    uint32_t getMinFreeHeap() { return 180000; }
+    uint32_t getMaxAllocHeap() { return 100000; }
+    const char* getChipModel() { return "ESP32-C6 (host)"; }
+    int getChipRevision() { return 0; }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    uint32_t getCpuFreqMHz() { return 160; }
+    uint32_t getCycleCount();     // Host clock scaled to getCpuFreqMHz()
+
+    unsigned long getRestarts() { return _restarts; }
+
+private:
+    unsigned long _restarts = 0;
+};
+
+extern EspClass ESP;
+
+#include <freertos/FreeRTOS.h>
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);     // Advances the mock clock
+
+// Test control: move the mock clock forward / back to zero
+void mockAdvanceMillis(unsigned long ms);
+void mockResetClock();
+
+void pinMode(int pin, int mode);
+int digitalRead(int pin);
+void attachInterrupt(int pin, void (*handler)(), int mode);
+int digitalPinToInterrupt(int pin);
+
+uint32_t getCpuFrequencyMhz();
+uint32_t getXtalFrequencyMhz();
+int esp_reset_reason();
+
+// RMT (esp32-hal-rmt.h): accepted and discarded
+typedef struct {
+    union {
+        struct {
+            uint32_t duration0 : 15;
+            uint32_t level0 : 1;
+            uint32_t duration1 : 15;
+            uint32_t level1 : 1;
+        };
+        uint32_t val;
+    };
+} rmt_data_t;
+
+typedef enum { RMT_RX_MODE = 0, RMT_TX_MODE = 1 } rmt_ch_dir_t;
+typedef enum { RMT_MEM_NUM_BLOCKS_1 = 1, RMT_MEM_NUM_BLOCKS_2 = 2 } rmt_reserve_memsize_t;
+#define RMT_WAIT_FOR_EVER ((uint32_t)-1)
+
+bool rmtInit(int pin, rmt_ch_dir_t dir, rmt_reserve_memsize_t mem, uint32_t freq);
+bool rmtWrite(int pin, rmt_data_t* data, size_t n, uint32_t timeout_ms);
+bool rmtWriteLooping(int pin, rmt_data_t* data, size_t n);
+
+#endif // MOCK_ARDUINO_H
@@ -0,0 +1,186 @@
+#ifndef MOCK_BLEDEVICE_H
+#define MOCK_BLEDEVICE_H
+
+#include <Arduino.h>
+#include <string>
+#include <map>
+#include <vector>
+
+// ============================================
+// Bluedroid BLE client (host mock)
+// Scans find nothing. A client connects only if a test set
+// BLEDevice::boxPresent, and then sees the box's service with a
+// notify and a register characteristic; writes to either are kept
+// in `writes`. Notifications are driven through
+// BitsperBoxBLEClient::handleNotifyData() directly.
+// ============================================
+
+typedef uint8_t esp_bd_addr_t[6];
+
+#define ESP_BLE_AD_TYPE_NAME_SHORT 0x08
+#define ESP_BLE_AD_TYPE_NAME_CMPL  0x09
+typedef enum { BLE_ADDR_TYPE_PUBLIC, BLE_ADDR_TYPE_RANDOM } esp_ble_addr_type_t;
+
+class BLEUUID {
+public:
+    BLEUUID() {}
+    BLEUUID(const char* uuid) : _uuid(uuid) {}
+    BLEUUID(uint16_t uuid) : _uuid(std::to_string(uuid)) {}
+    std::string toString() const { return _uuid; }
+
+private:
+    std::string _uuid;
+};
+
+class BLEAddress {
+public:
+    BLEAddress(esp_bd_addr_t addr) { memcpy(_addr, addr, sizeof(_addr)); }
+    BLEAddress(const char* addr);
+    String toString() const;
+    esp_bd_addr_t* getNative() { return &_addr; }
+
+private:
+    esp_bd_addr_t _addr = {0};
+};
+
+class BLEAdvertisedDevice {
+public:
+    BLEAddress getAddress() { return BLEAddress(address); }
+    esp_ble_addr_type_t getAddressType() { return BLE_ADDR_TYPE_PUBLIC; }
+    bool haveName() { return !name.empty(); }
+    String getName() { return String(name); }
+    // Raw advertising data: just the complete local name, if any
+    uint8_t* getPayload() {
+        _payload.clear();
+        if (!name.empty()) {
+            _payload.push_back((uint8_t)(name.size() + 1));
+            _payload.push_back(ESP_BLE_AD_TYPE_NAME_CMPL);
+            _payload.insert(_payload.end(), name.begin(), name.end());
+        }
+        return _payload.data();
+    }
+    size_t getPayloadLength() { return _payload.size(); }
+    bool haveServiceUUID() { return advertisesBox; }
+    bool isAdvertisingService(BLEUUID) { return advertisesBox; }
+    int getRSSI() { return rssi; }
+
+    esp_bd_addr_t address = {0};
+    std::string name;
+    bool advertisesBox = false;
+    int rssi = -60;
+
+private:
+    std::vector<uint8_t> _payload;
+};
+
+class BLEScanResults {
+public:
+    int getCount() { return 0; }
+};
+
+class BLEAdvertisedDeviceCallbacks {
+public:
+    virtual ~BLEAdvertisedDeviceCallbacks() {}
+    virtual void onResult(BLEAdvertisedDevice device) {}
+};
+
+class BLEScan {
+public:
+    void setAdvertisedDeviceCallbacks(BLEAdvertisedDeviceCallbacks* callbacks, bool = false) { _callbacks = callbacks; }
+    void setInterval(uint16_t) {}
+    void setWindow(uint16_t) {}
+    void setActiveScan(bool active) { this->active = active; }
+    bool start(uint32_t, void (*)(BLEScanResults), bool = false) { scans++; return true; }
+    void stop() {}
+    void clearResults() {}
+
+    bool active = false;
+    unsigned long scans = 0;
+
+private:
+    BLEAdvertisedDeviceCallbacks* _callbacks = nullptr;
+};
+
+class BLERemoteCharacteristic;
+typedef void (*notify_callback)(BLERemoteCharacteristic* characteristic, uint8_t* data, size_t length, bool isNotify);
+
+struct BLEWrite {
+    std::vector<uint8_t> data;
+    bool withResponse;
+};
+
+class BLERemoteCharacteristic {
+public:
+    bool canNotify() { return true; }
+    void registerForNotify(notify_callback callback, bool = true) { _notify = callback; }
+    void writeValue(uint8_t* data, size_t length, bool response = false) {
+        writes.push_back({std::vector<uint8_t>(data, data + length), response});
+    }
+    void writeValue(const char* data, bool response = false) {
+        writeValue((uint8_t*)data, strlen(data), response);
+    }
+    uint16_t getHandle() { return 0x002A; }
+
+    // Test side: raise a notification on the registered callback
+    void notify(const uint8_t* data, size_t length);
+
+    std::vector<BLEWrite> writes;
+
+private:
+    notify_callback _notify = nullptr;
+};
+
+class BLERemoteService {
+public:
+    // Every characteristic asked for exists
+    BLERemoteCharacteristic* getCharacteristic(BLEUUID uuid) { return &chars[uuid.toString()]; }
+
+    std::map<std::string, BLERemoteCharacteristic> chars;
+};
+
+class BLEClient;
+
+class BLEClientCallbacks {
+public:
+    virtual ~BLEClientCallbacks() {}
+    virtual void onConnect(BLEClient* client) {}
+    virtual void onDisconnect(BLEClient* client) {}
+};
+
+class BLEClient {
+public:
+    void setClientCallbacks(BLEClientCallbacks* callbacks) { _callbacks = callbacks; }
+    bool connect(BLEAddress address, uint8_t = 0, uint32_t = 0);
+    void disconnect();
+    bool isConnected() { return _connected; }
+    uint16_t getMTU() { return _mtu; }
+    bool setMTU(uint16_t mtu);
+    BLERemoteService* getService(BLEUUID) { return _connected ? &_service : nullptr; }
+    int getRssi() { return -60; }
+
+private:
+    BLEClientCallbacks* _callbacks = nullptr;
+    BLERemoteService _service;
+    bool _connected = false;
+    uint16_t _mtu = 23;
+};
+
+class BLEDevice {
+public:
+    static void init(const char*) { _initialized = true; }
+    static bool getInitialized() { return _initialized; }
+    static BLEScan* getScan() { return &_scan; }
+    static BLEClient* createClient() { return lastClient = new BLEClient(); }
+
+    // Test side: whether connect() reaches a box, the largest MTU it
+    // agrees to, and the client the firmware created last
+    static bool boxPresent;
+    static uint16_t peerMtu;
+    static BLEClient* lastClient;
+
+private:
+    static bool _initialized;
+    static BLEScan _scan;
+};
+
+#endif // MOCK_BLEDEVICE_H
@@ -0,0 +1,13 @@
+#ifndef MOCK_DNSSERVER_H
+#define MOCK_DNSSERVER_H
+
+#include <WiFi.h>
+
+class DNSServer {
+public:
+    bool start(uint16_t, const char*, IPAddress) { return true; }
+    void stop() {}
+    void processNextRequest() {}
+};
+
+#endif // MOCK_DNSSERVER_H
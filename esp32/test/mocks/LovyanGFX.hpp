@@ -0,0 +1,143 @@
+#ifndef MOCK_LOVYANGFX_HPP
+#define MOCK_LOVYANGFX_HPP
+
+#include <Arduino.h>
+#include <vector>
+
+// ============================================
+// LovyanGFX (host mock)
+// Draws nothing, but measures text like the built-in 6x8 GLCD font
+// (Font0) the firmware uses, so layouts wrap where they do on the
+// panel. `pushes` counts the pixel pushes a commit made.
+// ============================================
+
+#define SPI2_HOST        1
+#define SPI_DMA_CH_AUTO  3
+
+namespace lgfx {
+
+struct swap565_t { uint16_t raw; };
+
+class Bus_SPI {
+public:
+    struct config_t {
+        int spi_host, spi_mode, freq_write, freq_read;
+        bool spi_3wire, use_lock;
+        int dma_channel, pin_sclk, pin_mosi, pin_miso, pin_dc;
+    };
+    config_t config() { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+private:
+    config_t _cfg = {};
+};
+
+class Light_PWM {
+public:
+    struct config_t {
+        int pin_bl;
+        bool invert;
+        int freq;
+        int pwm_channel;
+    };
+    config_t config() { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+private:
+    config_t _cfg = {};
+};
+
+class Panel_ST7789 {
+public:
+    struct config_t {
+        int pin_cs, pin_rst, pin_busy, memory_width, memory_height, panel_width, panel_height;
+        int offset_x, offset_y, offset_rotation, dummy_read_pixel, dummy_read_bits;
+        bool readable, invert, rgb_order, dlen_16bit, bus_shared;
+    };
+    config_t config() { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+    void setBus(Bus_SPI*) {}
+    void setLight(Light_PWM*) {}
+
+private:
+    config_t _cfg = {};
+};
+
+struct IFont {};
+
+enum attribute_t { cp437_switch = 1, utf8_switch = 2 };
+
+#define MOCK_GLCD_WIDTH   6
+#define MOCK_GLCD_HEIGHT  8
+
+class LovyanGFX {
+public:
+    virtual ~LovyanGFX() {}
+
+    void startWrite() {}
+    void endWrite() {}
+    void fillScreen(uint16_t) {}
+    void fillRect(int, int, int, int, uint16_t) {}
+    void drawRect(int, int, int, int, uint16_t) {}
+    void drawFastHLine(int, int, int, uint16_t) {}
+    void fillCircle(int, int, int, uint16_t) {}
+    void drawCircle(int, int, int, uint16_t) {}
+    void setClipRect(int, int, int, int) {}
+    void clearClipRect() {}
+
+    void setFont(const IFont*) {}
+    void setTextDatum(int) {}
+    void setAttribute(attribute_t, uint8_t) {}
+    void setTextSize(float size) { _textSize = size; }
+    void setTextColor(uint16_t) {}
+    void setTextColor(uint16_t, uint16_t) {}
+    void setCursor(int, int) {}
+    size_t print(const char* text) { return strlen(text); }
+    int drawString(const char* text, int, int) { return textWidth(text); }
+    int textWidth(const char* text) { return (int)(strlen(text) * MOCK_GLCD_WIDTH * _textSize); }
+    int fontHeight() { return (int)(MOCK_GLCD_HEIGHT * _textSize); }
+
+    void pushImage(int, int, int, int, const uint16_t*) { pushes++; }
+    void pushImageDMA(int, int, int, int, const swap565_t*) { pushes++; }
+    void waitDMA() {}
+    void pushSprite(int, int) { pushes++; }
+
+    unsigned long pushes = 0;
+
+protected:
+    float _textSize = 1;
+};
+
+class LGFX_Device : public LovyanGFX {
+public:
+    void init() {}
+    void initDMA() {}
+    void setPanel(Panel_ST7789*) {}
+    void setRotation(int) {}
+    void setBrightness(uint8_t brightness) { this->brightness = brightness; }
+    void invertDisplay(bool) {}
+    void sleep() {}
+    void wakeup() {}
+
+    uint8_t brightness = 0;
+};
+
+} // namespace lgfx
+
+class LGFX_Sprite : public lgfx::LovyanGFX {
+public:
+    LGFX_Sprite() {}
+    LGFX_Sprite(lgfx::LovyanGFX*) {}
+    void setColorDepth(int) {}
+    bool createSprite(int w, int h) {
+        _buffer.assign((size_t)w * h, 0);
+        return true;
+    }
+    void deleteSprite() { _buffer.clear(); }
+    void* getBuffer() { return _buffer.empty() ? nullptr : _buffer.data(); }
+
+private:
+    std::vector<uint16_t> _buffer;
+};
+
+#endif // MOCK_LOVYANGFX_HPP
@@ -0,0 +1,41 @@
+#ifndef MOCK_PREFERENCES_H
+#define MOCK_PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+// NVS in memory: every Preferences object shares one store per
+// namespace, kept until mockClearPreferences()
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false);
+    void end() {}
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putBool(const char* key, bool value);
+    size_t putUShort(const char* key, uint16_t value);
+    size_t putString(const char* key, const char* value);
+    size_t putBytes(const char* key, const void* value, size_t length);
+
+    bool getBool(const char* key, bool defaultValue = false);
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0);
+    String getString(const char* key, const char* defaultValue = "");
+    size_t getString(const char* key, char* value, size_t maxLength);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buffer, size_t maxLength);
+
+private:
+    typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+    Namespace* _ns = nullptr;
+    bool _readOnly = false;
+
+    size_t put(const char* key, const void* value, size_t length);
+    const std::vector<uint8_t>* find(const char* key);
+};
+
+void mockClearPreferences();
+
+#endif // MOCK_PREFERENCES_H
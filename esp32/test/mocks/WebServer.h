@@ -0,0 +1,35 @@
+#ifndef MOCK_WEBSERVER_H
+#define MOCK_WEBSERVER_H
+
+#include <Arduino.h>
+
+// Routes are accepted and never called
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST };
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer {
+public:
+    WebServer(int = 80) {}
+
+    void on(const char*, std::function<void()>) {}
+    void on(const char*, HTTPMethod, std::function<void()>) {}
+    void on(const char*, HTTPMethod, std::function<void()>, std::function<void()>) {}
+    void onNotFound(std::function<void()>) {}
+    void begin() {}
+    void stop() {}
+    void handleClient() {}
+
+    String uri() { return String("/"); }
+    String arg(const char*) { return String(); }
+    bool hasArg(const char*) { return false; }
+
+    void send(int, const char* = nullptr, const String& = String()) {}
+    void send(int, const char*, const char*) {}
+    void send_P(int, const char*, const char*, size_t = 0) {}
+    void sendHeader(const char*, const String&, bool = false) {}
+    void setContentLength(size_t) {}
+    void sendContent(const char*, size_t) {}
+    void sendContent(const String&) {}
+};
+
+#endif // MOCK_WEBSERVER_H
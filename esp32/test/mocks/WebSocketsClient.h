@@ -0,0 +1,68 @@
+#ifndef MOCK_WEBSOCKETSCLIENT_H
+#define MOCK_WEBSOCKETSCLIENT_H
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// ============================================
+// WebSocketsClient (host mock)
+// Never opens a socket. A test plays the server: receive() raises an
+// event on the client's own handler, as the library does from loop(),
+// and everything the client sends is kept in `sentText` / `sentBinary`.
+// ============================================
+
+typedef enum {
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN,
+    WStype_PING,
+    WStype_PONG
+} WStype_t;
+
+class WebSocketsClient {
+public:
+    typedef std::function<void(WStype_t type, uint8_t* payload, size_t length)> WebSocketClientEvent;
+
+    WebSocketsClient();
+    ~WebSocketsClient();
+
+    void begin(const char* host, uint16_t port, const char* url = "/");
+    void beginSSL(const char* host, uint16_t port, const char* url = "/",
+                  const char* fingerprint = "", const char* protocol = "arduino");
+    void onEvent(WebSocketClientEvent handler) { _handler = handler; }
+    void setReconnectInterval(unsigned long interval) { reconnectInterval = interval; }
+    void enableHeartbeat(uint32_t, uint32_t, uint8_t) {}
+    void loop() {}
+    void disconnect();
+    bool isConnected() { return connected; }
+
+    bool sendTXT(const char* payload, size_t length);
+    bool sendTXT(const char* payload) { return sendTXT(payload, strlen(payload)); }
+    bool sendBIN(const uint8_t* payload, size_t length);
+    bool sendPing(uint8_t* = nullptr, size_t = 0) { pings++; return connected; }
+
+    // Test side: the client that last called begin*() with `host`
+    static WebSocketsClient* forHost(const char* host);
+
+    // Deliver an event as if it came off the socket. The payload is
+    // copied into a NUL-terminated buffer the handler may write into
+    void receive(WStype_t type, const void* payload = nullptr, size_t length = 0);
+    void receiveText(const char* text) { receive(WStype_TEXT, text, strlen(text)); }
+
+    std::string host;
+    uint16_t port = 0;
+    bool connected = false;
+    unsigned long reconnectInterval = 0;
+    unsigned long pings = 0;
+    std::vector<std::string> sentText;
+    std::vector<std::vector<uint8_t>> sentBinary;
+
+private:
+    WebSocketClientEvent _handler = nullptr;
+    std::vector<uint8_t> _rx;
+};
+
+#endif // MOCK_WEBSOCKETSCLIENT_H
@@ -0,0 +1,87 @@
+#ifndef MOCK_WIFI_H
+#define MOCK_WIFI_H
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+
+// Station that never associates unless a test says so (connected = true)
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+typedef enum {
+    WIFI_POWER_19_5dBm = 78,
+    WIFI_POWER_17dBm = 68,
+    WIFI_POWER_15dBm = 60,
+    WIFI_POWER_13dBm = 52,
+    WIFI_POWER_11dBm = 44,
+    WIFI_POWER_8_5dBm = 34
+} wifi_power_t;
+
+enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA };
+enum { WL_IDLE_STATUS, WL_CONNECTED, WL_DISCONNECTED };
+enum { WIFI_AUTH_OPEN };
+enum { WIFI_SCAN_RUNNING = -1, WIFI_SCAN_FAILED = -2 };
+
+class IPAddress {
+public:
+    IPAddress(uint32_t addr = 0) : _addr(addr) {}
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (unsigned)(_addr & 0xFF), (unsigned)((_addr >> 8) & 0xFF),
+                 (unsigned)((_addr >> 16) & 0xFF), (unsigned)(_addr >> 24));
+        return String(buf);
+    }
+    operator uint32_t() const { return _addr; }
+
+private:
+    uint32_t _addr;
+};
+
+class WiFiClass {
+public:
+    bool connected = false;
+    int rssi = -55;
+    int channelNumber = 6;
+    uint8_t bssid[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+
+    bool mode(int mode) { _mode = mode; return true; }
+    bool setSleep(wifi_ps_type_t) { return true; }
+    bool setSleep(bool) { return true; }
+    bool setTxPower(wifi_power_t) { return true; }
+    bool setAutoReconnect(bool) { return true; }
+    void persistent(bool) {}
+    int onEvent(std::function<void(WiFiEvent_t, WiFiEventInfo_t)>) { return 0; }
+
+    int begin(const char*, const char* = nullptr, int32_t = 0, const uint8_t* = nullptr, bool = true) { return 0; }
+    bool disconnect(bool = false, bool = false) { connected = false; return true; }
+    int status() { return connected ? WL_CONNECTED : WL_DISCONNECTED; }
+
+    int RSSI() { return rssi; }
+    String SSID() { return String("host"); }
+    uint8_t* BSSID() { return bssid; }
+    int32_t channel() { return channelNumber; }
+    IPAddress localIP() { return connected ? IPAddress(0x0A01A8C0) : IPAddress(); }   // 192.168.1.10
+    IPAddress softAPIP() { return IPAddress(0x0104A8C0); }                          // 192.168.4.1
+    void macAddress(uint8_t* mac) {
+        const uint8_t host[6] = {0x40, 0x4C, 0xCA, 0x00, 0x00, 0x01};
+        memcpy(mac, host, sizeof(host));
+    }
+    String macAddress() { return String("40:4C:CA:00:00:01"); }
+    String getHostname() { return String("bitsperwatch"); }
+    bool setHostname(const char*) { return true; }
+
+    bool softAP(const char*, const char* = nullptr) { return true; }
+    bool softAPdisconnect(bool = false) { return true; }
+
+    int16_t scanNetworks(bool = false) { return 0; }
+    int16_t scanComplete() { return 0; }
+    void scanDelete() {}
+    String SSID(int) { return String(); }
+    int RSSI(int) { return 0; }
+    int encryptionType(int) { return WIFI_AUTH_OPEN; }
+
+private:
+    int _mode = WIFI_OFF;
+};
+
+extern WiFiClass WiFi;
+
+#endif // MOCK_WIFI_H
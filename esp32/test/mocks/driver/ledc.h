@@ -0,0 +1,24 @@
+#ifndef MOCK_DRIVER_LEDC_H
+#define MOCK_DRIVER_LEDC_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum { LEDC_LOW_SPEED_MODE = 0 } ledc_mode_t;
+typedef enum { LEDC_CHANNEL_0 = 0 } ledc_channel_t;
+typedef enum { LEDC_FADE_NO_WAIT = 0, LEDC_FADE_WAIT_DONE } ledc_fade_mode_t;
+
+typedef struct {
+    uint32_t dir : 1;
+    uint32_t cycle_num : 10;
+    uint32_t scale : 10;
+    uint32_t step_num : 10;
+} ledc_fade_param_config_t;
+
+esp_err_t ledc_fade_func_install(int flags);
+esp_err_t ledc_set_multi_fade(ledc_mode_t mode, ledc_channel_t channel, uint32_t startDuty,
+                              const ledc_fade_param_config_t* fades, uint32_t count);
+esp_err_t ledc_fade_start(ledc_mode_t mode, ledc_channel_t channel, ledc_fade_mode_t wait);
+esp_err_t ledc_fade_stop(ledc_mode_t mode, ledc_channel_t channel);
+
+#endif // MOCK_DRIVER_LEDC_H
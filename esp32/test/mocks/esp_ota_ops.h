@@ -0,0 +1,33 @@
+#ifndef MOCK_ESP_OTA_OPS_H
+#define MOCK_ESP_OTA_OPS_H
+
+#include "esp_partition.h"
+#include "esp_err.h"
+
+typedef uint32_t esp_ota_handle_t;
+
+typedef enum {
+    ESP_OTA_IMG_NEW,
+    ESP_OTA_IMG_PENDING_VERIFY,
+    ESP_OTA_IMG_VALID,
+    ESP_OTA_IMG_INVALID,
+    ESP_OTA_IMG_ABORTED,
+    ESP_OTA_IMG_UNDEFINED
+} esp_ota_img_states_t;
+
+#define OTA_WITH_SEQUENTIAL_WRITES      0xfffffffe
+#define ESP_ERR_OTA_VALIDATE_FAILED     0x1503
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* start);
+const esp_partition_t* esp_ota_get_running_partition();
+const esp_partition_t* esp_ota_get_last_invalid_partition();
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* part, esp_ota_img_states_t* state);
+esp_err_t esp_ota_begin(const esp_partition_t* part, size_t size, esp_ota_handle_t* handle);
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void* data, size_t size);
+esp_err_t esp_ota_end(esp_ota_handle_t handle);
+esp_err_t esp_ota_abort(esp_ota_handle_t handle);
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* part);
+esp_err_t esp_ota_mark_app_valid_cancel_rollback();
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot();
+
+#endif // MOCK_ESP_OTA_OPS_H
@@ -0,0 +1,9 @@
+#ifndef MOCK_ESP_ROM_CRC_H
+#define MOCK_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+// Same CRC-32 (little-endian, reflected) as the ROM routine
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
+
+#endif // MOCK_ESP_ROM_CRC_H
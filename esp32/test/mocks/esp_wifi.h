@@ -0,0 +1,41 @@
+#ifndef MOCK_ESP_WIFI_H
+#define MOCK_ESP_WIFI_H
+
+typedef int wifi_err_reason_t;
+typedef int WiFiEvent_t;
+
+struct wifi_sta_disconnected_t {
+    int reason;
+};
+
+typedef struct {
+    wifi_sta_disconnected_t wifi_sta_disconnected;
+} WiFiEventInfo_t;
+
+enum {
+    ARDUINO_EVENT_WIFI_STA_START,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP
+};
+
+enum {
+    WIFI_REASON_UNSPECIFIED = 1,
+    WIFI_REASON_AUTH_EXPIRE,
+    WIFI_REASON_AUTH_LEAVE,
+    WIFI_REASON_ASSOC_EXPIRE,
+    WIFI_REASON_ASSOC_TOOMANY,
+    WIFI_REASON_NOT_AUTHED,
+    WIFI_REASON_NOT_ASSOCED,
+    WIFI_REASON_ASSOC_LEAVE,
+    WIFI_REASON_ASSOC_NOT_AUTHED,
+    WIFI_REASON_BEACON_TIMEOUT = 200,
+    WIFI_REASON_NO_AP_FOUND,
+    WIFI_REASON_AUTH_FAIL,
+    WIFI_REASON_ASSOC_FAIL,
+    WIFI_REASON_HANDSHAKE_TIMEOUT,
+    WIFI_REASON_CONNECTION_FAIL
+};
+
+#endif // MOCK_ESP_WIFI_H
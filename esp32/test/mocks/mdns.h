@@ -0,0 +1,45 @@
+#ifndef MOCK_MDNS_H
+#define MOCK_MDNS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+// Queries never find anything on the host
+#define MDNS_TYPE_PTR       0x000C
+#define ESP_IPADDR_TYPE_V4  0
+
+typedef struct {
+    union {
+        struct { uint32_t addr; } ip4;
+    } u_addr;
+    uint8_t type;
+} esp_ip_addr_t;
+
+typedef struct mdns_ip_addr_s {
+    esp_ip_addr_t addr;
+    struct mdns_ip_addr_s* next;
+} mdns_ip_addr_t;
+
+typedef struct mdns_result_s {
+    struct mdns_result_s* next;
+    char* instance_name;
+    char* hostname;
+    uint16_t port;
+    mdns_ip_addr_t* addr;
+} mdns_result_t;
+
+typedef struct mdns_search_once_s mdns_search_once_t;
+typedef void (*mdns_query_notify_t)(mdns_search_once_t* search);
+
+esp_err_t mdns_init();
+esp_err_t mdns_hostname_set(const char* hostname);
+mdns_search_once_t* mdns_query_async_new(const char* name, const char* service, const char* proto,
+                                         uint16_t type, uint32_t timeout, size_t maxResults,
+                                         mdns_query_notify_t notifier);
+bool mdns_query_async_get_results(mdns_search_once_t* search, uint32_t timeout,
+                                  mdns_result_t** results, uint8_t* count);
+esp_err_t mdns_query_async_delete(mdns_search_once_t* search);
+void mdns_query_results_free(mdns_result_t* results);
+
+#endif // MOCK_MDNS_H
@@ -0,0 +1,534 @@
+#include <Arduino.h>
+#include <stdarg.h>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <WiFi.h>
+#include <Preferences.h>
+#include <WebSocketsClient.h>
+#include <BLEDevice.h>
+#include <LovyanGFX.hpp>
+#include <esp_err.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <esp_pm.h>
+#include <esp_rom_crc.h>
+#include <mdns.h>
+#include <mbedtls/sha256.h>
+#include <driver/ledc.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+
+// ============================================
+// Clock
+// ============================================
+
+static unsigned long mockMillis = 0;
+
+unsigned long millis() {
+    return mockMillis;
+}
+
+unsigned long micros() {
+    return mockMillis * 1000UL;
+}
+
+void delay(unsigned long ms) {
+    mockMillis += ms;
+}
+
+void mockAdvanceMillis(unsigned long ms) {
+    mockMillis += ms;
+}
+
+void mockResetClock() {
+    mockMillis = 0;
+}
+
+uint32_t EspClass::getCycleCount() {
+    // The host's own clock: benchmarks time real work, not the mock clock
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    return (uint32_t)(ns * getCpuFreqMHz() / 1000);
+}
+
+int HardwareSerial::printf(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = vprintf(fmt, args);
+    va_end(args);
+    return n;
+}
+
+// ============================================
+// Pins, clocks, RMT
+// ============================================
+
+void pinMode(int, int) {}
+int digitalRead(int) { return HIGH; }          // Buttons idle (pulled up)
+void attachInterrupt(int, void (*)(), int) {}
+int digitalPinToInterrupt(int pin) { return pin; }
+
+uint32_t getCpuFrequencyMhz() { return 160; }
+uint32_t getXtalFrequencyMhz() { return 40; }
+int esp_reset_reason() { return 1; }           // ESP_RST_POWERON
+
+bool rmtInit(int, rmt_ch_dir_t, rmt_reserve_memsize_t, uint32_t) { return true; }
+bool rmtWrite(int, rmt_data_t*, size_t, uint32_t) { return true; }
+bool rmtWriteLooping(int, rmt_data_t*, size_t) { return true; }
+
+esp_err_t ledc_fade_func_install(int) { return ESP_OK; }
+esp_err_t ledc_set_multi_fade(ledc_mode_t, ledc_channel_t, uint32_t, const ledc_fade_param_config_t*, uint32_t) { return ESP_OK; }
+esp_err_t ledc_fade_start(ledc_mode_t, ledc_channel_t, ledc_fade_mode_t) { return ESP_OK; }
+esp_err_t ledc_fade_stop(ledc_mode_t, ledc_channel_t) { return ESP_OK; }
+
+esp_err_t esp_pm_configure(const void*) { return ESP_OK; }
+
+const char* esp_err_to_name(esp_err_t err) {
+    return err == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
+
+// ============================================
+// FreeRTOS
+// ============================================
+
+struct MockQueue {
+    size_t itemSize;
+    size_t length;
+    std::deque<std::vector<uint8_t>> items;
+};
+
+static int mockSemaphore;
+static int mockTask;
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return &mockSemaphore; }
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return &mockSemaphore; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t) { return pdTRUE; }
+
+EventGroupHandle_t xEventGroupCreate() {
+    return new EventBits_t(0);
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+    return *(EventBits_t*)group |= bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+    EventBits_t before = *(EventBits_t*)group;
+    *(EventBits_t*)group &= ~bits;
+    return before;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                BaseType_t, TickType_t) {
+    EventBits_t current = *(EventBits_t*)group;
+    if (clearOnExit) *(EventBits_t*)group &= ~bits;
+    return current;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    return new MockQueue{itemSize, length, {}};
+}
+
+BaseType_t xQueueSend(QueueHandle_t handle, const void* item, TickType_t) {
+    MockQueue* queue = (MockQueue*)handle;
+    if (queue->items.size() >= queue->length) return pdFALSE;
+    const uint8_t* bytes = (const uint8_t*)item;
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void* item, TickType_t) {
+    MockQueue* queue = (MockQueue*)handle;
+    if (queue->items.empty()) return pdFALSE;
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    return pdTRUE;
+}
+
+BaseType_t xTaskCreate(void (*)(void*), const char*, uint32_t, void*, UBaseType_t, TaskHandle_t* handle) {
+    if (handle) *handle = &mockTask;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void*), const char* name, uint32_t stack, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t) {
+    return xTaskCreate(task, name, stack, param, priority, handle);
+}
+
+void vTaskDelete(TaskHandle_t) {}
+void vTaskDelay(TickType_t ticks) { mockMillis += ticks; }
+TickType_t xTaskGetTickCount() { return (TickType_t)mockMillis; }
+TaskHandle_t xTaskGetCurrentTaskHandle() { return &mockTask; }
+
+BaseType_t xTaskNotify(TaskHandle_t, uint32_t, eNotifyAction) { return pdPASS; }
+BaseType_t xTaskNotifyFromISR(TaskHandle_t, uint32_t, eNotifyAction, BaseType_t*) { return pdPASS; }
+BaseType_t xTaskNotifyWait(uint32_t, uint32_t, uint32_t* value, TickType_t) {
+    if (value) *value = 0;
+    return pdFALSE;
+}
+BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdPASS; }
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+
+// ============================================
+// Preferences (NVS)
+// ============================================
+
+static std::map<std::string, std::map<std::string, std::vector<uint8_t>>> mockNvs;
+
+void mockClearPreferences() {
+    mockNvs.clear();
+}
+
+bool Preferences::begin(const char* name, bool readOnly) {
+    _ns = &mockNvs[name];
+    _readOnly = readOnly;
+    return true;
+}
+
+bool Preferences::clear() {
+    if (_ns == nullptr || _readOnly) return false;
+    _ns->clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    return _ns != nullptr && !_readOnly && _ns->erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    return find(key) != nullptr;
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+    uint8_t byte = value;
+    return put(key, &byte, 1);
+}
+
+size_t Preferences::putUShort(const char* key, uint16_t value) {
+    return put(key, &value, sizeof(value));
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    return put(key, value, strlen(value));
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    return put(key, value, length);
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+    const std::vector<uint8_t>* value = find(key);
+    return value && value->size() == 1 ? (*value)[0] != 0 : defaultValue;
+}
+
+uint16_t Preferences::getUShort(const char* key, uint16_t defaultValue) {
+    const std::vector<uint8_t>* value = find(key);
+    if (!value || value->size() != sizeof(uint16_t)) return defaultValue;
+    uint16_t out;
+    memcpy(&out, value->data(), sizeof(out));
+    return out;
+}
+
+String Preferences::getString(const char* key, const char* defaultValue) {
+    const std::vector<uint8_t>* value = find(key);
+    if (!value) return String(defaultValue);
+    return String(std::string(value->begin(), value->end()));
+}
+
+size_t Preferences::getString(const char* key, char* out, size_t maxLength) {
+    const std::vector<uint8_t>* value = find(key);
+    if (!value || value->size() + 1 > maxLength) return 0;
+    memcpy(out, value->data(), value->size());
+    out[value->size()] = '\0';
+    return value->size() + 1;   // NVS counts the terminator
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    const std::vector<uint8_t>* value = find(key);
+    return value ? value->size() : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    const std::vector<uint8_t>* value = find(key);
+    if (!value || value->size() > maxLength) return 0;
+    memcpy(buffer, value->data(), value->size());
+    return value->size();
+}
+
+size_t Preferences::put(const char* key, const void* value, size_t length) {
+    if (_ns == nullptr || _readOnly) return 0;
+    const uint8_t* bytes = (const uint8_t*)value;
+    (*_ns)[key].assign(bytes, bytes + length);
+    return length;
+}
+
+const std::vector<uint8_t>* Preferences::find(const char* key) {
+    if (_ns == nullptr) return nullptr;
+    auto it = _ns->find(key);
+    return it == _ns->end() ? nullptr : &it->second;
+}
+
+// ============================================
+// WebSocketsClient
+// ============================================
+
+// Clients are globals of other translation units: the registry must
+// exist before their constructors run
+static std::vector<WebSocketsClient*>& mockSockets() {
+    static std::vector<WebSocketsClient*> sockets;
+    return sockets;
+}
+
+WebSocketsClient::WebSocketsClient() {
+    mockSockets().push_back(this);
+}
+
+WebSocketsClient::~WebSocketsClient() {
+    mockSockets().erase(std::remove(mockSockets().begin(), mockSockets().end(), this),
+                        mockSockets().end());
+}
+
+void WebSocketsClient::begin(const char* host, uint16_t port, const char*) {
+    this->host = host;
+    this->port = port;
+}
+
+void WebSocketsClient::beginSSL(const char* host, uint16_t port, const char* url, const char*, const char*) {
+    begin(host, port, url);
+}
+
+void WebSocketsClient::disconnect() {
+    if (!connected) return;
+    connected = false;
+    if (_handler) _handler(WStype_DISCONNECTED, nullptr, 0);
+}
+
+bool WebSocketsClient::sendTXT(const char* payload, size_t length) {
+    if (!connected) return false;
+    sentText.emplace_back(payload, length);
+    return true;
+}
+
+bool WebSocketsClient::sendBIN(const uint8_t* payload, size_t length) {
+    if (!connected) return false;
+    sentBinary.emplace_back(payload, payload + length);
+    return true;
+}
+
+WebSocketsClient* WebSocketsClient::forHost(const char* host) {
+    for (WebSocketsClient* socket : mockSockets()) {
+        if (socket->host == host) return socket;
+    }
+    return nullptr;
+}
+
+void WebSocketsClient::receive(WStype_t type, const void* payload, size_t length) {
+    if (type == WStype_CONNECTED) connected = true;
+    if (type == WStype_DISCONNECTED) connected = false;
+
+    _rx.assign((const uint8_t*)payload, (const uint8_t*)payload + length);
+    _rx.push_back('\0');
+    if (_handler) _handler(type, _rx.data(), length);
+}
+
+// ============================================
+// BLE
+// ============================================
+
+bool BLEDevice::boxPresent = false;
+uint16_t BLEDevice::peerMtu = 517;
+BLEClient* BLEDevice::lastClient = nullptr;
+bool BLEDevice::_initialized = false;
+BLEScan BLEDevice::_scan;
+
+BLEAddress::BLEAddress(const char* addr) {
+    unsigned int b[6] = {0};
+    if (addr && sscanf(addr, "%x:%x:%x:%x:%x:%x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) == 6) {
+        for (int i = 0; i < 6; i++) _addr[i] = (uint8_t)b[i];
+    }
+}
+
+String BLEAddress::toString() const {
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02x:%02x:%02x:%02x:%02x:%02x",
+             _addr[0], _addr[1], _addr[2], _addr[3], _addr[4], _addr[5]);
+    return String(buf);
+}
+
+void BLERemoteCharacteristic::notify(const uint8_t* data, size_t length) {
+    if (_notify == nullptr) return;
+    std::vector<uint8_t> copy(data, data + length);
+    _notify(this, copy.data(), copy.size(), true);
+}
+
+bool BLEClient::connect(BLEAddress, uint8_t, uint32_t) {
+    if (!BLEDevice::boxPresent) return false;
+    _connected = true;
+    if (_callbacks) _callbacks->onConnect(this);
+    return true;
+}
+
+bool BLEClient::setMTU(uint16_t mtu) {
+    _mtu = min(mtu, BLEDevice::peerMtu);
+    return true;
+}
+
+void BLEClient::disconnect() {
+    if (!_connected) return;
+    _connected = false;
+    if (_callbacks) _callbacks->onDisconnect(this);
+}
+
+// ============================================
+// Flash: no partitions, so no log partition and no A/B slots
+// ============================================
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char*) { return nullptr; }
+esp_err_t esp_partition_read(const esp_partition_t*, size_t, void*, size_t) { return ESP_FAIL; }
+esp_err_t esp_partition_write(const esp_partition_t*, size_t, const void*, size_t) { return ESP_FAIL; }
+esp_err_t esp_partition_erase_range(const esp_partition_t*, size_t, size_t) { return ESP_FAIL; }
+
+static const esp_partition_t mockRunning = { 0x10000, 0x1E0000, "app0" };
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t*) { return nullptr; }
+const esp_partition_t* esp_ota_get_running_partition() { return &mockRunning; }
+const esp_partition_t* esp_ota_get_last_invalid_partition() { return nullptr; }
+esp_err_t esp_ota_get_state_partition(const esp_partition_t*, esp_ota_img_states_t* state) {
+    *state = ESP_OTA_IMG_VALID;
+    return ESP_OK;
+}
+esp_err_t esp_ota_begin(const esp_partition_t*, size_t, esp_ota_handle_t*) { return ESP_ERR_NOT_FOUND; }
+esp_err_t esp_ota_write(esp_ota_handle_t, const void*, size_t) { return ESP_FAIL; }
+esp_err_t esp_ota_end(esp_ota_handle_t) { return ESP_FAIL; }
+esp_err_t esp_ota_abort(esp_ota_handle_t) { return ESP_OK; }
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t*) { return ESP_FAIL; }
+esp_err_t esp_ota_mark_app_valid_cancel_rollback() { return ESP_OK; }
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot() { return ESP_OK; }
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+// ============================================
+// mDNS: nobody answers
+// ============================================
+
+esp_err_t mdns_init() { return ESP_OK; }
+esp_err_t mdns_hostname_set(const char*) { return ESP_OK; }
+mdns_search_once_t* mdns_query_async_new(const char*, const char*, const char*, uint16_t, uint32_t, size_t,
+                                         mdns_query_notify_t) { return nullptr; }
+bool mdns_query_async_get_results(mdns_search_once_t*, uint32_t, mdns_result_t** results, uint8_t* count) {
+    *results = nullptr;
+    if (count) *count = 0;
+    return true;
+}
+esp_err_t mdns_query_async_delete(mdns_search_once_t*) { return ESP_OK; }
+void mdns_query_results_free(mdns_result_t*) {}
+
+// ============================================
+// SHA-256 (FIPS 180-4)
+// ============================================
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static void sha256Block(mbedtls_sha256_context* ctx, const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16 |
+               (uint32_t)block[i * 4 + 2] << 8 | block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t v[8];
+    memcpy(v, ctx->state, sizeof(v));
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = rotr(v[4], 6) ^ rotr(v[4], 11) ^ rotr(v[4], 25);
+        uint32_t ch = (v[4] & v[5]) ^ (~v[4] & v[6]);
+        uint32_t t1 = v[7] + s1 + ch + SHA256_K[i] + w[i];
+        uint32_t s0 = rotr(v[0], 2) ^ rotr(v[0], 13) ^ rotr(v[0], 22);
+        uint32_t maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+        memmove(v + 1, v, 7 * sizeof(uint32_t));
+        v[4] += t1;
+        v[0] = t1 + s0 + maj;
+    }
+    for (int i = 0; i < 8; i++) ctx->state[i] += v[i];
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int) {
+    static const uint32_t H0[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memcpy(ctx->state, H0, sizeof(H0));
+    ctx->total = 0;
+    return 0;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t length) {
+    while (length > 0) {
+        size_t used = ctx->total % 64;
+        size_t n = min(length, 64 - used);
+        memcpy(ctx->buffer + used, input, n);
+        ctx->total += n;
+        input += n;
+        length -= n;
+        if (ctx->total % 64 == 0) sha256Block(ctx, ctx->buffer);
+    }
+    return 0;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char output[32]) {
+    uint64_t bits = ctx->total * 8;
+    uint8_t pad[72] = {0x80};
+    size_t used = ctx->total % 64;
+    size_t padLen = (used < 56 ? 56 : 120) - used;
+    for (int i = 0; i < 8; i++) pad[padLen + i] = (uint8_t)(bits >> (56 - 8 * i));
+    mbedtls_sha256_update(ctx, pad, padLen + 8);
+
+    for (int i = 0; i < 8; i++) {
+        output[i * 4] = (uint8_t)(ctx->state[i] >> 24);
+        output[i * 4 + 1] = (uint8_t)(ctx->state[i] >> 16);
+        output[i * 4 + 2] = (uint8_t)(ctx->state[i] >> 8);
+        output[i * 4 + 3] = (uint8_t)ctx->state[i];
+    }
+    return 0;
+}
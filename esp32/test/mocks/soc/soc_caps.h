@@ -0,0 +1,8 @@
+#ifndef MOCK_SOC_CAPS_H
+#define MOCK_SOC_CAPS_H
+
+// ESP32-C6
+#define SOC_LEDC_GAMMA_CURVE_FADE_SUPPORTED 1
+#define SOC_LEDC_SUPPORT_FADE_STOP          1
+
+#endif // MOCK_SOC_CAPS_H
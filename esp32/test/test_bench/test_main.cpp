@@ -0,0 +1,235 @@
+// Host microbenchmarks of the notification hot paths, as in the
+// on-target bench (src/benchmark.cpp): WS and BLE decode over JSON and
+// bpw1, the queue, the duplicate cache and the display layout. Timings
+// are printed per operation; every run also checks what it produced,
+// so a fast path that stopped parsing fails rather than looks good.
+
+#include <unity.h>
+#include <chrono>
+#include "fixtures.h"
+#include "websocket_client.h"
+#include "ble_client.h"
+#include "notification_queue.h"
+#include "recent_ids.h"
+#include "display.h"
+#include "storage.h"
+
+#define HOST_BENCH_ITERATIONS 1000   // Timed runs per benchmark
+#define HOST_BENCH_WARMUP     5      // Untimed runs first
+
+static WebSocketsClient* socket = nullptr;
+static WireBuilder binary;
+
+// Decode benchmarks: how many notifications reached the inbox, and the last one
+static unsigned long delivered = 0;
+static InboxItem lastItem;
+
+static NotificationQueue benchQueue;
+static RecentIdCache benchIds;
+static NotificationData benchNotif;
+static TextLayout benchLayout;
+static uint32_t counter = 0;
+
+typedef void (*BenchOp)();
+
+// Time `op` per iteration; `cleanup` runs untimed after each one.
+// Returns the mean in ns
+static double measure(const char* name, BenchOp op, BenchOp cleanup = nullptr) {
+    for (uint8_t i = 0; i < HOST_BENCH_WARMUP; i++) {
+        op();
+        if (cleanup) cleanup();
+    }
+
+    std::chrono::nanoseconds total(0);
+    for (uint16_t i = 0; i < HOST_BENCH_ITERATIONS; i++) {
+        auto start = std::chrono::steady_clock::now();
+        op();
+        total += std::chrono::steady_clock::now() - start;
+        if (cleanup) cleanup();
+    }
+
+    double perOp = (double)total.count() / HOST_BENCH_ITERATIONS;
+    char line[96];
+    snprintf(line, sizeof(line), "[BENCH] %-20s %10.0f ns/op", name, perOp);
+    TEST_MESSAGE(line);
+    return perOp;
+}
+
+// ============================================
+// Operations
+// ============================================
+
+static void wsJson() {
+    socket->receiveText(SAMPLE_JSON);
+}
+
+static void wsBinary() {
+    socket->receive(WStype_BIN, binary.data(), binary.length());
+}
+
+static void bleJson() {
+    BleClient.handleNotifyData((uint8_t*)SAMPLE_JSON, strlen(SAMPLE_JSON));
+}
+
+static void bleBinary() {
+    BleClient.handleNotifyData(binary.data(), binary.length());
+}
+
+static void queuePushPop() {
+    // Distinct tables so every push adds rather than merges
+    snprintf(benchNotif.table, sizeof(benchNotif.table), "%lu",
+             (unsigned long)(counter++ % MAX_NOTIFICATIONS));
+    benchQueue.push(benchNotif);
+    if (benchQueue.count() >= MAX_NOTIFICATIONS) {
+        benchQueue.pop();
+    }
+}
+
+static void recentIds() {
+    // New id each time: the full scan plus an insert, the common case
+    snprintf(benchNotif.id, sizeof(benchNotif.id), "bench-%lu", (unsigned long)counter++);
+    benchIds.checkAndRemember(benchNotif);
+}
+
+static void layoutFresh() {
+    benchLayout.valid = false;
+    Display.showNotification(benchNotif, benchLayout, 1, 1);
+}
+
+static void layoutCached() {
+    Display.showNotification(benchNotif, benchLayout, 1, 1);
+}
+
+static void drainTransports() {
+    // What the UI task and the ack flush would do, kept out of the timing
+    InboxItem* item;
+    while ((item = Events.takeNotification()) != nullptr) {
+        lastItem = *item;
+        delivered++;
+        Events.releaseNotification(item);
+    }
+
+    // The box answers every probe, or the WS client would drop the link
+    mockAdvanceMillis(ACK_BATCH_INTERVAL);
+    socket->receive(WStype_PONG);
+    WsClient.loop();
+    BleClient.loop();
+    socket->sentText.clear();
+    BLEDevice::lastClient->getService(BLEUUID(BLE_SERVICE_UUID))
+        ->getCharacteristic(BLEUUID(BLE_REGISTER_CHAR_UUID))->writes.clear();
+}
+
+// ============================================
+// Tests
+// ============================================
+
+static void assertSample(NotificationSource source) {
+    // Every run delivered exactly one notification and gave its slot back
+    TEST_ASSERT_EQUAL_UINT32(HOST_BENCH_WARMUP + HOST_BENCH_ITERATIONS, delivered);
+    TEST_ASSERT_EQUAL(source, lastItem.source);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, lastItem.data.id);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_TABLE, lastItem.data.table);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ALERT, lastItem.data.type);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, lastItem.data.message);
+    TEST_ASSERT_EQUAL_STRING("high", lastItem.data.priority);
+    TEST_ASSERT_TRUE(lastItem.data.timestamp == SAMPLE_TIMESTAMP);
+}
+
+void setUp() {
+    delivered = 0;
+    memset(&lastItem, 0, sizeof(lastItem));
+}
+
+void tearDown() {}
+
+static void test_ws_json() {
+    measure("ws.json", wsJson, drainTransports);
+    assertSample(SOURCE_WEBSOCKET);
+    TEST_ASSERT_EQUAL_UINT32(7, lastItem.seq);
+    TEST_ASSERT_EQUAL_UINT32(6, lastItem.prevSeq);
+}
+
+static void test_ws_binary() {
+    measure("ws.bpw1", wsBinary, drainTransports);
+    assertSample(SOURCE_WEBSOCKET);
+}
+
+static void test_ble_json() {
+    measure("ble.json", bleJson, drainTransports);
+    assertSample(SOURCE_BLE);
+    TEST_ASSERT_EQUAL_UINT32(7, lastItem.seq);
+}
+
+static void test_ble_binary() {
+    measure("ble.bpw1", bleBinary, drainTransports);
+    assertSample(SOURCE_BLE);
+}
+
+static void test_queue_push_pop() {
+    benchQueue.clear();
+    counter = 0;
+    measure("queue.push+pop", queuePushPop);
+
+    // Held at capacity less one, oldest tables popped first
+    TEST_ASSERT_EQUAL_UINT8(MAX_NOTIFICATIONS - 1, benchQueue.count());
+    TEST_ASSERT_NOT_NULL(benchQueue.front());
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, benchQueue.front()->data.message);
+}
+
+static void test_recent_ids() {
+    benchIds.clear();
+    measure("recentIds.check", recentIds);
+
+    // The last id is remembered, a new one is not
+    TEST_ASSERT_TRUE(benchIds.checkAndRemember(benchNotif));
+    strncpy(benchNotif.id, "never-seen", sizeof(benchNotif.id) - 1);
+    TEST_ASSERT_FALSE(benchIds.checkAndRemember(benchNotif));
+}
+
+static void test_layout() {
+    wireDecodeNotification(binary.data(), binary.length(), benchNotif);   // recentIds changed the id
+    measure("display.layout", layoutFresh);
+    TextLayout fresh = benchLayout;
+
+    // The sample wraps to three lines at text size 1
+    TEST_ASSERT_TRUE(fresh.valid);
+    TEST_ASSERT_EQUAL_UINT8(1, fresh.textSize);
+    TEST_ASSERT_EQUAL_UINT8(3, fresh.lineCount);
+
+    // The same scene each time: pushed to the panel once, not per run
+    unsigned long pushes = Display.getLGFX()->pushes;
+    measure("display.cached", layoutCached);
+    TEST_ASSERT_EQUAL_MEMORY(&fresh, &benchLayout, sizeof(benchLayout));
+    TEST_ASSERT_EQUAL_UINT32(pushes, Display.getLGFX()->pushes);
+}
+
+int main(int argc, char** argv) {
+    Storage.begin();
+    Events.begin();
+    Display.begin();
+    binary.sample();
+    wireDecodeNotification(binary.data(), binary.length(), benchNotif);
+
+    // Both links up, so the ack flushes go out instead of piling up
+    WsClient.begin("127.0.0.1", 3334);
+    socket = WebSocketsClient::forHost("127.0.0.1");
+    socket->receive(WStype_CONNECTED, "/", 1);
+
+    BLEDevice::boxPresent = true;
+    BleClient.setTargetAddress("a4:cf:12:34:56:78");
+    BleClient.begin();
+    BleClient.registerDevice(Storage.getDeviceId().c_str(), "BitsperWatch");
+    BleClient.startScan();
+    BleClient.loop();
+    BleClient.loop();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_ws_json);
+    RUN_TEST(test_ws_binary);
+    RUN_TEST(test_ble_json);
+    RUN_TEST(test_ble_binary);
+    RUN_TEST(test_queue_push_pop);
+    RUN_TEST(test_recent_ids);
+    RUN_TEST(test_layout);
+    return UNITY_END();
+}
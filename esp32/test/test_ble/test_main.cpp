@@ -0,0 +1,255 @@
+// BLE client: directed connect and register, notification parsing over
+// JSON, bpw1 and fragments, and the ack writes (ble_client.h)
+
+#include <unity.h>
+#include <ArduinoJson.h>
+#include "fixtures.h"
+#include "ble_client.h"
+#include "display.h"
+#include "storage.h"
+#include "metrics.h"
+#include "sequence_tracker.h"
+
+#define BOX_ADDRESS "a4:cf:12:34:56:78"
+
+static BLERemoteCharacteristic* registerChar() {
+    return BLEDevice::lastClient->getService(BLEUUID(BLE_SERVICE_UUID))
+        ->getCharacteristic(BLEUUID(BLE_REGISTER_CHAR_UUID));
+}
+
+static void receive(const void* data, size_t length) {
+    BleClient.handleNotifyData((uint8_t*)data, length);
+}
+
+static void receiveText(const char* text) {
+    receive(text, strlen(text));
+}
+
+static InboxItem* takeOnly() {
+    InboxItem* item = Events.takeNotification();
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_NULL(Events.takeNotification());
+    return item;
+}
+
+void setUp() {
+    // Flush what the previous test left: pending acks and inbox slots
+    mockAdvanceMillis(ACK_BATCH_INTERVAL);
+    BleClient.loop();
+    drainInbox();
+    registerChar()->writes.clear();
+}
+
+void tearDown() {}
+
+static void test_directed_connect_registers() {
+    // main() connected to the configured address without a scan, and
+    // the box refused a larger MTU
+    TEST_ASSERT_TRUE(BleClient.isConnected());
+    TEST_ASSERT_EQUAL_UINT32(0, BLEDevice::getScan()->scans);
+    TEST_ASSERT_EQUAL_UINT16(23, BleClient.getMTU());
+
+    // The register goes out again on every connect
+    BleClient.disconnect();
+    BleClient.startScan();
+    BleClient.loop();
+    BleClient.loop();
+    TEST_ASSERT_TRUE(BleClient.isConnected());
+    TEST_ASSERT_EQUAL(1, registerChar()->writes.size());
+
+    // Longer than one default-MTU packet once a filter rides along
+    const BLEWrite& write = registerChar()->writes[0];
+    TEST_ASSERT_TRUE(write.withResponse);
+
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(deserializeJson(doc, (const char*)write.data.data(), write.data.size()) ==
+                     DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_STRING("register", doc["type"] | "");
+    TEST_ASSERT_EQUAL_STRING(Storage.getDeviceId().c_str(), doc["device_id"] | "");
+    TEST_ASSERT_EQUAL_STRING(WIRE_PROTOCOL_NAME, doc["wire"] | "");
+    TEST_ASSERT_EQUAL(23, doc["mtu"] | 0);
+    TEST_ASSERT_EQUAL(1, doc["frag"] | 0);
+}
+
+static void test_binary_notification_fields() {
+    WireBuilder frame;
+    frame.sample().u32(WIRE_TAG_SEQ, 12).u32(WIRE_TAG_PREV_SEQ, 10);
+    receive(frame.data(), frame.length());
+
+    InboxItem* item = takeOnly();
+    TEST_ASSERT_EQUAL(SOURCE_BLE, item->source);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, item->data.id);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_TABLE, item->data.table);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ALERT, item->data.type);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, item->data.message);
+    TEST_ASSERT_EQUAL_STRING("high", item->data.priority);
+    TEST_ASSERT_TRUE(item->data.timestamp == SAMPLE_TIMESTAMP);
+    TEST_ASSERT_EQUAL_UINT32(12, item->seq);
+    TEST_ASSERT_EQUAL_UINT32(10, item->prevSeq);
+    Events.releaseNotification(item);
+}
+
+static void test_json_notification_fields() {
+    receiveText(SAMPLE_JSON);
+
+    InboxItem* item = takeOnly();
+    TEST_ASSERT_EQUAL(SOURCE_BLE, item->source);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, item->data.id);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_TABLE, item->data.table);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ALERT, item->data.type);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, item->data.message);
+    TEST_ASSERT_EQUAL_STRING("high", item->data.priority);
+    TEST_ASSERT_TRUE(item->data.timestamp == SAMPLE_TIMESTAMP);
+    TEST_ASSERT_EQUAL_UINT32(7, item->seq);
+    TEST_ASSERT_EQUAL_UINT32(6, item->prevSeq);
+    Events.releaseNotification(item);
+}
+
+static void test_fragmented_json_reassembled() {
+    const char* message = SAMPLE_JSON;
+    size_t total = strlen(message);
+    size_t chunk = 16;   // Default MTU: 20-byte values less the header
+    uint8_t count = (total + chunk - 1) / chunk;
+
+    uint8_t packet[32];
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_NULL(Events.takeNotification());   // Nothing before the last one
+        size_t len = min(chunk, total - i * chunk);
+        receive(packet, bleFragment(packet, 3, i, count, message + i * chunk, len));
+    }
+
+    InboxItem* item = takeOnly();
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, item->data.id);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, item->data.message);
+    TEST_ASSERT_EQUAL_UINT32(7, item->seq);
+    Events.releaseNotification(item);
+}
+
+static void test_lost_fragment_drops_message() {
+    unsigned long dropped = BleClient.getFramesDropped();
+    const char* message = SAMPLE_JSON;
+    uint8_t packet[32];
+
+    receive(packet, bleFragment(packet, 4, 0, 3, message, 16));
+    receive(packet, bleFragment(packet, 4, 2, 3, message + 32, 16));
+
+    TEST_ASSERT_EQUAL_UINT32(dropped + 1, BleClient.getFramesDropped());
+    TEST_ASSERT_EQUAL(0, drainInbox());
+}
+
+static void test_replies_need_our_device_id() {
+    // Another watch's, and one that names nobody
+    receiveText("{\"type\":\"registered\",\"device_id\":\"other\",\"seq_epoch\":41,\"seq\":0}");
+    receiveText("{\"type\":\"registered\",\"seq_epoch\":41,\"seq\":0}");
+    TEST_ASSERT_NOT_EQUAL(41, Sequences.getEpoch());
+
+    std::string ours = std::string("{\"type\":\"registered\",\"device_id\":\"") +
+                       Storage.getDeviceId().c_str() + "\",\"seq_epoch\":41,\"seq\":0}";
+    receiveText(ours.c_str());
+    TEST_ASSERT_EQUAL_UINT32(41, Sequences.getEpoch());
+}
+
+static void test_resync_written_with_response() {
+    // Epoch 41 (previous test): 1 and 2 never arrived
+    Sequences.onReceived(3, 0);
+    mockAdvanceMillis(SEQ_GAP_GRACE);
+    BleClient.loop();
+
+    TEST_ASSERT_EQUAL(1, registerChar()->writes.size());
+    const BLEWrite& write = registerChar()->writes[0];
+    TEST_ASSERT_TRUE(write.withResponse);
+
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(deserializeJson(doc, (const char*)write.data.data(), write.data.size()) ==
+                     DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_STRING("resync", doc["type"] | "");
+    TEST_ASSERT_EQUAL_UINT32(1, doc["from"] | 0u);
+    TEST_ASSERT_EQUAL_UINT32(2, doc["to"] | 0u);
+
+    Sequences.onResynced(2);
+}
+
+static void test_disconnect_discards_partial_message() {
+    unsigned long dropped = BleClient.getFramesDropped();
+    const char* message = SAMPLE_JSON;
+    size_t total = strlen(message);
+    uint8_t count = (total + 15) / 16;
+    uint8_t packet[32];
+
+    // The link goes halfway through a message
+    receive(packet, bleFragment(packet, 5, 0, count, message, 16));
+    BleClient.handleDisconnect();
+
+    // The next link's first message starts clean: the old partial one is
+    // discarded, not counted as lost in transit
+    for (uint8_t i = 0; i < count; i++) {
+        size_t len = min((size_t)16, total - i * 16);
+        receive(packet, bleFragment(packet, 6, i, count, message + i * 16, len));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(dropped, BleClient.getFramesDropped());
+    TEST_ASSERT_EQUAL(1, drainInbox());
+}
+
+static void test_malformed_json_counted() {
+    uint32_t errors = Metrics.get(METRIC_JSON_ERRORS);
+    receiveText("{\"type\":\"notification\",\"id\":");
+
+    TEST_ASSERT_EQUAL_UINT32(errors + 1, Metrics.get(METRIC_JSON_ERRORS));
+    TEST_ASSERT_EQUAL(0, drainInbox());
+}
+
+static void test_acks_at_default_mtu_written_with_response() {
+    // A full batch of UUID ids is far over one 23-byte MTU packet: none
+    // may be drained and then lost
+    char id[48];
+    for (uint8_t i = 0; i < ACK_BATCH_MAX; i++) {
+        snprintf(id, sizeof(id), "0d6c9a8e-5a43-4a8e-9f51-3b0b2f6f1c%02u", i);
+        WireBuilder frame;
+        frame.str(WIRE_TAG_ID, id).str(WIRE_TAG_TABLE, "5");
+        receive(frame.data(), frame.length());
+    }
+    TEST_ASSERT_EQUAL(ACK_BATCH_MAX, drainInbox());
+
+    BleClient.loop();
+    TEST_ASSERT_EQUAL(1, registerChar()->writes.size());
+
+    const BLEWrite& write = registerChar()->writes[0];
+    TEST_ASSERT_TRUE(write.withResponse);
+
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(deserializeJson(doc, (const char*)write.data.data(), write.data.size()) ==
+                     DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_STRING("acks", doc["type"] | "");
+    TEST_ASSERT_EQUAL(ACK_BATCH_MAX, doc["acks"].size());
+    TEST_ASSERT_EQUAL_STRING("0d6c9a8e-5a43-4a8e-9f51-3b0b2f6f1c00", doc["acks"][0] | "");
+}
+
+int main(int argc, char** argv) {
+    Storage.begin();
+    Events.begin();
+    Display.begin();
+
+    // A box in range at the configured address that stays at the default MTU
+    BLEDevice::boxPresent = true;
+    BLEDevice::peerMtu = 23;
+    BleClient.setTargetAddress(BOX_ADDRESS);
+    BleClient.begin();
+    BleClient.registerDevice(Storage.getDeviceId().c_str(), "BitsperWatch");
+    BleClient.startScan();
+    BleClient.loop();   // Directed search: no scan, connect requested
+    BleClient.loop();   // Connect, MTU, GATT, register
+
+    UNITY_BEGIN();
+    RUN_TEST(test_directed_connect_registers);
+    RUN_TEST(test_binary_notification_fields);
+    RUN_TEST(test_json_notification_fields);
+    RUN_TEST(test_fragmented_json_reassembled);
+    RUN_TEST(test_lost_fragment_drops_message);
+    RUN_TEST(test_malformed_json_counted);
+    RUN_TEST(test_acks_at_default_mtu_written_with_response);
+    RUN_TEST(test_replies_need_our_device_id);
+    RUN_TEST(test_resync_written_with_response);
+    RUN_TEST(test_disconnect_discards_partial_message);   // Last: leaves the link down
+    return UNITY_END();
+}
@@ -0,0 +1,154 @@
+// Notification text layout (display.cpp, text_layout.h). The mock panel
+// measures like the 6x8 built-in font: 6 px per glyph times the text
+// size, on a 152 px wide message area (LCD_WIDTH less the margins)
+
+#include <unity.h>
+#include "display.h"
+#include "text_layout.h"
+#include "fixtures.h"
+
+#define GLYPH_W  6
+
+static NotificationData notif;
+static TextLayout layout;
+
+static void show(const char* table, const char* message) {
+    memset(&notif, 0, sizeof(notif));
+    strncpy(notif.table, table, sizeof(notif.table) - 1);
+    strncpy(notif.type, SAMPLE_ALERT, sizeof(notif.type) - 1);
+    strncpy(notif.priority, "high", sizeof(notif.priority) - 1);
+    strncpy(notif.message, message, sizeof(notif.message) - 1);
+    layout.valid = false;
+    Display.showNotification(notif, layout, 1, 1);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_short_message_large_text() {
+    show("12", "Cuenta por favor");
+
+    TEST_ASSERT_TRUE(layout.valid);
+    TEST_ASSERT_FALSE(layout.truncated);
+    TEST_ASSERT_EQUAL_UINT8(3, layout.tableSize);
+    TEST_ASSERT_EQUAL_UINT8(2, layout.textSize);
+    TEST_ASSERT_EQUAL_UINT8(2, layout.lineCount);
+    TEST_ASSERT_EQUAL_UINT8(0, layout.start[0]);
+    TEST_ASSERT_EQUAL_UINT8(10, layout.length[0]);           // "Cuenta por"
+    TEST_ASSERT_EQUAL_INT16(10 * GLYPH_W * 2, layout.width[0]);
+    TEST_ASSERT_EQUAL_UINT8(11, layout.start[1]);            // "favor"
+    TEST_ASSERT_EQUAL_UINT8(5, layout.length[1]);
+    TEST_ASSERT_EQUAL_INT16(5 * GLYPH_W * 2, layout.width[1]);
+}
+
+static void test_long_message_small_text() {
+    // Four lines at size 2: falls back to size 1
+    show(SAMPLE_TABLE, SAMPLE_MESSAGE);
+
+    TEST_ASSERT_EQUAL_UINT8(1, layout.textSize);
+    TEST_ASSERT_EQUAL_UINT8(3, layout.lineCount);
+    TEST_ASSERT_FALSE(layout.truncated);
+
+    // "La mesa 12 solicita" / "atención del mesero, por" / "favor acérquese"
+    TEST_ASSERT_EQUAL_UINT8(19, layout.length[0]);
+    TEST_ASSERT_EQUAL_UINT8(20, layout.start[1]);
+    TEST_ASSERT_EQUAL_UINT8(25, layout.length[1]);           // ó is two bytes...
+    TEST_ASSERT_EQUAL_INT16(24 * GLYPH_W, layout.width[1]);  // ...and one glyph
+    TEST_ASSERT_EQUAL_UINT8(46, layout.start[2]);
+    TEST_ASSERT_EQUAL_UINT32(strlen(SAMPLE_MESSAGE), layout.start[2] + layout.length[2]);
+}
+
+static void test_table_heading_shrinks() {
+    show("Terraza 12", "Hola");
+    TEST_ASSERT_EQUAL_UINT8(1, layout.tableSize);   // 15 glyphs: 270 and 180 px don't fit
+
+    show("Bar 3", "Hola");
+    TEST_ASSERT_EQUAL_UINT8(2, layout.tableSize);   // 10 glyphs: 120 px at size 2
+}
+
+static void test_truncates_with_ellipsis() {
+    char message[256];
+    message[0] = '\0';
+    while (strlen(message) + 6 < sizeof(message)) {
+        strcat(message, "mesa ");
+    }
+    show("1", message);
+
+    // Nine size-1 lines fit between the separator and the footer
+    TEST_ASSERT_EQUAL_UINT8(1, layout.textSize);
+    TEST_ASSERT_EQUAL_UINT8(LAYOUT_MAX_LINES, layout.lineCount);
+    TEST_ASSERT_TRUE(layout.truncated);
+    uint8_t last = layout.lineCount - 1;
+    TEST_ASSERT_LESS_OR_EQUAL(LCD_WIDTH - 20, layout.width[last]);
+    TEST_ASSERT_EQUAL_INT16((layout.length[last] + 3) * GLYPH_W, layout.width[last]);
+}
+
+static void test_newline_ends_line() {
+    show("4", "Mesa 4\nCuenta");
+
+    TEST_ASSERT_EQUAL_UINT8(2, layout.textSize);
+    TEST_ASSERT_EQUAL_UINT8(2, layout.lineCount);
+    TEST_ASSERT_EQUAL_UINT8(6, layout.length[0]);
+    TEST_ASSERT_EQUAL_UINT8(7, layout.start[1]);
+    TEST_ASSERT_EQUAL_UINT8(6, layout.length[1]);
+}
+
+static void test_long_word_split_between_characters() {
+    show("4", "ABCDEFGHIJKLMNOPQRST");
+
+    TEST_ASSERT_EQUAL_UINT8(2, layout.textSize);
+    TEST_ASSERT_EQUAL_UINT8(2, layout.lineCount);
+    TEST_ASSERT_EQUAL_UINT8(12, layout.length[0]);   // 12 glyphs of 12 px in 152
+    TEST_ASSERT_EQUAL_UINT8(12, layout.start[1]);
+    TEST_ASSERT_EQUAL_UINT8(8, layout.length[1]);
+}
+
+static void test_cached_layout_replayed() {
+    show("5", "Cuenta por favor");
+    TextLayout first = layout;
+
+    // A valid layout is drawn as it is, without measuring again
+    strncpy(notif.message, "Un mensaje distinto y bastante mas largo que el anterior", sizeof(notif.message) - 1);
+    Display.showNotification(notif, layout, 1, 1);
+    TEST_ASSERT_EQUAL_MEMORY(&first, &layout, sizeof(layout));
+}
+
+static void test_unchanged_screen_not_pushed() {
+    show("6", "Cuenta por favor");
+    unsigned long pushes = Display.getLGFX()->pushes;
+    TEST_ASSERT_GREATER_THAN(0, pushes);
+
+    // Same scene again: no dirty rows, nothing sent to the panel
+    Display.showNotification(notif, layout, 1, 1);
+    TEST_ASSERT_EQUAL_UINT32(pushes, Display.getLGFX()->pushes);
+}
+
+static void test_font_encode() {
+    const char text[] = "\xC2\xBFQu\xC3\xA9? \xC3\xB1 \xE2\x82\xAC";   // ¿Qué? ñ €
+    char out[32];
+
+    size_t len = fontEncode(text, strlen(text), out, sizeof(out));
+    TEST_ASSERT_EQUAL_UINT32(9, len);
+    TEST_ASSERT_EQUAL_STRING("\xA8Qu\x82? \xA4 ?", out);
+
+    // Never splits a character, always terminates
+    TEST_ASSERT_EQUAL_UINT32(3, fontEncode(text, strlen(text), out, 4));
+    TEST_ASSERT_EQUAL_STRING("\xA8Qu", out);
+    TEST_ASSERT_EQUAL_UINT32(2, utf8Next(text, 0));
+}
+
+int main(int argc, char** argv) {
+    Display.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_short_message_large_text);
+    RUN_TEST(test_long_message_small_text);
+    RUN_TEST(test_table_heading_shrinks);
+    RUN_TEST(test_truncates_with_ellipsis);
+    RUN_TEST(test_newline_ends_line);
+    RUN_TEST(test_long_word_split_between_characters);
+    RUN_TEST(test_cached_layout_replayed);
+    RUN_TEST(test_unchanged_screen_not_pushed);
+    RUN_TEST(test_font_encode);
+    return UNITY_END();
+}
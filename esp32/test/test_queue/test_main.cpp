@@ -0,0 +1,160 @@
+// NotificationQueue ordering, merging and overflow (notification_queue.h)
+
+#include <unity.h>
+#include "notification_queue.h"
+
+static NotificationQueue queue;
+
+static NotificationData make(const char* table, const char* type, const char* priority,
+                             const char* message = "") {
+    NotificationData notif;
+    memset(&notif, 0, sizeof(notif));
+    strncpy(notif.table, table, sizeof(notif.table) - 1);
+    strncpy(notif.type, type, sizeof(notif.type) - 1);
+    strncpy(notif.priority, priority, sizeof(notif.priority) - 1);
+    strncpy(notif.message, message, sizeof(notif.message) - 1);
+    return notif;
+}
+
+void setUp() {
+    mockResetClock();
+    queue.clear();
+}
+
+void tearDown() {}
+
+static void test_priority_then_age() {
+    queue.push(make("1", "bill_ready", "low"));
+    queue.push(make("2", "waiter_called", "high"));
+    queue.push(make("3", "waiter_called", "high"));
+    queue.push(make("4", "urgent", "urgent"));
+    queue.push(make("5", "bill_ready", "medium"));
+
+    const char* expected[] = {"4", "2", "3", "5", "1"};
+    TEST_ASSERT_EQUAL_UINT8(5, queue.count());
+    for (const char* table : expected) {
+        TEST_ASSERT_EQUAL_STRING(table, queue.front()->data.table);
+        TEST_ASSERT_TRUE(queue.pop());
+    }
+    TEST_ASSERT_TRUE(queue.isEmpty());
+    TEST_ASSERT_NULL(queue.front());
+    TEST_ASSERT_FALSE(queue.pop());
+}
+
+static void test_unknown_priority_ranks_medium() {
+    TEST_ASSERT_EQUAL_UINT8(PRIORITY_MEDIUM, NotificationQueue::priorityRank("whenever"));
+    TEST_ASSERT_EQUAL_UINT8(PRIORITY_URGENT, NotificationQueue::priorityRank("urgent"));
+    TEST_ASSERT_EQUAL_UINT8(PRIORITY_LOW, NotificationQueue::priorityRank("low"));
+}
+
+static void test_merge_keeps_age_and_priority() {
+    queue.push(make("7", "waiter_called", "high", "first"));
+    mockAdvanceMillis(500);
+    queue.push(make("8", "waiter_called", "high"));
+
+    // Same table+type again, lower priority: refreshed, not demoted or moved back
+    TEST_ASSERT_EQUAL(QUEUE_MERGED, queue.push(make("7", "waiter_called", "low", "second")));
+    TEST_ASSERT_EQUAL_UINT8(2, queue.count());
+
+    const QueuedNotification* head = queue.front();
+    TEST_ASSERT_EQUAL_STRING("7", head->data.table);
+    TEST_ASSERT_EQUAL_STRING("second", head->data.message);
+    TEST_ASSERT_EQUAL_STRING("high", head->data.priority);
+    TEST_ASSERT_EQUAL_UINT32(0, head->queuedAt);
+}
+
+static NotificationData withId(NotificationData notif, const char* id) {
+    strncpy(notif.id, id, sizeof(notif.id) - 1);
+    return notif;
+}
+
+static void test_merge_keeps_absorbed_ids() {
+    queue.push(withId(make("7", "waiter_called", "high"), "id-1"));
+    queue.push(withId(make("7", "waiter_called", "high"), "id-2"));
+    queue.push(withId(make("7", "waiter_called", "high"), "id-2"));   // Same id: nothing new
+
+    const QueuedNotification* head = queue.front();
+    TEST_ASSERT_EQUAL_STRING("id-2", head->data.id);
+    TEST_ASSERT_EQUAL_UINT8(1, head->absorbedCount);
+    TEST_ASSERT_EQUAL_STRING("id-1", head->absorbed[0]);
+
+    // Beyond QUEUE_ABSORBED_IDS the oldest goes
+    char id[8];
+    for (uint8_t i = 3; i < 3 + QUEUE_ABSORBED_IDS; i++) {
+        snprintf(id, sizeof(id), "id-%d", i);
+        queue.push(withId(make("7", "waiter_called", "high"), id));
+    }
+    TEST_ASSERT_EQUAL_UINT8(QUEUE_ABSORBED_IDS, head->absorbedCount);
+    TEST_ASSERT_EQUAL_STRING("id-6", head->data.id);
+    TEST_ASSERT_EQUAL_STRING("id-2", head->absorbed[0]);
+    TEST_ASSERT_EQUAL_STRING("id-5", head->absorbed[QUEUE_ABSORBED_IDS - 1]);
+
+    // A new entry in a reused slot starts clean
+    queue.pop();
+    queue.push(withId(make("8", "bill_ready", "high"), "id-9"));
+    TEST_ASSERT_EQUAL_UINT8(0, queue.front()->absorbedCount);
+}
+
+static void test_merge_promotes() {
+    queue.push(make("1", "waiter_called", "high"));
+    queue.push(make("2", "bill_ready", "low"));
+    TEST_ASSERT_EQUAL(QUEUE_MERGED, queue.push(make("2", "bill_ready", "urgent")));
+
+    TEST_ASSERT_EQUAL_STRING("2", queue.front()->data.table);
+    TEST_ASSERT_EQUAL_STRING("urgent", queue.front()->data.priority);
+}
+
+static void test_merge_invalidates_layout() {
+    queue.push(make("1", "waiter_called", "high", "short"));
+    queue.frontLayout()->valid = true;   // As the display leaves it
+
+    queue.push(make("1", "waiter_called", "high", "a different, longer message"));
+    TEST_ASSERT_FALSE(queue.frontLayout()->valid);
+}
+
+static void test_full_evicts_lowest() {
+    unsigned long dropped = queue.getDroppedCount();
+    for (int i = 0; i < MAX_NOTIFICATIONS; i++) {
+        char table[8];
+        snprintf(table, sizeof(table), "%d", i);
+        TEST_ASSERT_EQUAL(QUEUE_ADDED, queue.push(make(table, "bill_ready", i == 3 ? "low" : "medium")));
+    }
+
+    TEST_ASSERT_EQUAL(QUEUE_EVICTED, queue.push(make("new", "waiter_called", "high")));
+    TEST_ASSERT_EQUAL_UINT8(MAX_NOTIFICATIONS, queue.count());
+    TEST_ASSERT_FALSE(queue.contains("3", "bill_ready"));
+    TEST_ASSERT_TRUE(queue.contains("new", "waiter_called"));
+    TEST_ASSERT_EQUAL_STRING("new", queue.front()->data.table);
+    TEST_ASSERT_EQUAL_UINT32(dropped + 1, queue.getDroppedCount());
+}
+
+static void test_full_drops_when_nothing_ranks_below() {
+    for (int i = 0; i < MAX_NOTIFICATIONS; i++) {
+        char table[8];
+        snprintf(table, sizeof(table), "%d", i);
+        queue.push(make(table, "waiter_called", "high"));
+    }
+
+    unsigned long dropped = queue.getDroppedCount();
+    TEST_ASSERT_EQUAL(QUEUE_DROPPED, queue.push(make("late", "waiter_called", "high")));
+    TEST_ASSERT_FALSE(queue.contains("late", "waiter_called"));
+    TEST_ASSERT_EQUAL_UINT32(dropped + 1, queue.getDroppedCount());
+
+    // Slots freed by pop() are reused
+    queue.pop();
+    TEST_ASSERT_EQUAL(QUEUE_ADDED, queue.push(make("late", "waiter_called", "high")));
+    TEST_ASSERT_TRUE(queue.contains("late", "waiter_called"));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_priority_then_age);
+    RUN_TEST(test_unknown_priority_ranks_medium);
+    RUN_TEST(test_merge_keeps_age_and_priority);
+    RUN_TEST(test_merge_keeps_absorbed_ids);
+    RUN_TEST(test_merge_promotes);
+    RUN_TEST(test_merge_invalidates_layout);
+    RUN_TEST(test_full_evicts_lowest);
+    RUN_TEST(test_full_drops_when_nothing_ranks_below);
+    return UNITY_END();
+}
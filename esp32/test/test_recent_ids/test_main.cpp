@@ -0,0 +1,66 @@
+// RecentIdCache: the WebSocket and BLE copies of one alert collapse,
+// with or without an id from the box (recent_ids.h)
+
+#include <unity.h>
+#include "fixtures.h"
+#include "recent_ids.h"
+
+static RecentIdCache cache;
+
+// A bpw1 alert without id or timestamp, decoded now
+static NotificationData decodeAnonymous(const char* table, const char* message) {
+    WireBuilder frame;
+    frame.str(WIRE_TAG_TABLE, table).str(WIRE_TAG_ALERT, SAMPLE_ALERT)
+         .str(WIRE_TAG_MESSAGE, message);
+
+    NotificationData notif;
+    TEST_ASSERT_TRUE(wireDecodeNotification(frame.data(), frame.length(), notif));
+    return notif;
+}
+
+void setUp() {
+    mockResetClock();
+    cache.clear();
+}
+
+void tearDown() {}
+
+static void test_same_id_is_duplicate() {
+    WireBuilder frame;
+    frame.sample();
+    NotificationData notif;
+    TEST_ASSERT_TRUE(wireDecodeNotification(frame.data(), frame.length(), notif));
+
+    TEST_ASSERT_FALSE(cache.checkAndRemember(notif));
+    TEST_ASSERT_TRUE(cache.checkAndRemember(notif));
+}
+
+static void test_no_id_copies_arriving_apart_collapse() {
+    // Same payload over WiFi then BLE, a while later: receive time is
+    // not part of the key
+    TEST_ASSERT_FALSE(cache.checkAndRemember(decodeAnonymous("7", "Mesa 7")));
+    mockAdvanceMillis(350);
+    TEST_ASSERT_TRUE(cache.checkAndRemember(decodeAnonymous("7", "Mesa 7")));
+
+    // A different table or message is a different alert
+    TEST_ASSERT_FALSE(cache.checkAndRemember(decodeAnonymous("8", "Mesa 7")));
+    TEST_ASSERT_FALSE(cache.checkAndRemember(decodeAnonymous("7", "Mesa 7, otra vez")));
+}
+
+static void test_nothing_to_key_on_never_deduped() {
+    unsigned long duplicates = cache.getDuplicateCount();
+    NotificationData empty;
+    memset(&empty, 0, sizeof(empty));
+
+    TEST_ASSERT_FALSE(cache.checkAndRemember(empty));
+    TEST_ASSERT_FALSE(cache.checkAndRemember(empty));
+    TEST_ASSERT_EQUAL_UINT32(duplicates, cache.getDuplicateCount());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_same_id_is_duplicate);
+    RUN_TEST(test_no_id_copies_arriving_apart_collapse);
+    RUN_TEST(test_nothing_to_key_on_never_deduped);
+    return UNITY_END();
+}
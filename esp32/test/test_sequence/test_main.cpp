@@ -0,0 +1,165 @@
+// SequenceTracker: the window past the last contiguous number, holes
+// and when they are asked for, prev_seq and epochs (sequence_tracker.h)
+
+#include <unity.h>
+#include "sequence_tracker.h"
+
+static SequenceTracker tracker;
+
+// Registered with a box on epoch 1, nothing received yet. The clock
+// starts past 0, which the tracker reads as "no hole"
+void setUp() {
+    mockResetClock();
+    mockAdvanceMillis(1);
+    tracker = SequenceTracker();
+    tracker.onRegistered(1, 0);
+}
+
+void tearDown() {}
+
+static void receive(uint32_t seq, uint32_t prevSeq = 0) {
+    tracker.onReceived(seq, prevSeq);
+}
+
+static void assertNoGap() {
+    uint32_t from, to;
+    mockAdvanceMillis(SEQ_GAP_GRACE);
+    TEST_ASSERT_FALSE(tracker.takeGap(from, to));
+}
+
+static void test_in_order() {
+    receive(1);
+    receive(2);
+    receive(3);
+    receive(2);   // The other link's copy
+
+    TEST_ASSERT_EQUAL_UINT32(3, tracker.getLastContiguous());
+    assertNoGap();
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getResyncs());
+}
+
+static void test_unregistered_ignored() {
+    tracker = SequenceTracker();
+    receive(5);
+
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getEpoch());
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getLastContiguous());
+    assertNoGap();
+}
+
+static void test_hole_filled_within_grace() {
+    receive(1);
+    receive(3);
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getLastContiguous());
+
+    // WS and BLE may deliver out of order: not asked for yet
+    uint32_t from, to;
+    mockAdvanceMillis(SEQ_GAP_GRACE - 1);
+    TEST_ASSERT_FALSE(tracker.takeGap(from, to));
+
+    receive(2);
+    TEST_ASSERT_EQUAL_UINT32(3, tracker.getLastContiguous());
+    assertNoGap();
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getLost());
+}
+
+static void test_hole_times_out_into_resync() {
+    receive(1);
+    receive(4);
+
+    uint32_t from, to;
+    mockAdvanceMillis(SEQ_GAP_GRACE);
+    TEST_ASSERT_TRUE(tracker.takeGap(from, to));
+    TEST_ASSERT_EQUAL_UINT32(2, from);
+    TEST_ASSERT_EQUAL_UINT32(3, to);
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getResyncs());
+
+    // Asked once per SEQ_RESYNC_RETRY while unanswered
+    TEST_ASSERT_FALSE(tracker.takeGap(from, to));
+    mockAdvanceMillis(SEQ_RESYNC_RETRY);
+    TEST_ASSERT_TRUE(tracker.takeGap(from, to));
+    TEST_ASSERT_EQUAL_UINT32(2, tracker.getResyncs());
+
+    // The box resent 2 and had nothing left of 3
+    receive(2);
+    tracker.onResynced(3);
+    TEST_ASSERT_EQUAL_UINT32(4, tracker.getLastContiguous());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getLost());
+    assertNoGap();
+}
+
+static void test_gap_wider_than_window() {
+    receive(1);
+    receive(1 + 100);
+
+    // Only the last SEQ_WINDOW numbers can still be resent: the rest is lost
+    uint32_t skipped = 101 - SEQ_WINDOW;
+    TEST_ASSERT_EQUAL_UINT32(skipped, tracker.getLastContiguous());
+    TEST_ASSERT_EQUAL_UINT32(skipped - 1, tracker.getLost());
+
+    uint32_t from, to;
+    mockAdvanceMillis(SEQ_GAP_GRACE);
+    TEST_ASSERT_TRUE(tracker.takeGap(from, to));
+    TEST_ASSERT_EQUAL_UINT32(skipped + 1, from);
+    TEST_ASSERT_EQUAL_UINT32(100, to);
+}
+
+static void test_prev_seq_skips_filtered() {
+    // 2-4 went to other watches
+    receive(1);
+    receive(5, 1);
+    TEST_ASSERT_EQUAL_UINT32(5, tracker.getLastContiguous());
+    assertNoGap();
+
+    // 7 went elsewhere, but 6 (ours) is missing
+    receive(8, 6);
+    TEST_ASSERT_EQUAL_UINT32(5, tracker.getLastContiguous());
+
+    uint32_t from, to;
+    mockAdvanceMillis(SEQ_GAP_GRACE);
+    TEST_ASSERT_TRUE(tracker.takeGap(from, to));
+    TEST_ASSERT_EQUAL_UINT32(6, from);
+    TEST_ASSERT_EQUAL_UINT32(6, to);
+
+    receive(6);
+    TEST_ASSERT_EQUAL_UINT32(8, tracker.getLastContiguous());
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getLost());
+}
+
+static void test_epoch_change_starts_over() {
+    receive(1);
+    receive(3);
+
+    // The box restarted: its numbers start over, the old hole is moot
+    tracker.onRegistered(2, 10);
+    TEST_ASSERT_EQUAL_UINT32(2, tracker.getEpoch());
+    TEST_ASSERT_EQUAL_UINT32(10, tracker.getLastContiguous());
+    assertNoGap();
+
+    receive(11);
+    TEST_ASSERT_EQUAL_UINT32(11, tracker.getLastContiguous());
+}
+
+static void test_same_epoch_resumes_past_hole() {
+    receive(1);
+    receive(3);
+
+    // Reconnect: the box has nothing left below 5 to replay
+    tracker.onRegistered(1, 5);
+    TEST_ASSERT_EQUAL_UINT32(5, tracker.getLastContiguous());
+    TEST_ASSERT_EQUAL_UINT32(3, tracker.getLost());   // 2, 4 and 5
+    assertNoGap();
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_in_order);
+    RUN_TEST(test_unregistered_ignored);
+    RUN_TEST(test_hole_filled_within_grace);
+    RUN_TEST(test_hole_times_out_into_resync);
+    RUN_TEST(test_gap_wider_than_window);
+    RUN_TEST(test_prev_seq_skips_filtered);
+    RUN_TEST(test_epoch_change_starts_over);
+    RUN_TEST(test_same_epoch_resumes_past_hole);
+    return UNITY_END();
+}
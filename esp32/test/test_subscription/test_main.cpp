@@ -0,0 +1,154 @@
+// SubscriptionFilter: parsing the portal's zone / table lists, the
+// register "filter" object and the local accept() (subscription_filter.h)
+
+#include <unity.h>
+#include <ArduinoJson.h>
+#include "subscription_filter.h"
+
+static SubscriptionFilter filter;
+static DeviceConfig config;
+
+static void load(const char* zones, const char* tables, uint8_t alerts = 0,
+                 uint8_t minPriority = PRIORITY_LOW) {
+    memset(&config, 0, sizeof(config));
+    strncpy(config.filter_zones, zones, sizeof(config.filter_zones) - 1);
+    strncpy(config.filter_tables, tables, sizeof(config.filter_tables) - 1);
+    config.filter_alerts = alerts;
+    config.filter_min_priority = minPriority;
+    filter.load(config);
+}
+
+static NotificationData make(const char* table, const char* type = "waiter_called",
+                             const char* priority = "medium") {
+    NotificationData notif;
+    memset(&notif, 0, sizeof(notif));
+    strncpy(notif.table, table, sizeof(notif.table) - 1);
+    strncpy(notif.type, type, sizeof(notif.type) - 1);
+    strncpy(notif.priority, priority, sizeof(notif.priority) - 1);
+    return notif;
+}
+
+static void written(JsonDocument& doc) {
+    doc.clear();
+    filter.writeJson(doc.to<JsonObject>());
+}
+
+void setUp() {
+    load("", "");
+}
+
+void tearDown() {}
+
+static void test_empty_takes_everything() {
+    TEST_ASSERT_TRUE(filter.isEmpty());
+    TEST_ASSERT_TRUE(filter.accept(make("T12", "bill_ready", "low")));
+    TEST_ASSERT_TRUE(filter.accept(make("")));
+
+    JsonDocument doc;
+    written(doc);
+    TEST_ASSERT_EQUAL(0, doc.size());
+}
+
+static void test_table_ranges_parsed() {
+    load("", "1-12, 20");
+
+    JsonDocument doc;
+    written(doc);
+    TEST_ASSERT_EQUAL(2, doc["tables"].size());
+    TEST_ASSERT_EQUAL(1, doc["tables"][0][0]);
+    TEST_ASSERT_EQUAL(12, doc["tables"][0][1]);
+    TEST_ASSERT_EQUAL(20, doc["tables"][1][0]);
+    TEST_ASSERT_EQUAL(20, doc["tables"][1][1]);
+    TEST_ASSERT_FALSE(doc["zones"].is<JsonArray>());
+
+    TEST_ASSERT_TRUE(filter.accept(make("1")));
+    TEST_ASSERT_TRUE(filter.accept(make("T12")));
+    TEST_ASSERT_TRUE(filter.accept(make("20")));
+    TEST_ASSERT_FALSE(filter.accept(make("13")));
+    TEST_ASSERT_FALSE(filter.accept(make("Barra")));   // No number
+}
+
+static void test_bad_ranges_skipped() {
+    load("", "5-3, x, 7 - 9");
+
+    JsonDocument doc;
+    written(doc);
+    TEST_ASSERT_EQUAL(1, doc["tables"].size());
+    TEST_ASSERT_EQUAL(7, doc["tables"][0][0]);
+    TEST_ASSERT_EQUAL(9, doc["tables"][0][1]);
+}
+
+static void test_zones_trimmed_and_lowered() {
+    load(", T ,B", "");
+
+    JsonDocument doc;
+    written(doc);
+    TEST_ASSERT_EQUAL(2, doc["zones"].size());
+    TEST_ASSERT_EQUAL_STRING("t", doc["zones"][0] | "");
+    TEST_ASSERT_EQUAL_STRING("b", doc["zones"][1] | "");
+
+    TEST_ASSERT_TRUE(filter.accept(make("T12")));
+    TEST_ASSERT_TRUE(filter.accept(make("b-3")));
+    TEST_ASSERT_FALSE(filter.accept(make("Terraza 3")));
+    TEST_ASSERT_FALSE(filter.accept(make("12")));   // Zone "" is not "t"
+}
+
+static void test_long_zone_sent_whole() {
+    load("Terraza Principal", "");
+
+    JsonDocument doc;
+    written(doc);
+    TEST_ASSERT_EQUAL_STRING("terraza principal", doc["zones"][0] | "");
+
+    TEST_ASSERT_FALSE(filter.accept(make("Terraza 3")));
+
+    // "Terraza Principal 3" only fits NotificationData.table in part
+    TEST_ASSERT_TRUE(filter.accept(make("Terraza Principal 3")));
+}
+
+static void test_zone_and_range_both_match() {
+    load("T", "1-5");
+
+    TEST_ASSERT_TRUE(filter.accept(make("T3")));
+    TEST_ASSERT_FALSE(filter.accept(make("T9")));
+    TEST_ASSERT_FALSE(filter.accept(make("B3")));
+}
+
+static void test_alert_types_and_priority() {
+    load("", "", SUB_ALERT_WAITER_CALLED | SUB_ALERT_URGENT, PRIORITY_HIGH);
+
+    JsonDocument doc;
+    written(doc);
+    TEST_ASSERT_EQUAL(2, doc["alerts"].size());
+    TEST_ASSERT_EQUAL_STRING("waiter_called", doc["alerts"][0] | "");
+    TEST_ASSERT_EQUAL_STRING("urgent", doc["alerts"][1] | "");
+    TEST_ASSERT_EQUAL_STRING("high", doc["min_priority"] | "");
+
+    TEST_ASSERT_TRUE(filter.accept(make("1", "waiter_called", "high")));
+    TEST_ASSERT_TRUE(filter.accept(make("1", "urgent", "urgent")));
+    TEST_ASSERT_FALSE(filter.accept(make("1", "bill_ready", "high")));
+    TEST_ASSERT_FALSE(filter.accept(make("1", "waiter_called", "medium")));
+}
+
+static void test_rejections_counted() {
+    load("T", "");
+    unsigned long filtered = filter.getFiltered();
+
+    filter.accept(make("T1"));
+    filter.accept(make("B1"));
+    filter.accept(make("B2"));
+    TEST_ASSERT_EQUAL_UINT32(filtered + 2, filter.getFiltered());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_takes_everything);
+    RUN_TEST(test_table_ranges_parsed);
+    RUN_TEST(test_bad_ranges_skipped);
+    RUN_TEST(test_zones_trimmed_and_lowered);
+    RUN_TEST(test_long_zone_sent_whole);
+    RUN_TEST(test_zone_and_range_both_match);
+    RUN_TEST(test_alert_types_and_priority);
+    RUN_TEST(test_rejections_counted);
+    return UNITY_END();
+}
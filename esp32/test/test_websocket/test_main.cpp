@@ -0,0 +1,296 @@
+// WebSocket client: register, notification parsing over JSON and bpw1,
+// the parse filter, the ack batches and the heartbeat's size
+// (websocket_client.h)
+
+#include <unity.h>
+#include <ArduinoJson.h>
+#include "fixtures.h"
+#include "websocket_client.h"
+#include "storage.h"
+#include "metrics.h"
+#include "boot_timeline.h"
+
+#define BOX_HOST "192.168.1.50"
+#define BOX_PORT 3334
+
+static WebSocketsClient* socket = nullptr;
+
+// The last frame of `type` the watch sent, parsed into `doc`
+static bool findSent(const char* type, JsonDocument& doc) {
+    for (auto it = socket->sentText.rbegin(); it != socket->sentText.rend(); ++it) {
+        if (deserializeJson(doc, it->c_str()) == DeserializationError::Ok &&
+            strcmp(doc["type"] | "", type) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Exactly one notification reached the inbox; returns it (the caller releases it)
+static InboxItem* takeOnly() {
+    InboxItem* item = Events.takeNotification();
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_NULL(Events.takeNotification());
+    return item;
+}
+
+void setUp() {
+    // Flush what the previous test left: pending acks and inbox slots
+    mockAdvanceMillis(ACK_BATCH_INTERVAL);
+    WsClient.loop();
+    drainInbox();
+    socket->sentText.clear();
+    socket->sentBinary.clear();
+}
+
+void tearDown() {}
+
+static void test_register_sent_on_connect() {
+    socket->receive(WStype_DISCONNECTED);
+    socket->receive(WStype_CONNECTED, "/", 1);
+
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(findSent("register", doc));
+    TEST_ASSERT_EQUAL_STRING(Storage.getDeviceId().c_str(), doc["device_id"] | "");
+    TEST_ASSERT_EQUAL_STRING(FIRMWARE_VERSION, doc["firmware"] | "");
+    TEST_ASSERT_EQUAL_STRING(WIRE_PROTOCOL_NAME, doc["wire"] | "");
+    TEST_ASSERT_TRUE(doc["client_time"].is<uint32_t>());
+    TEST_ASSERT_TRUE(doc["name"].is<const char*>());
+}
+
+// Past the next heartbeat, with the box answering the ping probe
+static void heartbeatTick() {
+    mockAdvanceMillis(20001);
+    WsClient.loop();
+    socket->receive(WStype_PONG);
+}
+
+// Every number at its widest, so the digits are the worst case too
+static void widenNumbers(JsonVariant value) {
+    if (value.is<JsonObject>()) {
+        for (JsonPair member : value.as<JsonObject>()) widenNumbers(member.value());
+    } else if (value.is<JsonArray>()) {
+        for (JsonVariant item : value.as<JsonArray>()) widenNumbers(item);
+    } else if (value.is<bool>()) {
+        return;
+    } else if (value.is<int32_t>() && value.as<int32_t>() < 0) {
+        value.set(INT32_MIN);
+    } else if (value.is<uint32_t>()) {
+        value.set(UINT32_MAX);
+    }
+}
+
+static void test_boot_timeline_resent_until_delivered() {
+    for (uint8_t i = 0; i < BOOT_STAGE_COUNT; i++) Boot.mark((BootStage)i);
+
+    // The socket refuses the first heartbeat
+    socket->connected = false;
+    heartbeatTick();
+    socket->connected = true;
+
+    heartbeatTick();
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(findSent("heartbeat", doc));
+    TEST_ASSERT_TRUE(doc["boot"].is<JsonObject>());
+
+    // Once only
+    socket->sentText.clear();
+    heartbeatTick();
+    TEST_ASSERT_TRUE(findSent("heartbeat", doc));
+    TEST_ASSERT_FALSE(doc["boot"].is<JsonObject>());
+}
+
+static void test_worst_case_heartbeat_fits() {
+    // All loop times ("both" mode included) and a full piggyback of acks
+    for (uint8_t i = 0; i < LOOP_COUNT; i++) Metrics.lap((MetricLoop)i, micros());
+
+    char frame[128];
+    for (uint8_t i = 0; i < ACK_PIGGYBACK_MAX; i++) {
+        snprintf(frame, sizeof(frame),
+                 "{\"type\":\"notification\",\"id\":\"%047u\",\"table\":\"1\"}", i);
+        socket->receiveText(frame);
+    }
+    drainInbox();
+
+    heartbeatTick();
+
+    // Dropped as too large otherwise
+    JsonDocument sent;
+    TEST_ASSERT_TRUE(findSent("heartbeat", sent));
+    TEST_ASSERT_EQUAL(LOOP_COUNT, sent["metrics"]["loop"].size());
+    TEST_ASSERT_EQUAL(ACK_PIGGYBACK_MAX, sent["acks"].size());
+
+    // Plus the first heartbeat's boot timeline and what an update in
+    // progress adds, every string copied rather than linked, in an arena
+    // of the size the client uses
+    Boot.writeJson(sent["boot"].to<JsonObject>());
+    widenNumbers(sent.as<JsonVariant>());
+    JsonObject ota = sent["ota"];
+    ota["version"] = "xxxxxxxxxxxxxxx";   // OTA_VERSION_LEN - 1 characters
+    ota["done"] = UINT32_MAX;
+    ota["total"] = UINT32_MAX;
+    ota["error"] = "bad_offer";
+    ota["verifying"] = true;
+    ota["rolled_back"] = true;
+
+    static StaticJsonArena<WS_TX_ARENA_SIZE> arena;
+    JsonDocument worst(&arena);
+    worst.set(sent);
+    TEST_ASSERT_FALSE(worst.overflowed());
+    TEST_ASSERT_LESS_THAN(WS_TX_BUFFER_SIZE, measureJson(worst));
+}
+
+static void test_json_notification_fields() {
+    socket->receiveText(SAMPLE_JSON);
+
+    InboxItem* item = takeOnly();
+    TEST_ASSERT_EQUAL(SOURCE_WEBSOCKET, item->source);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, item->data.id);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_TABLE, item->data.table);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ALERT, item->data.type);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, item->data.message);
+    TEST_ASSERT_EQUAL_STRING("high", item->data.priority);
+    TEST_ASSERT_TRUE(item->data.timestamp == SAMPLE_TIMESTAMP);
+    TEST_ASSERT_EQUAL_UINT32(7, item->seq);
+    TEST_ASSERT_EQUAL_UINT32(6, item->prevSeq);
+    Events.releaseNotification(item);
+}
+
+static void test_json_notification_defaults() {
+    mockAdvanceMillis(1000);
+    socket->receiveText("{\"type\":\"notification\",\"id\":\"n-2\",\"table\":\"4\",\"alert\":\"bill_ready\"}");
+
+    InboxItem* item = takeOnly();
+    TEST_ASSERT_EQUAL_STRING("n-2", item->data.id);
+    TEST_ASSERT_EQUAL_STRING("", item->data.message);
+    TEST_ASSERT_EQUAL_STRING("medium", item->data.priority);
+    TEST_ASSERT_TRUE(item->data.timestamp == 0);   // No box time
+    TEST_ASSERT_EQUAL_UINT32(0, item->seq);
+    Events.releaseNotification(item);
+}
+
+static void test_filter_skips_unknown_keys() {
+    // Far more than the RX arena holds unfiltered: parses only because
+    // the filter drops "extra" while reading
+    std::string frame = "{\"type\":\"notification\",\"id\":\"n-3\",\"table\":\"9\",\"extra\":[";
+    for (int i = 0; i < 400; i++) {
+        frame += (i ? ",\"" : "\"") + std::to_string(i) + "\"";
+    }
+    frame += "],\"alert\":\"urgent\"}";
+    TEST_ASSERT_GREATER_THAN(WS_RX_ARENA_SIZE, frame.size());
+
+    uint32_t errors = Metrics.get(METRIC_JSON_ERRORS);
+    socket->receiveText(frame.c_str());
+
+    InboxItem* item = takeOnly();
+    TEST_ASSERT_EQUAL_STRING("n-3", item->data.id);
+    TEST_ASSERT_EQUAL_STRING("9", item->data.table);
+    TEST_ASSERT_EQUAL_STRING("urgent", item->data.type);
+    TEST_ASSERT_EQUAL_UINT32(errors, Metrics.get(METRIC_JSON_ERRORS));
+    Events.releaseNotification(item);
+}
+
+static void test_malformed_json_counted() {
+    uint32_t errors = Metrics.get(METRIC_JSON_ERRORS);
+    socket->receiveText("{\"type\":\"notification\",\"id\":");
+
+    TEST_ASSERT_EQUAL_UINT32(errors + 1, Metrics.get(METRIC_JSON_ERRORS));
+    TEST_ASSERT_EQUAL(0, drainInbox());
+}
+
+static void test_binary_wire_negotiated() {
+    socket->receiveText("{\"type\":\"registered\",\"wire\":\"" WIRE_PROTOCOL_NAME "\"}");
+    TEST_ASSERT_TRUE(WsClient.isBinaryWire());
+
+    // Every register renegotiates it
+    socket->receive(WStype_DISCONNECTED);
+    socket->receive(WStype_CONNECTED, "/", 1);
+    TEST_ASSERT_FALSE(WsClient.isBinaryWire());
+
+    socket->receiveText("{\"type\":\"registered\"}");
+    TEST_ASSERT_FALSE(WsClient.isBinaryWire());
+}
+
+static void test_ping_answered() {
+    socket->receiveText("{\"type\":\"ping\"}");
+
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(findSent("pong", doc));
+    TEST_ASSERT_EQUAL_STRING(Storage.getDeviceId().c_str(), doc["device_id"] | "");
+}
+
+static void test_binary_notification_fields() {
+    WireBuilder frame;
+    frame.sample().u32(WIRE_TAG_SEQ, 41).u32(WIRE_TAG_PREV_SEQ, 39);
+    socket->receive(WStype_BIN, frame.data(), frame.length());
+
+    InboxItem* item = takeOnly();
+    TEST_ASSERT_EQUAL(SOURCE_WEBSOCKET, item->source);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, item->data.id);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_TABLE, item->data.table);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ALERT, item->data.type);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, item->data.message);
+    TEST_ASSERT_EQUAL_STRING("high", item->data.priority);
+    TEST_ASSERT_TRUE(item->data.timestamp == SAMPLE_TIMESTAMP);
+    TEST_ASSERT_EQUAL_UINT32(41, item->seq);
+    TEST_ASSERT_EQUAL_UINT32(39, item->prevSeq);
+    Events.releaseNotification(item);
+}
+
+static void test_acks_batched() {
+    socket->receiveText("{\"type\":\"notification\",\"id\":\"a-1\",\"table\":\"1\"}");
+    socket->receiveText("{\"type\":\"notification\",\"id\":\"a-2\",\"table\":\"2\"}");
+    drainInbox();
+
+    // Not a frame per notification
+    WsClient.loop();
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(findSent("acks", doc));
+
+    mockAdvanceMillis(ACK_BATCH_INTERVAL);
+    WsClient.loop();
+    TEST_ASSERT_TRUE(findSent("acks", doc));
+    TEST_ASSERT_EQUAL(2, doc["acks"].size());
+    TEST_ASSERT_EQUAL_STRING("a-1", doc["acks"][0] | "");
+    TEST_ASSERT_EQUAL_STRING("a-2", doc["acks"][1] | "");
+}
+
+static void test_acks_kept_when_send_fails() {
+    socket->receiveText("{\"type\":\"notification\",\"id\":\"a-3\",\"table\":\"3\"}");
+    drainInbox();
+
+    // The socket refuses the frame before the client has heard it closed
+    socket->connected = false;
+    mockAdvanceMillis(ACK_BATCH_INTERVAL);
+    WsClient.loop();
+    socket->connected = true;
+
+    WsClient.loop();
+    JsonDocument doc;
+    TEST_ASSERT_TRUE(findSent("acks", doc));
+    TEST_ASSERT_EQUAL(1, doc["acks"].size());
+    TEST_ASSERT_EQUAL_STRING("a-3", doc["acks"][0] | "");
+}
+
+int main(int argc, char** argv) {
+    Storage.begin();
+    Events.begin();
+    WsClient.begin(BOX_HOST, BOX_PORT);
+    socket = WebSocketsClient::forHost(BOX_HOST);
+    socket->receive(WStype_CONNECTED, "/", 1);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_register_sent_on_connect);
+    RUN_TEST(test_boot_timeline_resent_until_delivered);   // First heartbeats since connect
+    RUN_TEST(test_worst_case_heartbeat_fits);
+    RUN_TEST(test_json_notification_fields);
+    RUN_TEST(test_json_notification_defaults);
+    RUN_TEST(test_filter_skips_unknown_keys);
+    RUN_TEST(test_malformed_json_counted);
+    RUN_TEST(test_binary_wire_negotiated);
+    RUN_TEST(test_ping_answered);
+    RUN_TEST(test_binary_notification_fields);
+    RUN_TEST(test_acks_batched);
+    RUN_TEST(test_acks_kept_when_send_fails);
+    return UNITY_END();
+}
@@ -0,0 +1,180 @@
+// bpw1 decoding (wire_protocol.h) and BLE fragment reassembly (ble_framing.h)
+
+#include <unity.h>
+#include "wire_protocol.h"
+#include "ble_framing.h"
+#include "fixtures.h"
+
+static NotificationData notif;
+
+void setUp() {
+    mockResetClock();
+    memset(&notif, 0xAA, sizeof(notif));   // Decoding must overwrite everything
+}
+
+void tearDown() {}
+
+static void test_decode_sample() {
+    WireBuilder frame;
+    frame.sample().u32(WIRE_TAG_SEQ, 42).u32(WIRE_TAG_PREV_SEQ, 40);
+
+    uint32_t seq = 0, prevSeq = 0;
+    TEST_ASSERT_TRUE(wireIsBinary(frame.data(), frame.length()));
+    TEST_ASSERT_EQUAL_UINT8(WIRE_MSG_NOTIFICATION, wireMessageType(frame.data()));
+    TEST_ASSERT_TRUE(wireDecodeNotification(frame.data(), frame.length(), notif, &seq, &prevSeq));
+
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, notif.id);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_TABLE, notif.table);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ALERT, notif.type);
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_MESSAGE, notif.message);
+    TEST_ASSERT_EQUAL_STRING("high", notif.priority);
+    TEST_ASSERT_TRUE(notif.timestamp == SAMPLE_TIMESTAMP);
+    TEST_ASSERT_EQUAL_UINT32(42, seq);
+    TEST_ASSERT_EQUAL_UINT32(40, prevSeq);
+}
+
+static void test_decode_defaults() {
+    // Only a table: medium priority, local time, no numbering
+    mockAdvanceMillis(1234);
+    WireBuilder frame;
+    frame.str(WIRE_TAG_TABLE, "3");
+
+    uint32_t seq = 99;
+    TEST_ASSERT_TRUE(wireDecodeNotification(frame.data(), frame.length(), notif, &seq));
+    TEST_ASSERT_EQUAL_STRING("", notif.id);
+    TEST_ASSERT_EQUAL_STRING("3", notif.table);
+    TEST_ASSERT_EQUAL_STRING("", notif.type);
+    TEST_ASSERT_EQUAL_STRING("medium", notif.priority);
+    TEST_ASSERT_TRUE(notif.timestamp == 1234);
+    TEST_ASSERT_EQUAL_UINT32(0, seq);
+}
+
+static void test_decode_uuid_id() {
+    const uint8_t raw[16] = {0x0d, 0x6c, 0x9a, 0x8e, 0x5a, 0x43, 0x4a, 0x8e,
+                             0x9f, 0x51, 0x3b, 0x0b, 0x2f, 0x6f, 0x1c, 0x11};
+    WireBuilder frame;
+    frame.raw(WIRE_TAG_ID_UUID, raw, sizeof(raw));
+
+    TEST_ASSERT_TRUE(wireDecodeNotification(frame.data(), frame.length(), notif));
+    TEST_ASSERT_EQUAL_STRING(SAMPLE_ID, notif.id);
+}
+
+static void test_decode_alert_string_and_unknown_tags() {
+    WireBuilder frame;
+    frame.str(0x7E, "from a newer box")
+        .str(WIRE_TAG_ALERT, "custom_alert")
+        .u8(WIRE_TAG_PRIORITY, PRIORITY_URGENT)
+        .u8(0x7F, 1);
+
+    TEST_ASSERT_TRUE(wireDecodeNotification(frame.data(), frame.length(), notif));
+    TEST_ASSERT_EQUAL_STRING("custom_alert", notif.type);
+    TEST_ASSERT_EQUAL_STRING("urgent", notif.priority);
+}
+
+static void test_decode_clamps_long_fields() {
+    char table[40];
+    memset(table, 'T', sizeof(table) - 1);
+    table[sizeof(table) - 1] = '\0';
+    WireBuilder frame;
+    frame.str(WIRE_TAG_TABLE, table);
+
+    TEST_ASSERT_TRUE(wireDecodeNotification(frame.data(), frame.length(), notif));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(notif.table) - 1, strlen(notif.table));
+}
+
+static void test_decode_rejects_malformed() {
+    WireBuilder frame;
+    frame.sample();
+
+    // Last field runs past the end
+    TEST_ASSERT_FALSE(wireDecodeNotification(frame.data(), frame.length() - 1, notif));
+
+    // Wrong version, wrong type, no magic
+    frame.data()[1] = WIRE_VERSION + 1;
+    TEST_ASSERT_FALSE(wireDecodeNotification(frame.data(), frame.length(), notif));
+    frame.data()[1] = WIRE_VERSION;
+    frame.data()[2] = WIRE_MSG_OTA_CHUNK;
+    TEST_ASSERT_FALSE(wireDecodeNotification(frame.data(), frame.length(), notif));
+
+    const char json[] = "{\"type\":\"notification\"}";
+    TEST_ASSERT_FALSE(wireIsBinary((const uint8_t*)json, strlen(json)));
+}
+
+static void test_decode_ota_chunk() {
+    uint8_t frame[WIRE_OTA_HEADER_SIZE + 4] = {WIRE_MAGIC, WIRE_VERSION, WIRE_MSG_OTA_CHUNK,
+                                                0x00, 0x10, 0x02, 0x00, 0xE9, 0x01, 0x02, 0x03};
+    uint32_t offset;
+    const uint8_t* chunk;
+    size_t chunkLength;
+
+    TEST_ASSERT_TRUE(wireDecodeOtaChunk(frame, sizeof(frame), offset, chunk, chunkLength));
+    TEST_ASSERT_EQUAL_UINT32(0x21000, offset);
+    TEST_ASSERT_EQUAL_UINT32(4, chunkLength);
+    TEST_ASSERT_EQUAL_HEX8(0xE9, chunk[0]);
+
+    // A header with no data is not a chunk
+    TEST_ASSERT_FALSE(wireDecodeOtaChunk(frame, WIRE_OTA_HEADER_SIZE, offset, chunk, chunkLength));
+}
+
+// ============================================
+// Reassembly
+// ============================================
+
+static void test_reassemble_in_order() {
+    BleReassembler reassembler;
+    const char* message = SAMPLE_JSON;
+    size_t total = strlen(message);
+    size_t chunk = 16;   // Default MTU: 20-byte values less the header
+    uint8_t count = (total + chunk - 1) / chunk;
+
+    uint8_t packet[32];
+    for (uint8_t i = 0; i < count; i++) {
+        size_t len = min(chunk, total - i * chunk);
+        size_t n = bleFragment(packet, 5, i, count, message + i * chunk, len);
+        BleFrameResult result = reassembler.feed(packet, n);
+        TEST_ASSERT_EQUAL(i + 1 < count ? BLE_FRAME_PENDING : BLE_FRAME_COMPLETE, result);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(total, reassembler.length());
+    TEST_ASSERT_EQUAL_MEMORY(message, reassembler.data(), total);
+    TEST_ASSERT_EQUAL_UINT32(1, reassembler.getCompletedCount());
+}
+
+static void test_reassemble_passes_unframed() {
+    BleReassembler reassembler;
+    WireBuilder frame;
+    frame.sample();
+    TEST_ASSERT_EQUAL(BLE_FRAME_UNFRAMED, reassembler.feed(frame.data(), frame.length()));
+}
+
+static void test_reassemble_drops_gap_and_timeout() {
+    BleReassembler reassembler;
+    uint8_t packet[32];
+
+    // Fragment 1 lost: 2 is out of sequence
+    reassembler.feed(packet, bleFragment(packet, 1, 0, 3, "aaaa", 4));
+    TEST_ASSERT_EQUAL(BLE_FRAME_DROPPED, reassembler.feed(packet, bleFragment(packet, 1, 2, 3, "cccc", 4)));
+    TEST_ASSERT_EQUAL_UINT32(1, reassembler.getDroppedCount());
+
+    // The rest of a message that went stale
+    reassembler.feed(packet, bleFragment(packet, 2, 0, 2, "aaaa", 4));
+    mockAdvanceMillis(BLE_REASSEMBLY_TIMEOUT + 1);
+    TEST_ASSERT_EQUAL(BLE_FRAME_DROPPED, reassembler.feed(packet, bleFragment(packet, 2, 1, 2, "bbbb", 4)));
+    TEST_ASSERT_EQUAL_UINT32(2, reassembler.getDroppedCount());
+    TEST_ASSERT_EQUAL_UINT32(0, reassembler.getCompletedCount());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_decode_sample);
+    RUN_TEST(test_decode_defaults);
+    RUN_TEST(test_decode_uuid_id);
+    RUN_TEST(test_decode_alert_string_and_unknown_tags);
+    RUN_TEST(test_decode_clamps_long_fields);
+    RUN_TEST(test_decode_rejects_malformed);
+    RUN_TEST(test_decode_ota_chunk);
+    RUN_TEST(test_reassemble_in_order);
+    RUN_TEST(test_reassemble_passes_unframed);
+    RUN_TEST(test_reassemble_drops_gap_and_timeout);
+    return UNITY_END();
+}
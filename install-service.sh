@@ -26,32 +26,40 @@ echo "Install directory: $INSTALL_DIR"
 echo ""
 
 # Build the project first
-echo "[1/6] Building project..."
+echo "[1/7] Building project..."
 cd "$INSTALL_DIR"
 sudo -u $ACTUAL_USER npm run build
 
 # Update service file with correct user
-echo "[2/6] Configuring service file..."
+echo "[2/7] Configuring service file..."
 sed -i "s/User=admin1/User=$ACTUAL_USER/" bitsperbox.service
 sed -i "s/Group=admin1/Group=$ACTUAL_USER/" bitsperbox.service
 sed -i "s|/home/admin1|$HOME_DIR|g" bitsperbox.service
 
 # Copy service file
-echo "[3/6] Installing systemd service..."
+echo "[3/7] Installing systemd service..."
 cp bitsperbox.service /etc/systemd/system/bitsperbox.service
 
 # Add user to required groups
-echo "[4/6] Adding user to hardware groups..."
+echo "[4/7] Adding user to hardware groups..."
 usermod -aG dialout,bluetooth,lp $ACTUAL_USER 2>/dev/null || true
 
 # Reload systemd
-echo "[5/6] Reloading systemd..."
+echo "[5/7] Reloading systemd..."
 systemctl daemon-reload
 
 # Enable and start service
-echo "[6/6] Enabling service..."
+echo "[6/7] Enabling service..."
 systemctl enable bitsperbox.service
 
+# Advertise the watch WebSocket over mDNS (BitsperWatch finds the box by it)
+echo "[7/7] Publishing mDNS service..."
+if [ -d /etc/avahi/services ]; then
+  cp bitsperbox.avahi.service /etc/avahi/services/bitsperbox.service
+else
+  echo "  avahi-daemon not installed, watches need the box IP configured"
+fi
+
 echo ""
 echo "========================================="
 echo "  Installation Complete!"
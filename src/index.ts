@@ -19,11 +19,17 @@ import { DashboardSync } from './services/DashboardSync.js'
 import { WebServer } from './web/server.js'
 import { notificationBroadcaster } from './managers/NotificationBroadcaster.js'
 import { bleBroadcaster } from './managers/BLEBroadcaster.js'
+import { loadFirmwareImage } from './utils/firmwareRollout.js'
 
 const VERSION = '1.2.0' // Added ESP32 notification support
 const WEB_PORT = parseInt(process.env.WEB_PORT || '3333')
 const ESP32_WS_PORT = parseInt(process.env.ESP32_WS_PORT || '3334')
 
+// Watch firmware to roll out over WiFi (the PlatformIO firmware.bin and its FIRMWARE_VERSION)
+const WATCH_FIRMWARE = process.env.WATCH_FIRMWARE
+const WATCH_FIRMWARE_VERSION = process.env.WATCH_FIRMWARE_VERSION
+const WATCH_ROLLOUT_WAVE = parseInt(process.env.WATCH_ROLLOUT_WAVE || '2')
+
 async function main() {
   // Display banner
   console.log('')
@@ -209,6 +215,14 @@ async function main() {
     notificationBroadcaster.on('deviceDisconnected', (deviceId) => {
       logger.info(`📱 ESP32 disconnected (WiFi): ${deviceId}`)
     })
+
+    if (WATCH_FIRMWARE && WATCH_FIRMWARE_VERSION) {
+      try {
+        notificationBroadcaster.startRollout(loadFirmwareImage(WATCH_FIRMWARE, WATCH_FIRMWARE_VERSION), WATCH_ROLLOUT_WAVE)
+      } catch (error) {
+        logger.warn('Watch firmware rollout not started:', error)
+      }
+    }
   } catch (error) {
     logger.warn('ESP32 WebSocket server failed to start:', error)
     logger.info('ESP32 WiFi notifications will not be available')
@@ -0,0 +1,83 @@
+/**
+ * BLEBroadcaster: registered devices are dropped with their link, so
+ * the fragment/binary/MTU gates and the subscription check only count
+ * watches still connected.
+ *
+ * Run with `npm test` (no adapter needed: bleno's events are fed in).
+ */
+
+import { test } from 'node:test';
+import assert from 'node:assert/strict';
+import { BLEBroadcaster } from './BLEBroadcaster.js';
+import { WIRE_PROTOCOL_NAME } from '../utils/wireProtocol.js';
+
+const LEGACY_ADDRESS = 'a4:cf:12:00:00:01';
+const CURRENT_ADDRESS = 'a4:cf:12:00:00:02';
+
+// A broadcaster with one subscriber that records what it is sent
+function createBroadcaster(): { ble: any; sent: Buffer[] } {
+    const ble: any = new BLEBroadcaster();
+    const sent: Buffer[] = [];
+    ble.blenoLoaded = true;
+    ble.subscriptions.set((packet: Buffer) => sent.push(packet), 512);
+    return { ble, sent };
+}
+
+function connect(ble: any, address: string, register: object): void {
+    ble.handleAccept(address);
+    ble.handleMessage({ type: 'register', ...register });
+}
+
+function alert(table: string, message = 'Mesa solicita atención') {
+    return { table, alert: 'waiter_called', message, priority: 'high', timestamp: Date.now() };
+}
+
+test('a disconnected device no longer holds back the gates', () => {
+    const { ble, sent } = createBroadcaster();
+    const disconnected: string[] = [];
+    ble.on('deviceDisconnected', (deviceId: string) => disconnected.push(deviceId));
+
+    // Old firmware: JSON only, whole frames, everything
+    connect(ble, LEGACY_ADDRESS, { device_id: 'legacy', name: 'Old watch', mtu: 23 });
+    // Current firmware: bpw1, fragments, tables 5-5 only
+    connect(ble, CURRENT_ADDRESS, {
+        device_id: 'current', name: 'New watch', wire: WIRE_PROTOCOL_NAME,
+        mtu: 185, frag: 1, filter: { tables: [[5, 5]] }
+    });
+    assert.equal(ble.getDeviceCount(), 2);
+
+    sent.length = 0;
+    ble.broadcast(alert('9'));
+    assert.equal(sent.length, 1);
+    assert.equal(sent[0][0], '{'.charCodeAt(0));   // Whole JSON for the legacy watch
+
+    ble.handleDisconnect(LEGACY_ADDRESS);
+    assert.equal(ble.getDeviceCount(), 1);
+    assert.deepEqual(disconnected, ['legacy']);
+
+    // Nobody left wants table 9
+    sent.length = 0;
+    ble.broadcast(alert('9'));
+    assert.equal(sent.length, 0);
+
+    // Binary, fragmented to the remaining watch's MTU
+    ble.broadcast(alert('5', 'x'.repeat(240)));
+    assert.ok(sent.length > 1);
+    for (const packet of sent) {
+        assert.equal(packet[0], 0xf5);
+        assert.ok(packet.length <= 185 - 3);
+    }
+    assert.equal(sent[0][4], 0xb7);   // bpw1 magic after the fragment header
+});
+
+test('a disconnect only drops the devices of that link', () => {
+    const { ble } = createBroadcaster();
+    connect(ble, LEGACY_ADDRESS, { device_id: 'legacy', mtu: 23 });
+    connect(ble, CURRENT_ADDRESS, { device_id: 'current', mtu: 185, frag: 1 });
+
+    ble.handleDisconnect('a4:cf:12:00:00:99');
+    assert.equal(ble.getDeviceCount(), 2);
+
+    ble.handleDisconnect(CURRENT_ADDRESS);
+    assert.deepEqual(ble.getConnectedDevices().map((d: any) => d.deviceId), ['legacy']);
+});
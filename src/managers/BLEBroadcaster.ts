@@ -9,17 +9,32 @@
 
 import { EventEmitter } from 'events';
 import { logger } from '../utils/logger.js';
+import { encodeNotification, supportsBinaryWire } from '../utils/wireProtocol.js';
+import { parseAckBatch } from '../utils/ackBatch.js';
+import { notificationJournal } from '../utils/notificationJournal.js';
+import { SubscriptionFilter, FilterableNotification, parseSubscriptionFilter, matchesFilter, describeFilter } from '../utils/subscriptionFilter.js';
 
 // BLE UUIDs - must match ESP32 client
 const SERVICE_UUID = '4fafc2011fb5459e8fccc5c9c331914b';  // No hyphens for bleno
 const NOTIFY_CHAR_UUID = 'beb5483e36e14688b7f5ea07361b26a8';
 const REGISTER_CHAR_UUID = 'beb5483e36e14688b7f5ea07361b26a9';
 
+// Fragment framing for messages larger than one notification
+// (must match esp32/src/ble_framing.h)
+const FRAG_MARKER = 0xf5;
+const FRAG_HEADER_SIZE = 4;
+const MAX_ATT_MTU = 517;
+
 interface BLEDevice {
     deviceId: string;
     name: string;
     connectedAt: Date;
     lastActivity: Date;
+    binaryWire: boolean;  // Device accepts bpw1 binary notifications
+    mtu: number | null;   // ATT MTU the device reported on register (null = legacy, unknown)
+    fragments: boolean;   // Announced `frag`: reassembles 0xF5 fragments
+    filter: SubscriptionFilter | null;  // Declared on register; null = everything
+    address: string | null;  // Link it registered over, pruned on that link's disconnect
 }
 
 interface NotificationPayload {
@@ -29,6 +44,8 @@ interface NotificationPayload {
     message: string;
     priority: string;
     timestamp: number;
+    seq?: number;  // Journal sequence (see utils/notificationJournal.ts)
+    prev_seq?: number;  // Previous sequence sent over BLE, when filtered
 }
 
 interface DeviceInfo {
@@ -44,8 +61,10 @@ export class BLEBroadcaster extends EventEmitter {
     private notifyCharacteristic: any = null;
     private devices: Map<string, BLEDevice> = new Map();
     private isAdvertising: boolean = false;
-    private subscriptions: Set<any> = new Set();
+    private subscriptions: Map<any, number> = new Map();  // callback -> max value size
+    private fragmentSeq: number = 0;
     private blenoLoaded: boolean = false;
+    private clientAddress: string | null = null;  // Last accepted link (writes don't say theirs)
 
     constructor() {
         super();
@@ -90,14 +109,8 @@ export class BLEBroadcaster extends EventEmitter {
                 this.setupServices();
             });
 
-            this.bleno.on('accept', (clientAddress: string) => {
-                logger.info(`[BLE] Client connected: ${clientAddress}`);
-            });
-
-            this.bleno.on('disconnect', (clientAddress: string) => {
-                logger.info(`[BLE] Client disconnected: ${clientAddress}`);
-                // Note: We can't directly map clientAddress to deviceId without registration
-            });
+            this.bleno.on('accept', (clientAddress: string) => this.handleAccept(clientAddress));
+            this.bleno.on('disconnect', (clientAddress: string) => this.handleDisconnect(clientAddress));
 
         } catch (error) {
             logger.error('[BLE] Failed to initialize BLE:', error);
@@ -105,6 +118,29 @@ export class BLEBroadcaster extends EventEmitter {
         }
     }
 
+    private handleAccept(clientAddress: string): void {
+        logger.info(`[BLE] Client connected: ${clientAddress}`);
+        // A watch registers right after connecting: that register is this link's
+        this.clientAddress = clientAddress;
+    }
+
+    private handleDisconnect(clientAddress: string): void {
+        logger.info(`[BLE] Client disconnected: ${clientAddress}`);
+        if (this.clientAddress === clientAddress) {
+            this.clientAddress = null;
+        }
+
+        // Gone devices must not hold back the fragment/binary/MTU gates
+        // or keep alerts nobody else wants flowing
+        for (const [deviceId, device] of this.devices) {
+            if (device.address === clientAddress) {
+                logger.info(`[BLE] Device disconnected: ${device.name} (${deviceId})`);
+                this.devices.delete(deviceId);
+                this.emit('deviceDisconnected', deviceId);
+            }
+        }
+    }
+
     private startAdvertising(): void {
         if (!this.bleno || this.isAdvertising) return;
 
@@ -150,8 +186,8 @@ export class BLEBroadcaster extends EventEmitter {
             }
 
             onSubscribe(maxValueSize: number, updateValueCallback: any) {
-                logger.info('[BLE] Client subscribed to notifications');
-                this.broadcaster.subscriptions.add(updateValueCallback);
+                logger.info(`[BLE] Client subscribed to notifications (max value size ${maxValueSize})`);
+                this.broadcaster.subscriptions.set(updateValueCallback, maxValueSize);
                 this.broadcaster.notifyCharacteristic = updateValueCallback;
             }
 
@@ -237,6 +273,14 @@ export class BLEBroadcaster extends EventEmitter {
                 this.handleAck(message);
                 break;
 
+            case 'acks':
+                this.handleAckBatch(message);
+                break;
+
+            case 'resync':
+                this.handleResync(message);
+                break;
+
             default:
                 logger.warn(`[BLE] Unknown message type: ${msgType}`);
         }
@@ -250,20 +294,43 @@ export class BLEBroadcaster extends EventEmitter {
             deviceId,
             name: deviceName,
             connectedAt: new Date(),
-            lastActivity: new Date()
+            lastActivity: new Date(),
+            binaryWire: supportsBinaryWire(message),
+            mtu: Number(message.mtu) || null,
+            fragments: Boolean(message.frag),
+            filter: parseSubscriptionFilter(message.filter),
+            address: this.clientAddress
         };
 
         this.devices.set(deviceId, device);
 
-        logger.info(`[BLE] Device registered: ${deviceName} (${deviceId})`);
+        logger.info(`[BLE] Device registered: ${deviceName} (${deviceId}) - MTU ${device.mtu ?? 'unknown'}${device.fragments ? ' - frag' : ''}${device.binaryWire ? ' - binary' : ''}${device.filter ? ` - ${describeFilter(device.filter)}` : ''}`);
+
+        // Picks up after the last sequence the device has handled
+        const resume = notificationJournal.resume(message.seq_epoch, message.last_seq,
+            n => matchesFilter(device.filter, n));
 
-        // Send confirmation via notification
+        // Send confirmation via notification (client_time echo + our clock
+        // let the device sync for latency stats)
         this.sendToSubscribers({
             type: 'registered',
             device_id: deviceId,
-            message: 'Successfully registered with BitsperBox via BLE'
+            message: 'Successfully registered with BitsperBox via BLE',
+            ...(message.client_time !== undefined ? { client_time: message.client_time } : {}),
+            server_time: Date.now(),
+            seq_epoch: notificationJournal.epoch,
+            seq: resume.seq
         });
 
+        // Whatever was sent while it was away (subscribers aren't mapped
+        // to devices: the others drop these as duplicates)
+        for (const notification of resume.missed) {
+            this.sendNotification(notification);
+        }
+        if (resume.missed.length > 0) {
+            logger.info(`[BLE] Replayed ${resume.missed.length} missed notifications to ${deviceName} (from #${resume.missed[0].seq})`);
+        }
+
         this.emit('deviceConnected', {
             deviceId,
             name: deviceName,
@@ -286,16 +353,57 @@ export class BLEBroadcaster extends EventEmitter {
         this.emit('notificationAcked', { notificationId, deviceId });
     }
 
+    private handleAckBatch(message: any): void {
+        // Coalesced acks and user actions (own frame or on a heartbeat)
+        const deviceId = message.device_id;
+        const entries = parseAckBatch(message);
+        for (const { event, notificationId } of entries) {
+            this.emit(event, { notificationId, deviceId });
+        }
+        if (entries.length > 0) {
+            logger.debug(`[BLE] ${entries.length} acks/actions received from ${deviceId}`);
+        }
+    }
+
+    private handleResync(message: any): void {
+        // A device noticed a hole in the sequence numbers
+        const from = Number(message.from) || 0;
+        const to = Number(message.to) || 0;
+        const sameRun = message.seq_epoch === undefined || message.seq_epoch === notificationJournal.epoch;
+        const filter = this.devices.get(message.device_id)?.filter;
+        const missed = sameRun ? notificationJournal.range(from, to, n => matchesFilter(filter, n)) : [];
+        for (const notification of missed) {
+            this.sendNotification(notification);
+        }
+
+        // Anything in the range not sent is gone; the device stops waiting for it
+        this.sendToSubscribers({ type: 'resynced', device_id: message.device_id, to });
+        logger.info(`[BLE] Resync #${from}-#${to} for ${message.device_id}: ${missed.length} resent`);
+    }
+
     private sendToSubscribers(data: any): void {
+        this.sendBufferToSubscribers(Buffer.from(JSON.stringify(data)));
+    }
+
+    private sendBufferToSubscribers(buffer: Buffer): void {
         if (this.subscriptions.size === 0) {
             return;
         }
 
-        const buffer = Buffer.from(JSON.stringify(data));
+        // Fragments only when every registered device can put them back
+        // together; legacy firmware gets whole frames as before
+        const valueLimit = this.allDevicesFragment() ? this.deviceValueLimit() : null;
 
-        for (const callback of this.subscriptions) {
+        for (const [callback, maxValueSize] of this.subscriptions) {
             try {
-                callback(buffer);
+                if (valueLimit === null) {
+                    callback(buffer);
+                    continue;
+                }
+                const limit = Math.min(maxValueSize || valueLimit, valueLimit);
+                for (const packet of this.fragment(buffer, limit)) {
+                    callback(packet);
+                }
             } catch (error) {
                 logger.error('[BLE] Error sending to subscriber:', error);
             }
@@ -313,18 +421,111 @@ export class BLEBroadcaster extends EventEmitter {
             return;
         }
 
-        const message = {
-            type: 'notification',
-            ...notification
-        };
-
-        const jsonStr = JSON.stringify(message);
-        logger.info(`[BLE] Sending message (${jsonStr.length} bytes): ${jsonStr}`);
+        // Every subscriber gets every frame, so only skip what no
+        // registered device is subscribed to
+        const wanted = this.subscribedByAny();
+        if (!wanted(notification)) {
+            logger.info(`[BLE] No device subscribed to Table ${notification.table} - ${notification.alert}, not sent`);
+            return;
+        }
 
-        this.sendToSubscribers(message);
+        this.sendNotification(notification);
         logger.info(`[BLE] Notification broadcasted: Table ${notification.table} - ${notification.alert}`);
     }
 
+    private sendNotification(notification: NotificationPayload): void {
+        // Numbers nobody here was subscribed to aren't gaps
+        if (notification.seq !== undefined) {
+            const prev = notificationJournal.previous(notification.seq, this.subscribedByAny());
+            if (prev < notification.seq - 1) {
+                notification = { ...notification, prev_seq: prev };
+            }
+        }
+
+        // Subscriptions aren't mapped to device IDs, so binary is only used
+        // when every registered device understands it
+        if (this.allDevicesBinary()) {
+            const buffer = encodeNotification(notification);
+            logger.info(`[BLE] Sending binary message (${buffer.length} bytes)`);
+            this.sendBufferToSubscribers(buffer);
+        } else {
+            const message = {
+                type: 'notification',
+                ...notification
+            };
+
+            const jsonStr = JSON.stringify(message);
+            logger.info(`[BLE] Sending message (${jsonStr.length} bytes): ${jsonStr}`);
+
+            this.sendToSubscribers(message);
+        }
+    }
+
+    /**
+     * Largest notification value every registered device can receive
+     * (subscriptions aren't mapped to devices, so use the smallest MTU
+     * reported; a device that didn't report one doesn't pin it)
+     */
+    private deviceValueLimit(): number {
+        let mtu = MAX_ATT_MTU;
+        for (const device of this.devices.values()) {
+            if (device.mtu !== null) {
+                mtu = Math.min(mtu, device.mtu);
+            }
+        }
+        return mtu - 3;  // ATT notification header
+    }
+
+    private allDevicesFragment(): boolean {
+        if (this.devices.size === 0) return false;
+        for (const device of this.devices.values()) {
+            if (!device.fragments) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Split a payload into framed fragments when it doesn't fit one value
+     */
+    private fragment(buffer: Buffer, maxValueSize: number): Buffer[] {
+        if (buffer.length <= maxValueSize) {
+            return [buffer];
+        }
+
+        const chunkSize = maxValueSize - FRAG_HEADER_SIZE;
+        const count = Math.ceil(buffer.length / chunkSize);
+        if (chunkSize <= 0 || count > 255) {
+            logger.warn(`[BLE] Message too large to fragment (${buffer.length} bytes, limit ${maxValueSize})`);
+            return [buffer];
+        }
+
+        this.fragmentSeq = (this.fragmentSeq + 1) & 0xff;
+        const packets: Buffer[] = [];
+        for (let i = 0; i < count; i++) {
+            const chunk = buffer.subarray(i * chunkSize, (i + 1) * chunkSize);
+            packets.push(Buffer.concat([Buffer.from([FRAG_MARKER, this.fragmentSeq, i, count]), chunk]));
+        }
+
+        logger.debug(`[BLE] Fragmented ${buffer.length} bytes into ${count} packets of <= ${maxValueSize}`);
+        return packets;
+    }
+
+    private subscribedByAny(): (notification: FilterableNotification) => boolean {
+        const filters = Array.from(this.devices.values(), d => d.filter);
+        if (filters.length === 0 || filters.includes(null)) {
+            return () => true;
+        }
+        return n => filters.some(f => matchesFilter(f, n));
+    }
+
+    private allDevicesBinary(): boolean {
+        if (this.devices.size === 0) return false;
+        for (const device of this.devices.values()) {
+            if (!device.binaryWire) return false;
+        }
+        return true;
+    }
+
     /**
      * Send test notification
      */
@@ -381,6 +582,7 @@ export class BLEBroadcaster extends EventEmitter {
             this.stopAdvertising();
             // Clear devices
             this.devices.clear();
+            this.clientAddress = null;
             this.subscriptions.clear();
             logger.info('[BLE] BLE server stopped');
         }
@@ -8,6 +8,11 @@
 import { WebSocketServer, WebSocket } from 'ws';
 import { logger } from '../utils/logger.js';
 import { EventEmitter } from 'events';
+import { encodeNotification, encodeOtaChunk, supportsBinaryWire, WIRE_PROTOCOL_NAME } from '../utils/wireProtocol.js';
+import { parseAckBatch } from '../utils/ackBatch.js';
+import { notificationJournal } from '../utils/notificationJournal.js';
+import { SubscriptionFilter, parseSubscriptionFilter, matchesFilter, describeFilter } from '../utils/subscriptionFilter.js';
+import { FirmwareImage, FirmwareRollout, OtaReport, RolloutSummary } from '../utils/firmwareRollout.js';
 
 interface ConnectedDevice {
     ws: WebSocket;
@@ -19,6 +24,59 @@ interface ConnectedDevice {
     rssi?: number;
     freeHeap?: number;
     uptime?: number;
+    latency?: DeviceLatency;  // Last latency report from the heartbeat
+    boot?: BootTimeline;      // First heartbeat after each device boot
+    metrics?: DeviceMetrics;  // Last runtime metrics from the heartbeat
+    ota?: OtaReport;          // Firmware slot / update progress
+    binaryWire: boolean;  // Device accepts bpw1 binary notifications
+    filter: SubscriptionFilter | null;  // Declared on register; null = everything
+}
+
+// Notification latency histograms reported by the firmware
+// (bucket counts per transport; see esp32/src/latency_monitor.h)
+interface DeviceLatency {
+    edges: number[];
+    clock: { synced: boolean; offset: number; rtt: number };
+    ws: TransportLatency;
+    ble: TransportLatency;
+}
+
+// millis() at each boot milestone (see esp32/src/boot_timeline.h);
+// stages not reached yet are omitted
+interface BootTimeline {
+    display?: number;
+    config?: number;
+    tasks?: number;
+    wifi?: number;
+    ws?: number;
+    ble?: number;
+    first_notif?: number;
+    reset_reason: number;
+}
+
+// Runtime counters reported by the firmware (see esp32/src/metrics.h);
+// also served by the watch itself on http://<watch>:8080/metrics
+interface DeviceMetrics {
+    heap: [number, number, number];              // free, minimum ever, largest block
+    loop: Record<string, [number, number]>;      // per subsystem: avg us, max us
+    rx: [number, number, number];                // received over ws, ble, realtime
+    shown: number;
+    dup: number;
+    drop: [number, number, number];              // inbox full, queue full, acks
+    err: [number, number, number];               // json, binary decode, BLE reassembly
+    rc: [number, number, number];                // reconnects: ws, ble, realtime
+    seq?: [number, number];                      // resync requests, sequences given up
+}
+
+interface TransportLatency {
+    n: number;
+    net: number[];
+    dev: number[];
+    net_max: number;
+    dev_max: number;
+    parse_max_us: number;
+    queue_max_us: number;
+    render_max_us: number;
 }
 
 interface NotificationPayload {
@@ -28,6 +86,8 @@ interface NotificationPayload {
     message: string;
     priority: string;
     timestamp: number;
+    seq?: number;  // Journal sequence (see utils/notificationJournal.ts)
+    prev_seq?: number;  // Previous sequence sent to this device, when filtered
 }
 
 interface DeviceInfo {
@@ -37,6 +97,10 @@ interface DeviceInfo {
     connectedAt: Date;
     lastHeartbeat: Date;
     rssi?: number;
+    latency?: DeviceLatency;
+    boot?: BootTimeline;
+    metrics?: DeviceMetrics;
+    ota?: OtaReport;
     online: boolean;
 }
 
@@ -45,6 +109,7 @@ export class NotificationBroadcaster extends EventEmitter {
     private devices: Map<string, ConnectedDevice> = new Map();
     private port: number;
     private heartbeatInterval: NodeJS.Timeout | null = null;
+    private rollout: FirmwareRollout | null = null;
 
     constructor(port: number = 3334) {
         super();
@@ -135,7 +200,8 @@ export class NotificationBroadcaster extends EventEmitter {
         // Set ping interval to keep connection alive
         const pingInterval = setInterval(() => {
             if (ws.readyState === WebSocket.OPEN) {
-                this.sendToSocket(ws, { type: 'ping' });
+                // server_time lets devices track our clock for latency stats
+                this.sendToSocket(ws, { type: 'ping', server_time: Date.now() });
             } else {
                 clearInterval(pingInterval);
             }
@@ -157,10 +223,30 @@ export class NotificationBroadcaster extends EventEmitter {
                 this.handleAck(message);
                 break;
 
+            case 'acks':
+                this.handleAckBatch(message);
+                break;
+
+            case 'resync':
+                this.handleResync(message);
+                break;
+
             case 'pong':
                 // Pong response, connection is alive
                 break;
 
+            case 'log':
+                this.handleDeviceLog(message);
+                break;
+
+            case 'ota_chunk':
+                this.handleOtaChunk(message);
+                break;
+
+            case 'ota_status':
+                this.handleOtaStatus(message);
+                break;
+
             default:
                 logger.warn(`[Broadcaster] Unknown message type: ${msgType}`);
         }
@@ -172,6 +258,8 @@ export class NotificationBroadcaster extends EventEmitter {
         const deviceId = message.device_id;
         const deviceName = message.name || 'Unknown Device';
         const firmware = message.firmware || 'unknown';
+        const binaryWire = supportsBinaryWire(message);
+        const filter = parseSubscriptionFilter(message.filter);
 
         // Check if device already connected (reconnection)
         if (this.devices.has(deviceId)) {
@@ -187,26 +275,53 @@ export class NotificationBroadcaster extends EventEmitter {
             name: deviceName,
             firmware,
             connectedAt: new Date(),
-            lastHeartbeat: new Date()
+            lastHeartbeat: new Date(),
+            // Its millis(): tells a restart from a reconnect
+            uptime: typeof message.client_time === 'number' ? Math.floor(message.client_time / 1000) : undefined,
+            binaryWire,
+            filter
         };
 
         this.devices.set(deviceId, device);
 
-        logger.info(`[Broadcaster] Device registered: ${deviceName} (${deviceId}) - Firmware: ${firmware}`);
+        logger.info(`[Broadcaster] Device registered: ${deviceName} (${deviceId}) - Firmware: ${firmware}${binaryWire ? ' - binary' : ''}${filter ? ` - ${describeFilter(filter)}` : ''}`);
 
-        // Send confirmation
+        // Picks up after the last sequence the device has handled
+        const resume = notificationJournal.resume(message.seq_epoch, message.last_seq,
+            n => matchesFilter(filter, n));
+
+        // Send confirmation (echoing the wire protocol confirms we'll use it).
+        // Echoing client_time next to our clock gives the device an RTT-corrected
+        // clock offset, so it can measure network latency of notifications.
         this.sendToSocket(ws, {
             type: 'registered',
             device_id: deviceId,
-            message: 'Successfully registered with BitsperBox'
+            message: 'Successfully registered with BitsperBox',
+            ...(binaryWire ? { wire: WIRE_PROTOCOL_NAME } : {}),
+            ...(message.client_time !== undefined ? { client_time: message.client_time } : {}),
+            server_time: Date.now(),
+            seq_epoch: notificationJournal.epoch,
+            seq: resume.seq
         });
 
+        // Whatever was sent while it was away
+        for (const notification of resume.missed) {
+            this.sendNotification(device, notification);
+        }
+        if (resume.missed.length > 0) {
+            logger.info(`[Broadcaster] Replayed ${resume.missed.length} missed notifications to ${deviceName} (from #${resume.missed[0].seq})`);
+        }
+
         this.emit('deviceConnected', {
             deviceId,
             name: deviceName,
             firmware
         });
 
+        // Back after restarting into a new image (or rolled back), or due one
+        this.trackRollout(device, undefined);
+        this.offerFirmware(device, undefined);
+
         return deviceId;
     }
 
@@ -218,7 +333,25 @@ export class NotificationBroadcaster extends EventEmitter {
             device.uptime = message.uptime;
             device.freeHeap = message.free_heap;
             device.rssi = message.rssi;
+            if (message.latency) {
+                device.latency = message.latency;
+            }
+            if (message.boot) {
+                device.boot = message.boot;
+                logger.info(`[Broadcaster] ${device.name} booted: ready over WS at ${message.boot.ws ?? '?'} ms (reset reason ${message.boot.reset_reason})`);
+            }
+            if (message.metrics) {
+                device.metrics = message.metrics;
+            }
+            if (message.ota) {
+                device.ota = message.ota;
+                this.trackRollout(device, message.ota);
+                this.offerFirmware(device, message.ota);
+            }
         }
+
+        // Pending acks ride along on heartbeats
+        this.handleAckBatch(message);
     }
 
     private handleAck(message: any): void {
@@ -228,6 +361,92 @@ export class NotificationBroadcaster extends EventEmitter {
         this.emit('notificationAcked', { notificationId, deviceId });
     }
 
+    private handleAckBatch(message: any): void {
+        // Coalesced acks and user actions (own frame or on a heartbeat)
+        const deviceId = message.device_id;
+        const entries = parseAckBatch(message);
+        for (const { event, notificationId } of entries) {
+            this.emit(event, { notificationId, deviceId });
+        }
+        if (entries.length > 0) {
+            logger.debug(`[Broadcaster] ${entries.length} acks/actions received from ${deviceId}`);
+        }
+    }
+
+    private handleResync(message: any): void {
+        // A device noticed a hole in the sequence numbers
+        const device = this.devices.get(message.device_id);
+        if (!device) return;
+
+        const from = Number(message.from) || 0;
+        const to = Number(message.to) || 0;
+        const sameRun = message.seq_epoch === undefined || message.seq_epoch === notificationJournal.epoch;
+        const missed = sameRun ? notificationJournal.range(from, to, n => matchesFilter(device.filter, n)) : [];
+        for (const notification of missed) {
+            this.sendNotification(device, notification);
+        }
+
+        // Anything in the range not sent is gone; the device stops waiting for it
+        this.sendToSocket(device.ws, { type: 'resynced', to });
+        logger.info(`[Broadcaster] Resync #${from}-#${to} for ${device.name}: ${missed.length} resent`);
+    }
+
+    private handleDeviceLog(message: any): void {
+        // Remote log tail requested with setLogTail()
+        const deviceId = message.device_id;
+        const name = this.devices.get(deviceId)?.name ?? deviceId;
+        const lines = String(message.text ?? '').split('\n').filter(line => line.length > 0);
+        for (const line of lines) {
+            logger.info(`[Watch ${name}] ${line}`);
+        }
+        this.emit('deviceLog', { deviceId, lines, dropped: message.dropped ?? 0 });
+    }
+
+    private handleOtaChunk(message: any): void {
+        // A watch pulling the next piece of the image
+        const device = this.devices.get(message.device_id);
+        if (!device || !this.rollout?.isUpdating(device.deviceId)) return;
+
+        const data = this.rollout.chunk(message.offset, message.length);
+        if (!data) {
+            logger.warn(`[Broadcaster] Bad firmware chunk request from ${device.name}: ${message.offset}+${message.length}`);
+            return;
+        }
+        if (device.ws.readyState === WebSocket.OPEN) {
+            device.ws.send(encodeOtaChunk(message.offset, data));
+        }
+    }
+
+    private handleOtaStatus(message: any): void {
+        // Sent on every update state change, between heartbeats
+        const device = this.devices.get(message.device_id);
+        if (!device || !message.ota) return;
+
+        device.ota = message.ota;
+        this.trackRollout(device, message.ota);
+    }
+
+    private trackRollout(device: ConnectedDevice, report: OtaReport | undefined): void {
+        const state = this.rollout?.onReport(device.deviceId, device.firmware, report, device.uptime);
+        if (!state || !this.rollout) return;
+
+        const summary = this.rollout.getSummary();
+        const detail = summary.watches[device.deviceId]?.detail;
+        if (state === 'failed') {
+            logger.error(`[Broadcaster] Firmware ${summary.version} failed on ${device.name}: ${detail} - rollout halted`);
+        } else {
+            logger.info(`[Broadcaster] Firmware ${summary.version} on ${device.name}: ${state}${detail ? ` (${detail})` : ''} - wave ${summary.wave}`);
+        }
+    }
+
+    private offerFirmware(device: ConnectedDevice, report: OtaReport | undefined): void {
+        if (!this.rollout?.shouldOffer(device.deviceId, device.firmware, report)) return;
+
+        const { version, data, sha256 } = this.rollout.image;
+        this.sendToSocket(device.ws, { type: 'ota_offer', version, size: data.length, sha256 });
+        logger.info(`[Broadcaster] Offering firmware ${version} to ${device.name} (wave ${this.rollout.getSummary().wave}, running ${device.firmware})`);
+    }
+
     private startHeartbeatChecker(): void {
         // Check for stale connections every 60 seconds
         this.heartbeatInterval = setInterval(() => {
@@ -252,6 +471,27 @@ export class NotificationBroadcaster extends EventEmitter {
         }
     }
 
+    private sendNotification(device: ConnectedDevice, notification: NotificationPayload): void {
+        // A filtered device skips numbers; tell it which ones weren't for it
+        if (device.filter && notification.seq !== undefined) {
+            const prev = notificationJournal.previous(notification.seq, n => matchesFilter(device.filter, n));
+            if (prev < notification.seq - 1) {
+                notification = { ...notification, prev_seq: prev };
+            }
+        }
+
+        if (device.binaryWire) {
+            if (device.ws.readyState === WebSocket.OPEN) {
+                device.ws.send(encodeNotification(notification));
+            }
+        } else {
+            this.sendToSocket(device.ws, {
+                type: 'notification',
+                ...notification
+            });
+        }
+    }
+
     /**
      * Broadcast notification to all connected devices
      */
@@ -261,17 +501,32 @@ export class NotificationBroadcaster extends EventEmitter {
             ...notification
         };
 
-        const messageStr = JSON.stringify(message);
+        // Encode each representation at most once (for the unfiltered devices)
+        let messageStr: string | null = null;
+        let messageBin: Buffer | null = null;
         let sentCount = 0;
+        let filteredCount = 0;
 
         for (const device of this.devices.values()) {
             if (device.ws.readyState === WebSocket.OPEN) {
-                device.ws.send(messageStr);
+                if (device.filter) {
+                    if (!matchesFilter(device.filter, notification)) {
+                        filteredCount++;
+                        continue;
+                    }
+                    this.sendNotification(device, notification);
+                } else if (device.binaryWire) {
+                    messageBin ??= encodeNotification(notification);
+                    device.ws.send(messageBin);
+                } else {
+                    messageStr ??= JSON.stringify(message);
+                    device.ws.send(messageStr);
+                }
                 sentCount++;
             }
         }
 
-        logger.info(`[Broadcaster] Notification broadcasted to ${sentCount} devices: Table ${notification.table} - ${notification.alert}`);
+        logger.info(`[Broadcaster] Notification broadcasted to ${sentCount} devices${filteredCount > 0 ? ` (${filteredCount} not subscribed)` : ''}: Table ${notification.table} - ${notification.alert}`);
     }
 
     /**
@@ -283,10 +538,7 @@ export class NotificationBroadcaster extends EventEmitter {
             return false;
         }
 
-        this.sendToSocket(device.ws, {
-            type: 'notification',
-            ...notification
-        });
+        this.sendNotification(device, notification);
 
         logger.info(`[Broadcaster] Notification sent to device ${deviceId}`);
         return true;
@@ -317,10 +569,63 @@ export class NotificationBroadcaster extends EventEmitter {
             connectedAt: d.connectedAt,
             lastHeartbeat: d.lastHeartbeat,
             rssi: d.rssi,
+            latency: d.latency,
+            boot: d.boot,
+            metrics: d.metrics,
+            ota: d.ota,
             online: d.ws.readyState === WebSocket.OPEN
         }));
     }
 
+    /**
+     * Start or stop a device's remote log tail (field debugging).
+     * level: 0 off, 1 errors, 2 warnings, 3 info, 4 debug (see
+     * esp32/src/debug_log.h); only levels compiled into the firmware arrive
+     */
+    setLogTail(deviceId: string, level: number): boolean {
+        const device = this.devices.get(deviceId);
+        if (!device || device.ws.readyState !== WebSocket.OPEN) {
+            return false;
+        }
+
+        this.sendToSocket(device.ws, { type: 'log_tail', level });
+        logger.info(`[Broadcaster] Log tail for ${device.name} set to level ${level}`);
+        return true;
+    }
+
+    /**
+     * Roll a firmware image out to the watches, `waveSize` at a time.
+     * A watch gets it on register or its next heartbeat; a failure on
+     * any watch stops the rollout (see utils/firmwareRollout.ts)
+     */
+    startRollout(image: FirmwareImage, waveSize: number): void {
+        this.rollout = new FirmwareRollout(image, Math.max(1, waveSize));
+        logger.info(`[Broadcaster] Firmware rollout: ${image.version} (${image.data.length} bytes, sha256 ${image.sha256.slice(0, 12)}...) in waves of ${this.rollout.waveSize}`);
+
+        for (const device of this.devices.values()) {
+            this.offerFirmware(device, device.ota);
+        }
+    }
+
+    /**
+     * Stop offering the image; transfers in progress are cancelled
+     */
+    stopRollout(): void {
+        if (!this.rollout) return;
+
+        for (const device of this.devices.values()) {
+            if (this.rollout.isUpdating(device.deviceId)) {
+                this.sendToSocket(device.ws, { type: 'ota_cancel' });
+            }
+        }
+        logger.info(`[Broadcaster] Firmware rollout of ${this.rollout.image.version} stopped`);
+        this.rollout = null;
+    }
+
+    getRollout(): RolloutSummary | null {
+        return this.rollout?.getSummary() ?? null;
+    }
+
     /**
      * Get count of connected devices
      */
@@ -3,6 +3,7 @@ import { logger } from '../utils/logger.js'
 import type { DeviceConfig, Order, RealtimePayload } from '../types/index.js'
 import { notificationBroadcaster } from './NotificationBroadcaster.js'
 import { bleBroadcaster } from './BLEBroadcaster.js'
+import { notificationJournal } from '../utils/notificationJournal.js'
 
 // ============================================
 // Types for Realtime Events
@@ -344,15 +345,16 @@ export class RealtimeManager {
 
     logger.info(`🔔 Menu Pro notification: ${notification.type} for table ${notification.table_number}`)
 
-    // Create notification payload
-    const payload = {
+    // Create notification payload, numbered once for both transports so
+    // a watch can tell what it missed (either way) and ask for it again
+    const payload = notificationJournal.append({
       id: notification.id,
       table: notification.table_number,
       alert: notification.type,
       message: notification.message || notification.title,
       priority: notification.priority,
       timestamp: Date.now()
-    }
+    })
 
     // Broadcast to all connected ESP32 devices via WiFi WebSocket
     notificationBroadcaster.broadcast(payload)
@@ -0,0 +1,36 @@
+/**
+ * BitsperWatch ack batches
+ *
+ * Devices coalesce delivery acks and user actions into one frame
+ * (esp32/src/ack_batcher.h): a `type: 'acks'` message, or the same
+ * arrays piggybacked on a heartbeat.
+ *
+ *   { acks: [id...], displayed: [id...], dismissed: [id...] }
+ */
+
+export type AckEvent = 'notificationAcked' | 'notificationDisplayed' | 'notificationDismissed'
+
+const ACK_FIELDS: Array<[string, AckEvent]> = [
+  ['acks', 'notificationAcked'],
+  ['displayed', 'notificationDisplayed'],
+  ['dismissed', 'notificationDismissed']
+]
+
+export interface AckEntry {
+  event: AckEvent
+  notificationId: string
+}
+
+export function parseAckBatch(message: Record<string, unknown>): AckEntry[] {
+  const entries: AckEntry[] = []
+  for (const [field, event] of ACK_FIELDS) {
+    const ids = message[field]
+    if (!Array.isArray(ids)) continue
+    for (const id of ids) {
+      if (typeof id === 'string' && id.length > 0) {
+        entries.push({ event, notificationId: id })
+      }
+    }
+  }
+  return entries
+}
@@ -0,0 +1,202 @@
+/**
+ * BitsperWatch firmware rollout
+ *
+ * Hands a new firmware image to the watches over their WebSocket, one
+ * wave at a time (esp32/src/ota_updater.h):
+ *
+ *   ota_offer { version, size, sha256 }  ->  ota_chunk { offset, length }, answered
+ *                                            with binary chunks until done
+ *   heartbeat / ota_status { ota: { state, done, total, verifying, error } }
+ *
+ * A wave is up to `waveSize` watches. The next wave starts only once
+ * every watch in the current one runs the new version and has kept it
+ * (no longer "verifying"). A failed download, or a watch coming back on
+ * its old firmware after restarting into the new one, stops the rollout
+ * so the rest of the fleet stays where it is.
+ */
+
+import { createHash } from 'crypto'
+import { readFileSync } from 'fs'
+
+// OTA_CHUNK_SIZE on the watch: the most it asks for at once
+const OTA_CHUNK_MAX = 4096
+
+// A watch still not done by then counts as failed
+const UPDATE_TIMEOUT_MS = 20 * 60 * 1000
+
+// First byte of an ESP32 app image
+const ESP_IMAGE_MAGIC = 0xe9
+
+export interface FirmwareImage {
+  version: string
+  data: Buffer
+  sha256: string
+}
+
+// The watch's `ota` object (OtaUpdater::writeJson)
+export interface OtaReport {
+  state?: string        // idle, downloading, rebooting, failed
+  ab?: boolean          // Has a second app slot
+  version?: string
+  done?: number
+  total?: number
+  error?: string
+  verifying?: boolean   // Running a new image not kept yet
+  rolled_back?: boolean
+}
+
+type WatchState = 'updating' | 'done' | 'failed' | 'skipped'
+
+interface WatchRollout {
+  deviceId: string
+  state: WatchState
+  wave: number
+  startedAt: number
+  rebooted: boolean     // Reported "rebooting": the next report after a restart shows the outcome
+  rebootUptime?: number // Its uptime (s) then; a register below it means it restarted
+  detail?: string
+}
+
+export interface RolloutSummary {
+  version: string
+  size: number
+  wave: number
+  waveSize: number
+  halted: string | null
+  watches: Record<string, { state: WatchState; wave: number; detail?: string }>
+}
+
+export function loadFirmwareImage(path: string, version: string): FirmwareImage {
+  const data = readFileSync(path)
+  if (data.length === 0 || data[0] !== ESP_IMAGE_MAGIC) {
+    throw new Error(`${path} is not an ESP32 app image`)
+  }
+  return { version, data, sha256: createHash('sha256').update(data).digest('hex') }
+}
+
+export class FirmwareRollout {
+  private watches = new Map<string, WatchRollout>()
+  private wave = 1
+  private halted: string | null = null
+
+  constructor(readonly image: FirmwareImage, readonly waveSize: number) {}
+
+  /**
+   * Whether to (re)offer the image to a watch running `firmware`, on
+   * register and on heartbeats. Admits it to the current wave if there
+   * is room
+   */
+  shouldOffer(deviceId: string, firmware: string, report?: OtaReport): boolean {
+    if (firmware === this.image.version) return false
+
+    const watch = this.watches.get(deviceId)
+    if (watch) {
+      // Lost its transfer (reconnect, restart): offer again to resume or restart it
+      return watch.state === 'updating' && !watch.rebooted &&
+        report?.state !== 'downloading' && report?.state !== 'rebooting'
+    }
+
+    this.checkTimeouts()
+    if (this.halted || this.inWave() >= this.waveSize) return false
+
+    this.watches.set(deviceId, { deviceId, state: 'updating', wave: this.wave, startedAt: Date.now(), rebooted: false })
+    return true
+  }
+
+  /**
+   * A report from a watch in the rollout (heartbeat or ota_status), or
+   * its register (no report); `uptime` is the watch's in seconds.
+   * Returns its new state when that changed
+   */
+  onReport(deviceId: string, firmware: string, report: OtaReport | undefined, uptime?: number): WatchState | null {
+    const watch = this.watches.get(deviceId)
+    if (!watch || watch.state !== 'updating') return null
+
+    if (report?.error === 'no_slot') {
+      this.settle(watch, 'skipped', 'single-slot partition table, needs USB')
+    } else if (report?.state === 'failed' || report?.error === 'bad_offer') {
+      this.settle(watch, 'failed', report?.error ?? 'failed')
+    } else if (watch.rebooted && firmware !== this.image.version && this.restarted(watch, report, uptime)) {
+      // Restarted, and the bootloader went back to the old slot
+      this.settle(watch, 'failed', `rolled back to ${firmware}`)
+    } else if (firmware === this.image.version && report !== undefined && !report.verifying) {
+      this.settle(watch, 'done')
+    } else if (Date.now() - watch.startedAt > UPDATE_TIMEOUT_MS) {
+      this.settle(watch, 'failed', 'timeout')
+    } else {
+      if (report?.state === 'rebooting' && !watch.rebooted) {
+        watch.rebooted = true
+        watch.rebootUptime = uptime
+      }
+      return null
+    }
+    return watch.state
+  }
+
+  /**
+   * Bytes for a watch's chunk request, null if it's out of range
+   */
+  chunk(offset: unknown, length: unknown): Buffer | null {
+    if (typeof offset !== 'number' || typeof length !== 'number') return null
+    if (offset < 0 || offset >= this.image.data.length || length <= 0 || length > OTA_CHUNK_MAX) return null
+    return this.image.data.subarray(offset, offset + length)
+  }
+
+  isUpdating(deviceId: string): boolean {
+    return this.watches.get(deviceId)?.state === 'updating'
+  }
+
+  getSummary(): RolloutSummary {
+    const watches: RolloutSummary['watches'] = {}
+    for (const [deviceId, { state, wave, detail }] of this.watches) {
+      watches[deviceId] = { state, wave, ...(detail ? { detail } : {}) }
+    }
+    return {
+      version: this.image.version,
+      size: this.image.data.length,
+      wave: this.wave,
+      waveSize: this.waveSize,
+      halted: this.halted,
+      watches,
+    }
+  }
+
+  private settle(watch: WatchRollout, state: WatchState, detail?: string): void {
+    watch.state = state
+    watch.detail = detail
+    if (state === 'failed' && !this.halted) {
+      this.halted = `${watch.deviceId}: ${detail ?? 'failed'}`
+    }
+
+    // Everyone in this wave is through: open the next one
+    if (!this.halted && this.inWave('updating') === 0) {
+      this.wave++
+    }
+  }
+
+  private restarted(watch: WatchRollout, report: OtaReport | undefined, uptime?: number): boolean {
+    if (report !== undefined) return report.state !== 'rebooting'
+
+    // A register alone may just be the WS reconnecting before the restart:
+    // only an uptime reset says it came back up
+    return uptime !== undefined && watch.rebootUptime !== undefined && uptime < watch.rebootUptime
+  }
+
+  private checkTimeouts(): void {
+    // A watch that went away mid-update would hold its wave forever
+    const now = Date.now()
+    for (const watch of this.watches.values()) {
+      if (watch.state === 'updating' && now - watch.startedAt > UPDATE_TIMEOUT_MS) {
+        this.settle(watch, 'failed', 'timeout')
+      }
+    }
+  }
+
+  private inWave(state?: WatchState): number {
+    let count = 0
+    for (const watch of this.watches.values()) {
+      if (watch.wave === this.wave && (state === undefined || watch.state === state)) count++
+    }
+    return count
+  }
+}
@@ -0,0 +1,111 @@
+/**
+ * BitsperWatch notification journal
+ *
+ * Every notification sent to the watches gets a sequence number, shared
+ * by the WebSocket and BLE paths, and the last JOURNAL_SIZE are kept so
+ * a watch can catch up (esp32/src/sequence_tracker.h):
+ *
+ *   register  { seq_epoch, last_seq }  ->  registered { seq_epoch, seq } + the missed ones
+ *   resync    { from, to }             ->  the ones still kept + resynced { to }
+ *
+ * Numbers restart with each box run; the epoch (its start, in seconds)
+ * tells a watch its last_seq belongs to an older run. A watch with a
+ * subscription filter only gets some numbers; `prev_seq` on each of its
+ * notifications tells it the ones in between were not for it.
+ */
+
+// Matches SEQ_WINDOW on the watch: a gap wider than this can't be filled anyway
+const JOURNAL_SIZE = 64
+
+// A replayed alert older than this is stale for the floor staff
+const REPLAY_MAX_AGE_MS = 10 * 60 * 1000
+
+export interface SequencedNotification {
+  id?: string
+  table: string
+  alert: string
+  message: string
+  priority: string
+  timestamp: number
+  seq: number
+}
+
+export type NotificationPredicate = (notification: SequencedNotification) => boolean
+
+const ALL: NotificationPredicate = () => true
+
+interface JournalEntry {
+  notification: SequencedNotification
+  sentAt: number
+}
+
+export interface ResumePoint {
+  seq: number                              // Watch counts everything up to here as handled
+  missed: SequencedNotification[]          // Oldest first, to send after `registered`
+}
+
+export class NotificationJournal {
+  readonly epoch = Math.floor(Date.now() / 1000)
+  private entries: JournalEntry[] = []
+  private head = 0
+
+  /**
+   * Number a notification and remember it for replays
+   */
+  append<T extends Omit<SequencedNotification, 'seq'>>(notification: T): T & { seq: number } {
+    const sequenced = { ...notification, seq: ++this.head }
+    this.entries.push({ notification: sequenced, sentAt: Date.now() })
+    if (this.entries.length > JOURNAL_SIZE) {
+      this.entries.shift()
+    }
+    return sequenced
+  }
+
+  /**
+   * Where a registering watch picks up. A watch that has seen nothing
+   * sequenced since it booted (no epoch) starts at the head: replaying
+   * everything would flood it with alerts it may have already handled
+   */
+  resume(epoch: unknown, lastSeq: unknown, accept: NotificationPredicate = ALL): ResumePoint {
+    if (typeof epoch !== 'number' || epoch === 0) {
+      return { seq: this.head, missed: [] }
+    }
+
+    // Same run: after its last one. Older run: whatever this run sent
+    const after = epoch === this.epoch && typeof lastSeq === 'number' ? lastSeq : 0
+    const missed = this.range(after + 1, this.head, accept)
+    return { seq: missed.length > 0 ? missed[0].seq - 1 : this.head, missed }
+  }
+
+  /**
+   * Kept notifications with from <= seq <= to, oldest first
+   */
+  range(from: number, to: number, accept: NotificationPredicate = ALL): SequencedNotification[] {
+    const oldest = Date.now() - REPLAY_MAX_AGE_MS
+    return this.entries
+      .filter(e => e.notification.seq >= from && e.notification.seq <= to && e.sentAt >= oldest)
+      .map(e => e.notification)
+      .filter(accept)
+  }
+
+  /**
+   * The last number before `seq` that `accept` takes, as far back as
+   * the journal goes (older numbers can't be resent anyway)
+   */
+  previous(seq: number, accept: NotificationPredicate): number {
+    for (let i = this.entries.length - 1; i >= 0; i--) {
+      const notification = this.entries[i].notification
+      if (notification.seq < seq && accept(notification)) {
+        return notification.seq
+      }
+    }
+    return this.entries.length > 0 ? Math.min(this.entries[0].notification.seq, seq) - 1 : seq - 1
+  }
+
+  getHead(): number {
+    return this.head
+  }
+}
+
+// Singleton instance
+export const notificationJournal = new NotificationJournal()
@@ -0,0 +1,82 @@
+/**
+ * BitsperWatch subscription filters
+ *
+ * A watch declares which alerts it is for in its register message
+ * (esp32/src/subscription_filter.h) and only gets those:
+ *
+ *   filter: { zones: ['t'], tables: [[1, 12], [20, 20]],
+ *             alerts: ['waiter_called'], min_priority: 'high' }
+ *
+ * A table label splits into a zone (the text before the first digit,
+ * lower-cased: 'T12' -> 't', 'Terraza 3' -> 'terraza') and a number.
+ * Every criterion that is set must match; no filter takes everything.
+ */
+
+const PRIORITIES = ['low', 'medium', 'high', 'urgent']
+
+export interface SubscriptionFilter {
+  zones: string[]
+  tables: Array<[number, number]>
+  alerts: string[]
+  minPriority: number  // Index in PRIORITIES
+}
+
+export interface FilterableNotification {
+  table: string
+  alert: string
+  priority: string
+}
+
+export function parseSubscriptionFilter(raw: unknown): SubscriptionFilter | null {
+  if (!raw || typeof raw !== 'object') return null
+  const input = raw as Record<string, unknown>
+
+  const zones = Array.isArray(input.zones)
+    ? input.zones.filter((z): z is string => typeof z === 'string' && z.length > 0).map(z => z.toLowerCase())
+    : []
+  const tables = Array.isArray(input.tables)
+    ? input.tables
+        .filter((r): r is [number, number] => Array.isArray(r) && typeof r[0] === 'number' && typeof r[1] === 'number')
+        .map(([lo, hi]): [number, number] => [lo, hi])
+    : []
+  const alerts = Array.isArray(input.alerts)
+    ? input.alerts.filter((a): a is string => typeof a === 'string')
+    : []
+  const minPriority = Math.max(0, PRIORITIES.indexOf(String(input.min_priority ?? 'low')))
+
+  if (zones.length === 0 && tables.length === 0 && alerts.length === 0 && minPriority === 0) {
+    return null
+  }
+  return { zones, tables, alerts, minPriority }
+}
+
+export function splitTable(label: string): { zone: string; number: number } {
+  const match = /^(\D*)(\d+)?/.exec(String(label ?? ''))
+  const zone = (match?.[1] ?? '').replace(/[\s_-]+$/, '').toLowerCase()
+  return { zone, number: match?.[2] !== undefined ? parseInt(match[2], 10) : -1 }
+}
+
+export function matchesFilter(filter: SubscriptionFilter | null | undefined, notification: FilterableNotification): boolean {
+  if (!filter) return true
+
+  const rank = PRIORITIES.indexOf(notification.priority)
+  if ((rank < 0 ? 1 : rank) < filter.minPriority) return false
+  if (filter.alerts.length > 0 && !filter.alerts.includes(notification.alert)) return false
+
+  if (filter.zones.length > 0 || filter.tables.length > 0) {
+    const { zone, number } = splitTable(notification.table)
+    if (filter.zones.length > 0 && !filter.zones.includes(zone)) return false
+    if (filter.tables.length > 0 && !filter.tables.some(([lo, hi]) => number >= lo && number <= hi)) return false
+  }
+  return true
+}
+
+export function describeFilter(filter: SubscriptionFilter | null | undefined): string {
+  if (!filter) return 'all'
+  const parts: string[] = []
+  if (filter.zones.length > 0) parts.push(`zones ${filter.zones.join(',')}`)
+  if (filter.tables.length > 0) parts.push(`tables ${filter.tables.map(([lo, hi]) => lo === hi ? `${lo}` : `${lo}-${hi}`).join(',')}`)
+  if (filter.alerts.length > 0) parts.push(`alerts ${filter.alerts.join(',')}`)
+  if (filter.minPriority > 0) parts.push(`from ${PRIORITIES[filter.minPriority]}`)
+  return parts.join(', ')
+}
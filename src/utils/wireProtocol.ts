@@ -0,0 +1,131 @@
+/**
+ * BitsperWatch binary wire protocol ("bpw1")
+ *
+ * Compact TLV encoding for ESP32 notifications. Must match
+ * esp32/src/wire_protocol.h. Devices announce support with
+ * `wire: 'bpw1'` in their register message; everyone else gets JSON.
+ *
+ *   [magic 0xB7][version][msg type] then repeated [tag][len][value]
+ *
+ * Firmware chunks (utils/firmwareRollout.ts) carry raw bytes instead:
+ *
+ *   [magic 0xB7][version][0x02][offset: 4 bytes, little-endian][data]
+ */
+
+export const WIRE_PROTOCOL_NAME = 'bpw1'
+
+const WIRE_MAGIC = 0xb7
+const WIRE_VERSION = 1
+const WIRE_MSG_NOTIFICATION = 0x01
+const WIRE_MSG_OTA_CHUNK = 0x02
+
+const TAG_ID = 0x01
+const TAG_TABLE = 0x02
+const TAG_ALERT_CODE = 0x03
+const TAG_ALERT = 0x04
+const TAG_PRIORITY = 0x05
+const TAG_MESSAGE = 0x06
+const TAG_TIMESTAMP = 0x07
+const TAG_ID_UUID = 0x08
+const TAG_SEQ = 0x09
+const TAG_PREV_SEQ = 0x0a
+
+const ALERT_CODES: Record<string, number> = {
+  waiter_called: 1,
+  bill_ready: 2,
+  payment_confirmed: 3,
+  urgent: 4,
+}
+
+const PRIORITY_CODES: Record<string, number> = {
+  low: 0,
+  medium: 1,
+  high: 2,
+  urgent: 3,
+}
+
+const UUID_RE = /^[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$/i
+
+export interface WireNotification {
+  id?: string
+  table: string
+  alert: string
+  message: string
+  priority: string
+  timestamp: number
+  seq?: number
+  prev_seq?: number
+}
+
+export function supportsBinaryWire(message: { wire?: unknown }): boolean {
+  return message.wire === WIRE_PROTOCOL_NAME
+}
+
+function field(tag: number, value: Buffer): Buffer {
+  // Values are capped at 255 bytes (1-byte length)
+  const body = value.length > 255 ? value.subarray(0, 255) : value
+  return Buffer.concat([Buffer.from([tag, body.length]), body])
+}
+
+function stringField(tag: number, value: string): Buffer {
+  let bytes = Buffer.from(value, 'utf8')
+  if (bytes.length > 255) {
+    // Don't cut a multi-byte UTF-8 sequence in half
+    let end = 255
+    while (end > 0 && (bytes[end] & 0xc0) === 0x80) end--
+    bytes = bytes.subarray(0, end)
+  }
+  return field(tag, bytes)
+}
+
+export function encodeNotification(notification: WireNotification): Buffer {
+  const parts: Buffer[] = [Buffer.from([WIRE_MAGIC, WIRE_VERSION, WIRE_MSG_NOTIFICATION])]
+
+  if (notification.id) {
+    if (UUID_RE.test(notification.id)) {
+      parts.push(field(TAG_ID_UUID, Buffer.from(notification.id.replace(/-/g, ''), 'hex')))
+    } else {
+      parts.push(stringField(TAG_ID, notification.id))
+    }
+  }
+
+  parts.push(stringField(TAG_TABLE, String(notification.table ?? '')))
+
+  const alertCode = ALERT_CODES[notification.alert]
+  if (alertCode !== undefined) {
+    parts.push(field(TAG_ALERT_CODE, Buffer.from([alertCode])))
+  } else {
+    parts.push(stringField(TAG_ALERT, notification.alert ?? ''))
+  }
+
+  const priorityCode = PRIORITY_CODES[notification.priority] ?? PRIORITY_CODES.medium
+  parts.push(field(TAG_PRIORITY, Buffer.from([priorityCode])))
+
+  if (notification.message) {
+    parts.push(stringField(TAG_MESSAGE, notification.message))
+  }
+
+  const ts = Buffer.alloc(8)
+  ts.writeBigUInt64LE(BigInt(Math.max(0, Math.floor(notification.timestamp))))
+  parts.push(field(TAG_TIMESTAMP, ts))
+
+  if (notification.seq !== undefined) {
+    const seq = Buffer.alloc(4)
+    seq.writeUInt32LE(notification.seq >>> 0)
+    parts.push(field(TAG_SEQ, seq))
+  }
+
+  if (notification.prev_seq !== undefined) {
+    const prev = Buffer.alloc(4)
+    prev.writeUInt32LE(notification.prev_seq >>> 0)
+    parts.push(field(TAG_PREV_SEQ, prev))
+  }
+
+  return Buffer.concat(parts)
+}
+
+export function encodeOtaChunk(offset: number, data: Buffer): Buffer {
+  const header = Buffer.from([WIRE_MAGIC, WIRE_VERSION, WIRE_MSG_OTA_CHUNK, 0, 0, 0, 0])
+  header.writeUInt32LE(offset >>> 0, 3)
+  return Buffer.concat([header, data])
+}
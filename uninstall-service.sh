@@ -22,6 +22,7 @@ systemctl disable bitsperbox 2>/dev/null || true
 
 echo "Removing service file..."
 rm -f /etc/systemd/system/bitsperbox.service
+rm -f /etc/avahi/services/bitsperbox.service
 
 echo "Reloading systemd..."
 systemctl daemon-reload